@@ -9,6 +9,7 @@
 constexpr unsigned CAN_TIMEOUT_MS = 100;          // 100
 constexpr uint8_t RPM_MSG_PERIOD_MS = 150;        // 150
 constexpr uint8_t HYDRAULIC_MSG_PERIOD_MS = 165;  // 165
+constexpr uint8_t HYDRAULIC_CHECKUP_MSG_PERIOD_MS = 20;  // 20, every dash loop, master EBS test
 constexpr uint8_t APPS_MSG_PERIOD_MS = 250;       // 250
 constexpr float WHEEL_PRECISION = 1e-2;           // 1e-2
 
@@ -27,6 +28,19 @@ constexpr uint16_t DATA_LOGGER_SIGNALS_2 = 0x512;  // 0x512
 constexpr uint16_t DATA_LOGGER_SIGNALS_3 = 0x513;  // 0x513
 constexpr uint16_t DATA_LOGGER_SIGNALS_4 = 0x514;  // 0x514
 constexpr uint16_t DATA_LOGGER_SIGNALS_5 = 0x515;  // 0x515
+constexpr uint16_t DEBUG_LOG_CONFIG_ID = 0x510;    // 0x510
+
+// DEBUG_LOG_CONFIG_ID: buf[0] boards it applies to, buf[1] runtime module mask (debugUtils.hpp)
+constexpr uint8_t DEBUG_LOG_BOARD_MASTER = 0x01;    // 0x01
+constexpr uint8_t DEBUG_LOG_BOARD_DASH = 0x02;      // 0x02
+constexpr uint8_t DEBUG_LOG_BOARD_CELLS = 0x04;     // 0x04
+constexpr uint8_t DEBUG_LOG_BOARD_HANDCART = 0x08;  // 0x08
+
+constexpr uint16_t DASH_CALIBRATION_ID = 0x516;  // 0x516
+// DASH_CALIBRATION_ID: buf[0] command, the dash answers with CALIBRATION_STATUS
+constexpr uint8_t CALIBRATION_START = 0x01;  // 0x01
+constexpr uint8_t CALIBRATION_SAVE = 0x02;   // 0x02
+constexpr uint8_t CALIBRATION_ABORT = 0x03;  // 0x03
 
 //-----------------------------------------------------------------------------
 
@@ -53,10 +67,12 @@ constexpr uint8_t EBS_REDUNDANCY_MSG = 0x37;      // 0x37
 //-----------------------------------------------------------------------------
 // Logging Status IDs
 //-----------------------------------------------------------------------------
-constexpr uint8_t DRIVING_STATE = 0x40;      // 0x40
-constexpr uint16_t DRIVING_CONTROL = 0x501;  // 0x501
-constexpr uint16_t SYSTEM_STATUS = 0x502;    // 0x502
-constexpr uint16_t SOC_MSG = 0x60;           // 0x60
+constexpr uint8_t DRIVING_STATE = 0x40;       // 0x40
+constexpr uint8_t TORQUE_STATUS = 0x41;       // 0x41
+constexpr uint8_t CALIBRATION_STATUS = 0x42;  // 0x42
+constexpr uint16_t DRIVING_CONTROL = 0x501;   // 0x501
+constexpr uint16_t SYSTEM_STATUS = 0x502;     // 0x502
+constexpr uint16_t SOC_MSG = 0x60;            // 0x60
 
 //-----------------------------------------------------------------------------
 // Steering System
@@ -210,6 +226,8 @@ constexpr uint16_t WIDGET_AUTONOMOUS_MISSION = 0x000E;
 constexpr uint16_t WIDGET_INVERTER_WARNINGS = 0x000D;
 constexpr uint16_t WIDGET_ALL_TEMPS = 0x0010;  // Base ID for all temperature widgets
 constexpr uint16_t WIDGET_HV_SOC = 0x0011;
+// Several widgets in one packet, TLV entries: widget ID, value count, values
+constexpr uint16_t WIDGET_FRAME = 0x0020;
 constexpr uint16_t WIDGET_BMS_DUMP_0 = 0xBB00;
 constexpr uint16_t WIDGET_BMS_DUMP_1 = 0xBB01;
 constexpr uint16_t WIDGET_BMS_DUMP_2 = 0xBB02;
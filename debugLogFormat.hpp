@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Wire format of the deferred debug log, written by the boards (deferredLog.hpp) to their
+ * serial port and read by the host decoder (tools/log_decoder)
+ * @details A record is a format string ID plus up to MAX_ARGS raw 32 bit arguments. The ID is the
+ * FNV-1a hash of the format string, computed at compile time on the board; the host hashes the
+ * LOG_* format strings it finds in the sources to get them back. Records share the port with
+ * plain text prints, so each frame starts with FRAME_MAGIC and ends with a checksum, and the
+ * decoder passes any byte that is not part of a valid frame through as text.
+ *
+ * Frame, little-endian: magic[2] | arg_count | arg_types | id u32 | timestamp_us u32 |
+ * args u32[arg_count] | checksum (sum of every byte after the magic, modulo 256)
+ */
+namespace dlog {
+
+constexpr uint8_t FRAME_MAGIC[2] = {0xA5, 0x1D};
+constexpr std::size_t MAX_ARGS = 4;
+constexpr std::size_t FRAME_HEADER_SIZE = 12;  // magic, count, types, id, timestamp
+constexpr std::size_t MAX_FRAME_SIZE = FRAME_HEADER_SIZE + 4 * MAX_ARGS + 1;
+
+/**
+ * @brief How an argument's 32 bits are to be read, 2 bits per argument in arg_types
+ */
+enum class ArgType : uint8_t {
+  U32 = 0,
+  I32 = 1,
+  F32 = 2,
+};
+
+constexpr uint32_t fnv1a(const char *text) {
+  uint32_t hash = 2166136261U;
+  for (; *text != '\0'; text++) {
+    hash ^= static_cast<uint8_t>(*text);
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+/**
+ * @brief Format of the record the boards send when their queue overflowed
+ */
+constexpr const char *DROPPED_FORMAT = "[debug log] %u records dropped";
+
+struct Record {
+  uint32_t id;
+  uint32_t timestamp_us;
+  uint8_t arg_count;
+  uint8_t arg_types;
+  uint32_t args[MAX_ARGS];
+
+  [[nodiscard]] constexpr ArgType type(const std::size_t arg) const {
+    return static_cast<ArgType>(arg_types >> (2 * arg) & 0x3U);
+  }
+};
+
+/**
+ * @brief Writes the frame of a record
+ * @return bytes written, at most MAX_FRAME_SIZE
+ */
+inline std::size_t encode_frame(const Record &record, uint8_t *out) {
+  std::size_t n = 0;
+  auto put32 = [&](uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+      out[n++] = static_cast<uint8_t>(value >> (8 * i));
+    }
+  };
+  out[n++] = FRAME_MAGIC[0];
+  out[n++] = FRAME_MAGIC[1];
+  out[n++] = record.arg_count;
+  out[n++] = record.arg_types;
+  put32(record.id);
+  put32(record.timestamp_us);
+  for (std::size_t i = 0; i < record.arg_count && i < MAX_ARGS; i++) {
+    put32(record.args[i]);
+  }
+  uint8_t checksum = 0;
+  for (std::size_t i = 2; i < n; i++) {
+    checksum = static_cast<uint8_t>(checksum + out[i]);
+  }
+  out[n++] = checksum;
+  return n;
+}
+
+/**
+ * @brief Reads the frame starting at data, if it is one
+ * @return bytes the frame takes, 0 if data does not hold a whole valid frame
+ */
+inline std::size_t decode_frame(const uint8_t *data, const std::size_t size, Record &record) {
+  if (size < FRAME_HEADER_SIZE + 1 || data[0] != FRAME_MAGIC[0] || data[1] != FRAME_MAGIC[1] ||
+      data[2] > MAX_ARGS) {
+    return 0;
+  }
+  const std::size_t length = FRAME_HEADER_SIZE + 4 * data[2] + 1;
+  if (size < length) {
+    return 0;
+  }
+  uint8_t checksum = 0;
+  for (std::size_t i = 2; i + 1 < length; i++) {
+    checksum = static_cast<uint8_t>(checksum + data[i]);
+  }
+  if (checksum != data[length - 1]) {
+    return 0;
+  }
+  auto get32 = [data](std::size_t at) {
+    return static_cast<uint32_t>(data[at]) | static_cast<uint32_t>(data[at + 1]) << 8 |
+           static_cast<uint32_t>(data[at + 2]) << 16 | static_cast<uint32_t>(data[at + 3]) << 24;
+  };
+  record.arg_count = data[2];
+  record.arg_types = data[3];
+  record.id = get32(4);
+  record.timestamp_us = get32(8);
+  for (std::size_t i = 0; i < record.arg_count; i++) {
+    record.args[i] = get32(FRAME_HEADER_SIZE + 4 * i);
+  }
+  return length;
+}
+
+}  // namespace dlog
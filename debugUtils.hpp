@@ -1,32 +1,109 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 
-#ifdef DEBUG
+/**
+ * @brief Debug logging shared by the boards, selected at build time by level and module
+ *
+ * Build flags:
+ *   DEBUG_LEVEL    LOG_LEVEL_OFF (default, every log call compiles to nothing) up to
+ *                  LOG_LEVEL_DEBUG; a call is kept if its level is at most DEBUG_LEVEL
+ *   DEBUG_MODULES  LOG_* module mask compiled in, all of them by default
+ *
+ * LOG_ERROR/WARN/INFO/DEBUG(module, "fmt", numbers...) are deferred records (deferredLog.hpp):
+ * cheap enough for the control loop and interrupts, formatted on the host by tools/log_decoder.
+ * DEBUG_PRINT/DEBUG_PRINTLN are plain Serial prints for setup and rare events, kept from
+ * LOG_LEVEL_INFO. Modules that were compiled in can also be muted at run time, per board, with a
+ * DEBUG_LOG_CONFIG_ID frame (see apply_log_config()).
+ */
+
+#define LOG_LEVEL_OFF 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef DEBUG_LEVEL
+#define DEBUG_LEVEL LOG_LEVEL_OFF
+#endif
+
+constexpr uint8_t LOG_CAN = 1U << 0;    // bus traffic and timeouts
+constexpr uint8_t LOG_STATE = 1U << 1;  // state machines and checkups
+constexpr uint8_t LOG_IO = 1U << 2;     // pins, pedals, pressures, buzzers
+constexpr uint8_t LOG_TEMP = 1U << 3;   // cell temperatures
+constexpr uint8_t LOG_SPI = 1U << 4;    // display link
+constexpr uint8_t LOG_ALL = LOG_CAN | LOG_STATE | LOG_IO | LOG_TEMP | LOG_SPI;
+
+#ifndef DEBUG_MODULES
+#define DEBUG_MODULES LOG_ALL
+#endif
+
+namespace debug_log {
+
+/**
+ * @brief Modules logged at run time, out of the ones compiled in
+ */
+inline std::atomic<uint8_t> runtime_mask{DEBUG_MODULES};
+
+constexpr bool compiled(const int level, const uint8_t module) {
+  return level <= DEBUG_LEVEL && (module & (DEBUG_MODULES)) != 0;
+}
+
+/**
+ * @brief Applies a DEBUG_LOG_CONFIG_ID frame if it is addressed to this board
+ * @details buf[0]: DEBUG_LOG_BOARD_* bits of the boards it applies to, buf[1]: module mask
+ */
+inline void apply_log_config(const uint8_t *buf, const uint8_t len, const uint8_t board) {
+  if (len >= 2 && (buf[0] & board) != 0) {
+    runtime_mask.store(buf[1], std::memory_order_relaxed);
+  }
+}
+
+}  // namespace debug_log
+
+#if DEBUG_LEVEL > LOG_LEVEL_OFF
+#include "deferredLog.hpp"
+
+/**
+ * @brief True if logs of this level and module are kept; constant false if they were not compiled
+ */
+#define LOG_ENABLED(level, module)       \
+  (debug_log::compiled(level, module) && \
+   (debug_log::runtime_mask.load(std::memory_order_relaxed) & (module)) != 0)
+
+#define LOG_AT(level, module, fmt, ...)                          \
+  do {                                                           \
+    if constexpr (debug_log::compiled(level, module)) {          \
+      if (LOG_ENABLED(level, module)) {                          \
+        dlog::write<dlog::fnv1a(fmt)>(__VA_ARGS__);              \
+      }                                                          \
+    }                                                            \
+  } while (0)
+#define DEBUG_LOG_FLUSH() dlog::drain(Serial)
+#else
+#define LOG_ENABLED(level, module) false
+#define LOG_AT(level, module, fmt, ...) \
+  do {                                  \
+  } while (0)
+#define DEBUG_LOG_FLUSH()
+#endif
+
+#define LOG_ERROR(module, fmt, ...) LOG_AT(LOG_LEVEL_ERROR, module, fmt, ##__VA_ARGS__)
+#define LOG_WARN(module, fmt, ...) LOG_AT(LOG_LEVEL_WARN, module, fmt, ##__VA_ARGS__)
+#define LOG_INFO(module, fmt, ...) LOG_AT(LOG_LEVEL_INFO, module, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(module, fmt, ...) LOG_AT(LOG_LEVEL_DEBUG, module, fmt, ##__VA_ARGS__)
+
+#if DEBUG_LEVEL >= LOG_LEVEL_INFO
 #include <Arduino.h>
-#define DBUG_PRINT(str)                                                       \
-  Serial.print(millis());                                                      \
-  Serial.print(": ");                                                          \
-  Serial.print(__PRETTY_FUNCTION__);                                           \
-  Serial.print(' ');                                                           \
-  Serial.print(__FILE__);                                                      \
-  Serial.print(':');                                                           \
-  Serial.print(__LINE__);                                                      \
-  Serial.print(' ');                                                           \
-  Serial.println(str);
-
-#define DBUG_PRINT_VAR(var)                                                   \
-  Serial.print(millis());                                                      \
-  Serial.print(": ");                                                          \
-  Serial.print(__PRETTY_FUNCTION__);                                           \
-  Serial.print(' ');                                                           \
-  Serial.print(__FILE__);                                                      \
-  Serial.print(':');                                                           \
-  Serial.print(__LINE__);                                                      \
-  Serial.print(' ');                                                           \
-  Serial.print(#var);                                                          \
-  
-  Serial.print(" = ");                                                         \
-  Serial.println(var);
+#define DEBUG_PRINT(x) Serial.print(x)
+#define DEBUG_PRINTLN(x) Serial.println(x)
+#define DEBUG_WRITE(x) Serial.write(x)
+#define DEBUG_PRINT_VAR(var) \
+  Serial.print(#var " = ");  \
+  Serial.println(var)
 #else
-#define DBUG_PRINT_VAR(var)
-#define DBUG_PRINT(str)
+#define DEBUG_PRINT(x)
+#define DEBUG_PRINTLN(x)
+#define DEBUG_WRITE(x)
+#define DEBUG_PRINT_VAR(var)
 #endif
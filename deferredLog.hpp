@@ -0,0 +1,146 @@
+#pragma once
+#include <Arduino.h>
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#include "debugLogFormat.hpp"
+
+// Deferred debug log shared by the boards (C++17). A log call stores the compile time ID of its
+// format string and its raw arguments in a lock-free queue, which costs about as much as a few
+// stores and never allocates, so it may be used from interrupts. The loop later sends the queued
+// records to the serial port without blocking (drain()), and tools/log_decoder formats them on
+// the host. Use it through the LOG_* macros of debugUtils.hpp.
+
+namespace dlog {
+
+/**
+ * @brief Bounded multi-producer single-consumer queue of records
+ *
+ * Producers (the loop and any interrupt) claim a slot with a compare and swap on the head and
+ * publish it through the slot's sequence number (Vyukov's bounded queue), so an interrupt never
+ * waits for the code it interrupted. Sequence numbers are kept relative to the slot index, which
+ * makes the all-zero state valid: a static queue is usable before any constructor runs.
+ */
+template <std::size_t Capacity>
+class RecordQueue {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity is a power of two");
+  static constexpr uint32_t MASK = Capacity - 1;
+
+public:
+  bool push(const Record &record) {
+    uint32_t position = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = slots_[position & MASK];
+      const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto lag = static_cast<int32_t>(sequence - (position - (position & MASK)));
+      if (lag == 0) {
+        if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          slot.record = record;
+          slot.sequence.store(sequence + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;  // full, the consumer has not freed this slot yet
+      } else {
+        position = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Takes the oldest record, only from the loop
+   */
+  bool pop(Record &record) {
+    Slot &slot = slots_[tail_ & MASK];
+    const uint32_t lap = tail_ - (tail_ & MASK);
+    if (slot.sequence.load(std::memory_order_acquire) != lap + 1) {
+      return false;
+    }
+    record = slot.record;
+    slot.sequence.store(lap + Capacity, std::memory_order_release);
+    tail_++;
+    return true;
+  }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> sequence;  ///< lap start: free, lap start + 1: holds a record
+    Record record;
+  };
+
+  std::array<Slot, Capacity> slots_;
+  std::atomic<uint32_t> head_;
+  uint32_t tail_;
+};
+
+constexpr std::size_t QUEUE_CAPACITY = 256;
+
+inline RecordQueue<QUEUE_CAPACITY> queue;
+inline std::atomic<uint32_t> dropped{0};
+
+template <typename T>
+constexpr ArgType arg_type() {
+  if constexpr (std::is_floating_point_v<T>) {
+    return ArgType::F32;
+  } else if constexpr (std::is_signed_v<T>) {
+    return ArgType::I32;
+  } else {
+    return ArgType::U32;
+  }
+}
+
+template <typename T>
+uint32_t arg_bits(const T value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    const auto narrow = static_cast<float>(value);
+    uint32_t bits = 0;
+    std::memcpy(&bits, &narrow, sizeof(bits));
+    return bits;
+  } else {
+    return static_cast<uint32_t>(value);
+  }
+}
+
+template <uint32_t Id, typename... Args>
+bool push(const Args... args) {
+  static_assert(sizeof...(Args) <= MAX_ARGS, "at most dlog::MAX_ARGS arguments");
+  static_assert((std::is_arithmetic_v<Args> && ...),
+                "only numbers can be logged, the text belongs in the format string");
+  Record record{Id, static_cast<uint32_t>(micros()), sizeof...(Args), 0, {}};
+  std::size_t i = 0;
+  ((record.arg_types |= static_cast<uint8_t>(static_cast<uint8_t>(arg_type<Args>()) << (2 * i)),
+    record.args[i++] = arg_bits(args)),
+   ...);
+  return queue.push(record);
+}
+
+/**
+ * @brief Queues a record of the format string with hash Id, counted as dropped if the queue is full
+ */
+template <uint32_t Id, typename... Args>
+void write(const Args... args) {
+  if (!push<Id>(args...)) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Sends queued records to out for as long as it can take a whole frame without blocking
+ */
+template <typename Out>
+void drain(Out &out) {
+  uint8_t frame[MAX_FRAME_SIZE];
+  const uint32_t lost = dropped.exchange(0, std::memory_order_relaxed);
+  if (lost != 0 && !push<fnv1a(DROPPED_FORMAT)>(lost)) {
+    dropped.fetch_add(lost, std::memory_order_relaxed);  // reported once there is room
+  }
+  Record record;
+  while (out.availableForWrite() >= static_cast<int>(MAX_FRAME_SIZE) && queue.pop(record)) {
+    out.write(frame, encode_frame(record, frame));
+  }
+}
+
+}  // namespace dlog
@@ -0,0 +1,168 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Time based input conditioning shared by the master, dash and handcart boards (C++17, the dash
+// and handcart build with the Teensy default). Every threshold is a time in micros(), never a
+// number of loop iterations, so making a loop faster or slower does not change how long a signal
+// has to be stable before it is accepted.
+
+/**
+ * @brief Debounces up to 32 digital channels at once and keeps the time of their last edge
+ *
+ * A channel's state follows its raw input once the input has shown the new value, without
+ * interruption, for the channel's stable time. Each channel has a down counter of the time it
+ * still has to hold; bit k of every counter lives in plane k, so an update is a few word
+ * operations per plane whatever the number of channels (vertical counters).
+ *
+ * @tparam NumChannels channels, bit i of samples and states is channel i
+ * @tparam CounterBits planes, stable times must be below 2^CounterBits us (about 2 s by default)
+ */
+template <std::size_t NumChannels, std::size_t CounterBits = 21>
+class InputConditioner {
+  static_assert(NumChannels > 0 && NumChannels <= 32, "channels are bits of a uint32_t");
+  static constexpr uint32_t CHANNEL_MASK =
+      NumChannels == 32 ? UINT32_MAX : (1U << NumChannels) - 1;
+
+public:
+  static constexpr uint32_t MAX_STABLE_US = (1U << CounterBits) - 1;
+
+  /**
+   * @param stable_us time each channel must hold a new value before it is accepted
+   * @param initial_states states before the first sample
+   */
+  constexpr explicit InputConditioner(const std::array<uint32_t, NumChannels>& stable_us,
+                                      uint32_t initial_states = 0)
+      : state_(initial_states & CHANNEL_MASK) {
+    for (std::size_t channel = 0; channel < NumChannels; channel++) {
+      for (std::size_t k = 0; k < CounterBits; k++) {
+        threshold_[k] |= (stable_us[channel] >> k & 1U) << channel;
+      }
+    }
+    counter_ = threshold_;
+  }
+
+  /**
+   * @brief Takes states as already debounced at now_us, e.g. from a first read of the pins once
+   * they are set up, so inputs at rest do not show an edge on the first updates
+   */
+  void reset(const uint32_t states, const uint32_t now_us) {
+    state_ = states & CHANNEL_MASK;
+    differed_ = 0;
+    changed_ = 0;
+    counter_ = threshold_;
+    last_edge_us_.fill(now_us);
+    last_us_ = now_us;
+  }
+
+  /**
+   * @brief Feeds one sample of every channel, taken at now_us
+   * @return the debounced states
+   */
+  uint32_t update(const uint32_t sample, const uint32_t now_us) {
+    // Longer gaps count as MAX_STABLE_US, every stable time is below it
+    const uint32_t elapsed_us =
+        now_us - last_us_ > MAX_STABLE_US ? MAX_STABLE_US : now_us - last_us_;
+    last_us_ = now_us;
+
+    const uint32_t differs = (sample ^ state_) & CHANNEL_MASK;
+    // Only time between two samples that both show the new value counts as stable
+    const uint32_t holding = differs & differed_;
+    differed_ = differs;
+
+    // counter -= elapsed_us on the holding channels, one full subtractor per plane
+    uint32_t borrow = 0;
+    uint32_t nonzero = 0;
+    for (std::size_t k = 0; k < CounterBits; k++) {
+      const uint32_t a = counter_[k];
+      const uint32_t b = (elapsed_us >> k & 1U) != 0 ? holding : 0;
+      counter_[k] = a ^ b ^ borrow;
+      borrow = (~a & (b | borrow)) | (b & borrow);
+      nonzero |= counter_[k];
+    }
+    const uint32_t changed = differs & (borrow | ~nonzero);
+    state_ ^= changed;
+    changed_ = changed;
+    differed_ &= ~changed;
+
+    const uint32_t reload = ~differs | changed;
+    for (std::size_t k = 0; k < CounterBits; k++) {
+      counter_[k] = (counter_[k] & ~reload) | (threshold_[k] & reload);
+    }
+    for (uint32_t edges = changed; edges != 0; edges &= edges - 1) {
+      last_edge_us_[__builtin_ctz(edges)] = now_us;
+    }
+    return state_;
+  }
+
+  [[nodiscard]] uint32_t states() const { return state_; }
+  [[nodiscard]] bool state(const std::size_t channel) const {
+    return (state_ >> channel & 1U) != 0;
+  }
+
+  /**
+   * @brief Whether the channel went low to high (rose) or high to low (fell) on the last update
+   */
+  [[nodiscard]] bool rose(const std::size_t channel) const {
+    return ((changed_ & state_) >> channel & 1U) != 0;
+  }
+  [[nodiscard]] bool fell(const std::size_t channel) const {
+    return ((changed_ & ~state_) >> channel & 1U) != 0;
+  }
+
+  /**
+   * @brief Time since the channel's debounced state last changed (since construction if never)
+   */
+  [[nodiscard]] uint32_t time_since_edge_us(const std::size_t channel,
+                                            const uint32_t now_us) const {
+    return now_us - last_edge_us_[channel];
+  }
+
+private:
+  std::array<uint32_t, CounterBits> threshold_{};
+  std::array<uint32_t, CounterBits> counter_{};
+  std::array<uint32_t, NumChannels> last_edge_us_{};
+  uint32_t state_ = 0;
+  uint32_t differed_ = 0;  ///< Channels that differed from their state on the previous sample
+  uint32_t changed_ = 0;   ///< Channels that changed on the last update
+  uint32_t last_us_ = 0;
+};
+
+/**
+ * @brief A multi-valued input (e.g. a selector read from an ADC) accepted once it has read the
+ * same value for stable_us
+ */
+template <typename T>
+class DebouncedValue {
+public:
+  constexpr DebouncedValue(const uint32_t stable_us, const T initial)
+      : stable_us_(stable_us), value_(initial), candidate_(initial) {}
+
+  /**
+   * @return the accepted value
+   */
+  T update(const T sample, const uint32_t now_us) {
+    if (sample != candidate_) {
+      candidate_ = sample;
+      candidate_since_us_ = now_us;
+    }
+    if (candidate_ != value_ && now_us - candidate_since_us_ >= stable_us_) {
+      value_ = candidate_;
+      last_edge_us_ = now_us;
+    }
+    return value_;
+  }
+
+  [[nodiscard]] T value() const { return value_; }
+  [[nodiscard]] uint32_t time_since_edge_us(const uint32_t now_us) const {
+    return now_us - last_edge_us_;
+  }
+
+private:
+  uint32_t stable_us_;
+  T value_;
+  T candidate_;
+  uint32_t candidate_since_us_ = 0;
+  uint32_t last_edge_us_ = 0;
+};
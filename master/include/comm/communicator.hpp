@@ -6,9 +6,11 @@
 #include <string>
 
 #include "../../CAN_IDs.h"
+#include "../../debugUtils.hpp"
 #include "../utils.hpp"
 #include "comm/utils.hpp"
-#include "debugUtils.hpp"
+#include "embedded/emergencyIrq.hpp"
+#include "embedded/sdLogger.hpp"
 #include "enum_utils.hpp"
 #include "model/systemData.hpp"
 #include "utils.hpp"
@@ -17,14 +19,15 @@
  * @brief Array of standard CAN message codes to be used for FIFO filtering
  * Each Code struct contains a key and a corresponding message ID.
  */
-inline std::array<Code, 8> fifoCodes = {{{0, DASH_ID},
+inline std::array<Code, 9> fifoCodes = {{{0, DASH_ID},
                                          {1, BAMO_RESPONSE_ID},
                                          {2, AS_CU_EMERGENCY_SIGNAL},
                                          {3, MISSION_FINISHED},
                                          {4, AS_CU_ID},
                                          {5, RES_STATE},
                                          {6, RES_READY},
-                                         {7, BMS_ID}}};
+                                         {7, BMS_ID},
+                                         {9, DEBUG_LOG_CONFIG_ID}}};
 
 /**
  * @brief Array of extended CAN message codes to be used for FIFO filtering
@@ -141,6 +144,22 @@ public:
    * @brief Publish rl wheel rpm to CAN
    */
   static int publish_rpm();
+
+  /**
+   * @brief Publish the heartbeat statistics of one component
+   */
+  static int publish_heartbeat_stats(Component component);
+
+  /**
+   * @brief Publish the status and timing of one check of the initial checkup
+   */
+  static int publish_checkup_report(uint8_t check, CheckStatus status, uint16_t started_ms,
+                                    uint16_t finished_ms);
+
+  /**
+   * @brief Publish the response of one hydraulic line during an EBS check phase
+   */
+  static int publish_ebs_curve(uint8_t phase, uint8_t line, const StepFit &fit);
 };
 
 inline Communicator::Communicator(SystemData *system_data) { _systemData = system_data; }
@@ -167,25 +186,26 @@ inline void Communicator::res_state_callback(const uint8_t *buf) {
   bool emg_stop2 = buf[3] >> 7 & 0x01;
   bool go_switch = (buf[0] >> 1) & 0x01;
   bool go_button = (buf[0] >> 2) & 0x01;
-  // DEBUG_PRINT("RES GO: " + String(go_switch) + "   EMG 1: " + String(emg_stop1) + "   EMG 2: " +
-  // String(emg_stop2));
+  // DEBUG_PRINTLN("RES GO: " + String(go_switch) + "   EMG 1: " + String(emg_stop1) +
+  // "   EMG 2: " + String(emg_stop2));
 
   if (go_button || go_switch)
     _systemData->r2d_logics_.process_go_signal();
   else if (!(emg_stop1 || emg_stop2)) {  // If both are false
-    // DEBUG_PRINT("Received Emergency from RES");
+    // DEBUG_PRINTLN("Received Emergency from RES");
     _systemData->failure_detection_.emergency_signal_ = true;
+    EmergencyIrq::raise(EmergencySource::RES);
   }
 
   _systemData->failure_detection_.radio_quality_ = buf[6];
   bool signal_loss = (buf[7] >> 6) & 0x01;
   if (!signal_loss) {
-    _systemData->updatable_timestamps_.res_signal_loss_timestamp_
-        .reset();  // making sure we dont receive only signal loss for the defined time interval
-                   // DEBUG_PRINT("SIGNAL OKAY");
+    // making sure we dont receive only signal loss for the defined time interval
+    _systemData->component_timeouts_.kick(Component::RES);
+    // DEBUG_PRINTLN("SIGNAL OKAY");
   } else {
     // Too many will violate the disconnection time limit
-    // DEBUG_PRINT("SIGNAL LOSS");
+    // DEBUG_PRINTLN("SIGNAL LOSS");
   }
 }
 
@@ -197,7 +217,7 @@ inline void Communicator::res_ready_callback() {
 }
 
 inline void Communicator::bamocar_callback(const uint8_t *buf) {
-  _systemData->updatable_timestamps_.inversor_alive_timestamp_.reset();
+  _systemData->component_timeouts_.kick(Component::INVERTER);
 
   if (buf[0] == BTB_READY) {
     if (buf[1] == false) {
@@ -211,15 +231,15 @@ inline void Communicator::bamocar_callback(const uint8_t *buf) {
     if (dc_voltage < DC_THRESHOLD) {
       // When voltage drops/is below threshold:
       // Reset hold timer and check if voltage has been below threshold long enough
-      _systemData->updatable_timestamps_.dc_voltage_hold_timestamp_.reset();
-      if (_systemData->updatable_timestamps_.dc_voltage_drop_timestamp_.checkWithoutReset()) {
+      _systemData->dc_voltage_timeouts_.kick(DcVoltageTimer::HOLD);
+      if (_systemData->dc_voltage_timeouts_.expired(DcVoltageTimer::DROP)) {
         _systemData->failure_detection_.ts_on_ = false;
       }
     } else {
       // When voltage is above threshold:
       // Reset drop timer and check if voltage has been above threshold long enough
-      _systemData->updatable_timestamps_.dc_voltage_drop_timestamp_.reset();
-      if (_systemData->updatable_timestamps_.dc_voltage_hold_timestamp_.checkWithoutReset()) {
+      _systemData->dc_voltage_timeouts_.kick(DcVoltageTimer::DROP);
+      if (_systemData->dc_voltage_timeouts_.expired(DcVoltageTimer::HOLD)) {
         _systemData->failure_detection_.ts_on_ = true;
       }
     }
@@ -227,31 +247,34 @@ inline void Communicator::bamocar_callback(const uint8_t *buf) {
 }
 
 inline void Communicator::pc_callback(const uint8_t *buf) {
-  // DEBUG_PRINT("PC alive signal received");
+  // DEBUG_PRINTLN("PC alive signal received");
   if (buf[0] == PC_ALIVE) {
-    _systemData->updatable_timestamps_.pc_alive_timestamp_.reset();
+    _systemData->component_timeouts_.kick(Component::PC);
   } else if (buf[0] == MISSION_FINISHED) {
     _systemData->mission_finished_ = true;
   } else if (buf[0] == AS_CU_EMERGENCY_SIGNAL) {
-    DEBUG_PRINT("Received Emergency from AS CU");
+    LOG_WARN(LOG_CAN, "Received Emergency from AS CU");
     _systemData->failure_detection_.emergency_signal_ = true;
+    EmergencyIrq::raise(EmergencySource::AS_CU);
   }
 }
 
 inline void Communicator::steering_callback() {
-  _systemData->updatable_timestamps_.steer_alive_timestamp_.reset();
+  _systemData->component_timeouts_.kick(Component::STEERING);
 }
 
 inline void Communicator::dash_callback(const uint8_t *buf) {
   if (buf[0] == HYDRAULIC_LINE) {
     _systemData->hardware_data_.hydraulic_line_front_pressure = (buf[2] << 8) | buf[1];
+    _systemData->hardware_data_.hydraulic_line_front_received_us = micros();
   }
 }
 inline void Communicator::bms_callback(const uint8_t *buf) {
-  _systemData->updatable_timestamps_.bms_alive_timestamp_.reset();
+  _systemData->component_timeouts_.kick(Component::BMS);
 }
 
 inline void Communicator::parse_message(const CAN_message_t &msg) {
+  SdLogger::record_can_frame(msg);
   switch (msg.id) {
     case AS_CU_ID:
       pc_callback(msg.buf);
@@ -272,6 +295,9 @@ inline void Communicator::parse_message(const CAN_message_t &msg) {
     case BMS_ID:
       bms_callback(msg.buf);
       break;
+    case DEBUG_LOG_CONFIG_ID:
+      debug_log::apply_log_config(msg.buf, msg.len, DEBUG_LOG_BOARD_MASTER);
+      break;
     default:
       break;
   }
@@ -298,6 +324,29 @@ inline int Communicator::publish_debug_morning_log(const SystemData &system_data
   return 0;
 }
 
+inline int Communicator::publish_heartbeat_stats(const Component component) {
+  // The CAN interrupt updates the stats on every kick
+  noInterrupts();
+  const HeartbeatStats stats = _systemData->component_timeouts_.stats(component);
+  interrupts();
+  send_message(8, create_heartbeat_stats_msg(component, stats), DATA_LOGGER_SIGNALS_3);
+  return 0;
+}
+
+inline int Communicator::publish_checkup_report(const uint8_t check, const CheckStatus status,
+                                                 const uint16_t started_ms,
+                                                 const uint16_t finished_ms) {
+  send_message(6, create_checkup_report_msg(check, status, started_ms, finished_ms),
+               DATA_LOGGER_SIGNALS_4);
+  return 0;
+}
+
+inline int Communicator::publish_ebs_curve(const uint8_t phase, const uint8_t line,
+                                           const StepFit &fit) {
+  send_message(8, create_ebs_curve_msg(phase, line, fit), DATA_LOGGER_SIGNALS_5);
+  return 0;
+}
+
 inline int Communicator::publish_soc(uint8_t soc) {
   const std::array<uint8_t, 2> msg = {SOC_MSG, soc};
   send_message(2, msg, MASTER_ID);
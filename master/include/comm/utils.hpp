@@ -3,6 +3,8 @@
 
 #include "../../CAN_IDs.h"
 #include "enum_utils.hpp"
+#include "logic/checkupGraph.hpp"
+#include "model/pressureCurve.hpp"
 #include "model/systemData.hpp"
 
 /**
@@ -91,4 +93,66 @@ inline std::array<uint8_t, 8> create_hydraulic_presures_msg(const SystemData& sy
   data[7] = rear_converter.bytes[3];
 
   return data;
-}
\ No newline at end of file
+}
+/**
+ * @brief Heartbeat statistics of one component (DATA_LOGGER_SIGNALS_3)
+ *
+ * byte 0 component, byte 1 near misses (saturating), then min, mean, p99 and max interval as
+ * 12 bit little endian fields in 0.25 ms (saturating at 1023.75 ms).
+ */
+inline std::array<uint8_t, 8> create_heartbeat_stats_msg(const Component component,
+                                                         const HeartbeatStats& stats) {
+  auto quarter_ms = [](uint32_t interval_us) -> uint64_t {
+    return std::min<uint32_t>(interval_us / 250, 0xFFF);
+  };
+  const uint64_t intervals = quarter_ms(stats.min_interval_us()) |
+                             quarter_ms(stats.mean_interval_us()) << 12 |
+                             quarter_ms(stats.p99_interval_us()) << 24 |
+                             quarter_ms(stats.max_interval_us()) << 36;
+  std::array<uint8_t, 8> msg{};
+  msg[0] = to_underlying(component);
+  msg[1] = static_cast<uint8_t>(std::min<uint32_t>(stats.near_misses(), UINT8_MAX));
+  for (std::size_t i = 0; i < 6; i++) {
+    msg[i + 2] = static_cast<uint8_t>(intervals >> (8 * i));
+  }
+  return msg;
+}
+
+/**
+ * @brief Timing of one check of the initial checkup (DATA_LOGGER_SIGNALS_4)
+ *
+ * byte 0 check, byte 1 status, then the time the check started and the time it passed (or last
+ * failed) as 16 bit little endian ms after ASMS on (0xFFFF = not yet).
+ */
+inline std::array<uint8_t, 6> create_checkup_report_msg(const uint8_t check,
+                                                       const CheckStatus status,
+                                                       const uint16_t started_ms,
+                                                       const uint16_t finished_ms) {
+  return {check,
+          to_underlying(status),
+          static_cast<uint8_t>(started_ms & 0xFF),
+          static_cast<uint8_t>(started_ms >> 8),
+          static_cast<uint8_t>(finished_ms & 0xFF),
+          static_cast<uint8_t>(finished_ms >> 8)};
+}
+
+/**
+ * @brief Response of one hydraulic line during an EBS check phase (DATA_LOGGER_SIGNALS_5)
+ *
+ * byte 0 phase (low nibble) and line (bit 7), then the start and final level as 10 bit ADC
+ * counts and the 10-90 %, 63 % and settle times as 12 bit ms (saturating), little endian.
+ */
+inline std::array<uint8_t, 8> create_ebs_curve_msg(const uint8_t phase, const uint8_t line,
+                                                   const StepFit& fit) {
+  auto adc = [](int16_t value) -> uint64_t { return std::clamp<int16_t>(value, 0, 0x3FF); };
+  auto ms = [](uint16_t value) -> uint64_t { return std::min<uint16_t>(value, 0xFFF); };
+  const uint64_t fields = adc(fit.start_adc) | adc(fit.final_adc) << 10 |
+                          ms(fit.t10_90_ms) << 20 | ms(fit.tau_ms) << 32 |
+                          ms(fit.settle_ms) << 44;
+  std::array<uint8_t, 8> msg{};
+  msg[0] = static_cast<uint8_t>((phase & 0x0F) | (line & 0x01) << 7);
+  for (std::size_t i = 0; i < 7; i++) {
+    msg[i + 1] = static_cast<uint8_t>(fields >> (8 * i));
+  }
+  return msg;
+}
@@ -1,14 +1,14 @@
 // ReSharper disable CppMemberFunctionMayBeConst
 #pragma once
 
-#include <Bounce2.h>
-
 #include <model/hardwareData.hpp>
 #include <model/structure.hpp>
 
-#include "debugUtils.hpp"
+#include "../../debugUtils.hpp"
+#include "../../inputConditioning.hpp"
 #include "hardwareSettings.hpp"
 #include "metro.h"
+#include "pinMap.hpp"
 #include "utils.hpp"
 
 struct SimulateTSMSActivate {
@@ -98,24 +98,27 @@ public:
   }
 
 private:
+  /**
+   * @brief Debounced channels, bit order of the debouncer samples
+   */
+  enum class Debounced : uint8_t { TSMS_SDC, PNEUMATIC, ASMS, ASATS, ATS, WD_READY };
+  static constexpr std::array<uint32_t, 6> STABLE_US = {
+      TSMS_SDC_STABLE_US, INPUT_STABLE_US, ASMS_STABLE_US,
+      INPUT_STABLE_US,    INPUT_STABLE_US, INPUT_STABLE_US};
+
   SystemData* system_data_;  ///< Pointer to the system updatable data storage
+  InputSnapshot inputs_;     ///< Digital inputs, sampled once per digital_reads()
+  InputConditioner<STABLE_US.size()> conditioner_{
+      STABLE_US, 1U << to_underlying(Debounced::PNEUMATIC)};  ///< Pneumatic starts pressurised
+  DebouncedValue<Mission> mission_{MISSION_STABLE_US, Mission::MANUAL};
 
-  std::deque<int> brake_readings;                 ///< Buffer for brake sensor readings
-  unsigned int asms_change_counter_ = 0;          ///< counter to avoid noise on asms
-  unsigned int aats_change_counter_ = 0;          ///< counter to avoid noise on aats
-  unsigned int sdc_change_counter_ = 0;           ///< counter to avoid noise on sdc
-  unsigned int pneumatic_change_counter_ = 0;     ///< counter to avoid noise on pneumatic line
-  unsigned int mission_change_counter_ = 0;       ///< counter to avoid noise on mission change
-  unsigned int sdc_tsms_change_counter_ = 0;      ///< counter to avoid noise on sdc bspd
-  unsigned int ats_change_counter_ = 0;           ///< counter to avoid noise on ats
-  unsigned int wd_ready_change_counter_ = 0;      ///< counter to avoid noise on wd ready
-  Mission last_tried_mission_ = Mission::MANUAL;  ///< Last attempted mission state
+  std::deque<int> brake_readings;  ///< Buffer for brake sensor readings
 
   /**
-   * @brief Reads the pneumatic line pressure states and updates the HardwareData object.
-   * Debounces input changes to avoid spurious transitions.
+   * @brief Debounces every digital input in one pass and updates the HardwareData object:
+   * TSMS SDC, pneumatic line (both sensors), ASMS, ASATS, ATS and watchdog ready.
    */
-  void read_pneumatic_line();
+  void read_debounced_inputs();
 
   /**
    * @brief Reads the current mission state based on input pins and updates the mission object.
@@ -123,29 +126,12 @@ private:
    */
   void read_mission();
 
-  /**
-   * @brief Reads the ASMS switch state and updates the HardwareData object.
-   * Debounces input changes to avoid spurious transitions.
-   */
-  void read_asms_switch();
-  /**
-   * @brief Reads the AATS state and updates the HardwareData object.
-   * Debounces input changes to avoid spurious transitions.
-   */
-  void read_asats_state();
-
   /**
    * @brief Reads the wheel speed sensors and updates the HardwareData object.
    * Debounces input changes to avoid spurious transitions.
    */
   void read_wheel_speed_sensors();
 
-  /**
-   * @brief Reads the bspd pin and updates the HardwareData object.
-   * Debounces input changes to avoid spurious transitions.
-   */
-  void read_tsms_sdc();
-
   /**
    * @brief Reads the brake sensor and updates the HardwareData object.
    * Debounces input changes to avoid spurious transitions.
@@ -157,17 +143,6 @@ private:
    */
   void read_soc();
 
-  /**
-   * @brief Reads the ats and updates the HardwareData object.
-   * Debounces input changes to avoid spurious transitions.
-   */
-  void read_ats();
-
-  /**
-   * @brief Reads the watchdog ready pin and updates the HardwareData object.
-   */
-  void read_watchdog_ready();
-
   /**
    * @brief Reads the rpm of the wheels and updates the HardwareData object.
    */
@@ -175,15 +150,11 @@ private:
 };
 
 inline void DigitalReceiver::digital_reads() {
-  read_pneumatic_line();
+  inputs_.sample();
+  read_debounced_inputs();
   read_mission();
-  read_asms_switch();
-  read_asats_state();
   read_soc();
   read_brake_sensor();
-  read_ats();
-  read_tsms_sdc();
-  read_watchdog_ready();
   read_rpm();
 }
 
@@ -194,34 +165,39 @@ inline void DigitalReceiver::read_soc() {
   system_data_->hardware_data_.soc_ = static_cast<uint8_t>(mapped_value);
 }
 
-inline void DigitalReceiver::read_tsms_sdc() {
-  bool is_sdc_closed = digitalRead(SDC_TSMS_STATE_PIN);  // low when sdc/bspd open
-  // is_sdc_closed = this->sim.activate_shit(is_sdc_closed);
-  debounce(is_sdc_closed, system_data_->hardware_data_.tsms_sdc_closed_,
-           this->sdc_tsms_change_counter_, 1000);
-  // DEBUG_PRINT_VAR(is_sdc_closed);
-  // DEBUG_PRINT_VAR(system_data_->hardware_data_.tsms_sdc_closed_);
-}
 inline void DigitalReceiver::read_brake_sensor() {
   int hydraulic_pressure = analogRead(BRAKE_SENSOR);
+  system_data_->hardware_data_.hydraulic_line_raw_pressure = hydraulic_pressure;
   insert_value_queue(hydraulic_pressure, brake_readings, 10);
   system_data_->hardware_data_._hydraulic_line_pressure = average_queue(brake_readings);
 }
-inline void DigitalReceiver::read_pneumatic_line() {
-  bool pneumatic1 = digitalRead(EBS_SENSOR2);
-  bool pneumatic2 = digitalRead(EBS_SENSOR1);
 
+inline void DigitalReceiver::read_debounced_inputs() {
+  const bool pneumatic1 = inputs_[DigitalInput::EBS_SENSOR_2];
+  const bool pneumatic2 = inputs_[DigitalInput::EBS_SENSOR_1];
   system_data_->hardware_data_.pneumatic_line_pressure_1_ = pneumatic1;
   system_data_->hardware_data_.pneumatic_line_pressure_2_ = pneumatic2;
-  bool latest_pneumatic_pressure = pneumatic1 && pneumatic2;
-  // print values
-  //  DEBUG_PRINT_VAR(latest_pneumatic_pressure);
-  //  DEBUG_PRINT_VAR(system_data_->hardware_data_.pneumatic_line_pressure_);
-  //  DEBUG_PRINT_VAR(pneumatic1);
-  //  DEBUG_PRINT_VAR(pneumatic2);
 
-  debounce(latest_pneumatic_pressure, system_data_->hardware_data_.pneumatic_line_pressure_,
-           pneumatic_change_counter_);
+  auto bit = [](Debounced channel, bool value) -> uint32_t {
+    return static_cast<uint32_t>(value) << to_underlying(channel);
+  };
+  const uint32_t sample =
+      bit(Debounced::TSMS_SDC, inputs_[DigitalInput::SDC_TSMS]) |  // low when sdc/bspd open
+      bit(Debounced::PNEUMATIC, pneumatic1 && pneumatic2) |
+      bit(Debounced::ASMS, inputs_[DigitalInput::ASMS]) |
+      bit(Debounced::ASATS, !inputs_[DigitalInput::ASATS]) |  // active low
+      bit(Debounced::ATS, inputs_[DigitalInput::ATS]) |
+      bit(Debounced::WD_READY, inputs_[DigitalInput::WD_READY]);
+  conditioner_.update(sample, micros());
+
+  auto& hardware_data = system_data_->hardware_data_;
+  hardware_data.tsms_sdc_closed_ = conditioner_.state(to_underlying(Debounced::TSMS_SDC));
+  hardware_data.pneumatic_line_pressure_ = conditioner_.state(to_underlying(Debounced::PNEUMATIC));
+  hardware_data.asms_on_ = conditioner_.state(to_underlying(Debounced::ASMS));
+  hardware_data.asats_pressed_ =
+      conditioner_.state(to_underlying(Debounced::ASATS)) && hardware_data.asms_on_;
+  hardware_data.ats_pressed_ = conditioner_.state(to_underlying(Debounced::ATS));
+  hardware_data.wd_ready_ = conditioner_.state(to_underlying(Debounced::WD_READY));
 }
 
 inline void DigitalReceiver::read_mission() {
@@ -246,38 +222,7 @@ inline void DigitalReceiver::read_mission() {
     mapped_value = 6;  // Inspection
   }
 
-  Mission latest_mission = static_cast<Mission>(mapped_value);
-  if ((latest_mission == system_data_->mission_) && (latest_mission == last_tried_mission_)) {
-    mission_change_counter_ = 0;
-  } else {
-    mission_change_counter_++;
-  }
-  this->last_tried_mission_ = latest_mission;
-  if (mission_change_counter_ >= CHANGE_COUNTER_LIMIT) {
-    system_data_->mission_ = latest_mission;
-    mission_change_counter_ = 0;
-  }
-}
-
-inline void DigitalReceiver::read_asms_switch() {
-  bool latest_asms_status = digitalRead(ASMS_IN_PIN);
-  debounce(latest_asms_status, system_data_->hardware_data_.asms_on_, asms_change_counter_, 1000);
-}
-
-inline void DigitalReceiver::read_asats_state() {
-  bool asats_pressed = !digitalRead(ASATS) && system_data_->hardware_data_.asms_on_;
-  debounce(asats_pressed, system_data_->hardware_data_.asats_pressed_, aats_change_counter_);
-}
-
-inline void DigitalReceiver::read_ats() {
-  bool ats_pressed = digitalRead(ATS);
-  // DEBUG_PRINT_VAR(ats_pressed);
-  debounce(ats_pressed, system_data_->hardware_data_.ats_pressed_, ats_change_counter_);
-}
-
-inline void DigitalReceiver::read_watchdog_ready() {
-  bool wd_ready = digitalRead(WD_READY);
-  debounce(wd_ready, system_data_->hardware_data_.wd_ready_, wd_ready_change_counter_);
+  system_data_->mission_ = mission_.update(static_cast<Mission>(mapped_value), micros());
 }
 
 inline void DigitalReceiver::read_rpm() {
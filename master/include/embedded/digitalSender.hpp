@@ -165,7 +165,7 @@ inline void DigitalSender::toggle_watchdog() {
   static volatile bool wd_state = false;
   wd_state = !wd_state;
   digitalWrite(WD_ALIVE, wd_state);
-  // DEBUG_PRINT("Toggling watchdog: " + String(wd_state ? "ON" : "OFF"));
+  // DEBUG_PRINTLN("Toggling watchdog: " + String(wd_state ? "ON" : "OFF"));
 }
 
 inline void DigitalSender::close_watchdog_sdc() { digitalWrite(WD_SDC_CLOSE, HIGH); }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief What raised an emergency event, one bit each
+ */
+enum class EmergencySource : uint8_t {
+  RES = 0x01,                ///< RES emergency stop frame
+  AS_CU = 0x02,              ///< AS CU emergency frame
+  COMPONENT_TIMEOUT = 0x04,  ///< An alive signal missed its deadline
+};
+
+/**
+ * @brief Fast path for emergency events
+ *
+ * raise() can be called from any interrupt (CAN receive, timers): it latches the source and pends
+ * the software interrupt, which runs above the FlexCAN and TeensyTimerTool interrupts (priority
+ * 128), so the handler opens the SDC before the caller's ISR even returns.
+ */
+class EmergencyIrq {
+public:
+  static constexpr uint8_t NVIC_PRIORITY = 16;  ///< Lower is more urgent
+
+  /**
+   * @brief Installs the handler on the software interrupt and enables it
+   */
+  static void begin(void (*handler)()) {
+    handler_ = handler;
+    attachInterruptVector(IRQ_SOFTWARE, isr);
+    NVIC_SET_PRIORITY(IRQ_SOFTWARE, NVIC_PRIORITY);
+    NVIC_ENABLE_IRQ(IRQ_SOFTWARE);
+  }
+
+  static void raise(EmergencySource source) {
+    if (pending_.fetch_or(static_cast<uint8_t>(source)) == 0) {
+      raised_at_us_ = micros();
+    }
+    NVIC_SET_PENDING(IRQ_SOFTWARE);
+  }
+
+  /**
+   * @brief Sources raised since the last call, clearing them
+   */
+  static uint8_t take_pending() { return pending_.exchange(0); }
+
+  /**
+   * @brief micros() of the first raise() since the last take_pending()
+   */
+  static uint32_t raised_at_us() { return raised_at_us_; }
+
+private:
+  inline static std::atomic<uint8_t> pending_{0};
+  inline static volatile uint32_t raised_at_us_ = 0;
+  inline static void (*handler_)() = nullptr;
+
+  static void isr() {
+    if (handler_ != nullptr) {
+      handler_();
+    }
+  }
+};
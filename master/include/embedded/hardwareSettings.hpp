@@ -8,6 +8,7 @@ constexpr int EBS_BUZZER_TIMEOUT = 8000;
 constexpr int LED_BLINK_INTERVAL = 500;
 constexpr int PROCESS_INTERVAL = 200;
 constexpr int SLOWER_PROCESS_INTERVAL = 30;
+constexpr int HEARTBEAT_STATS_INTERVAL = 100;  // one component per frame
 constexpr int INITIAL_CHECKUP_STEP_TIMEOUT = 500;
 constexpr unsigned long READY_TIMEOUT_MS = 5000;
 constexpr unsigned long RELEASE_EBS_TIMEOUT_MS = 1000;
@@ -16,6 +17,8 @@ constexpr int WD_TIMEOUT_MS = 500;
 constexpr int BRAKE_PRESSURE_LOWER_THRESHOLD = 170;
 constexpr int BRAKE_PRESSURE_UPPER_THRESHOLD = 510;
 constexpr int LIMIT_RPM_INTERVAL = 500000;
+constexpr int SD_LOG_SAMPLE_PERIOD_US = 1000;  // 1 kHz snapshot of the system data
+constexpr int SD_LOG_FLUSH_INTERVAL = 1000;    // commit file size to the FAT every second
 
 constexpr int ADC_MAX_VALUE = 1023;
 constexpr int SOC_PERCENT_MAX = 100;
@@ -24,12 +27,20 @@ constexpr int PULSES_PER_ROTATION = 48;
 constexpr int SECONDS_IN_MINUTE = 60;
 constexpr float MICRO_TO_SECONDS = 1e-6f;
 
-// Number of consecutive different values of a digital input to consider change
-// (to avoid noise)
-constexpr int CHANGE_COUNTER_LIMIT = 5;
+// Time an input must hold a new value before it is accepted (to avoid noise)
+constexpr uint32_t INPUT_STABLE_US = 50'000;
+constexpr uint32_t ASMS_STABLE_US = 1'000'000;
+constexpr uint32_t TSMS_SDC_STABLE_US = 1'000'000;
+constexpr uint32_t MISSION_STABLE_US = 5'000;
 constexpr int WD_PULSE_INTERVAL_MS = 50;
 constexpr int WATCHDOG_TOGGLE_DURATION = 1000;
 constexpr int WATCHDOG_TEST_DURATION = 1000;
+constexpr bool WATCHDOG_CHECKUP_ENABLED = false;  // the checkup passes the watchdog check as is
+
+// EBS actuator test: a hydraulic line is settled once it stays within the band for the window,
+// which spans two front line frames from the dash (HYDRAULIC_CHECKUP_MSG_PERIOD_MS)
+constexpr int EBS_SETTLE_BAND_ADC = 6;  // about 1.2 bar
+constexpr uint32_t EBS_SETTLE_WINDOW_US = 40'000;
 
 constexpr float MAX_V_ANALOG = 3.3;     // Volts
 constexpr float MIN_HYDRAULIC_V = 0.5;  // Volts
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "embedded/hardwareSettings.hpp"
+#include "enum_utils.hpp"
+
+/**
+ * @brief Location of a Teensy 4.1 pin on the fast GPIO ports (GPIO6..GPIO9), as in core_pins.h
+ */
+struct GpioPin {
+  uint8_t port;
+  uint8_t bit;
+};
+
+namespace teensy41 {
+
+constexpr uint8_t FIRST_FAST_PORT = 6;
+constexpr std::size_t NUM_FAST_PORTS = 4;
+
+/// Indexed by pin number
+constexpr std::array<GpioPin, 42> PIN_MAP{{
+    {6, 3},  {6, 2},  {9, 4},  {9, 5},  {9, 6},  {9, 8},  {7, 10}, {7, 17}, {7, 16}, {7, 11},
+    {7, 0},  {7, 2},  {7, 1},  {7, 3},  {6, 18}, {6, 19}, {6, 23}, {6, 22}, {6, 17}, {6, 16},
+    {6, 26}, {6, 27}, {6, 24}, {6, 25}, {6, 12}, {6, 13}, {6, 30}, {6, 31}, {8, 18}, {9, 31},
+    {8, 23}, {8, 22}, {7, 12}, {9, 7},  {7, 29}, {7, 28}, {7, 18}, {7, 19}, {6, 28}, {6, 29},
+    {6, 20}, {6, 21},
+}};
+
+}  // namespace teensy41
+
+/**
+ * @brief Digital inputs of the master, in the order of DIGITAL_INPUT_PINS
+ */
+enum class DigitalInput : uint8_t {
+  ASMS,
+  ASATS,
+  ATS,
+  SDC_TSMS,
+  EBS_SENSOR_1,
+  EBS_SENSOR_2,
+  WD_READY,
+  WD_SDC_RELAY,
+};
+
+constexpr std::array<uint8_t, 8> DIGITAL_INPUT_PINS = {
+    ASMS_IN_PIN, ASATS, ATS, SDC_TSMS_STATE_PIN, EBS_SENSOR1, EBS_SENSOR2, WD_READY, WD_SDC_RELAY};
+
+/**
+ * @brief All digital inputs sampled with one pad status register read per GPIO port
+ *
+ * Inputs sharing a port are read in the same instruction; the (at most four) port reads happen
+ * back to back with interrupts masked, so the snapshot is coherent. Signals are then extracted
+ * with masks computed at compile time, skipping the digitalRead() pin table lookup.
+ */
+class InputSnapshot {
+public:
+  static constexpr std::size_t NUM_INPUTS = DIGITAL_INPUT_PINS.size();
+
+  /**
+   * @brief Bits of each fast port (GPIO6 first) that hold one of the inputs
+   */
+  static constexpr std::array<uint32_t, teensy41::NUM_FAST_PORTS> PORT_MASKS = [] {
+    std::array<uint32_t, teensy41::NUM_FAST_PORTS> masks{};
+    for (const uint8_t pin : DIGITAL_INPUT_PINS) {
+      const GpioPin gpio = teensy41::PIN_MAP[pin];
+      masks[gpio.port - teensy41::FIRST_FAST_PORT] |= 1U << gpio.bit;
+    }
+    return masks;
+  }();
+
+  void sample() {
+    noInterrupts();
+    if constexpr (PORT_MASKS[0] != 0) {
+      psr_[0] = GPIO6_PSR;
+    }
+    if constexpr (PORT_MASKS[1] != 0) {
+      psr_[1] = GPIO7_PSR;
+    }
+    if constexpr (PORT_MASKS[2] != 0) {
+      psr_[2] = GPIO8_PSR;
+    }
+    if constexpr (PORT_MASKS[3] != 0) {
+      psr_[3] = GPIO9_PSR;
+    }
+    interrupts();
+  }
+
+  [[nodiscard]] bool operator[](const DigitalInput input) const {
+    const GpioPin gpio = teensy41::PIN_MAP[DIGITAL_INPUT_PINS[to_underlying(input)]];
+    return (psr_[gpio.port - teensy41::FIRST_FAST_PORT] >> gpio.bit & 1U) != 0;
+  }
+
+private:
+  std::array<uint32_t, teensy41::NUM_FAST_PORTS> psr_{};
+};
+
+static_assert(
+    [] {
+      for (const uint8_t pin : DIGITAL_INPUT_PINS) {
+        if (pin >= teensy41::PIN_MAP.size()) {
+          return false;
+        }
+      }
+      return true;
+    }(),
+    "every digital input must be in the Teensy 4.1 pin map");
@@ -0,0 +1,590 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FlexCAN_T4.h>
+#include <SdFat.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "../../debugUtils.hpp"
+#include "../../sdLogFormat.hpp"
+#include "TeensyTimerTool.h"
+#include "embedded/hardwareSettings.hpp"
+#include "model/systemData.hpp"
+#include "spscQueue.hpp"
+
+/**
+ * @brief One row of the SAMPLES table: a snapshot of HardwareData and FailureDetection
+ */
+struct LogSample {
+  uint32_t timestamp_us;
+  uint8_t state;
+  uint8_t checkup_state;
+  uint8_t ebs_phase;
+  uint8_t mission;
+  uint8_t pneumatic_line_pressure;
+  uint8_t pneumatic_line_pressure_1;
+  uint8_t pneumatic_line_pressure_2;
+  uint8_t asms_on;
+  uint8_t asats_pressed;
+  uint8_t ats_pressed;
+  uint8_t tsms_sdc_closed;
+  uint8_t master_sdc_closed;
+  uint8_t wd_ready;
+  uint8_t soc;
+  uint8_t steer_dead;
+  uint8_t pc_dead;
+  uint8_t inversor_dead;
+  uint8_t res_dead;
+  uint8_t bms_dead;
+  uint8_t emergency_signal;
+  uint8_t ts_on;
+  uint8_t mission_finished;
+  uint8_t r2d;
+  int32_t hydraulic_pressure_front;
+  int32_t hydraulic_pressure;
+  float right_wheel_rpm;
+  float left_wheel_rpm;
+  float radio_quality;
+  uint32_t dc_voltage;
+};
+
+/**
+ * @brief One row of the CAN_RX table
+ */
+struct LogCanFrame {
+  uint32_t timestamp_us;
+  uint32_t id;
+  uint8_t len;
+  uint8_t flags;  // bit 0 extended, bit 1 remote, bit 2 overrun
+  uint64_t data;  // buf[0] in the least significant byte
+};
+
+/**
+ * @brief Maps a field of a row struct to a column of the on-card format
+ */
+struct LogColumn {
+  const char *name;
+  sdlog::ColumnType type;
+  std::size_t offset;
+};
+
+#define SAMPLE_COLUMN(field, type) \
+  LogColumn { #field, sdlog::ColumnType::type, offsetof(LogSample, field) }
+#define CAN_COLUMN(field, type) \
+  LogColumn { #field, sdlog::ColumnType::type, offsetof(LogCanFrame, field) }
+
+inline constexpr std::array<LogColumn, 30> SAMPLE_COLUMNS = {{
+    SAMPLE_COLUMN(timestamp_us, U32),
+    SAMPLE_COLUMN(state, U8),
+    SAMPLE_COLUMN(checkup_state, U8),
+    SAMPLE_COLUMN(ebs_phase, U8),
+    SAMPLE_COLUMN(mission, U8),
+    SAMPLE_COLUMN(pneumatic_line_pressure, U8),
+    SAMPLE_COLUMN(pneumatic_line_pressure_1, U8),
+    SAMPLE_COLUMN(pneumatic_line_pressure_2, U8),
+    SAMPLE_COLUMN(asms_on, U8),
+    SAMPLE_COLUMN(asats_pressed, U8),
+    SAMPLE_COLUMN(ats_pressed, U8),
+    SAMPLE_COLUMN(tsms_sdc_closed, U8),
+    SAMPLE_COLUMN(master_sdc_closed, U8),
+    SAMPLE_COLUMN(wd_ready, U8),
+    SAMPLE_COLUMN(soc, U8),
+    SAMPLE_COLUMN(steer_dead, U8),
+    SAMPLE_COLUMN(pc_dead, U8),
+    SAMPLE_COLUMN(inversor_dead, U8),
+    SAMPLE_COLUMN(res_dead, U8),
+    SAMPLE_COLUMN(bms_dead, U8),
+    SAMPLE_COLUMN(emergency_signal, U8),
+    SAMPLE_COLUMN(ts_on, U8),
+    SAMPLE_COLUMN(mission_finished, U8),
+    SAMPLE_COLUMN(r2d, U8),
+    SAMPLE_COLUMN(hydraulic_pressure_front, I32),
+    SAMPLE_COLUMN(hydraulic_pressure, I32),
+    SAMPLE_COLUMN(right_wheel_rpm, F32),
+    SAMPLE_COLUMN(left_wheel_rpm, F32),
+    SAMPLE_COLUMN(radio_quality, F32),
+    SAMPLE_COLUMN(dc_voltage, U32),
+}};
+
+inline constexpr std::array<LogColumn, 5> CAN_COLUMNS = {{
+    CAN_COLUMN(timestamp_us, U32),
+    CAN_COLUMN(id, U32),
+    CAN_COLUMN(len, U8),
+    CAN_COLUMN(flags, U8),
+    CAN_COLUMN(data, U64),
+}};
+
+#undef SAMPLE_COLUMN
+#undef CAN_COLUMN
+
+/**
+ * @brief Sum of the column sizes, i.e. the bytes one row takes inside a block
+ */
+template <std::size_t N>
+constexpr std::size_t packed_row_size(const std::array<LogColumn, N> &columns) {
+  std::size_t size = 0;
+  for (const auto &column : columns) {
+    size += sdlog::column_type_size(column.type);
+  }
+  return size;
+}
+
+/**
+ * @brief Checks at compile time that every column lies inside its row struct and that its name
+ * fits the descriptor without truncation
+ */
+template <typename Row, std::size_t N>
+constexpr bool columns_fit_row(const std::array<LogColumn, N> &columns) {
+  for (const auto &column : columns) {
+    if (column.offset + sdlog::column_type_size(column.type) > sizeof(Row)) {
+      return false;
+    }
+    if (std::char_traits<char>::length(column.name) >= sdlog::COLUMN_NAME_LENGTH) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(columns_fit_row<LogSample>(SAMPLE_COLUMNS));
+static_assert(columns_fit_row<LogCanFrame>(CAN_COLUMNS));
+
+/**
+ * @brief A 512 byte block, aligned so the SDIO driver can move it without bouncing
+ */
+struct alignas(sdlog::BLOCK_SIZE) LogBlock {
+  uint8_t bytes[sdlog::BLOCK_SIZE];
+  bool sealed = false;  // full and waiting to be written to the card
+};
+
+/**
+ * @brief Producer queue plus double-buffered columnar blocks for one table
+ * @details Rows are pushed from the control loop or an ISR. The loop-side drain() scatters each
+ * row straight into its column slots of the active block; when the block fills it is sealed and
+ * the other buffer becomes active. If the other buffer has not reached the card yet, rows stay in
+ * the queue, and only when the queue is full are rows dropped (and counted).
+ */
+template <typename Row, std::size_t Columns, std::size_t QueueSize>
+class LogTable {
+public:
+  LogTable(sdlog::TableId id, const std::array<LogColumn, Columns> &columns)
+      : id_(id), columns_(columns) {
+    capacity_ = sdlog::rows_per_block(packed_row_size(columns_));
+    std::size_t offset = sizeof(sdlog::BlockHeader);
+    for (std::size_t i = 0; i < Columns; i++) {
+      column_offsets_[i] = offset;
+      offset += capacity_ * sdlog::column_type_size(columns_[i].type);
+    }
+  }
+
+  /**
+   * @brief Enqueues a row, safe to call from an interrupt
+   */
+  void push(const Row &row) {
+    if (!queue_.push(row)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Moves queued rows into the active block, sealing it when full
+   * @param sequence file-wide block counter, incremented for every block sealed
+   * @param max_rows bound on the work done in one call
+   */
+  void drain(uint32_t &sequence, std::size_t max_rows) {
+    Row row;
+    for (std::size_t n = 0; n < max_rows; n++) {
+      LogBlock &block = blocks_[active_];
+      if (block.sealed) {
+        return;  // both buffers are waiting for the card
+      }
+      if (!queue_.pop(row)) {
+        return;
+      }
+      const auto *src = reinterpret_cast<const uint8_t *>(&row);
+      for (std::size_t i = 0; i < Columns; i++) {
+        const std::size_t size = sdlog::column_type_size(columns_[i].type);
+        std::memcpy(block.bytes + column_offsets_[i] + rows_ * size, src + columns_[i].offset,
+                    size);
+      }
+      if (++rows_ == capacity_) {
+        seal(sequence);
+      }
+    }
+  }
+
+  /**
+   * @brief Seals the active block even if partially filled, used when closing the file
+   */
+  void seal_partial(uint32_t &sequence) {
+    if (rows_ > 0 && !blocks_[active_].sealed) {
+      seal(sequence);
+    }
+  }
+
+  /**
+   * @return the sealed block with the lowest sequence number, or nullptr
+   */
+  LogBlock *next_sealed() {
+    LogBlock *oldest = nullptr;
+    for (auto &block : blocks_) {
+      if (block.sealed &&
+          (oldest == nullptr ||
+           sdlog::sequence_before(header_of(block).sequence, header_of(*oldest).sequence))) {
+        oldest = &block;
+      }
+    }
+    return oldest;
+  }
+
+  [[nodiscard]] bool has_queued_rows() const { return !queue_.empty(); }
+  [[nodiscard]] uint32_t total_dropped() const { return total_dropped_; }
+  [[nodiscard]] const std::array<LogColumn, Columns> &columns() const { return columns_; }
+  [[nodiscard]] sdlog::TableId id() const { return id_; }
+
+private:
+  static sdlog::BlockHeader &header_of(LogBlock &block) {
+    return *reinterpret_cast<sdlog::BlockHeader *>(block.bytes);
+  }
+
+  void seal(uint32_t &sequence) {
+    LogBlock &block = blocks_[active_];
+    const uint32_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+    total_dropped_ += dropped;
+    header_of(block) = sdlog::BlockHeader{sdlog::BLOCK_MAGIC,
+                                          static_cast<uint8_t>(sdlog::BlockKind::DATA),
+                                          static_cast<uint8_t>(id_),
+                                          rows_,
+                                          capacity_,
+                                          sequence++,
+                                          dropped};
+    block.sealed = true;
+    active_ ^= 1;
+    rows_ = 0;
+  }
+
+  sdlog::TableId id_;
+  std::array<LogColumn, Columns> columns_;
+  std::array<std::size_t, Columns> column_offsets_{};
+  uint16_t capacity_ = 0;
+  uint16_t rows_ = 0;  // rows already in the active block
+  uint8_t active_ = 0;
+  std::array<LogBlock, 2> blocks_{};
+  SpscQueue<Row, QueueSize> queue_;
+  std::atomic<uint32_t> dropped_{0};
+  uint32_t total_dropped_ = 0;
+};
+
+/**
+ * @brief High-rate logger to the built-in SDIO card of the Teensy 4.1
+ * @details A 1 kHz timer snapshots the system data into the SAMPLES table and every CAN frame
+ * received is pushed into the CAN_RX table from the receive interrupt. The control loop only
+ * calls service(), which moves queued rows into blocks and writes at most one block per call,
+ * and only when the card is not busy, so the loop never waits on the card.
+ */
+class SdLogger {
+public:
+  static constexpr uint64_t PREALLOCATE_BYTES = 512ULL * 1024 * 1024;
+  static constexpr std::size_t MAX_ROWS_PER_SERVICE = 64;
+
+  explicit SdLogger(SystemData *system_data) : _system_data_(system_data) {}
+
+  /**
+   * @brief Mounts the card, trims the last log, creates the next LOGxxxxx.BIN, writes the schema
+   * and starts sampling
+   * @return false if there is no usable card; the logger then stays disabled
+   */
+  bool begin();
+
+  /**
+   * @brief Updates the state machine values included in each sample
+   */
+  void set_state(uint8_t state, uint8_t checkup_state, uint8_t ebs_phase) {
+    state_ = state;
+    checkup_state_ = checkup_state;
+    ebs_phase_ = ebs_phase;
+  }
+
+  /**
+   * @brief Records a received CAN frame, called from Communicator::parse_message
+   */
+  static void record_can_frame(const CAN_message_t &msg);
+
+  /**
+   * @brief Non-blocking housekeeping, to be called every loop
+   */
+  void service();
+
+  /**
+   * @brief Writes every pending row, drops the preallocated tail and closes the file
+   */
+  void end();
+
+  [[nodiscard]] bool is_logging() const { return logging_; }
+
+private:
+  /**
+   * @brief Scans the card once for the highest LOGxxxxx.BIN and trims it to its written size;
+   * the car is switched off without end(), which leaves the preallocated clusters in the file
+   * @return index of the file to create
+   */
+  unsigned recover_last_file();
+  void sample();
+  bool write_schema();
+  LogBlock *next_sealed();
+  bool write_block(const uint8_t *bytes);
+
+  SystemData *_system_data_;
+  SdFs sd_;
+  FsFile file_;
+  TeensyTimerTool::PeriodicTimer sample_timer_;
+  Metro flush_timer_{SD_LOG_FLUSH_INTERVAL};
+  bool logging_ = false;
+  uint32_t sequence_ = 0;
+  volatile uint8_t state_ = 0;
+  volatile uint8_t checkup_state_ = 0;
+  volatile uint8_t ebs_phase_ = 0;
+
+  LogTable<LogSample, SAMPLE_COLUMNS.size(), 64> samples_{sdlog::TableId::SAMPLES,
+                                                          SAMPLE_COLUMNS};
+  inline static LogTable<LogCanFrame, CAN_COLUMNS.size(), 256> can_frames_{
+      sdlog::TableId::CAN_RX, CAN_COLUMNS};
+  inline static std::atomic<bool> can_enabled_{false};
+};
+
+inline bool SdLogger::begin() {
+  if (!sd_.begin(SdioConfig(FIFO_SDIO))) {
+    DEBUG_PRINTLN("SD card not found, logging disabled");
+    return false;
+  }
+  const unsigned index = recover_last_file();
+  char name[] = "LOG00000.BIN";
+  snprintf(name, sizeof(name), "LOG%05u.BIN", index < 100000 ? index : 99999);
+  if (!file_.open(name, O_RDWR | O_CREAT | O_TRUNC)) {
+    DEBUG_PRINTLN("Could not create log file");
+    return false;
+  }
+  // Contiguous clusters keep the card from stalling on allocation mid-run
+  if (!file_.preAllocate(PREALLOCATE_BYTES)) {
+    DEBUG_PRINTLN("Log file preallocation failed, continuing without it");
+  }
+  // Blocks of older files left in the clusters past the end of this one never continue its
+  // sequence, so the decoder stops where this file ends
+  sequence_ = (index << 20) ^ micros();
+  if (!write_schema()) {
+    file_.close();
+    return false;
+  }
+  logging_ = true;
+  can_enabled_.store(true, std::memory_order_release);
+  flush_timer_.reset();
+  sample_timer_.begin([this] { sample(); }, SD_LOG_SAMPLE_PERIOD_US);
+  DEBUG_PRINTLN(String("Logging to ") + name);
+  return true;
+}
+
+inline unsigned SdLogger::recover_last_file() {
+  FsFile root;
+  FsFile entry;
+  if (!root.open("/")) {
+    return 0;
+  }
+  unsigned next = 0;
+  char last[13] = "";
+  char entry_name[13];
+  while (entry.openNext(&root, O_RDONLY)) {
+    unsigned index = 0;
+    if (!entry.isDir() && entry.getName(entry_name, sizeof(entry_name)) == 12 &&
+        sscanf(entry_name, "LOG%05u.BIN", &index) == 1 && index >= next) {
+      next = index + 1;
+      strcpy(last, entry_name);
+    }
+    entry.close();
+  }
+  root.close();
+  if (last[0] != '\0' && entry.open(last, O_RDWR)) {
+    entry.truncate(entry.fileSize());
+    entry.close();
+  }
+  return next;
+}
+
+inline bool SdLogger::write_schema() {
+  constexpr std::size_t column_count = SAMPLE_COLUMNS.size() + CAN_COLUMNS.size();
+  constexpr std::size_t schema_blocks =
+      column_count <= sdlog::FIRST_SCHEMA_DESCRIPTORS
+          ? 1
+          : 1 + (column_count - sdlog::FIRST_SCHEMA_DESCRIPTORS + sdlog::SCHEMA_DESCRIPTORS - 1) /
+                    sdlog::SCHEMA_DESCRIPTORS;
+
+  std::array<sdlog::ColumnDescriptor, column_count> descriptors{};
+  std::size_t n = 0;
+  auto describe = [&descriptors, &n](const auto &columns, sdlog::TableId table) {
+    for (const auto &column : columns) {
+      auto &descriptor = descriptors[n++];
+      strncpy(descriptor.name, column.name, sdlog::COLUMN_NAME_LENGTH);
+      descriptor.type = static_cast<uint8_t>(column.type);
+      descriptor.table = static_cast<uint8_t>(table);
+    }
+  };
+  describe(SAMPLE_COLUMNS, sdlog::TableId::SAMPLES);
+  describe(CAN_COLUMNS, sdlog::TableId::CAN_RX);
+
+  LogBlock block;
+  std::size_t written = 0;
+  for (std::size_t b = 0; b < schema_blocks; b++) {
+    std::memset(block.bytes, 0, sizeof(block.bytes));
+    std::size_t offset = sizeof(sdlog::BlockHeader);
+    std::size_t room = sdlog::SCHEMA_DESCRIPTORS;
+    if (b == 0) {
+      const sdlog::FileInfo info{sdlog::FILE_MAGIC,
+                                 sdlog::FORMAT_VERSION,
+                                 static_cast<uint16_t>(column_count),
+                                 static_cast<uint16_t>(schema_blocks),
+                                 0,
+                                 millis()};
+      std::memcpy(block.bytes + offset, &info, sizeof(info));
+      offset += sizeof(info);
+      room = sdlog::FIRST_SCHEMA_DESCRIPTORS;
+    }
+    const std::size_t count = std::min(room, column_count - written);
+    std::memcpy(block.bytes + offset, &descriptors[written], count * sizeof(descriptors[0]));
+    written += count;
+    const sdlog::BlockHeader header{sdlog::BLOCK_MAGIC,
+                                    static_cast<uint8_t>(sdlog::BlockKind::SCHEMA),
+                                    0,
+                                    static_cast<uint16_t>(count),
+                                    static_cast<uint16_t>(count),
+                                    sequence_++,
+                                    0};
+    std::memcpy(block.bytes, &header, sizeof(header));
+    if (!write_block(block.bytes)) {
+      return false;
+    }
+  }
+  return file_.flush();
+}
+
+inline bool SdLogger::write_block(const uint8_t *bytes) {
+  return file_.write(bytes, sdlog::BLOCK_SIZE) == sdlog::BLOCK_SIZE;
+}
+
+inline void SdLogger::record_can_frame(const CAN_message_t &msg) {
+  if (!can_enabled_.load(std::memory_order_acquire)) {
+    return;
+  }
+  LogCanFrame frame{micros(), msg.id, msg.len, 0, 0};
+  frame.flags = static_cast<uint8_t>(msg.flags.extended | (msg.flags.remote << 1) |
+                                     (msg.flags.overrun << 2));
+  for (uint8_t i = 0; i < msg.len && i < 8; i++) {
+    frame.data |= static_cast<uint64_t>(msg.buf[i]) << (8 * i);
+  }
+  can_frames_.push(frame);
+}
+
+inline void SdLogger::sample() {
+  const HardwareData &hw = _system_data_->hardware_data_;
+  const FailureDetection &fd = _system_data_->failure_detection_;
+  const LogSample row{micros(),
+                      state_,
+                      checkup_state_,
+                      ebs_phase_,
+                      static_cast<uint8_t>(_system_data_->mission_),
+                      hw.pneumatic_line_pressure_,
+                      hw.pneumatic_line_pressure_1_,
+                      hw.pneumatic_line_pressure_2_,
+                      hw.asms_on_,
+                      hw.asats_pressed_,
+                      hw.ats_pressed_,
+                      hw.tsms_sdc_closed_,
+                      hw.master_sdc_closed_,
+                      hw.wd_ready_,
+                      hw.soc_,
+                      fd.steer_dead_,
+                      fd.pc_dead_,
+                      fd.inversor_dead_,
+                      fd.res_dead_,
+                      fd.bms_dead_,
+                      fd.emergency_signal_,
+                      fd.ts_on_,
+                      _system_data_->mission_finished_,
+                      _system_data_->r2d_logics_.r2d,
+                      hw.hydraulic_line_front_pressure,
+                      hw._hydraulic_line_pressure,
+                      static_cast<float>(hw._right_wheel_rpm),
+                      static_cast<float>(hw._left_wheel_rpm),
+                      static_cast<float>(fd.radio_quality_),
+                      fd.dc_voltage_};
+  samples_.push(row);
+}
+
+inline void SdLogger::service() {
+  if (!logging_) {
+    return;
+  }
+  samples_.drain(sequence_, MAX_ROWS_PER_SERVICE);
+  can_frames_.drain(sequence_, MAX_ROWS_PER_SERVICE);
+
+  if (sd_.card()->isBusy()) {
+    return;  // a previous write is still being programmed, try again next loop
+  }
+  LogBlock *block = next_sealed();
+  if (block != nullptr) {
+    if (!write_block(block->bytes)) {
+      DEBUG_PRINTLN("SD write failed, logging stopped");
+      sample_timer_.stop();
+      can_enabled_.store(false, std::memory_order_release);
+      logging_ = false;
+      return;
+    }
+    block->sealed = false;
+    return;  // one card operation per loop
+  }
+  if (flush_timer_.check()) {
+    file_.flush();
+  }
+}
+
+inline void SdLogger::end() {
+  if (!logging_) {
+    return;
+  }
+  sample_timer_.stop();
+  can_enabled_.store(false, std::memory_order_release);
+  logging_ = false;
+  // Blocks go out in sequence order, the decoder stops at the first one out of it
+  auto write_all = [this] {
+    for (LogBlock *block = next_sealed(); block != nullptr; block = next_sealed()) {
+      write_block(block->bytes);
+      block->sealed = false;
+    }
+  };
+  do {
+    samples_.drain(sequence_, SIZE_MAX);
+    can_frames_.drain(sequence_, SIZE_MAX);
+    write_all();
+  } while (samples_.has_queued_rows() || can_frames_.has_queued_rows());
+  samples_.seal_partial(sequence_);
+  can_frames_.seal_partial(sequence_);
+  write_all();
+  file_.truncate();  // drop the unused preallocated tail
+  file_.close();
+}
+
+inline LogBlock *SdLogger::next_sealed() {
+  LogBlock *block = samples_.next_sealed();
+  LogBlock *can_block = can_frames_.next_sealed();
+  if (block == nullptr ||
+      (can_block != nullptr &&
+       sdlog::sequence_before(reinterpret_cast<sdlog::BlockHeader *>(can_block->bytes)->sequence,
+                              reinterpret_cast<sdlog::BlockHeader *>(block->bytes)->sequence))) {
+    return can_block;
+  }
+  return block;
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#include "enum_utils.hpp"
+
+/**
+ * @brief Where a check of the initial checkup is
+ */
+enum class CheckStatus : uint8_t {
+  BLOCKED,  ///< Some prerequisite has not passed yet
+  RUNNING,
+  PASSED,
+  FAILED,  ///< Failed on its last run; it runs again on the next tick
+};
+
+/**
+ * @brief One check of a checkup: once every prerequisite has passed, `run` is called every tick
+ * until it returns PASSED
+ */
+template <typename Context, typename CheckEnum>
+struct CheckNode {
+  CheckEnum id;
+  uint32_t prerequisites;  ///< Bit to_underlying(check) of each check that must pass first
+  CheckStatus (*run)(Context &);
+};
+
+/**
+ * @brief Prerequisite mask for CheckNode
+ */
+template <typename CheckEnum>
+constexpr uint32_t after(std::initializer_list<CheckEnum> checks) {
+  uint32_t mask = 0;
+  for (const CheckEnum check : checks) {
+    mask |= 1U << to_underlying(check);
+  }
+  return mask;
+}
+
+/**
+ * @brief The checks of a checkup and their prerequisites, a dependency graph
+ *
+ * Rows are indexed by check, and a check may only depend on rows above it, so the graph has no
+ * cycles and a single pass in row order starts every check whose prerequisites just passed.
+ */
+template <typename Context, typename CheckEnum, std::size_t NumChecks>
+class CheckupGraph {
+  static_assert(NumChecks <= 32, "prerequisites are bits of a uint32_t");
+
+public:
+  using Node = CheckNode<Context, CheckEnum>;
+  static constexpr uint32_t ALL = NumChecks == 32 ? UINT32_MAX : (1U << NumChecks) - 1;
+
+  constexpr explicit CheckupGraph(const std::array<Node, NumChecks> &nodes) : nodes_(nodes) {}
+
+  /**
+   * @brief True when row i holds check i and only depends on the rows above it
+   */
+  [[nodiscard]] constexpr bool well_formed() const {
+    for (std::size_t i = 0; i < NumChecks; i++) {
+      if (static_cast<std::size_t>(to_underlying(nodes_[i].id)) != i ||
+          (nodes_[i].prerequisites >> i) != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] constexpr const Node &node(std::size_t check) const { return nodes_[check]; }
+  static constexpr std::size_t size() { return NumChecks; }
+
+private:
+  std::array<Node, NumChecks> nodes_;
+};
+
+/**
+ * @brief State of one run of a CheckupGraph, with the start and end time of every check
+ *
+ * Times are in ms from the last reset(). Each check that passes or fails is marked for
+ * reporting once, see take_report().
+ */
+template <std::size_t NumChecks>
+class CheckupProgress {
+public:
+  static constexpr uint16_t NOT_YET = UINT16_MAX;
+
+  CheckupProgress() { reset(0); }
+
+  void reset(const uint32_t now_ms) {
+    status_.fill(CheckStatus::BLOCKED);
+    started_ms_.fill(NOT_YET);
+    finished_ms_.fill(NOT_YET);
+    passed_ = 0;
+    unreported_ = 0;
+    origin_ms_ = now_ms;
+  }
+
+  /**
+   * @brief Runs every check whose prerequisites have passed, in row order
+   * @return PASSED once every check passed, FAILED if a check failed on this tick, else RUNNING
+   */
+  template <typename Context, typename CheckEnum>
+  CheckStatus tick(const CheckupGraph<Context, CheckEnum, NumChecks> &graph, Context &context,
+                   const uint32_t now_ms) {
+    const uint16_t elapsed_ms = since_origin(now_ms);
+    bool failed = false;
+    for (std::size_t check = 0; check < NumChecks; check++) {
+      const auto &node = graph.node(check);
+      if (status_[check] == CheckStatus::PASSED || (node.prerequisites & ~passed_) != 0) {
+        continue;
+      }
+      if (status_[check] == CheckStatus::BLOCKED) {
+        started_ms_[check] = elapsed_ms;
+      }
+      const CheckStatus previous = status_[check];
+      status_[check] = node.run(context);
+      if (status_[check] == CheckStatus::PASSED) {
+        passed_ |= 1U << check;
+        finished_ms_[check] = elapsed_ms;
+        unreported_ |= 1U << check;
+      } else if (status_[check] == CheckStatus::FAILED) {
+        failed = true;
+        finished_ms_[check] = elapsed_ms;
+        if (previous != CheckStatus::FAILED) {
+          unreported_ |= 1U << check;
+        }
+      }
+    }
+    if (passed_ == CheckupGraph<Context, CheckEnum, NumChecks>::ALL) {
+      return CheckStatus::PASSED;
+    }
+    return failed ? CheckStatus::FAILED : CheckStatus::RUNNING;
+  }
+
+  [[nodiscard]] CheckStatus status(std::size_t check) const { return status_[check]; }
+  [[nodiscard]] bool passed(std::size_t check) const { return (passed_ >> check & 1U) != 0; }
+  [[nodiscard]] uint16_t started_ms(std::size_t check) const { return started_ms_[check]; }
+  [[nodiscard]] uint16_t finished_ms(std::size_t check) const { return finished_ms_[check]; }
+
+  /**
+   * @brief A check that passed or failed since it was last reported, clearing it
+   * @return the check, or NumChecks if there is nothing to report
+   */
+  std::size_t take_report() {
+    if (unreported_ == 0) {
+      return NumChecks;
+    }
+    const auto check = static_cast<std::size_t>(std::countr_zero(unreported_));
+    unreported_ &= unreported_ - 1;
+    return check;
+  }
+
+private:
+  uint16_t since_origin(uint32_t now_ms) const {
+    const uint32_t elapsed_ms = now_ms - origin_ms_;
+    return elapsed_ms < NOT_YET ? static_cast<uint16_t>(elapsed_ms) : NOT_YET - 1;
+  }
+
+  std::array<CheckStatus, NumChecks> status_{};
+  std::array<uint16_t, NumChecks> started_ms_{};
+  std::array<uint16_t, NumChecks> finished_ms_{};
+  uint32_t passed_ = 0;
+  uint32_t unreported_ = 0;
+  uint32_t origin_ms_ = 0;
+};
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <array>
 #include <cstdlib>
+#include <span>
 
-#include "debugUtils.hpp"
+#include "../../debugUtils.hpp"
 #include "embedded/digitalSender.hpp"
 #include "embedded/hardwareSettings.hpp"
+#include "logic/checkupGraph.hpp"
+#include "model/pressureCurve.hpp"
 #include "model/systemData.hpp"
 
 // Also known as Orchestrator
@@ -12,13 +16,40 @@
  * @brief The CheckupManager class handles various checkup operations.
  */
 class CheckupManager {
+public:
+  /**
+   * @brief The checks of the initial checkup, one row each in CHECKS
+   */
+  enum class Check : uint8_t {
+    ASMS,
+    WATCHDOG,
+    EBS_STORAGE,
+    BRAKE_PRESSURE,
+    ASATS,
+    TIMESTAMPS,
+    CLOSE_SDC,
+    TS,
+    EBS_ACTUATORS,
+  };
+  static constexpr std::size_t NUM_CHECKS = to_underlying(Check::EBS_ACTUATORS) + 1;
+  using Graph = CheckupGraph<CheckupManager, Check, NUM_CHECKS>;
+
 private:
   SystemData *_system_data_;  ///< Pointer to the system data object containing system status and
+                              ///< sensor information.
   TeensyTimerTool::PeriodicTimer watchdog_timer_;
-  ///< sensor information.
   Metro _watchdog_toggle_timer_{WATCHDOG_TOGGLE_DURATION};  ///< Timer for watchdog toggle sequence
   Metro _watchdog_test_timer_{WATCHDOG_TEST_DURATION};      ///< Timer for watchdog verification
 
+  enum class WatchdogPhase : uint8_t { START_TOGGLING, TOGGLING, CHECK, DONE };
+  WatchdogPhase watchdog_phase_{WatchdogPhase::START_TOGGLING};
+
+  CheckupProgress<NUM_CHECKS> progress_;
+
+  PressureCurve rear_curve_{EBS_SETTLE_BAND_ADC, EBS_SETTLE_WINDOW_US};
+  PressureCurve front_curve_{EBS_SETTLE_BAND_ADC, EBS_SETTLE_WINDOW_US};
+  uint32_t front_received_us_ = 0;  ///< Time of the last front pressure frame added to its curve
+
   /**
    * @brief Checks if the vehicle has failed to build hydraulic pressure in the limit time
    * (definido em engage ebs otv, quando entramos em ready ebs é ativado entao a pressão tem de
@@ -32,18 +63,51 @@ private:
   bool failed_to_reduce_hydraulic_pressure_in_time() const;
 
   /**
-   * @brief Handles the EBS checkup.
+   * @brief Handles the EBS checkup. Each check phase passes once both hydraulic lines have
+   * settled on the expected side of the threshold.
+   * @return true once both actuators were checked
+   */
+  bool handle_ebs_check();
+
+  /**
+   * @brief Starts the curves of both hydraulic lines, right after an EBS valve switch
    */
-  void handle_ebs_check();
+  void start_curves();
+
+  /**
+   * @brief Adds the rear line (every call) and the front line (every new dash frame) to their
+   * curves
+   * @return true once both lines have settled
+   */
+  bool sample_curves();
+
+  /**
+   * @brief Queues the fit of both lines at the end of a check phase, see take_curve_reports()
+   */
+  void report_curves();
+
+  /**
+   * @brief Back to the start of the checkup, with both EBS actuators engaged
+   */
+  void reset_progress();
+
+  // Checks, see CHECKS
+  static CheckStatus check_asms(CheckupManager &cm);
+  static CheckStatus check_watchdog(CheckupManager &cm);
+  static CheckStatus check_ebs_storage(CheckupManager &cm);
+  static CheckStatus check_brake_pressure(CheckupManager &cm);
+  static CheckStatus check_asats(CheckupManager &cm);
+  static CheckStatus check_timestamps(CheckupManager &cm);
+  static CheckStatus close_sdc(CheckupManager &cm);
+  static CheckStatus check_ts(CheckupManager &cm);
+  static CheckStatus check_ebs_actuators(CheckupManager &cm);
 
 public:
   Metro _ebs_sound_timestamp_{EBS_BUZZER_TIMEOUT};  ///< Timer for the EBS buzzer sound check.
 
   /**
-   * @brief The CheckupState enum represents the different states of
-   * the initial checkup process.
-   * The checkup process is a sequence of checks that the vehicle must pass
-   * before it can transition to ready state.
+   * @brief Summary of the initial checkup progress, as published on CAN and logged: the first
+   * check in CHECKS that has not passed yet (the states without a check are not used anymore)
    */
   enum class CheckupState {
     WAIT_FOR_ASMS,
@@ -72,6 +136,17 @@ public:
     COMPLETE
   };
 
+  enum class HydraulicLine : uint8_t { REAR, FRONT };
+
+  /**
+   * @brief How one hydraulic line responded during a check phase of the EBS test
+   */
+  struct EbsCurveReport {
+    EbsPressureTestPhase phase;
+    HydraulicLine line;
+    StepFit fit;
+  };
+
   /**
    * This is for easier debugging in case initial checkup fails
    */
@@ -84,11 +159,54 @@ public:
     SUCCESS
   };
 
+  /**
+   * @brief Every check with its prerequisites, in an order where each row only depends on the
+   * rows above it
+   *
+   * Checks without a path between them run concurrently. The watchdog test runs while the EBS
+   * storage, brake pressure and ASATS are checked. The EBS actuators are tested while the inverter
+   * precharges and proves its DC voltage. The watchdog must pass before the SDC is closed, since
+   * its relay only closes once the watchdog test has passed.
+   */
+  static constexpr Graph CHECKS{{{
+      {Check::ASMS, 0, check_asms},
+      {Check::WATCHDOG, after({Check::ASMS}), check_watchdog},
+      {Check::EBS_STORAGE, after({Check::ASMS}), check_ebs_storage},
+      {Check::BRAKE_PRESSURE, after({Check::EBS_STORAGE}), check_brake_pressure},
+      {Check::ASATS, after({Check::BRAKE_PRESSURE}), check_asats},
+      {Check::TIMESTAMPS, after({Check::ASATS}), check_timestamps},
+      {Check::CLOSE_SDC, after({Check::TIMESTAMPS, Check::WATCHDOG}), close_sdc},
+      {Check::TS, after({Check::CLOSE_SDC}), check_ts},
+      {Check::EBS_ACTUATORS, after({Check::CLOSE_SDC}), check_ebs_actuators},
+  }}};
+
+  /**
+   * @brief CheckupState reported while each check is the first one not passed
+   */
+  static constexpr std::array<CheckupState, NUM_CHECKS> SUMMARY{
+      CheckupState::WAIT_FOR_ASMS,
+      CheckupState::CHECK_WATCHDOG,
+      CheckupState::CHECK_EBS_STORAGE,
+      CheckupState::CHECK_BRAKE_PRESSURE,
+      CheckupState::WAIT_FOR_ASATS,
+      CheckupState::CHECK_TIMESTAMPS,
+      CheckupState::CLOSE_SDC,
+      CheckupState::WAIT_FOR_TS,
+      CheckupState::EBS_CHECKS,
+  };
+
   CheckupState checkup_state_{
-      CheckupState::WAIT_FOR_ASMS};  ///< Current state of the checkup process.
+      CheckupState::WAIT_FOR_ASMS};  ///< Summary of the checkup progress, see SUMMARY
+  CheckupError error_{CheckupError::WAITING_FOR_RESPONSE};  ///< Why the last failed check failed
 
   EbsPressureTestPhase pressure_test_phase_{EbsPressureTestPhase::DISABLE_ACTUATOR_1};
 
+private:
+  std::array<EbsCurveReport, 6> curve_reports_{};  ///< Both lines of the three check phases
+  std::size_t curve_report_count_ = 0;
+
+public:
+
   /**
    * @brief Constructor for the CheckupManager class.
    * @param system_data Pointer to the system data object.
@@ -116,10 +234,27 @@ public:
   bool should_stay_off();
 
   /**
-   * @brief Performs an initial checkup.
+   * @brief Runs every check of the initial checkup whose prerequisites have passed
+   * @return SUCCESS once all checks passed, the error of a check that failed on this call, or
+   * WAITING_FOR_RESPONSE
    */
   CheckupError initial_checkup_sequence();
 
+  /**
+   * @brief Status and timing of every check since ASMS was switched on
+   */
+  [[nodiscard]] const CheckupProgress<NUM_CHECKS> &progress() const { return progress_; }
+  CheckupProgress<NUM_CHECKS> &progress() { return progress_; }
+
+  /**
+   * @brief Fits queued since the last call, valid until the next EBS check phase ends
+   */
+  std::span<const EbsCurveReport> take_curve_reports() {
+    const std::size_t count = curve_report_count_;
+    curve_report_count_ = 0;
+    return {curve_reports_.data(), count};
+  }
+
   /**
    * @brief Performs a last re-check for off to ready transition.
    */
@@ -158,13 +293,33 @@ public:
    *
    */
   [[nodiscard]] bool res_triggered() const;
+
+  /**
+   * @brief O(1) check of the alive deadlines, safe to call from a timer interrupt.
+   */
+  [[nodiscard]] bool component_deadline_missed() const;
 };
 
+static_assert(CheckupManager::CHECKS.well_formed(),
+              "CheckupManager::CHECKS rows must be in Check order and only depend on rows above");
+
 inline void CheckupManager::reset_checkup_state() {
-  checkup_state_ = CheckupState::WAIT_FOR_ASMS;
+  reset_progress();
   _system_data_->mission_finished_ = false;
 }
 
+inline void CheckupManager::reset_progress() {
+  progress_.reset(millis());
+  checkup_state_ = CheckupState::WAIT_FOR_ASMS;
+  watchdog_phase_ = WatchdogPhase::START_TOGGLING;
+  if (pressure_test_phase_ != EbsPressureTestPhase::DISABLE_ACTUATOR_1) {
+    // Interrupted half way, a valve may still be disabled
+    DigitalSender::enable_ebs_actuator_REAR();
+    DigitalSender::enable_ebs_actuator_FRONT();
+    pressure_test_phase_ = EbsPressureTestPhase::DISABLE_ACTUATOR_1;
+  }
+}
+
 inline bool CheckupManager::should_stay_manual_driving() const {
   if (_system_data_->mission_ != Mission::MANUAL ||
       _system_data_->hardware_data_.pneumatic_line_pressure_ != 0 ||
@@ -191,195 +346,259 @@ inline void CheckupManager::reset_mission_finished() {
 
 inline CheckupManager::CheckupError CheckupManager::initial_checkup_sequence() {
   if (!_system_data_->hardware_data_.asms_on_) {
-    checkup_state_ = CheckupState::WAIT_FOR_ASMS;
+    reset_progress();
   }
-  switch (checkup_state_) {
-    case CheckupState::WAIT_FOR_ASMS:
-      if (_system_data_->hardware_data_.asms_on_) {
-        checkup_state_ = CheckupState::CHECK_EBS_STORAGE;
-        DEBUG_PRINT("ASMS activated, starting watchdog check");
-      }
+  const CheckStatus status = progress_.tick(CHECKS, *this, millis());
+
+  checkup_state_ = CheckupState::CHECKUP_COMPLETE;
+  for (std::size_t check = 0; check < NUM_CHECKS; check++) {
+    if (!progress_.passed(check)) {
+      checkup_state_ = SUMMARY[check];
       break;
-    case CheckupState::START_TOGGLING_WATCHDOG:
-      if (_system_data_->hardware_data_.wd_ready_) {
-        checkup_state_ = CheckupState::TOGGLING_WATCHDOG;
-        _watchdog_toggle_timer_.reset();
-        DEBUG_PRINT("Watchdog ready, starting toggle sequence");
+    }
+  }
+
+  switch (status) {
+    case CheckStatus::PASSED:
+      DEBUG_PRINTLN("Checkup complete, transitioning to ready state");
+      return CheckupError::SUCCESS;
+    case CheckStatus::FAILED:
+      return error_;
+    default:
+      return CheckupError::WAITING_FOR_RESPONSE;
+  }
+}
+
+inline CheckStatus CheckupManager::check_asms(CheckupManager &cm) {
+  if (!cm._system_data_->hardware_data_.asms_on_) {
+    return CheckStatus::RUNNING;
+  }
+  DEBUG_PRINTLN("ASMS activated, starting checkup");
+  return CheckStatus::PASSED;
+}
+
+inline CheckStatus CheckupManager::check_watchdog(CheckupManager &cm) {
+  if constexpr (!WATCHDOG_CHECKUP_ENABLED) {
+    return CheckStatus::PASSED;
+  }
+  const bool wd_ready = cm._system_data_->hardware_data_.wd_ready_;
+  switch (cm.watchdog_phase_) {
+    case WatchdogPhase::START_TOGGLING:
+      if (wd_ready) {
+        cm.watchdog_phase_ = WatchdogPhase::TOGGLING;
+        cm._watchdog_toggle_timer_.reset();
+        DEBUG_PRINTLN("Watchdog ready, starting toggle sequence");
         break;
       }
       DigitalSender::toggle_watchdog();
       break;
 
-    case CheckupState::TOGGLING_WATCHDOG:
+    case WatchdogPhase::TOGGLING:
       // Fail immediately if WD_READY goes low during toggling
-      if (!_system_data_->hardware_data_.wd_ready_) {
-        DEBUG_PRINT("Watchdog error: WD_READY went low during toggling phase");
-        return CheckupError::ERROR_WD_TOGGLE;
+      if (!wd_ready) {
+        DEBUG_PRINTLN("Watchdog error: WD_READY went low during toggling phase");
+        cm.error_ = CheckupError::ERROR_WD_TOGGLE;
+        return CheckStatus::FAILED;
       }
-
       DigitalSender::toggle_watchdog();
 
-      // Toggle for the specified duration
-      if (_watchdog_toggle_timer_.checkWithoutReset()) {
-        checkup_state_ = CheckupState::STOP_TOGGLING_WATCHDOG;
-        _watchdog_test_timer_.reset();
-        DEBUG_PRINT("Watchdog toggle complete, stopping watchdog");
+      // Toggle for the specified duration, then stop and expect WD_READY to drop
+      if (cm._watchdog_toggle_timer_.checkWithoutReset()) {
+        cm.watchdog_phase_ = WatchdogPhase::CHECK;
+        cm._watchdog_test_timer_.reset();
+        DEBUG_PRINTLN("Watchdog toggle complete, beginning verification");
       }
       break;
 
-    case CheckupState::STOP_TOGGLING_WATCHDOG:
-      _watchdog_test_timer_.reset();
-      checkup_state_ = CheckupState::CHECK_WATCHDOG;
-      DEBUG_PRINT("Stopping watchdog toggle, beginning verification");
-      break;
-
-    case CheckupState::CHECK_WATCHDOG:
-      if (!_system_data_->hardware_data_.wd_ready_) {
+    case WatchdogPhase::CHECK:
+      if (!wd_ready) {
         DigitalSender::close_watchdog_sdc();
-
-        checkup_state_ = CheckupState::START_TOGGLING_WATCHDOG_AGAIN;
-        DEBUG_PRINT("Watchdog no longer ready - verification successful");
-        break;
+        cm.watchdog_timer_.begin([] { DigitalSender::toggle_watchdog(); }, 50'000);
+        cm.watchdog_phase_ = WatchdogPhase::DONE;
+        DEBUG_PRINTLN("Watchdog no longer ready - verification successful");
+        return CheckStatus::PASSED;
       }
-      if (_watchdog_test_timer_.checkWithoutReset()) {
-        DEBUG_PRINT("Watchdog test failed - WD_READY did not go low during verification time");
-        return CheckupError::ERROR_WD_STAYED_READY;
+      if (cm._watchdog_test_timer_.checkWithoutReset()) {
+        DEBUG_PRINTLN("Watchdog test failed - WD_READY did not go low during verification time");
+        cm.error_ = CheckupError::ERROR_WD_STAYED_READY;
+        return CheckStatus::FAILED;
       }
       break;
-    case CheckupState::START_TOGGLING_WATCHDOG_AGAIN:
-      watchdog_timer_.begin([] { DigitalSender::toggle_watchdog(); }, 50'000);
-      checkup_state_ = CheckupState::CHECK_EBS_STORAGE;
-      break;
-    case CheckupState::CHECK_EBS_STORAGE:
-      DEBUG_PRINT("EBS Storage - pressure: " +
-                  String(_system_data_->hardware_data_.pneumatic_line_pressure_));
-      if (_system_data_->hardware_data_.pneumatic_line_pressure_) {
-        checkup_state_ = CheckupState::CHECK_BRAKE_PRESSURE;
-      }
-      break;
-    case CheckupState::CHECK_BRAKE_PRESSURE:
-      DEBUG_PRINT(
-          "Hydraulic Pressure: " + String(_system_data_->hardware_data_._hydraulic_line_pressure) +
-          " - " + String(_system_data_->hardware_data_.hydraulic_line_front_pressure));
-      if (_system_data_->hardware_data_._hydraulic_line_pressure >= HYDRAULIC_BRAKE_THRESHOLD &&
-          _system_data_->hardware_data_.hydraulic_line_front_pressure >=
-              HYDRAULIC_BRAKE_THRESHOLD
-            && _system_data_->hardware_data_._hydraulic_line_pressure < BRAKE_PRESSURE_UPPER_THRESHOLD &&
-          _system_data_->hardware_data_.hydraulic_line_front_pressure < BRAKE_PRESSURE_UPPER_THRESHOLD) {
-        checkup_state_ = CheckupState::WAIT_FOR_ASATS;
-      }
-      break;
-    case CheckupState::WAIT_FOR_ASATS:
-      if (_system_data_->hardware_data_.asats_pressed_) {
-        _system_data_->failure_detection_.emergency_signal_ = false;
-        checkup_state_ = CheckupState::CHECK_TIMESTAMPS;
-        DEBUG_PRINT("AS ATS Pressed");
-      }
-      break;
-    case CheckupState::CHECK_TIMESTAMPS: {
-      if (_system_data_->failure_detection_.has_any_component_timed_out() ||
-          _system_data_->failure_detection_.emergency_signal_) {
-        return CheckupError::ERROR_TIMESTAMPS_EMERGENCY;
-      }
-      checkup_state_ = CheckupState::CLOSE_SDC;
-      break;
-    }
-    case CheckupState::CLOSE_SDC:
-      if (_system_data_->mission_ != Mission::MANUAL) {
-        this->_system_data_->hardware_data_.master_sdc_closed_ = true;
-        checkup_state_ = CheckupState::WAIT_FOR_TS;
-        DEBUG_PRINT("Closing SDC");
 
-        DigitalSender::close_sdc();
-      }
-      break;
-    case CheckupState::WAIT_FOR_TS:
-      DEBUG_PRINT("Waiting for TS activation");
-      if (_system_data_->failure_detection_.ts_on_) {
-        DEBUG_PRINT("TS activated");
-        checkup_state_ = CheckupState::EBS_CHECKS;
-      }
-      break;
-    case CheckupState::EBS_CHECKS:
-      // DEBUG_PRINT("Starting EBS checks");
-      handle_ebs_check();
-      break;
-    case CheckupState::CHECKUP_COMPLETE:
-      // Final state, all checks passed
-      DEBUG_PRINT("Checkup complete, transitioning to ready state");
-      return CheckupError::SUCCESS;
+    case WatchdogPhase::DONE:
+      return CheckStatus::PASSED;
+  }
+  return CheckStatus::RUNNING;
+}
 
-    default:
-      break;
+inline CheckStatus CheckupManager::check_ebs_storage(CheckupManager &cm) {
+  LOG_DEBUG(LOG_STATE, "EBS Storage - pressure: %u",
+            cm._system_data_->hardware_data_.pneumatic_line_pressure_);
+  return cm._system_data_->hardware_data_.pneumatic_line_pressure_ ? CheckStatus::PASSED
+                                                                   : CheckStatus::RUNNING;
+}
+
+inline CheckStatus CheckupManager::check_brake_pressure(CheckupManager &cm) {
+  const auto &hardware_data = cm._system_data_->hardware_data_;
+  LOG_DEBUG(LOG_STATE, "Hydraulic Pressure: %d - %d", hardware_data._hydraulic_line_pressure,
+            hardware_data.hydraulic_line_front_pressure);
+  if (hardware_data._hydraulic_line_pressure >= HYDRAULIC_BRAKE_THRESHOLD &&
+      hardware_data.hydraulic_line_front_pressure >= HYDRAULIC_BRAKE_THRESHOLD &&
+      hardware_data._hydraulic_line_pressure < BRAKE_PRESSURE_UPPER_THRESHOLD &&
+      hardware_data.hydraulic_line_front_pressure < BRAKE_PRESSURE_UPPER_THRESHOLD) {
+    return CheckStatus::PASSED;
+  }
+  return CheckStatus::RUNNING;
+}
+
+inline CheckStatus CheckupManager::check_asats(CheckupManager &cm) {
+  if (!cm._system_data_->hardware_data_.asats_pressed_) {
+    return CheckStatus::RUNNING;
+  }
+  cm._system_data_->failure_detection_.emergency_signal_ = false;
+  DEBUG_PRINTLN("AS ATS Pressed");
+  return CheckStatus::PASSED;
+}
+
+inline CheckStatus CheckupManager::check_timestamps(CheckupManager &cm) {
+  if (cm._system_data_->failure_detection_.has_any_component_timed_out() ||
+      cm._system_data_->failure_detection_.emergency_signal_) {
+    cm.error_ = CheckupError::ERROR_TIMESTAMPS_EMERGENCY;
+    return CheckStatus::FAILED;
+  }
+  return CheckStatus::PASSED;
+}
+
+inline CheckStatus CheckupManager::close_sdc(CheckupManager &cm) {
+  if (cm._system_data_->mission_ == Mission::MANUAL) {
+    return CheckStatus::RUNNING;
+  }
+  cm._system_data_->hardware_data_.master_sdc_closed_ = true;
+  DEBUG_PRINTLN("Closing SDC");
+  DigitalSender::close_sdc();
+  return CheckStatus::PASSED;
+}
+
+inline CheckStatus CheckupManager::check_ts(CheckupManager &cm) {
+  if (!cm._system_data_->failure_detection_.ts_on_) {
+    return CheckStatus::RUNNING;
   }
-  return CheckupError::WAITING_FOR_RESPONSE;
+  DEBUG_PRINTLN("TS activated");
+  return CheckStatus::PASSED;
+}
+
+inline CheckStatus CheckupManager::check_ebs_actuators(CheckupManager &cm) {
+  return cm.handle_ebs_check() ? CheckStatus::PASSED : CheckStatus::RUNNING;
 }
 
-inline void CheckupManager::handle_ebs_check() {
+inline bool CheckupManager::handle_ebs_check() {
   switch (pressure_test_phase_) {
     case EbsPressureTestPhase::DISABLE_ACTUATOR_1:
       // Step 10: Disable EBS actuator 1
-      DEBUG_PRINT("Disabling EBS actuator 1");
+      DEBUG_PRINTLN("Disabling EBS actuator 1");
       DigitalSender::disable_ebs_actuator_REAR();
+      start_curves();
       pressure_test_phase_ = EbsPressureTestPhase::CHECK_ACTUATOR_2;
       break;
 
     case EbsPressureTestPhase::CHECK_ACTUATOR_2:
-    DEBUG_PRINT_VAR(_system_data_->hardware_data_.hydraulic_line_front_pressure);
-      if (_system_data_->hardware_data_.pneumatic_line_pressure_ &&
+      LOG_DEBUG(LOG_STATE, "Front hydraulic line: %d",
+                _system_data_->hardware_data_.hydraulic_line_front_pressure);
+      if (sample_curves() && _system_data_->hardware_data_.pneumatic_line_pressure_ &&
           _system_data_->hardware_data_._hydraulic_line_pressure < HYDRAULIC_BRAKE_THRESHOLD &&
           _system_data_->hardware_data_.hydraulic_line_front_pressure >=
               HYDRAULIC_BRAKE_THRESHOLD) {  // pressure should be high even with only one actuator
-        DEBUG_PRINT("Pressure high confirmed with only actuator 2");
+        DEBUG_PRINTLN("Pressure high confirmed with only actuator 2");
+        report_curves();
         pressure_test_phase_ = EbsPressureTestPhase::CHANGE_ACTUATORS;
       }
       break;
 
     case EbsPressureTestPhase::CHANGE_ACTUATORS:
       // Step 12: Enable EBS actuator 1 again and disable actuator 2
-      DEBUG_PRINT("Re-enabling EBS actuator 1 and disabling actuator 2");
+      DEBUG_PRINTLN("Re-enabling EBS actuator 1 and disabling actuator 2");
       DigitalSender::enable_ebs_actuator_REAR();
       DigitalSender::disable_ebs_actuator_FRONT();
+      start_curves();
       pressure_test_phase_ = EbsPressureTestPhase::CHECK_ACTUATOR_1;
       break;
 
     case EbsPressureTestPhase::CHECK_ACTUATOR_1:
       // Step 13: Check that the brake pressure is still built up correctly
-      if (_system_data_->hardware_data_.pneumatic_line_pressure_ &&
+      if (sample_curves() && _system_data_->hardware_data_.pneumatic_line_pressure_ &&
           _system_data_->hardware_data_._hydraulic_line_pressure >=
               HYDRAULIC_BRAKE_THRESHOLD &&
           _system_data_->hardware_data_.hydraulic_line_front_pressure < HYDRAULIC_BRAKE_THRESHOLD) {
-        DEBUG_PRINT("Pressure high confirmed with only actuator 1");
+        DEBUG_PRINTLN("Pressure high confirmed with only actuator 1");
+        report_curves();
         pressure_test_phase_ = EbsPressureTestPhase::ENABLE_ACTUATOR_2;
       }
       break;
 
     case EbsPressureTestPhase::ENABLE_ACTUATOR_2:
       // Step 14: Enable EBS actuator 2 again
-      DEBUG_PRINT("Re-enabling EBS actuator 2");
+      DEBUG_PRINTLN("Re-enabling EBS actuator 2");
       DigitalSender::enable_ebs_actuator_FRONT();
+      start_curves();
       pressure_test_phase_ = EbsPressureTestPhase::CHECK_BOTH_ACTUATORS;
       break;
 
     case EbsPressureTestPhase::CHECK_BOTH_ACTUATORS:
       // Step 15: Check that both actuators are working correctly
-      DEBUG_PRINT("Final pressure check");
-      if (_system_data_->hardware_data_.pneumatic_line_pressure_ &&
+      DEBUG_PRINTLN("Final pressure check");
+      if (sample_curves() && _system_data_->hardware_data_.pneumatic_line_pressure_ &&
           _system_data_->hardware_data_.hydraulic_line_front_pressure >=
               HYDRAULIC_BRAKE_THRESHOLD &&
           _system_data_->hardware_data_._hydraulic_line_pressure >= HYDRAULIC_BRAKE_THRESHOLD) {
-        DEBUG_PRINT("Both actuators confirmed working correctly");
+        DEBUG_PRINTLN("Both actuators confirmed working correctly");
+        report_curves();
         pressure_test_phase_ = EbsPressureTestPhase::COMPLETE;
       }
       break;
 
     case EbsPressureTestPhase::COMPLETE:
       // Step 16: Transition to ready state
-      DEBUG_PRINT("EBS check complete, transitioning to next state");
-      checkup_state_ = CheckupState::CHECKUP_COMPLETE;
+      DEBUG_PRINTLN("EBS check complete, transitioning to next state");
       pressure_test_phase_ = EbsPressureTestPhase::DISABLE_ACTUATOR_1;
-      break;
+      return true;
   }
+  return false;
+}
+
+inline void CheckupManager::start_curves() {
+  const auto &hardware_data = _system_data_->hardware_data_;
+  const uint32_t now_us = micros();
+  rear_curve_.start(hardware_data.hydraulic_line_raw_pressure, now_us);
+  noInterrupts();
+  front_received_us_ = hardware_data.hydraulic_line_front_received_us;
+  const int front = hardware_data.hydraulic_line_front_pressure;
+  interrupts();
+  front_curve_.start(front, now_us);
+}
+
+inline bool CheckupManager::sample_curves() {
+  const auto &hardware_data = _system_data_->hardware_data_;
+  rear_curve_.add(hardware_data.hydraulic_line_raw_pressure, micros());
+  // The dash sends the front line, stale readings would look settled
+  noInterrupts();
+  const uint32_t received_us = hardware_data.hydraulic_line_front_received_us;
+  const int front = hardware_data.hydraulic_line_front_pressure;
+  interrupts();
+  if (received_us != front_received_us_) {
+    front_received_us_ = received_us;
+    front_curve_.add(front, received_us);
+  }
+  return rear_curve_.settled() && front_curve_.settled();
+}
+
+inline void CheckupManager::report_curves() {
+  if (curve_report_count_ + 2 > curve_reports_.size()) {
+    return;  // nobody took the last ones
+  }
+  curve_reports_[curve_report_count_++] = {pressure_test_phase_, HydraulicLine::REAR,
+                                           rear_curve_.fit()};
+  curve_reports_[curve_report_count_++] = {pressure_test_phase_, HydraulicLine::FRONT,
+                                           front_curve_.fit()};
 }
 
 inline bool CheckupManager::should_stay_ready() const {
@@ -477,3 +696,7 @@ inline bool CheckupManager::emergency_sequence_complete() const {
 inline bool CheckupManager::res_triggered() const {
   return _system_data_->failure_detection_.emergency_signal_;
 }
+
+inline bool CheckupManager::component_deadline_missed() const {
+  return _system_data_->component_timeouts_.any_expired();
+}
@@ -1,8 +1,8 @@
 #pragma once
 
+#include "../../debugUtils.hpp"
 #include "TeensyTimerTool.h"
 #include "comm/communicator.hpp"
-#include "debugUtils.hpp"
 #include "embedded/digitalSender.hpp"
 #include "enum_utils.hpp"
 #include "metro.h"
@@ -21,6 +21,8 @@ private:
   Metro state_timer_;
   Metro process_timer_{PROCESS_INTERVAL};
   Metro slower_process_timer_{SLOWER_PROCESS_INTERVAL};
+  Metro heartbeat_stats_timer_{HEARTBEAT_STATS_INTERVAL};
+  uint8_t next_heartbeat_component_ = 0;
 
   uint8_t previous_master_state_;
   uint8_t previous_checkup_state_;
@@ -46,7 +48,7 @@ public:
   void init() {
     mission_timer_.reset();
     state_timer_.reset();
-    DEBUG_PRINT("Output coordinator initialized...");
+    DEBUG_PRINTLN("Output coordinator initialized...");
   }
 
   void process(uint8_t current_master_state, uint8_t current_checkup_state, uint8_t ebs_state) {
@@ -62,6 +64,9 @@ public:
     if (slower_process_timer_.check()) {
       send_data_logging_data(current_master_state, current_checkup_state);
     }
+    if (heartbeat_stats_timer_.check()) {
+      send_heartbeat_stats();
+    }
   }
 
   void blink_emergency_led() {
@@ -95,7 +100,6 @@ public:
     digital_sender_->deactivate_ebs();
     digital_sender_->open_sdc();
     this->system_data_->hardware_data_.master_sdc_closed_ = false;
-    DEBUG_PRINT("Entering manual state...");
   }
 
   /**
@@ -157,6 +161,11 @@ private:
                                             current_checkup_state);
   }
 
+  void send_heartbeat_stats() {
+    Communicator::publish_heartbeat_stats(static_cast<Component>(next_heartbeat_component_));
+    next_heartbeat_component_ = (next_heartbeat_component_ + 1) % ComponentTimeouts::size();
+  }
+
   void send_soc() { Communicator::publish_soc(system_data_->hardware_data_.soc_); }
 
   void send_asms() { Communicator::publish_asms_on(system_data_->hardware_data_.asms_on_); }
@@ -233,10 +242,10 @@ private:
 
   void brake_light_update() {
     int brake_val = system_data_->hardware_data_._hydraulic_line_pressure;
-    // DEBUG_PRINT("Brake pressure: " + String(brake_val));
-    // DEBUG_PRINT("Brake pressure lower threshold: " +
+    // DEBUG_PRINTLN("Brake pressure: " + String(brake_val));
+    // DEBUG_PRINTLN("Brake pressure lower threshold: " +
     //            String(BRAKE_PRESSURE_LOWER_THRESHOLD));
-    // DEBUG_PRINT("Brake pressure upper threshold: " +
+    // DEBUG_PRINTLN("Brake pressure upper threshold: " +
     //            String(BRAKE_PRESSURE_UPPER_THRESHOLD));
 
     if (brake_val >= BRAKE_PRESSURE_LOWER_THRESHOLD &&
@@ -256,18 +265,18 @@ private:
     }
   }
   void dash_ats_update(uint8_t current_master_state) {
-    // DEBUG_PRINT("=== ATS Update Debug ===");
-    // DEBUG_PRINT("ATS Pressed: " + String(system_data_->hardware_data_.ats_pressed_));
-    // DEBUG_PRINT("Current Master State: " + String(current_master_state) +
+    // DEBUG_PRINTLN("=== ATS Update Debug ===");
+    // DEBUG_PRINTLN("ATS Pressed: " + String(system_data_->hardware_data_.ats_pressed_));
+    // DEBUG_PRINTLN("Current Master State: " + String(current_master_state) +
     //             " (AS_MANUAL=" + String(to_underlying(State::AS_MANUAL)) + ")");
-    // DEBUG_PRINT("TSMS SDC Closed: " +
+    // DEBUG_PRINTLN("TSMS SDC Closed: " +
     // String(system_data_->hardware_data_.tsms_sdc_closed_)); if
     // (system_data_->hardware_data_.tsms_sdc_closed_) {
     //   opened_again = false;
     // }
 
     // if (tsms_was_closed_ && !system_data_->hardware_data_.tsms_sdc_closed_) {
-    //   DEBUG_PRINT(">>> TSMS opened - recording time for 100ms delay");
+    //   DEBUG_PRINTLN(">>> TSMS opened - recording time for 100ms delay");
     //   tsms_open_time_ = millis();
     //   opened = true;
     // }
@@ -286,7 +295,7 @@ private:
     if (system_data_->hardware_data_.ats_pressed_ &&
       current_master_state == to_underlying(State::AS_MANUAL) &&
       system_data_->hardware_data_.tsms_sdc_closed_) {
-        // DEBUG_PRINT(">>> CLOSING SDC - All conditions met");
+        // DEBUG_PRINTLN(">>> CLOSING SDC - All conditions met");
         digital_sender_->close_sdc();
         // tsms_was_closed_ = system_data_->hardware_data_.tsms_sdc_closed_;
 
@@ -296,16 +305,16 @@ private:
       //          (millis() - tsms_open_time_) >= 100
               )
                {
-      // DEBUG_PRINT(">>> OPENING SDC - TSMS SDC not closed (100ms delay elapsed)");
+      // DEBUG_PRINTLN(">>> OPENING SDC - TSMS SDC not closed (100ms delay elapsed)");
       digital_sender_->open_sdc();
       this->system_data_->hardware_data_.master_sdc_closed_ = false;
     } else {
-      // DEBUG_PRINT(">>> NO SDC ACTION - Conditions not met");
+      // DEBUG_PRINTLN(">>> NO SDC ACTION - Conditions not met");
       if (!system_data_->hardware_data_.ats_pressed_) {
-        // DEBUG_PRINT("    - ATS not pressed");
+        // DEBUG_PRINTLN("    - ATS not pressed");
       }
       if (current_master_state != to_underlying(State::AS_MANUAL)) {
-        // DEBUG_PRINT("    - Not in AS_MANUAL state");
+        // DEBUG_PRINTLN("    - Not in AS_MANUAL state");
       }
     }
   }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <embedded/digitalSender.hpp>
+#include <embedded/emergencyIrq.hpp>
 #include <logic/checkupManager.hpp>
+#include <logic/transitionTable.hpp>
 #include <model/structure.hpp>
 
 #include "TeensyTimerTool.h"
@@ -16,9 +18,14 @@ using namespace TeensyTimerTool;
  * state and handle transitions.
  */
 class ASState {
+public:
+  static constexpr std::size_t NUM_STATES = to_underlying(State::AS_EMERGENCY) + 1;
+  static constexpr uint32_t DEADLINE_CHECK_PERIOD_US = 1'000;
+
 private:
-  PeriodicTimer emergency_timer_;
-  volatile bool timer_has_started = false;
+  PeriodicTimer deadline_timer_;
+  volatile uint8_t emergency_sources_ = 0;     ///< EmergencySource bits being handled
+  volatile uint32_t emergency_latency_us_ = 0;  ///< raise() to SDC open, last emergency event
   OutputCoordinator *
       _output_coordinator_;  ///< Pointer to the OutputCoordinator object for hardware interactions.
   Communicator
@@ -26,7 +33,95 @@ private:
 
   inline static ASState *instance = nullptr;
 
+  // Guards
+  static bool leaves_manual(ASState &as) {
+    return !as._checkup_manager_.should_stay_manual_driving();
+  }
+  static bool stays_manual(ASState &as) {
+    return as._checkup_manager_.should_stay_manual_driving();
+  }
+  static bool checkup_passed(ASState &as) {
+    as._output_coordinator_->refresh_r2d_vars();
+    as._output_coordinator_->refresh_emergency_vars();
+    return !as._checkup_manager_.should_stay_off();
+  }
+  static bool ready_to_drive(ASState &as) { return !as._checkup_manager_.should_stay_ready(); }
+  static bool mission_finished(ASState &as) {
+    return !as._checkup_manager_.should_stay_driving();
+  }
+  static bool res_triggered(ASState &as) { return as._checkup_manager_.res_triggered(); }
+  static bool asms_off(ASState &as) { return !as._checkup_manager_.should_stay_mission_finished(); }
+  static bool emergency_sequence_complete(ASState &as) {
+    return as._checkup_manager_.emergency_sequence_complete();
+  }
+  static bool emergency_detected(ASState &as) {
+    return as._checkup_manager_.should_enter_emergency(as.state_);
+  }
+  static bool emergency_raised(ASState &as) { return as.emergency_sources_ != 0; }
+  static bool stop_requested(ASState &as) {
+    return (as.emergency_sources_ & (to_underlying(EmergencySource::RES) |
+                                     to_underlying(EmergencySource::AS_CU))) != 0;
+  }
+
+  // Actions, run with interrupts masked: they drive outputs and leave logging to step()
+  static void enter_off(ASState &as) {
+    as._output_coordinator_->enter_off_state();
+    as._checkup_manager_.reset_checkup_state();
+  }
+  static void enter_manual(ASState &as) {
+    as._output_coordinator_->enter_manual_state();
+  }
+  static void enter_ready(ASState &as) {
+    as._output_coordinator_->enter_ready_state();
+  }
+  static void enter_driving(ASState &as) {
+    as._output_coordinator_->enter_driving_state();
+    as._checkup_manager_.reset_mission_finished();
+  }
+  static void enter_finished(ASState &as) { as._output_coordinator_->enter_finish_state(); }
+  static void enter_emergency(ASState &as) {
+    as._output_coordinator_->enter_emergency_state();
+    as._checkup_manager_._ebs_sound_timestamp_.reset();
+  }
+
+  // Run every tick in their state, before the guards
+  static void blink_driving_led(ASState &as) { as._output_coordinator_->blink_driving_led(); }
+  static void blink_emergency_led(ASState &as) { as._output_coordinator_->blink_emergency_led(); }
+
 public:
+  using Table = TransitionTable<ASState, State, NUM_STATES, 13>;
+
+  /**
+   * @brief Every transition of the AS state machine, grouped by source state, in priority order
+   *
+   * EMERGENCY_EVENT rows are taken from the software interrupt raised by EmergencyIrq (RES and
+   * AS CU frames, missed alive deadlines); the emergency LOOP rows catch what is only polled
+   * (hydraulic pressure, ASMS, TS, SDC).
+   */
+  static constexpr Table TRANSITIONS{
+      {{
+          {State::AS_MANUAL, Trigger::LOOP, leaves_manual, enter_off, State::AS_OFF},
+          {State::AS_OFF, Trigger::LOOP, stays_manual, enter_manual, State::AS_MANUAL},
+          {State::AS_OFF, Trigger::LOOP, checkup_passed, enter_ready, State::AS_READY},
+          {State::AS_READY, Trigger::EMERGENCY_EVENT, emergency_raised, enter_emergency,
+           State::AS_EMERGENCY},
+          {State::AS_READY, Trigger::LOOP, emergency_detected, enter_emergency,
+           State::AS_EMERGENCY},
+          {State::AS_READY, Trigger::LOOP, ready_to_drive, enter_driving, State::AS_DRIVING},
+          {State::AS_DRIVING, Trigger::EMERGENCY_EVENT, emergency_raised, enter_emergency,
+           State::AS_EMERGENCY},
+          {State::AS_DRIVING, Trigger::LOOP, emergency_detected, enter_emergency,
+           State::AS_EMERGENCY},
+          {State::AS_DRIVING, Trigger::LOOP, mission_finished, enter_finished, State::AS_FINISHED},
+          {State::AS_FINISHED, Trigger::EMERGENCY_EVENT, stop_requested, enter_emergency,
+           State::AS_EMERGENCY},
+          {State::AS_FINISHED, Trigger::LOOP, res_triggered, enter_emergency, State::AS_EMERGENCY},
+          {State::AS_FINISHED, Trigger::LOOP, asms_off, enter_off, State::AS_OFF},
+          {State::AS_EMERGENCY, Trigger::LOOP, emergency_sequence_complete, enter_off,
+           State::AS_OFF},
+      }},
+      {{nullptr, nullptr, nullptr, blink_driving_led, nullptr, blink_emergency_led}}};
+
   CheckupManager
       _checkup_manager_;        ///< CheckupManager object for handling various checkup operations.
   State state_{State::AS_OFF};  ///< Current state of the vehicle system, initialized to OFF.
@@ -46,103 +141,119 @@ public:
     instance = this;
   }
 
+  /**
+   * @brief Hooks the emergency software interrupt and starts the alive deadline checks.
+   */
+  void init();
+
   /**
    * @brief Calculates the state of the vehicle.
    */
   void calculate_state();
-  void timer_started() { timer_has_started = true; }
+
+  /**
+   * @brief Time from the last emergency event being raised to the SDC being opened, in us
+   */
+  [[nodiscard]] uint32_t emergency_latency_us() const { return emergency_latency_us_; }
+
+  /**
+   * @brief Transition counters and time in state histograms since boot
+   */
+  [[nodiscard]] const TransitionMetrics<NUM_STATES, Table::size()> &metrics() const {
+    return metrics_;
+  }
+
+private:
+  TransitionMetrics<NUM_STATES, Table::size()> metrics_;
+
+  /**
+   * @brief Takes the first transition out of the current state whose guard holds
+   * @return true if the state changed
+   */
+  bool step(Trigger trigger);
+
+  static void on_emergency_irq();
+
+  /**
+   * @brief Observes the component deadlines on every tick, so the TimeoutManager latch records a
+   * miss in any state; only a miss in AS_READY or AS_DRIVING raises the emergency
+   */
+  void check_deadlines();
+
+  /**
+   * @brief Sends one frame for every check of the initial checkup that passed or failed since
+   * the last call, and one for each hydraulic line fitted by the EBS test
+   */
+  void publish_checkup_reports();
 };
 
+static_assert(ASState::TRANSITIONS.grouped_by_source(),
+              "ASState::TRANSITIONS rows must be grouped by source state");
+
+inline void ASState::init() {
+  EmergencyIrq::begin(on_emergency_irq);
+  deadline_timer_.begin([] { instance->check_deadlines(); }, DEADLINE_CHECK_PERIOD_US);
+}
+
+inline void ASState::check_deadlines() {
+  const bool missed = _checkup_manager_.component_deadline_missed();
+  if (missed && (state_ == State::AS_READY || state_ == State::AS_DRIVING)) {
+    EmergencyIrq::raise(EmergencySource::COMPONENT_TIMEOUT);
+  }
+}
+
+inline void ASState::on_emergency_irq() {
+  const uint32_t raised_at_us = EmergencyIrq::raised_at_us();
+  instance->emergency_sources_ = EmergencyIrq::take_pending();
+  if (instance->step(Trigger::EMERGENCY_EVENT)) {
+    instance->emergency_latency_us_ = micros() - raised_at_us;
+  }
+  instance->emergency_sources_ = 0;
+}
+
+inline bool ASState::step(const Trigger trigger) {
+  const State from = state_;
+  const auto range = TRANSITIONS.range(from);
+  for (std::size_t i = range.begin; i < range.end; i++) {
+    const auto &transition = TRANSITIONS.row(i);
+    if (transition.trigger != trigger || !transition.guard(*this)) {
+      continue;
+    }
+    // The emergency interrupt may have moved on while the guard ran; actions must not undo it
+    noInterrupts();
+    if (state_ != from) {
+      interrupts();
+      return false;
+    }
+    transition.action(*this);
+    state_ = transition.to;
+    metrics_.record(i, to_underlying(from), millis());
+    interrupts();
+    if (trigger == Trigger::LOOP) {
+      LOG_INFO(LOG_STATE, "AS state %u -> %u", to_underlying(from), to_underlying(transition.to));
+    }
+    return true;
+  }
+  return false;
+}
+
+inline void ASState::publish_checkup_reports() {
+  auto &progress = _checkup_manager_.progress();
+  for (std::size_t check = progress.take_report(); check < CheckupManager::NUM_CHECKS;
+       check = progress.take_report()) {
+    Communicator::publish_checkup_report(static_cast<uint8_t>(check), progress.status(check),
+                                         progress.started_ms(check), progress.finished_ms(check));
+  }
+  for (const auto &report : _checkup_manager_.take_curve_reports()) {
+    Communicator::publish_ebs_curve(static_cast<uint8_t>(report.phase),
+                                    to_underlying(report.line), report.fit);
+  }
+}
+
 inline void ASState::calculate_state() {
-  switch (state_) {
-    case State::AS_MANUAL:
-      if (_checkup_manager_.should_stay_manual_driving()) {
-        break;
-      }
-
-      DEBUG_PRINT("Entering OFF state from MANUAL");
-      _output_coordinator_->enter_off_state();
-      _checkup_manager_.reset_checkup_state();
-      state_ = State::AS_OFF;
-      break;
-
-    case State::AS_OFF:
-
-      if (!timer_has_started) {
-        emergency_timer_.begin(
-            [] {
-              instance->timer_started();
-              if (instance->_checkup_manager_.should_enter_emergency(instance->state_)) {
-                instance->_output_coordinator_->enter_emergency_state();
-                instance->_checkup_manager_._ebs_sound_timestamp_.reset();
-                instance->state_ = State::AS_EMERGENCY;
-              }
-            },
-            50'000);
-      }
-      // If manual driving checkup fails, the car can't be in OFF state, so it goes back to MANUAL
-      if (_checkup_manager_.should_stay_manual_driving()) {
-        DEBUG_PRINT("Entering MANUAL state from OFF");
-        _output_coordinator_->enter_manual_state();
-        state_ = State::AS_MANUAL;
-        break;
-      }
-      _output_coordinator_->refresh_r2d_vars();
-      _output_coordinator_->refresh_emergency_vars();
-      if (_checkup_manager_.should_stay_off()) break;
-
-      DEBUG_PRINT("Entering READY state from OFF");
-      _output_coordinator_->enter_ready_state();
-      state_ = State::AS_READY;
-      DEBUG_PRINT("READY state entered...");
-      break;
-
-    case State::AS_READY:
-
-      if (_checkup_manager_.should_stay_ready()) {
-        break;
-      }
-      _output_coordinator_->enter_driving_state();
-      _checkup_manager_.reset_mission_finished();
-      state_ = State::AS_DRIVING;
-      break;
-
-    case State::AS_DRIVING:
-      _output_coordinator_->blink_driving_led();
-      if (_checkup_manager_.should_stay_driving()) break;
-      _output_coordinator_->enter_finish_state();
-      state_ = State::AS_FINISHED;
-      break;
-
-    case State::AS_FINISHED:
-      if (_checkup_manager_.res_triggered()) {
-        DEBUG_PRINT("Entering EMERGENCY state from FINISHED");
-
-        _output_coordinator_->enter_emergency_state();
-        _checkup_manager_._ebs_sound_timestamp_.reset();
-        state_ = State::AS_EMERGENCY;
-        break;
-      }
-      if (_checkup_manager_.should_stay_mission_finished()) break;
-
-      DEBUG_PRINT("Entering OFF state from FINISHED");
-      _output_coordinator_->enter_off_state();
-      _checkup_manager_.reset_checkup_state();
-      state_ = State::AS_OFF;
-      break;
-
-    case State::AS_EMERGENCY:
-      _output_coordinator_->blink_emergency_led();
-
-      if (_checkup_manager_.emergency_sequence_complete()) {
-        DEBUG_PRINT("Entering OFF state from EMERGENCY");
-        _output_coordinator_->enter_off_state();
-        _checkup_manager_.reset_checkup_state();
-        state_ = State::AS_OFF;
-        break;
-      }
-      break;
-    default:
-      break;
+  if (const auto on_tick = TRANSITIONS.on_tick(state_)) {
+    on_tick(*this);
   }
+  step(Trigger::LOOP);
+  publish_checkup_reports();
 }
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "enum_utils.hpp"
+
+/**
+ * @brief What makes a transition's guard be evaluated
+ */
+enum class Trigger : uint8_t {
+  LOOP,             ///< Every calculate_state() call
+  EMERGENCY_EVENT,  ///< The emergency software interrupt (see EmergencyIrq)
+};
+
+/**
+ * @brief One row of a state machine: when in `from` and `guard` holds, run `action` and go to `to`
+ *
+ * Guards are allowed to have side effects (e.g. advancing the checkup sequence), they run in
+ * table order and the first one that holds wins.
+ */
+template <typename Context, typename StateEnum>
+struct Transition {
+  StateEnum from;
+  Trigger trigger;
+  bool (*guard)(Context &);
+  void (*action)(Context &);
+  StateEnum to;
+};
+
+/**
+ * @brief Transition rows grouped by source state, with the per state ranges computed at compile
+ * time so that a tick only walks the guards of the current state
+ */
+template <typename Context, typename StateEnum, std::size_t NumStates, std::size_t NumTransitions>
+class TransitionTable {
+public:
+  using Row = Transition<Context, StateEnum>;
+
+  struct Range {
+    uint8_t begin = 0;
+    uint8_t end = 0;
+  };
+
+  constexpr TransitionTable(const std::array<Row, NumTransitions> &rows,
+                            const std::array<void (*)(Context &), NumStates> &on_tick)
+      : rows_(rows), on_tick_(on_tick) {
+    static_assert(NumTransitions < UINT8_MAX, "transition index must fit in uint8_t");
+    for (std::size_t i = 0; i < NumTransitions; i++) {
+      const auto state = static_cast<std::size_t>(to_underlying(rows[i].from));
+      if (i == 0 || rows[i - 1].from != rows[i].from) {
+        ranges_[state].begin = static_cast<uint8_t>(i);
+      }
+      ranges_[state].end = static_cast<uint8_t>(i + 1);
+    }
+  }
+
+  /**
+   * @brief True when the rows of each source state are contiguous, required by the range index
+   */
+  [[nodiscard]] constexpr bool grouped_by_source() const {
+    for (std::size_t i = 0; i < NumTransitions; i++) {
+      for (std::size_t j = i + 2; j < NumTransitions; j++) {
+        if (rows_[i].from == rows_[j].from && rows_[j - 1].from != rows_[i].from) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] constexpr const Row &row(std::size_t index) const { return rows_[index]; }
+  [[nodiscard]] constexpr Range range(StateEnum state) const {
+    return ranges_[static_cast<std::size_t>(to_underlying(state))];
+  }
+  [[nodiscard]] constexpr auto on_tick(StateEnum state) const {
+    return on_tick_[static_cast<std::size_t>(to_underlying(state))];
+  }
+  static constexpr std::size_t size() { return NumTransitions; }
+
+private:
+  std::array<Row, NumTransitions> rows_;
+  std::array<void (*)(Context &), NumStates> on_tick_;
+  std::array<Range, NumStates> ranges_{};
+};
+
+/**
+ * @brief Per transition counters and time in state histograms
+ *
+ * Histogram bucket 0 counts stays under 1 ms, bucket k (k >= 1) counts stays in [2^(k-1), 2^k) ms,
+ * the last bucket also takes everything longer (2^(NUM_BUCKETS-2) ms is about 16 s).
+ */
+template <std::size_t NumStates, std::size_t NumTransitions>
+class TransitionMetrics {
+public:
+  static constexpr std::size_t NUM_BUCKETS = 16;
+
+  void record(std::size_t transition, std::size_t from, uint32_t now_ms) {
+    transition_count_[transition]++;
+    const uint32_t dwell_ms = now_ms - entered_at_ms_;
+    const std::size_t bucket = std::bit_width(dwell_ms);
+    time_in_state_[from][bucket < NUM_BUCKETS ? bucket : NUM_BUCKETS - 1]++;
+    entered_at_ms_ = now_ms;
+  }
+
+  [[nodiscard]] uint32_t transition_count(std::size_t transition) const {
+    return transition_count_[transition];
+  }
+  [[nodiscard]] const std::array<uint32_t, NUM_BUCKETS> &time_in_state(std::size_t state) const {
+    return time_in_state_[state];
+  }
+  [[nodiscard]] uint32_t time_in_current_state_ms(uint32_t now_ms) const {
+    return now_ms - entered_at_ms_;
+  }
+
+private:
+  std::array<uint32_t, NumTransitions> transition_count_{};
+  std::array<std::array<uint32_t, NUM_BUCKETS>, NumStates> time_in_state_{};
+  uint32_t entered_at_ms_ = 0;
+};
@@ -14,7 +14,9 @@ struct HardwareData {
   bool master_sdc_closed_ = false;
   bool wd_ready_ = false;
   int hydraulic_line_front_pressure = 0;
+  uint32_t hydraulic_line_front_received_us = 0;  // micros() of the last front pressure frame
   int _hydraulic_line_pressure = 0;
+  int hydraulic_line_raw_pressure = 0;  // last rear sample, without the moving average
   uint8_t soc_ = 0;
   double _right_wheel_rpm = 0;
   double _left_wheel_rpm = 0;
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Streaming inter-arrival statistics of one heartbeat, in O(1) memory
+ *
+ * Mean and variance use Welford's update. The p99 comes from NUM_BUCKETS equal buckets spanning
+ * the timeout (the last one also takes anything slower), so its resolution is timeout / 32. An
+ * interval longer than NEAR_MISS_PERCENT of the timeout is counted as a near miss: the node was
+ * late but not yet dead.
+ */
+class HeartbeatStats {
+public:
+  static constexpr std::size_t NUM_BUCKETS = 32;
+  static constexpr uint32_t NEAR_MISS_PERCENT = 80;
+
+  HeartbeatStats() = default;
+  explicit HeartbeatStats(uint32_t timeout_us)
+      : bucket_width_us_(std::max<uint32_t>(timeout_us / NUM_BUCKETS, 1)),
+        near_miss_us_(timeout_us / 100 * NEAR_MISS_PERCENT) {}
+
+  /**
+   * @brief Records an arrival at now_us; intervals start from the second arrival
+   */
+  void record(uint32_t now_us) {
+    if (arrivals_ > 0) {
+      add_interval(now_us - last_seen_us_);
+    }
+    last_seen_us_ = now_us;
+    arrivals_++;
+  }
+
+  [[nodiscard]] uint32_t last_seen_us() const { return last_seen_us_; }
+  [[nodiscard]] uint32_t arrivals() const { return arrivals_; }
+  [[nodiscard]] uint32_t intervals() const { return intervals_; }
+  [[nodiscard]] uint32_t near_misses() const { return near_misses_; }
+  [[nodiscard]] uint32_t min_interval_us() const { return intervals_ > 0 ? min_us_ : 0; }
+  [[nodiscard]] uint32_t max_interval_us() const { return max_us_; }
+  [[nodiscard]] uint32_t mean_interval_us() const { return static_cast<uint32_t>(mean_us_); }
+  [[nodiscard]] float variance_us2() const {
+    return intervals_ > 1 ? m2_us2_ / static_cast<float>(intervals_ - 1) : 0.0F;
+  }
+
+  /**
+   * @brief Upper edge of the bucket holding the 99th percentile interval, capped by the maximum
+   */
+  [[nodiscard]] uint32_t p99_interval_us() const {
+    uint32_t total = 0;
+    for (const uint16_t count : histogram_) {
+      total += count;
+    }
+    const uint32_t rank = total - total / 100;  // ceil(0.99 * total)
+    uint32_t seen = 0;
+    for (std::size_t i = 0; i < NUM_BUCKETS; i++) {
+      seen += histogram_[i];
+      if (seen >= rank && seen > 0) {
+        return i + 1 < NUM_BUCKETS ? std::min<uint32_t>((i + 1) * bucket_width_us_, max_us_)
+                                   : max_us_;
+      }
+    }
+    return 0;
+  }
+
+private:
+  void add_interval(uint32_t interval_us) {
+    intervals_++;
+    const auto x = static_cast<float>(interval_us);
+    const float delta = x - mean_us_;
+    mean_us_ += delta / static_cast<float>(intervals_);
+    m2_us2_ += delta * (x - mean_us_);
+    min_us_ = std::min(min_us_, interval_us);
+    max_us_ = std::max(max_us_, interval_us);
+    if (interval_us > near_miss_us_) {
+      near_misses_++;
+    }
+    const std::size_t bucket =
+        std::min<std::size_t>(interval_us / bucket_width_us_, NUM_BUCKETS - 1);
+    if (histogram_[bucket] == UINT16_MAX) {
+      // Halve everything rather than saturate, so the shape (and the p99) stays right
+      for (uint16_t &count : histogram_) {
+        count /= 2;
+      }
+    }
+    histogram_[bucket]++;
+  }
+
+  uint32_t bucket_width_us_ = 1;
+  uint32_t near_miss_us_ = UINT32_MAX;
+  uint32_t last_seen_us_ = 0;
+  uint32_t arrivals_ = 0;
+  uint32_t intervals_ = 0;
+  uint32_t near_misses_ = 0;
+  uint32_t min_us_ = UINT32_MAX;
+  uint32_t max_us_ = 0;
+  float mean_us_ = 0.0F;
+  float m2_us2_ = 0.0F;
+  std::array<uint16_t, NUM_BUCKETS> histogram_{};
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * @brief Step response of a hydraulic line, fitted from its PressureCurve
+ *
+ * Times are in ms from the valve switch that started the curve.
+ */
+struct StepFit {
+  int16_t start_adc = 0;
+  int16_t final_adc = 0;
+  uint16_t t10_90_ms = 0;  ///< 10 % to 90 % of the step, rise or decay time
+  uint16_t tau_ms = 0;     ///< 63 % of the step, the time constant of a first order line
+  uint16_t settle_ms = 0;  ///< Entered the band it settled in
+};
+
+/**
+ * @brief Pressure of one hydraulic line sampled after a valve switch, until it settles
+ *
+ * The line is settled once every sample for settle_window_us stayed within settle_band_adc of
+ * the first of them. Samples are kept for the fit in a fixed buffer: when it fills up every other
+ * sample is dropped and the minimum spacing doubles, so a slow line still covers the whole phase
+ * with CAPACITY points.
+ */
+class PressureCurve {
+public:
+  static constexpr std::size_t CAPACITY = 128;
+
+  constexpr PressureCurve(const int settle_band_adc, const uint32_t settle_window_us)
+      : settle_band_adc_(settle_band_adc), settle_window_us_(settle_window_us) {}
+
+  /**
+   * @brief Starts a new curve at the valve switch, from the line's last reading
+   */
+  void start(const int adc, const uint32_t now_us) {
+    origin_us_ = now_us;
+    count_ = 0;
+    spacing_us_ = 0;
+    anchor_adc_ = adc;
+    anchor_us_ = now_us;
+    settled_ = false;
+    store(adc, 0);
+    last_adc_ = adc;
+  }
+
+  void add(const int adc, const uint32_t now_us) {
+    if (count_ == 0) {
+      start(adc, now_us);
+      return;
+    }
+    if (std::abs(adc - anchor_adc_) > settle_band_adc_) {
+      anchor_adc_ = adc;
+      anchor_us_ = now_us;
+    }
+    settled_ = now_us - anchor_us_ >= settle_window_us_;
+    last_adc_ = adc;
+
+    const uint32_t elapsed_us = now_us - origin_us_;
+    if (elapsed_us - samples_[count_ - 1].elapsed_us < spacing_us_) {
+      return;
+    }
+    if (count_ == CAPACITY) {
+      for (std::size_t i = 1; i < CAPACITY / 2; i++) {
+        samples_[i] = samples_[2 * i];
+      }
+      count_ = CAPACITY / 2;
+      spacing_us_ = samples_[1].elapsed_us - samples_[0].elapsed_us;
+    }
+    store(adc, elapsed_us);
+  }
+
+  [[nodiscard]] bool settled() const { return settled_; }
+  [[nodiscard]] int level() const { return last_adc_; }
+  [[nodiscard]] std::size_t size() const { return count_; }
+
+  /**
+   * @brief Rise or decay of the line from its first sample to its current level, crossings
+   * interpolated between samples; only the levels are set if the line moved less than the band
+   */
+  [[nodiscard]] StepFit fit() const {
+    StepFit fit;
+    const int start = samples_[0].adc;
+    fit.start_adc = static_cast<int16_t>(start);
+    fit.final_adc = static_cast<int16_t>(last_adc_);
+    fit.settle_ms = to_ms(anchor_us_ - origin_us_);
+    if (std::abs(last_adc_ - start) <= settle_band_adc_) {
+      return fit;
+    }
+    const uint32_t t10_us = crossing_us(10);
+    fit.t10_90_ms = to_ms(crossing_us(90) - t10_us);
+    fit.tau_ms = to_ms(crossing_us(63));
+    return fit;
+  }
+
+private:
+  struct Sample {
+    uint32_t elapsed_us;
+    int16_t adc;
+  };
+
+  void store(const int adc, const uint32_t elapsed_us) {
+    samples_[count_++] = {elapsed_us, static_cast<int16_t>(adc)};
+  }
+
+  static uint16_t to_ms(const uint32_t us) {
+    return static_cast<uint16_t>(std::min<uint32_t>(us / 1000, UINT16_MAX));
+  }
+
+  /**
+   * @brief First time the line covered percent of its step
+   */
+  [[nodiscard]] uint32_t crossing_us(const int percent) const {
+    const float start = samples_[0].adc;
+    const float target =
+        start + static_cast<float>((last_adc_ - samples_[0].adc) * percent) / 100.0f;
+    const bool rising = last_adc_ > samples_[0].adc;
+    for (std::size_t i = 1; i < count_; i++) {
+      const Sample &sample = samples_[i];
+      if (rising ? sample.adc < target : sample.adc > target) {
+        continue;
+      }
+      const Sample &before = samples_[i - 1];
+      const float fraction = (target - before.adc) / static_cast<float>(sample.adc - before.adc);
+      return before.elapsed_us +
+             static_cast<uint32_t>(fraction *
+                                   static_cast<float>(sample.elapsed_us - before.elapsed_us));
+    }
+    return samples_[count_ - 1].elapsed_us;
+  }
+
+  int settle_band_adc_;
+  uint32_t settle_window_us_;
+  std::array<Sample, CAPACITY> samples_{};
+  std::size_t count_ = 0;
+  uint32_t spacing_us_ = 0;  ///< Minimum time between two stored samples
+  uint32_t origin_us_ = 0;
+  int anchor_adc_ = 0;       ///< First sample of the current settling window
+  uint32_t anchor_us_ = 0;
+  int last_adc_ = 0;
+  bool settled_ = false;
+};
@@ -9,11 +9,11 @@
  * holds all the data necessary
  */
 struct SystemData {
-  NonUnitaryFailureDetection updatable_timestamps_;
-  NonUnitaryFailureDetection updated_timestamps_;
+  ComponentTimeouts component_timeouts_ = make_component_timeouts();
+  DcVoltageTimeouts dc_voltage_timeouts_ = make_dc_voltage_timeouts();
 
   R2DLogics r2d_logics_;
-  FailureDetection failure_detection_{updated_timestamps_};
+  FailureDetection failure_detection_{component_timeouts_};
 
   HardwareData hardware_data_;
   Mission mission_{Mission::MANUAL};
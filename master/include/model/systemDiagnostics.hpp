@@ -2,10 +2,11 @@
 
 #include <cstdlib>
 
+#include "../../debugUtils.hpp"
 #include "Arduino.h"
-#include "debugUtils.hpp"
 #include "embedded/hardwareSettings.hpp"
 #include "metro.h"
+#include "model/timeoutManager.hpp"
 
 struct R2DLogics {
   Metro readyTimestamp{READY_TIMEOUT_MS};
@@ -51,31 +52,24 @@ struct R2DLogics {
   }
 };
 
-struct NonUnitaryFailureDetection {
-  VolatileMetro pc_alive_timestamp_{COMPONENT_TIMESTAMP_TIMEOUT};
-  VolatileMetro steer_alive_timestamp_{COMPONENT_TIMESTAMP_TIMEOUT};
-  VolatileMetro inversor_alive_timestamp_{COMPONENT_TIMESTAMP_TIMEOUT};
-  VolatileMetro bms_alive_timestamp_{COMPONENT_TIMESTAMP_TIMEOUT};
-  VolatileMetro res_signal_loss_timestamp_{RES_TIMESTAMP_TIMEOUT};
-  VolatileMetro dc_voltage_drop_timestamp_{
-      DC_VOLTAGE_TIMEOUT};  // timer to check if dc voltage drops below
-                            // threshold for more than 150ms
-  VolatileMetro dc_voltage_hold_timestamp_{
-      DC_VOLTAGE_HOLD};  // timer for ts on, only after enough voltage for 1 sec
-
-  NonUnitaryFailureDetection& operator=(const NonUnitaryFailureDetection& other) {
-    if (this != &other) {
-      pc_alive_timestamp_ = other.pc_alive_timestamp_;
-      steer_alive_timestamp_ = other.steer_alive_timestamp_;
-      inversor_alive_timestamp_ = other.inversor_alive_timestamp_;
-      res_signal_loss_timestamp_ = other.res_signal_loss_timestamp_;
-      dc_voltage_drop_timestamp_ = other.dc_voltage_drop_timestamp_;
-      dc_voltage_hold_timestamp_ = other.dc_voltage_hold_timestamp_;
-      bms_alive_timestamp_ = other.bms_alive_timestamp_;
-    }
-    return *this;
-  }
-};
+using ComponentTimeouts = TimeoutManager<Component, 5>;
+using DcVoltageTimeouts = TimeoutManager<DcVoltageTimer, 2>;
+
+/**
+ * @brief Alive deadlines, kicked by the CAN callbacks
+ */
+inline ComponentTimeouts make_component_timeouts() {
+  return ComponentTimeouts({COMPONENT_TIMESTAMP_TIMEOUT, COMPONENT_TIMESTAMP_TIMEOUT,
+                            COMPONENT_TIMESTAMP_TIMEOUT, COMPONENT_TIMESTAMP_TIMEOUT,
+                            RES_TIMESTAMP_TIMEOUT});
+}
+
+/**
+ * @brief DC voltage drop (150 ms below threshold) and hold (1 s above threshold) timers
+ */
+inline DcVoltageTimeouts make_dc_voltage_timeouts() {
+  return DcVoltageTimeouts({DC_VOLTAGE_TIMEOUT, DC_VOLTAGE_HOLD});
+}
 
 struct FailureDetection {
   bool steer_dead_{false};
@@ -89,35 +83,28 @@ struct FailureDetection {
   volatile double radio_quality_{0};
   volatile unsigned dc_voltage_{0};
 
-  // Reference to the timestamp struct
-  NonUnitaryFailureDetection& timestamps_;
+  // Reference to the alive deadlines
+  const ComponentTimeouts& timeouts_;
 
   // init ref
-  FailureDetection(NonUnitaryFailureDetection& timestamps) : timestamps_(timestamps) {}
+  FailureDetection(const ComponentTimeouts& timeouts) : timeouts_(timeouts) {}
 
   [[nodiscard]] bool has_any_component_timed_out() {
-    steer_dead_ = timestamps_.steer_alive_timestamp_.checkWithoutReset();
-    pc_dead_ = timestamps_.pc_alive_timestamp_.checkWithoutReset();
-    inversor_dead_ = timestamps_.inversor_alive_timestamp_.checkWithoutReset();
-    res_dead_ = timestamps_.res_signal_loss_timestamp_.checkWithoutReset();
-    bms_dead_ = timestamps_.bms_alive_timestamp_.checkWithoutReset();
-
-    if (steer_dead_ || pc_dead_ || inversor_dead_ || res_dead_ || bms_dead_) {
-      DEBUG_PRINT("=== System Component Status Check ===");
-    }
-    if (steer_dead_) {
-      DEBUG_PRINT("Steering System: " + String(steer_dead_ ? "DEAD" : "ALIVE"));
+    if (!timeouts_.any_expired()) {
+      steer_dead_ = pc_dead_ = inversor_dead_ = res_dead_ = bms_dead_ = false;
+      return false;
     }
-    if (pc_dead_) {
-      DEBUG_PRINT("PC Connection: " + String(pc_dead_ ? "DEAD" : "ALIVE"));
+    steer_dead_ = timeouts_.expired(Component::STEERING);
+    pc_dead_ = timeouts_.expired(Component::PC);
+    inversor_dead_ = timeouts_.expired(Component::INVERTER);
+    res_dead_ = timeouts_.expired(Component::RES);
+    bms_dead_ = timeouts_.expired(Component::BMS);
+
+    const bool any_dead = steer_dead_ || pc_dead_ || inversor_dead_ || res_dead_ || bms_dead_;
+    if (any_dead) {
+      LOG_WARN(LOG_CAN, "Timed out: steering %u, PC %u, inverter %u, RES %u", steer_dead_,
+               pc_dead_, inversor_dead_, res_dead_);
     }
-    if (inversor_dead_) {
-      DEBUG_PRINT("Inverter Status: " + String(inversor_dead_ ? "DEAD" : "ALIVE"));
-    }
-    if (res_dead_) {
-      DEBUG_PRINT("RES Signal: " + String(res_dead_ ? "DEAD" : "ALIVE"));
-    }
-
-    return steer_dead_ || pc_dead_ || inversor_dead_ || res_dead_ || bms_dead_;
+    return any_dead;
   }
 };
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "enum_utils.hpp"
+#include "model/heartbeatStats.hpp"
+
+/**
+ * @brief Components whose alive signal has a deadline; any of them missing it is an emergency
+ */
+enum class Component : uint8_t { PC, STEERING, INVERTER, BMS, RES };
+
+/**
+ * @brief Hysteresis timers on the inverter DC voltage
+ */
+enum class DcVoltageTimer : uint8_t {
+  DROP,  ///< Pushed while above threshold, expires after DC_VOLTAGE_TIMEOUT below it
+  HOLD,  ///< Pushed while below threshold, expires after DC_VOLTAGE_HOLD above it
+};
+
+/**
+ * @brief Deadlines keyed by component in an indexed binary min-heap
+ *
+ * kick() stores the kick time of one key and restores the heap in O(log N); it is meant for the
+ * CAN receive interrupt. The heap is ordered on the time each key has left, timeout minus the
+ * micros() elapsed since its kick, so any_expired() only checks the key on top, which is kept in a
+ * single volatile byte for the loop and timer interrupts. Elapsed time is unsigned like Metro, so
+ * it is wrap safe up to ~71 minutes of silence; a key seen expired is latched until its next kick
+ * so a longer silence does not read as alive again. Every kick also feeds the key's
+ * HeartbeatStats.
+ */
+template <typename Key, std::size_t N>
+class TimeoutManager {
+public:
+  explicit TimeoutManager(const std::array<uint32_t, N> &timeouts_ms) {
+    const uint32_t now_us = micros();
+    for (std::size_t i = 0; i < N; i++) {
+      timeout_us_[i] = timeouts_ms[i] * 1000;
+      kicked_us_[i] = now_us;
+      heap_[i] = static_cast<uint8_t>(i);
+      stats_[i] = HeartbeatStats(timeout_us_[i]);
+      position_[i] = static_cast<uint8_t>(i);
+    }
+    for (std::size_t i = N / 2; i-- > 0;) {
+      sift_down(i, now_us);
+    }
+    earliest_ = heap_[0];
+  }
+
+  /**
+   * @brief Records a sign of life from key and restarts its timeout
+   */
+  void kick(Key key) {
+    const uint32_t now_us = micros();
+    const auto index = static_cast<std::size_t>(to_underlying(key));
+    stats_[index].record(now_us);
+    kicked_us_[index] = now_us;
+    kicks_[index] = kicks_[index] + 1;  // drops any latch on the previous kick
+    sift_down(position_[index], now_us);
+    sift_up(position_[index], now_us);
+    earliest_ = heap_[0];
+  }
+
+  [[nodiscard]] bool any_expired() const { return expired_index(earliest_); }
+
+  [[nodiscard]] bool expired(Key key) const {
+    return expired_index(static_cast<std::size_t>(to_underlying(key)));
+  }
+
+  /**
+   * @brief The component that will (or did) miss its deadline first
+   */
+  [[nodiscard]] Key earliest() const { return static_cast<Key>(heap_[0]); }
+
+  static constexpr std::size_t size() { return N; }
+
+  [[nodiscard]] const HeartbeatStats &stats(Key key) const {
+    return stats_[static_cast<std::size_t>(to_underlying(key))];
+  }
+
+private:
+  bool latched(std::size_t index) const { return latched_kick_[index] == kicks_[index] + 1; }
+  bool expired_index(std::size_t index) const {
+    // the kick count is read first, a kick landing after it leaves a latch that never matches
+    const uint32_t kicks = kicks_[index];
+    if (latched(index)) {
+      return true;
+    }
+    if (micros() - kicked_us_[index] < timeout_us_[index]) {
+      return false;
+    }
+    latched_kick_[index] = kicks + 1;
+    return true;
+  }
+  int64_t remaining_us(std::size_t index, uint32_t now_us) const {
+    if (latched(index)) {
+      return INT64_MIN;
+    }
+    return static_cast<int64_t>(timeout_us_[index]) -
+           static_cast<int64_t>(now_us - kicked_us_[index]);
+  }
+  bool earlier(std::size_t a, std::size_t b, uint32_t now_us) const {
+    return remaining_us(heap_[a], now_us) < remaining_us(heap_[b], now_us);
+  }
+  void swap_nodes(std::size_t a, std::size_t b) {
+    const uint8_t key = heap_[a];
+    heap_[a] = heap_[b];
+    heap_[b] = key;
+    position_[heap_[a]] = static_cast<uint8_t>(a);
+    position_[heap_[b]] = static_cast<uint8_t>(b);
+  }
+  void sift_up(std::size_t i, uint32_t now_us) {
+    while (i > 0 && earlier(i, (i - 1) / 2, now_us)) {
+      swap_nodes(i, (i - 1) / 2);
+      i = (i - 1) / 2;
+    }
+  }
+  void sift_down(std::size_t i, uint32_t now_us) {
+    while (true) {
+      std::size_t smallest = i;
+      for (const std::size_t child : {2 * i + 1, 2 * i + 2}) {
+        if (child < N && earlier(child, smallest, now_us)) {
+          smallest = child;
+        }
+      }
+      if (smallest == i) {
+        return;
+      }
+      swap_nodes(i, smallest);
+      i = smallest;
+    }
+  }
+
+  std::array<uint32_t, N> timeout_us_{};
+  std::array<volatile uint32_t, N> kicked_us_{};
+  std::array<volatile uint32_t, N> kicks_{};
+  mutable std::array<volatile uint32_t, N> latched_kick_{};  ///< kicks_ + 1 of an expired kick
+  std::array<uint8_t, N> heap_{};      ///< heap_[0] has the least time left
+  std::array<uint8_t, N> position_{};  ///< position_[key] = index of key in heap_
+  std::array<HeartbeatStats, N> stats_{};
+  volatile uint8_t earliest_ = 0;  ///< heap_[0], for readers outside the kicking interrupt
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Lock-free single producer, single consumer queue
+ * @details Safe between one interrupt (or the main loop) pushing and the main loop popping,
+ * without disabling interrupts. Capacity must be a power of two; one slot is never wasted
+ * because head and tail are free-running counters.
+ */
+template <typename T, std::size_t N>
+class SpscQueue {
+  static_assert(N != 0 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+  /**
+   * @brief Enqueues a copy of item
+   * @return false if the queue is full and the item was discarded
+   */
+  bool push(const T& item) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == N) {
+      return false;
+    }
+    buffer_[head & (N - 1)] = item;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Dequeues the oldest item into out
+   * @return false if the queue was empty
+   */
+  bool pop(T& out) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_.load(std::memory_order_acquire) == tail) {
+      return false;
+    }
+    out = buffer_[tail & (N - 1)];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  [[nodiscard]] std::size_t size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  static constexpr std::size_t capacity() { return N; }
+
+private:
+  std::array<T, N> buffer_{};
+  std::atomic<std::size_t> head_{0};
+  std::atomic<std::size_t> tail_{0};
+};
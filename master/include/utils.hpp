@@ -52,28 +52,3 @@ void rpm_2_byte(const float rr_rpm, /* const */ char* rr_rpm_byte) {
 
   return;
 }
-
-/**
- * @brief debounce function to avoid sporadic changes (and repeating the code everywhere)
- *
- * @param new_value The newly read value
- * @param stored_value Reference to the stored value that will be updated
- * @param counter Reference to the counter for this specific input
- * @param counter_limit Number of consecutive different readings before accepting change
- */
-void debounce(const bool new_value, bool& stored_value, unsigned int& counter,
-              const unsigned int counter_limit) {
-  if (new_value == stored_value) {
-    counter = 0;
-  } else {
-    counter++;
-    if (counter >= counter_limit) {
-      stored_value = new_value;
-      counter = 0;
-    }
-  }
-}
-
-void debounce(const bool new_value, bool& stored_value, unsigned int& counter) {
-  debounce(new_value, stored_value, counter, 50);
-}
\ No newline at end of file
@@ -1,7 +1,8 @@
+#include "../../debugUtils.hpp"
 #include "comm/communicator.hpp"
-#include "debugUtils.hpp"
 #include "embedded/digitalReceiver.hpp"
 #include "embedded/digitalSender.hpp"
+#include "embedded/sdLogger.hpp"
 #include "enum_utils.hpp"
 #include "logic/outputCoordinator.hpp"
 #include "logic/stateLogic.hpp"
@@ -15,6 +16,7 @@ DigitalSender digital_sender = DigitalSender();
 OutputCoordinator output_coordinator =
     OutputCoordinator(&system_data, &communicator, &digital_sender);
 ASState as_state = ASState(&system_data, &communicator, &output_coordinator);
+SdLogger sd_logger = SdLogger(&system_data);
 TeensyTimerTool::PeriodicTimer watchdog_timer_;
 bool is_first_loop = true;
 void setup() {
@@ -22,15 +24,14 @@ void setup() {
   Communicator::_systemData = &system_data;
   communicator.init();
   output_coordinator.init();
-  DEBUG_PRINT("Starting up...");
+  as_state.init();
+  sd_logger.begin();
+  DEBUG_PRINTLN("Starting up...");
   delay(100);
 }
 
 void loop() {
   digital_receiver.digital_reads();
-  noInterrupts();
-  system_data.updated_timestamps_ = system_data.updatable_timestamps_;
-  interrupts();
 
   as_state.calculate_state();
   uint8_t current_master_state = to_underlying(as_state.state_);
@@ -38,6 +39,9 @@ void loop() {
   uint8_t ebs_state = to_underlying(as_state._checkup_manager_.pressure_test_phase_);
 
   output_coordinator.process(current_master_state, current_checkup_state, ebs_state);
+  sd_logger.set_state(current_master_state, current_checkup_state, ebs_state);
+  sd_logger.service();
 
+  DEBUG_LOG_FLUSH();
   delay(LOOP_DELAY);
 }
\ No newline at end of file
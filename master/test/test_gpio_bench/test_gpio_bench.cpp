@@ -0,0 +1,80 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include "embedded/pinMap.hpp"
+
+/**
+ * @brief Cost of sampling the digital inputs once, the way DigitalReceiver::digital_reads() does,
+ * with digitalRead() per pin (before) and with the port snapshot (after)
+ *
+ * Run on the car's Teensy 4.1 (pio test -e teensy41 -f test_gpio_bench); cycles are from the DWT
+ * cycle counter, the results are printed and the snapshot is required to be cheaper.
+ */
+namespace {
+
+constexpr uint32_t ITERATIONS = 10'000;
+
+volatile uint32_t sink = 0;  // keeps the reads from being optimised away
+
+uint32_t digital_read_cycles() {
+  const uint32_t start = ARM_DWT_CYCCNT;
+  for (uint32_t i = 0; i < ITERATIONS; i++) {
+    uint32_t bits = 0;
+    for (std::size_t pin = 0; pin < DIGITAL_INPUT_PINS.size(); pin++) {
+      bits |= static_cast<uint32_t>(digitalRead(DIGITAL_INPUT_PINS[pin])) << pin;
+    }
+    sink = bits;
+  }
+  return (ARM_DWT_CYCCNT - start) / ITERATIONS;
+}
+
+uint32_t snapshot_cycles() {
+  InputSnapshot inputs;
+  const uint32_t start = ARM_DWT_CYCCNT;
+  for (uint32_t i = 0; i < ITERATIONS; i++) {
+    inputs.sample();
+    uint32_t bits = 0;
+    for (std::size_t input = 0; input < InputSnapshot::NUM_INPUTS; input++) {
+      bits |= static_cast<uint32_t>(inputs[static_cast<DigitalInput>(input)]) << input;
+    }
+    sink = bits;
+  }
+  return (ARM_DWT_CYCCNT - start) / ITERATIONS;
+}
+
+}  // namespace
+
+void test_snapshot_is_cheaper_than_digital_read() {
+  const uint32_t before = digital_read_cycles();
+  const uint32_t after = snapshot_cycles();
+  char message[96];
+  snprintf(message, sizeof(message), "%u inputs: digitalRead %lu cycles, snapshot %lu cycles",
+           static_cast<unsigned>(DIGITAL_INPUT_PINS.size()), static_cast<unsigned long>(before),
+           static_cast<unsigned long>(after));
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN_UINT32(before, after);
+}
+
+void test_snapshot_agrees_with_digital_read() {
+  InputSnapshot inputs;
+  inputs.sample();
+  for (std::size_t input = 0; input < InputSnapshot::NUM_INPUTS; input++) {
+    TEST_ASSERT_EQUAL(digitalRead(DIGITAL_INPUT_PINS[input]) == HIGH,
+                      inputs[static_cast<DigitalInput>(input)]);
+  }
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+int main() {
+  delay(2000);  // wait for the serial monitor
+  for (const uint8_t pin : DIGITAL_INPUT_PINS) {
+    pinMode(pin, INPUT);
+  }
+  UNITY_BEGIN();
+  RUN_TEST(test_snapshot_agrees_with_digital_read);
+  RUN_TEST(test_snapshot_is_cheaper_than_digital_read);
+  return UNITY_END();
+}
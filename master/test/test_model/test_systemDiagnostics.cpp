@@ -2,7 +2,8 @@
 #include "unity.h"
 
 void test_hasAnyComponentTimedOut(void) {
-  FailureDetection fd;
+  const ComponentTimeouts timeouts = make_component_timeouts();
+  FailureDetection fd{timeouts};
   TEST_ASSERT_FALSE(fd.has_any_component_timed_out());
   delay(COMPONENT_TIMESTAMP_TIMEOUT + 1);
   TEST_ASSERT_TRUE(fd.has_any_component_timed_out());
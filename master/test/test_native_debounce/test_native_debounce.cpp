@@ -0,0 +1,161 @@
+#include <unity.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+#include "../../inputConditioning.hpp"
+
+namespace {
+
+/**
+ * @brief One channel debounced the obvious way, the reference for the vertical counters
+ */
+struct ScalarDebouncer {
+  uint32_t stable_us;
+  bool state = false;
+  bool pending = false;
+  uint32_t since_us = 0;
+
+  void update(bool sample, uint32_t now_us) {
+    if (sample == state) {
+      pending = false;
+      return;
+    }
+    if (!pending) {
+      pending = true;
+      since_us = now_us;
+    }
+    if (now_us - since_us >= stable_us) {
+      state = sample;
+      pending = false;
+    }
+  }
+};
+
+constexpr std::array<uint32_t, 6> STABLE_US = {1'000'000, 50'000, 0, 5'000, 2'097'151, 1};
+
+/**
+ * @brief Time from a channel settling on a new value to its state following, sampled every
+ * period_us
+ */
+uint32_t settle_time_us(uint32_t period_us) {
+  InputConditioner<1> conditioner({50'000});
+  uint32_t now_us = 0;
+  conditioner.update(1, now_us);
+  while (!conditioner.state(0)) {
+    now_us += period_us;
+    conditioner.update(1, now_us);
+  }
+  return now_us;
+}
+
+}  // namespace
+
+void test_matches_scalar_reference() {
+  InputConditioner<STABLE_US.size()> conditioner(STABLE_US, 0b000101);
+  std::array<ScalarDebouncer, STABLE_US.size()> reference{};
+  for (std::size_t i = 0; i < reference.size(); i++) {
+    reference[i] = ScalarDebouncer{STABLE_US[i], ((0b000101U >> i) & 1U) != 0};
+  }
+
+  std::mt19937 rng(1234);
+  uint32_t now_us = 0;
+  uint32_t sample = 0;
+  for (int step = 0; step < 200'000; step++) {
+    now_us += rng() % 8 == 0 ? rng() % 300'000 : rng() % 3'000;
+    if (rng() % 16 == 0) {
+      sample ^= 1U << (rng() % STABLE_US.size());  // mostly long stable stretches
+    }
+    const uint32_t states = conditioner.update(sample, now_us);
+    for (std::size_t i = 0; i < reference.size(); i++) {
+      reference[i].update(((sample >> i) & 1U) != 0, now_us);
+      TEST_ASSERT_EQUAL(reference[i].state, ((states >> i) & 1U) != 0);
+    }
+  }
+}
+
+void test_glitch_shorter_than_stable_time_is_ignored() {
+  InputConditioner<2> conditioner({50'000, 50'000});
+  conditioner.update(0b11, 10'000);
+  conditioner.update(0b11, 40'000);
+  conditioner.update(0b01, 45'000);  // channel 1 bounces back, it starts over
+  conditioner.update(0b11, 60'000);
+  TEST_ASSERT_EQUAL_UINT32(0b01, conditioner.update(0b11, 60'000));
+  TEST_ASSERT_EQUAL_UINT32(0b11, conditioner.update(0b11, 110'000));
+}
+
+void test_stable_time_does_not_depend_on_loop_rate() {
+  TEST_ASSERT_EQUAL_UINT32(50'000, settle_time_us(1'000));
+  TEST_ASSERT_EQUAL_UINT32(50'000, settle_time_us(5'000));
+  TEST_ASSERT_EQUAL_UINT32(50'000, settle_time_us(250));
+  TEST_ASSERT_EQUAL_UINT32(51'000, settle_time_us(3'000));  // first sample at or after 50 ms
+}
+
+void test_edges_and_time_since_edge() {
+  InputConditioner<2> conditioner({1'000, 1'000}, 0b10);
+  conditioner.update(0b01, 100);
+  conditioner.update(0b01, 1'100);
+  TEST_ASSERT_TRUE(conditioner.rose(0));
+  TEST_ASSERT_TRUE(conditioner.fell(1));
+  TEST_ASSERT_FALSE(conditioner.fell(0));
+  TEST_ASSERT_FALSE(conditioner.rose(1));
+  conditioner.update(0b01, 5'100);
+  TEST_ASSERT_FALSE(conditioner.rose(0));  // edges only last one update
+  TEST_ASSERT_EQUAL_UINT32(4'000, conditioner.time_since_edge_us(0, 5'100));
+}
+
+void test_micros_wrap() {
+  InputConditioner<1> conditioner({100'000});
+  conditioner.update(1, UINT32_MAX - 40'000);
+  conditioner.update(1, 50'000);  // 90 ms, across the wrap
+  TEST_ASSERT_FALSE(conditioner.state(0));
+  conditioner.update(1, 60'000);
+  TEST_ASSERT_TRUE(conditioner.state(0));
+}
+
+void test_gap_longer_than_counters_is_stable() {
+  using Conditioner = InputConditioner<2>;
+  Conditioner conditioner({1'000'000, Conditioner::MAX_STABLE_US});
+  conditioner.update(0b11, 0);
+  conditioner.update(0b11, Conditioner::MAX_STABLE_US + 6);  // a stalled loop
+  TEST_ASSERT_EQUAL_UINT32(0b11, conditioner.states());
+}
+
+void test_reset_takes_states_without_edges() {
+  InputConditioner<2> conditioner({1'000, 1'000});
+  conditioner.reset(0b10, 7'000);  // an idle high button
+  conditioner.update(0b10, 7'100);
+  TEST_ASSERT_FALSE(conditioner.rose(1));
+  TEST_ASSERT_EQUAL_UINT32(0b10, conditioner.states());
+  TEST_ASSERT_EQUAL_UINT32(100, conditioner.time_since_edge_us(1, 7'100));
+  conditioner.update(0b00, 8'000);
+  conditioner.update(0b00, 9'000);
+  TEST_ASSERT_TRUE(conditioner.fell(1));
+}
+
+void test_debounced_value() {
+  DebouncedValue<int> selector(5'000, 0);
+  selector.update(3, 1'000);
+  selector.update(2, 2'000);  // still moving
+  TEST_ASSERT_EQUAL(0, selector.update(2, 6'000));
+  TEST_ASSERT_EQUAL(2, selector.update(2, 7'000));
+  TEST_ASSERT_EQUAL_UINT32(3'000, selector.time_since_edge_us(10'000));
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_matches_scalar_reference);
+  RUN_TEST(test_glitch_shorter_than_stable_time_is_ignored);
+  RUN_TEST(test_stable_time_does_not_depend_on_loop_rate);
+  RUN_TEST(test_edges_and_time_since_edge);
+  RUN_TEST(test_micros_wrap);
+  RUN_TEST(test_gap_longer_than_counters_is_stable);
+  RUN_TEST(test_reset_takes_states_without_edges);
+  RUN_TEST(test_debounced_value);
+  return UNITY_END();
+}
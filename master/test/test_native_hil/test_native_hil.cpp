@@ -0,0 +1,328 @@
+#include <unity.h>
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// The real setup()/loop() and globals, running on the native mocks
+#include "../../src/main.cpp"
+#include "vehicle_model.hpp"
+
+// Each test starts with the car in AS_OFF, ASMS off, and leaves it that way, so the tests run
+// full missions one after another on a single boot of the firmware (virtual time keeps going).
+
+namespace {
+
+using Checkup = CheckupManager::CheckupState;
+
+constexpr uint64_t NEVER = UINT64_MAX;
+
+// Timing requirements checked by the suite
+constexpr uint64_t CHECKUP_BUDGET_US = 2'500'000;    ///< ASMS on to AS_READY, operator included
+constexpr uint64_t R2D_LATENCY_BUDGET_US = 2'000;     ///< RES GO frame to EBS released
+constexpr uint64_t BRAKES_APPLIED_BUDGET_US = 20'000;  ///< emergency to both lines above threshold
+constexpr uint64_t PNEUMATIC_LOSS_BUDGET_US = INPUT_STABLE_US + 2'000;
+constexpr uint64_t COMPONENT_LOSS_BUDGET_US =
+    COMPONENT_TIMESTAMP_TIMEOUT * 1000ULL + ASState::DEADLINE_CHECK_PERIOD_US;
+
+vehicle_sim::VehicleModel car;
+
+void boot() {
+  static bool booted = false;
+  if (booted) {
+    return;
+  }
+  booted = true;
+  car.begin();
+  setup();
+}
+
+/**
+ * @brief Runs loop() until done() holds, at most for timeout_us
+ * @return virtual time at which done() held, 0 on timeout
+ */
+template <class Done>
+uint64_t run_until(Done done, const uint64_t timeout_us) {
+  const uint64_t end_us = mock::now_us() + timeout_us;
+  while (mock::now_us() < end_us) {
+    loop();
+    if (done()) {
+      return mock::now_us();
+    }
+  }
+  return 0;
+}
+
+void run_for(const uint64_t duration_us) {
+  run_until([] { return false; }, duration_us);
+}
+
+bool in_state(const State state) { return as_state.state_ == state; }
+bool in_checkup(const Checkup checkup) {
+  return as_state._checkup_manager_.checkup_state_ == checkup;
+}
+bool brakes_applied() {
+  const int threshold_adc = HYDRAULIC_BRAKE_THRESHOLD;
+  return vehicle_sim::pressure_to_adc(car.rear_bar()) >= threshold_adc &&
+         vehicle_sim::pressure_to_adc(car.front_bar()) >= threshold_adc;
+}
+
+void report(const char *what, const uint64_t us) {
+  char text[96];
+  std::snprintf(text, sizeof(text), "%s: %.3f ms", what, static_cast<double>(us) / 1000.0);
+  TEST_MESSAGE(text);
+}
+
+/**
+ * @brief ASMS on, the operator presses ASATS when asked, the checkup runs to AS_READY
+ * @return time taken from ASMS on, NEVER if the car did not get ready
+ */
+uint64_t checkup_to_ready() {
+  TEST_ASSERT_TRUE(in_state(State::AS_OFF));
+  const uint64_t asms_on_us = mock::now_us();
+  car.set_asms(true);
+  if (run_until([] { return in_checkup(Checkup::WAIT_FOR_ASATS); }, CHECKUP_BUDGET_US) == 0) {
+    return NEVER;
+  }
+  car.set_asats(true);
+  run_until([] { return !in_checkup(Checkup::WAIT_FOR_ASATS); }, 1'000'000);
+  car.set_asats(false);
+  const uint64_t ready_us = run_until([] { return in_state(State::AS_READY); }, CHECKUP_BUDGET_US);
+  return ready_us == 0 ? NEVER : ready_us - asms_on_us;
+}
+
+/**
+ * @brief Waits out READY_TIMEOUT_MS and sends RES GO
+ * @return RES GO frame to EBS valves released, NEVER if the car did not start driving
+ */
+uint64_t go_to_driving() {
+  run_for(READY_TIMEOUT_MS * 1000 + 50'000);
+  TEST_ASSERT_TRUE(in_state(State::AS_READY));
+  const uint64_t go_us = mock::now_us();
+  car.res_go();
+  if (run_until([] { return in_state(State::AS_DRIVING); }, 500'000) == 0) {
+    return NEVER;
+  }
+  // The GO frame goes out with the next RES period
+  const uint64_t frame_us =
+      go_us + vehicle_sim::RES_PERIOD_US - go_us % vehicle_sim::RES_PERIOD_US;
+  const uint64_t released_us = car.first_write(EBS_VALVE_FRONT_PIN, LOW, go_us);
+  return released_us - frame_us;
+}
+
+/**
+ * @brief ASMS off and the EBS buzzer time, back to AS_OFF
+ */
+void shut_down() {
+  car.set_asms(false);
+  const uint64_t off_us = run_until([] { return in_state(State::AS_OFF); },
+                                    EBS_BUZZER_TIMEOUT * 1000ULL + 1'000'000);
+  TEST_ASSERT_TRUE_MESSAGE(off_us != 0, "car did not return to AS_OFF");
+  run_for(ASMS_STABLE_US + 100'000);
+}
+
+}  // namespace
+
+void test_acceleration_mission() {
+  boot();
+  run_for(200'000);
+  const uint64_t checkup_us = checkup_to_ready();
+  TEST_ASSERT_TRUE_MESSAGE(checkup_us != NEVER, "checkup did not complete");
+  report("checkup (ASMS on to AS_READY)", checkup_us);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT64(CHECKUP_BUDGET_US, checkup_us);
+  TEST_ASSERT_TRUE(brakes_applied());
+  TEST_ASSERT_EQUAL(HIGH, mock::pin(CLOSE_SDC));
+
+  const uint64_t r2d_us = go_to_driving();
+  TEST_ASSERT_TRUE_MESSAGE(r2d_us != NEVER, "car did not start driving");
+  report("R2D (RES GO frame to EBS released)", r2d_us);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT64(R2D_LATENCY_BUDGET_US, r2d_us);
+
+  // The brakes must be released before RELEASE_EBS_TIMEOUT_MS or the car goes to emergency
+  run_for(RELEASE_EBS_TIMEOUT_MS * 1000 + 500'000);
+  TEST_ASSERT_TRUE(in_state(State::AS_DRIVING));
+  TEST_ASSERT_FALSE(brakes_applied());
+
+  car.mission_finished();
+  TEST_ASSERT_TRUE(run_until([] { return in_state(State::AS_FINISHED); }, 100'000) != 0);
+  TEST_ASSERT_EQUAL(LOW, mock::pin(CLOSE_SDC));
+  TEST_ASSERT_TRUE(run_until(brakes_applied, BRAKES_APPLIED_BUDGET_US) != 0);
+  shut_down();
+}
+
+void test_checkup_reports_every_check_once() {
+  using Check = CheckupManager::Check;
+  struct Report {
+    int count = 0;
+    uint8_t status = 0;
+    uint16_t started_ms = 0;
+    uint16_t finished_ms = 0;
+  };
+  // Only the checkup of test_acceleration_mission has run so far
+  std::array<Report, CheckupManager::NUM_CHECKS> reports{};
+  for (const auto &sent : mock::can_bus(CAN3).tx) {
+    if (sent.msg.id != DATA_LOGGER_SIGNALS_4) continue;
+    TEST_ASSERT_EQUAL(6, sent.msg.len);
+    TEST_ASSERT_LESS_THAN(CheckupManager::NUM_CHECKS, sent.msg.buf[0]);
+    Report &report = reports[sent.msg.buf[0]];
+    report.count++;
+    report.status = sent.msg.buf[1];
+    report.started_ms = static_cast<uint16_t>(sent.msg.buf[2] | sent.msg.buf[3] << 8);
+    report.finished_ms = static_cast<uint16_t>(sent.msg.buf[4] | sent.msg.buf[5] << 8);
+  }
+  for (const Report &report : reports) {
+    TEST_ASSERT_EQUAL(1, report.count);
+    TEST_ASSERT_EQUAL(to_underlying(CheckStatus::PASSED), report.status);
+    TEST_ASSERT_TRUE(report.started_ms <= report.finished_ms);
+  }
+  auto at = [&](Check check) -> const Report & { return reports[to_underlying(check)]; };
+  // The EBS actuators are tested while the inverter precharges, not after TS is on
+  TEST_ASSERT_EQUAL(at(Check::CLOSE_SDC).finished_ms, at(Check::EBS_ACTUATORS).started_ms);
+  TEST_ASSERT_TRUE(at(Check::EBS_ACTUATORS).finished_ms < at(Check::TS).finished_ms);
+  TEST_ASSERT_EQUAL(at(Check::ASMS).finished_ms, at(Check::WATCHDOG).started_ms);
+}
+
+void test_ebs_curves_follow_the_lines() {
+  using Phase = CheckupManager::EbsPressureTestPhase;
+  using Line = CheckupManager::HydraulicLine;
+  struct Curve {
+    uint8_t phase;
+    uint8_t line;
+    int start_adc;
+    int final_adc;
+    int t10_90_ms;
+    int tau_ms;
+  };
+  std::vector<Curve> curves;
+  for (const auto &sent : mock::can_bus(CAN3).tx) {
+    if (sent.msg.id != DATA_LOGGER_SIGNALS_5) continue;
+    uint64_t fields = 0;
+    for (int i = 0; i < 7; i++) fields |= static_cast<uint64_t>(sent.msg.buf[i + 1]) << (8 * i);
+    curves.push_back({static_cast<uint8_t>(sent.msg.buf[0] & 0x0F),
+                      static_cast<uint8_t>(sent.msg.buf[0] >> 7), static_cast<int>(fields & 0x3FF),
+                      static_cast<int>(fields >> 10 & 0x3FF), static_cast<int>(fields >> 20 & 0xFFF),
+                      static_cast<int>(fields >> 32 & 0xFFF)});
+  }
+  // Both lines of the three check phases of the first checkup
+  TEST_ASSERT_EQUAL(6, curves.size());
+  auto find = [&](Phase phase, Line line) -> const Curve & {
+    for (const Curve &curve : curves) {
+      if (curve.phase == to_underlying(phase) && curve.line == to_underlying(line)) return curve;
+    }
+    TEST_FAIL_MESSAGE("curve not reported");
+    return curves.front();
+  };
+  const vehicle_sim::PlantParams plant;
+  auto near_tau = [](int expected_ms, const Curve &curve) {
+    char text[96];
+    std::snprintf(text, sizeof(text), "phase %d line %d: %d -> %d, tau %d ms, 10-90 %d ms",
+                  curve.phase, curve.line, curve.start_adc, curve.final_adc, curve.tau_ms,
+                  curve.t10_90_ms);
+    TEST_MESSAGE(text);
+    TEST_ASSERT_INT_WITHIN(expected_ms / 4, expected_ms, curve.tau_ms);
+  };
+  // Rear released, front still braking
+  const Curve &rear_release = find(Phase::CHECK_ACTUATOR_2, Line::REAR);
+  TEST_ASSERT_TRUE(rear_release.final_adc < rear_release.start_adc);
+  near_tau(static_cast<int>(plant.release_tau_ms), rear_release);
+  // Rear braking again, front released
+  const Curve &rear_build = find(Phase::CHECK_ACTUATOR_1, Line::REAR);
+  TEST_ASSERT_TRUE(rear_build.final_adc > rear_build.start_adc);
+  near_tau(static_cast<int>(plant.build_tau_ms), rear_build);
+  const Curve &front_release = find(Phase::CHECK_ACTUATOR_1, Line::FRONT);
+  TEST_ASSERT_TRUE(front_release.final_adc < front_release.start_adc);
+  near_tau(static_cast<int>(plant.release_tau_ms), front_release);
+  // Front braking again, the dash sends it every HYDRAULIC_CHECKUP_MSG_PERIOD_MS
+  const Curve &front_build = find(Phase::CHECK_BOTH_ACTUATORS, Line::FRONT);
+  TEST_ASSERT_TRUE(front_build.final_adc > front_build.start_adc);
+  near_tau(static_cast<int>(plant.build_tau_ms), front_build);
+  // A first order line takes ln(9) tau from 10 % to 90 %
+  TEST_ASSERT_INT_WITHIN(15, static_cast<int>(2.2f * plant.build_tau_ms), rear_build.t10_90_ms);
+}
+
+void test_res_emergency_while_driving() {
+  TEST_ASSERT_TRUE(checkup_to_ready() != NEVER);
+  TEST_ASSERT_TRUE(go_to_driving() != NEVER);
+  run_for(1'500'000);
+
+  const uint64_t stop_us = mock::now_us();
+  car.res_emergency();
+  // Opened from the receive interrupt, before loop() runs again
+  TEST_ASSERT_TRUE(in_state(State::AS_EMERGENCY));
+  TEST_ASSERT_EQUAL_UINT64(stop_us, car.first_write(CLOSE_SDC, LOW, stop_us));
+  TEST_ASSERT_EQUAL_UINT64(stop_us, car.first_write(EBS_VALVE_FRONT_PIN, HIGH, stop_us));
+  TEST_ASSERT_EQUAL_UINT64(stop_us, car.first_write(EBS_VALVE_REAR_PIN, HIGH, stop_us));
+
+  const uint64_t braked_us = run_until(brakes_applied, BRAKES_APPLIED_BUDGET_US);
+  TEST_ASSERT_TRUE_MESSAGE(braked_us != 0, "brakes not applied in time");
+  report("RES emergency to brakes applied", braked_us - stop_us);
+
+  car.res_release();
+  shut_down();
+}
+
+void test_steering_loss_while_driving() {
+  TEST_ASSERT_TRUE(checkup_to_ready() != NEVER);
+  TEST_ASSERT_TRUE(go_to_driving() != NEVER);
+  run_for(1'500'000);
+
+  car.silence(Component::STEERING);
+  const uint64_t silenced_us = mock::now_us();
+  const uint64_t emergency_us =
+      run_until([] { return in_state(State::AS_EMERGENCY); }, 2 * COMPONENT_LOSS_BUDGET_US);
+  TEST_ASSERT_TRUE(emergency_us != 0);
+  // The last frame was sent at most one alive period before the node went quiet
+  const uint64_t last_frame_us = silenced_us - silenced_us % vehicle_sim::ALIVE_PERIOD_US;
+  const uint64_t opened_us = car.first_write(CLOSE_SDC, LOW, silenced_us);
+  report("last steering frame to SDC open", opened_us - last_frame_us);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT64(COMPONENT_LOSS_BUDGET_US, opened_us - last_frame_us);
+
+  car.revive(Component::STEERING);
+  shut_down();
+}
+
+void test_pneumatic_loss_in_ready() {
+  TEST_ASSERT_TRUE(checkup_to_ready() != NEVER);
+  run_for(500'000);
+
+  car.set_leak(100.0f);  // the tank drops under the switch pressure in a few ms
+  const uint64_t lost_us = run_until([] { return mock::pin(EBS_SENSOR1) == LOW; }, 100'000);
+  TEST_ASSERT_TRUE(lost_us != 0);
+  const uint64_t emergency_us =
+      run_until([] { return in_state(State::AS_EMERGENCY); }, 2 * PNEUMATIC_LOSS_BUDGET_US);
+  TEST_ASSERT_TRUE(emergency_us != 0);
+  report("EBS pressure switch open to AS_EMERGENCY", emergency_us - lost_us);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT64(PNEUMATIC_LOSS_BUDGET_US, emergency_us - lost_us);
+
+  car.set_leak(0.0f);
+  car.refill_tank();
+  shut_down();
+}
+
+// The front line never releases, so the car must not get past the single actuator checks
+void test_stuck_front_actuator_fails_ebs_check() {
+  car.stick_front_line(car.front_bar());  // the front line holds whatever pressure it has now
+  TEST_ASSERT_TRUE(brakes_applied());
+  TEST_ASSERT_TRUE(checkup_to_ready() == NEVER);
+  TEST_ASSERT_TRUE(in_state(State::AS_OFF));
+  TEST_ASSERT_TRUE(in_checkup(Checkup::EBS_CHECKS));
+  TEST_ASSERT_EQUAL(CheckupManager::EbsPressureTestPhase::CHECK_ACTUATOR_1,
+                    as_state._checkup_manager_.pressure_test_phase_);
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_acceleration_mission);
+  RUN_TEST(test_checkup_reports_every_check_once);
+  RUN_TEST(test_ebs_curves_follow_the_lines);
+  RUN_TEST(test_res_emergency_while_driving);
+  RUN_TEST(test_steering_loss_while_driving);
+  RUN_TEST(test_pneumatic_loss_in_ready);
+  RUN_TEST(test_stuck_front_actuator_fails_ebs_check);  // leaves the EBS check half done, keep last
+  return UNITY_END();
+}
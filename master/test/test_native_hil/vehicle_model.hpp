@@ -0,0 +1,254 @@
+#pragma once
+#include <Arduino.h>
+#include <FlexCAN_T4.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "../../../CAN_IDs.h"
+#include "embedded/hardwareSettings.hpp"
+#include "model/timeoutManager.hpp"
+#include "native_mock.hpp"
+
+/**
+ * @brief Virtual car on the stand for the master firmware running on the native mocks
+ *
+ * Every plant and CAN node advances on the virtual clock (see native_mock.hpp). The plant ticks
+ * at 1 kHz, reads the master's outputs from its pins and drives its inputs. The CAN nodes send
+ * their frames periodically, the same way the real bus interrupts a delay() in loop().
+ *
+ * - Hydraulics: each axle has a first order response to its EBS valve (HIGH = braking). The
+ *   rear line feeds BRAKE_SENSOR through the sensor equation. The front line is sent by the
+ *   dash every HYDRAULIC_MSG_PERIOD_MS, or HYDRAULIC_CHECKUP_MSG_PERIOD_MS while the master
+ *   reports ASMS on and a state before AS_READY.
+ * - Pneumatics: a tank that loses air on every valve engagement and through an optional leak.
+ *   Both EBS sensors read HIGH above the switch pressure.
+ * - Watchdog: WD_READY stays HIGH while WD_ALIVE toggles at least every watchdog_timeout_us.
+ * - Bamocar: the DC link precharges while the SDC (CLOSE_SDC and TSMS) is closed and discharges
+ *   otherwise. It is reported with the DC voltage code every 20 ms.
+ * - RES, AS CU (PC), steering and BMS send their alive frames until silenced.
+ */
+namespace vehicle_sim {
+
+struct PlantParams {
+  float braked_bar = 40.0f;       ///< line pressure with the valve engaged and air in the tank
+  float build_tau_ms = 40.0f;     ///< time constant of the line filling
+  float release_tau_ms = 60.0f;   ///< time constant of the line emptying
+  float stuck_front_bar = -1.0f;  ///< >= 0 forces the front line to that pressure (fault)
+
+  float tank_bar = 8.0f;
+  float switch_bar = 6.0f;            ///< EBS pressure switches open below this
+  float engage_cost_bar = 0.02f;      ///< air used by one valve engagement
+  float leak_bar_per_s = 0.0f;
+
+  uint16_t battery_dc = 2600;         ///< Bamocar units, the master's DC_THRESHOLD is 1890
+  uint16_t precharge_dc_per_ms = 10;
+  uint16_t discharge_dc_per_ms = 20;
+
+  uint32_t watchdog_timeout_us = 100'000;
+};
+
+constexpr uint64_t PLANT_PERIOD_US = 1'000;
+constexpr uint64_t RES_PERIOD_US = 50'000;
+constexpr uint64_t ALIVE_PERIOD_US = 100'000;
+constexpr uint64_t BAMOCAR_PERIOD_US = 20'000;
+constexpr uint64_t RES_GO_PRESS_US = 150'000;
+constexpr int AMI_ACCELERATION = 100;
+constexpr int SOC_ADC = 800;
+
+/**
+ * @brief Brake pressure sensor reading, U = p / 65 + 0.5 on a 10 bit ADC over 3.3 V
+ */
+inline int pressure_to_adc(const float bar) {
+  const float volts = bar / HYDRAULIC_PRESSURE_SLOPE + MIN_HYDRAULIC_V;
+  return std::clamp(static_cast<int>(volts / MAX_V_ANALOG * ADC_MAX_VALUE), 0, ADC_MAX_VALUE);
+}
+
+/**
+ * @brief One write to an output pin of the master
+ */
+struct PinEdge {
+  uint64_t time_us;
+  int pin;
+  int value;
+};
+
+class VehicleModel {
+public:
+  explicit VehicleModel(const PlantParams &params = {}) : params_(params) {}
+
+  /**
+   * @brief Sets the car up with ASMS off, air in the tanks, the acceleration mission selected and
+   * TSMS on, then starts the plant and the CAN nodes; call before setup()
+   */
+  void begin() {
+    mock::set_pin(ASMS_IN_PIN, LOW);
+    mock::set_pin(ASATS, HIGH);  // active low
+    mock::set_pin(SDC_TSMS_STATE_PIN, HIGH);
+    mock::set_analog(AMI, AMI_ACCELERATION);
+    mock::set_analog(SOC, SOC_ADC);
+    mock::runtime().on_digital_write = [this](int pin, int value) {
+      edges_.push_back({mock::now_us(), pin, value});
+      if ((pin == EBS_VALVE_REAR_PIN || pin == EBS_VALVE_FRONT_PIN) && value == HIGH) {
+        tank_bar_ = std::max(0.0f, tank_bar_ - params_.engage_cost_bar);
+      }
+      if (pin == WD_ALIVE) {
+        last_wd_toggle_us_ = mock::now_us();
+        watchdog_fed_ = true;
+      }
+    };
+    tank_bar_ = params_.tank_bar;
+    step();
+
+    mock::schedule_periodic(PLANT_PERIOD_US, [this] { step(); });
+    mock::schedule_periodic(RES_PERIOD_US, [this] { send_res_state(); });
+    mock::schedule_periodic(BAMOCAR_PERIOD_US, [this] {
+      if (alive(Component::INVERTER)) {
+        send(BAMO_RESPONSE_ID, {BAMOCAR_BATTERY_VOLTAGE_CODE, static_cast<uint8_t>(dc_ & 0xFF),
+                                static_cast<uint8_t>(dc_ >> 8), 0});
+      }
+    });
+    mock::schedule_periodic(ALIVE_PERIOD_US, [this] {
+      if (alive(Component::PC)) send(AS_CU_ID, {PC_ALIVE});
+      if (alive(Component::STEERING)) send(STEERING_ID, {0x00, 0x7B, 0, 0, 0, 0, 0x1E, 0}, true);
+      if (alive(Component::BMS)) send(BMS_ID, {0, 0, 0, 0, 0, 0, 0, 0});
+    });
+    // The dash follows the master's ASMS and state frames
+    mock::can_bus(CAN3).on_transmit = [this](const CAN_message_t &msg) {
+      if (msg.id == MASTER_ID && msg.buf[0] == ASMS) master_asms_on_ = msg.buf[1] != 0;
+      if (msg.id == MASTER_ID && msg.buf[0] == STATE_MSG) master_state_ = msg.buf[1];
+    };
+    mock::schedule_periodic(1'000, [this] {
+      const bool checkup = master_asms_on_ && master_state_ < AS_READY;
+      const uint64_t period_us =
+          (checkup ? HYDRAULIC_CHECKUP_MSG_PERIOD_MS : HYDRAULIC_MSG_PERIOD_MS) * 1000ULL;
+      if (mock::now_us() - last_hydraulic_us_ < period_us) {
+        return;
+      }
+      last_hydraulic_us_ = mock::now_us();
+      const int front = pressure_to_adc(front_bar_);
+      send(DASH_ID, {static_cast<uint8_t>(HYDRAULIC_LINE), static_cast<uint8_t>(front & 0xFF),
+                     static_cast<uint8_t>(front >> 8)});
+    });
+  }
+
+  // Driver and operator
+  void set_asms(bool on) { mock::set_pin(ASMS_IN_PIN, on ? HIGH : LOW); }
+  void set_asats(bool pressed) { mock::set_pin(ASATS, pressed ? LOW : HIGH); }
+  void set_tsms(bool on) { mock::set_pin(SDC_TSMS_STATE_PIN, on ? HIGH : LOW); }
+
+  // RES
+  void res_go() { go_until_us_ = mock::now_us() + RES_GO_PRESS_US; }
+  void res_emergency() {
+    res_stopped_ = true;
+    send_res_state();
+  }
+  void res_release() { res_stopped_ = false; }
+
+  // AS CU
+  void mission_finished() { send(AS_CU_ID, {MISSION_FINISHED}); }
+
+  // Faults
+  void silence(Component component) { silent_[index(component)] = true; }
+  void revive(Component component) { silent_[index(component)] = false; }
+  void set_leak(float bar_per_s) { params_.leak_bar_per_s = bar_per_s; }
+  void stick_front_line(float bar) { params_.stuck_front_bar = bar; }
+  void refill_tank() { tank_bar_ = params_.tank_bar; }
+
+  [[nodiscard]] float rear_bar() const { return rear_bar_; }
+  [[nodiscard]] float front_bar() const { return front_bar_; }
+  [[nodiscard]] float tank_bar() const { return tank_bar_; }
+  [[nodiscard]] uint16_t dc() const { return dc_; }
+  [[nodiscard]] bool watchdog_ready() const { return mock::pin(WD_READY) == HIGH; }
+
+  /**
+   * @brief Virtual time of the first write of value to pin at or after since_us, 0 if none
+   */
+  [[nodiscard]] uint64_t first_write(int pin, int value, uint64_t since_us) const {
+    for (const auto &edge : edges_) {
+      if (edge.time_us >= since_us && edge.pin == pin && edge.value == value) {
+        return edge.time_us;
+      }
+    }
+    return 0;
+  }
+
+private:
+  static std::size_t index(Component component) {
+    return static_cast<std::size_t>(to_underlying(component));
+  }
+  [[nodiscard]] bool alive(Component component) const { return !silent_[index(component)]; }
+
+  void send(uint32_t id, std::initializer_list<uint8_t> data, bool extended = false) {
+    CAN_message_t msg;
+    msg.id = id;
+    msg.flags.extended = extended;
+    msg.len = static_cast<uint8_t>(data.size());
+    std::copy(data.begin(), data.end(), msg.buf);
+    mock::can_bus(CAN3).inject(msg);
+  }
+
+  void send_res_state() {
+    if (!alive(Component::RES)) {
+      return;
+    }
+    const bool go = mock::now_us() < go_until_us_;
+    const uint8_t byte0 = res_stopped_ ? 0x00 : static_cast<uint8_t>(0x01 | (go ? 0x04 : 0x00));
+    const uint8_t byte3 = res_stopped_ ? 0x00 : 0x80;
+    send(RES_STATE, {byte0, 0, 0, byte3, 0, 0, 92, 0});
+  }
+
+  static float approach(float value, float target, float tau_ms) {
+    return value + (target - value) * (static_cast<float>(PLANT_PERIOD_US) / 1000.0f / tau_ms);
+  }
+
+  void step() {
+    const bool has_air = tank_bar_ >= params_.switch_bar;
+    auto line = [&](float bar, int valve_pin) {
+      const bool engaged = mock::pin(valve_pin) == HIGH && tank_bar_ > 0.0f;
+      return engaged ? approach(bar, params_.braked_bar, params_.build_tau_ms)
+                     : approach(bar, 0.0f, params_.release_tau_ms);
+    };
+    rear_bar_ = line(rear_bar_, EBS_VALVE_REAR_PIN);
+    front_bar_ = params_.stuck_front_bar >= 0.0f ? params_.stuck_front_bar
+                                                 : line(front_bar_, EBS_VALVE_FRONT_PIN);
+    mock::set_analog(BRAKE_SENSOR, pressure_to_adc(rear_bar_));
+
+    tank_bar_ = std::max(0.0f, tank_bar_ - params_.leak_bar_per_s *
+                                               static_cast<float>(PLANT_PERIOD_US) / 1e6f);
+    mock::set_pin(EBS_SENSOR1, has_air ? HIGH : LOW);
+    mock::set_pin(EBS_SENSOR2, has_air ? HIGH : LOW);
+
+    const bool fed = watchdog_fed_ &&
+                     mock::now_us() - last_wd_toggle_us_ < params_.watchdog_timeout_us;
+    mock::set_pin(WD_READY, fed ? HIGH : LOW);
+
+    const bool sdc_closed = mock::pin(CLOSE_SDC) == HIGH && mock::pin(SDC_TSMS_STATE_PIN) == HIGH;
+    if (sdc_closed) {
+      dc_ = static_cast<uint16_t>(
+          std::min<int>(params_.battery_dc, dc_ + params_.precharge_dc_per_ms));
+    } else {
+      dc_ = static_cast<uint16_t>(std::max<int>(0, dc_ - params_.discharge_dc_per_ms));
+    }
+  }
+
+  PlantParams params_;
+  float rear_bar_ = 0.0f;
+  float front_bar_ = 0.0f;
+  float tank_bar_ = 0.0f;
+  uint16_t dc_ = 0;
+  bool watchdog_fed_ = false;
+  uint64_t last_wd_toggle_us_ = 0;
+  uint64_t go_until_us_ = 0;
+  bool res_stopped_ = false;
+  bool master_asms_on_ = false;
+  uint8_t master_state_ = AS_OFF;
+  uint64_t last_hydraulic_us_ = 0;
+  std::array<bool, to_underlying(Component::RES) + 1> silent_{};
+  std::vector<PinEdge> edges_;
+};
+
+}  // namespace vehicle_sim
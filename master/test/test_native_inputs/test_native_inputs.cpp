@@ -0,0 +1,59 @@
+#include <unity.h>
+
+#include "embedded/pinMap.hpp"
+
+void test_pin_map_matches_core_pins() {
+  for (std::size_t pin = 0; pin < teensy41::PIN_MAP.size(); pin++) {
+    TEST_ASSERT_EQUAL_UINT8(mock::TEENSY41_PADS[pin].port, teensy41::PIN_MAP[pin].port);
+    TEST_ASSERT_EQUAL_UINT8(mock::TEENSY41_PADS[pin].bit, teensy41::PIN_MAP[pin].bit);
+  }
+}
+
+void test_snapshot_reads_each_input_alone() {
+  InputSnapshot inputs;
+  for (std::size_t i = 0; i < InputSnapshot::NUM_INPUTS; i++) {
+    mock::reset();
+    digitalWrite(DIGITAL_INPUT_PINS[i], HIGH);
+    inputs.sample();
+    for (std::size_t j = 0; j < InputSnapshot::NUM_INPUTS; j++) {
+      TEST_ASSERT_EQUAL(i == j, inputs[static_cast<DigitalInput>(j)]);
+    }
+  }
+}
+
+void test_snapshot_matches_digital_read() {
+  InputSnapshot inputs;
+  for (uint32_t pattern = 0; pattern < (1U << InputSnapshot::NUM_INPUTS); pattern += 37) {
+    for (std::size_t i = 0; i < InputSnapshot::NUM_INPUTS; i++) {
+      digitalWrite(DIGITAL_INPUT_PINS[i], (pattern >> i & 1U) != 0 ? HIGH : LOW);
+    }
+    inputs.sample();
+    for (std::size_t i = 0; i < InputSnapshot::NUM_INPUTS; i++) {
+      TEST_ASSERT_EQUAL(digitalRead(DIGITAL_INPUT_PINS[i]) == HIGH,
+                        inputs[static_cast<DigitalInput>(i)]);
+    }
+  }
+}
+
+void test_snapshot_holds_until_next_sample() {
+  InputSnapshot inputs;
+  digitalWrite(ASMS_IN_PIN, HIGH);
+  inputs.sample();
+  digitalWrite(ASMS_IN_PIN, LOW);
+  TEST_ASSERT_TRUE(inputs[DigitalInput::ASMS]);
+  inputs.sample();
+  TEST_ASSERT_FALSE(inputs[DigitalInput::ASMS]);
+}
+
+void setUp() { mock::reset(); }
+
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_pin_map_matches_core_pins);
+  RUN_TEST(test_snapshot_reads_each_input_alone);
+  RUN_TEST(test_snapshot_matches_digital_read);
+  RUN_TEST(test_snapshot_holds_until_next_sample);
+  return UNITY_END();
+}
@@ -0,0 +1,286 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+// The real setup()/loop() and globals, running on the native mocks
+#include "../../src/main.cpp"
+#include "can_replay.hpp"
+
+namespace {
+
+const std::string TEST_DIR = std::string(__FILE__).substr(0, std::string(__FILE__).rfind('/'));
+const std::string DEFAULT_TRACE =
+    TEST_DIR + "/../../../tools/can_replay/traces/autonomous_res_emergency.log";
+
+constexpr const char *STATE_NAMES[] = {"AS_MANUAL",   "AS_OFF",      "AS_READY",
+                                       "AS_DRIVING",  "AS_FINISHED", "AS_EMERGENCY"};
+constexpr const char *CHECKUP_NAMES[] = {"WAIT_FOR_ASMS",
+                                         "START_TOGGLING_WATCHDOG",
+                                         "TOGGLING_WATCHDOG",
+                                         "STOP_TOGGLING_WATCHDOG",
+                                         "CHECK_WATCHDOG",
+                                         "START_TOGGLING_WATCHDOG_AGAIN",
+                                         "CHECK_EBS_STORAGE",
+                                         "CHECK_BRAKE_PRESSURE",
+                                         "CLOSE_SDC",
+                                         "WAIT_FOR_ASATS",
+                                         "WAIT_FOR_TS",
+                                         "EBS_CHECKS",
+                                         "CHECK_TIMESTAMPS",
+                                         "CHECKUP_COMPLETE"};
+constexpr const char *EBS_PHASE_NAMES[] = {"DISABLE_ACTUATOR_1", "CHECK_ACTUATOR_2",
+                                           "CHANGE_ACTUATORS",   "CHECK_ACTUATOR_1",
+                                           "ENABLE_ACTUATOR_2",  "CHECK_BOTH_ACTUATORS",
+                                           "COMPLETE"};
+
+// Hydraulic plant: line pressure follows the EBS valve of its axle
+constexpr int BRAKED_ADC = 300;
+constexpr int RELEASED_ADC = 100;
+constexpr int AMI_ACCELERATION = 100;
+constexpr int SOC_ADC = 800;
+
+std::string trace_path() {
+  const char *path = std::getenv("CAN_REPLAY_TRACE");
+  return path != nullptr ? path : DEFAULT_TRACE;
+}
+
+std::string golden_path() {
+  return std::getenv("CAN_REPLAY_TRACE") != nullptr ? trace_path() + ".master.golden"
+                                                    : TEST_DIR + "/golden_state_trace.txt";
+}
+
+int axle_pressure(int valve_pin) { return mock::pin(valve_pin) ? BRAKED_ADC : RELEASED_ADC; }
+
+/**
+ * @brief Car on the stand: ASMS on, air in the tanks, acceleration selected, TSMS closed,
+ * ASATS pressed for half a second once ASMS is up, ASMS switched off after the emergency
+ */
+void wire_test_bench() {
+  mock::set_pin(ASMS_IN_PIN, HIGH);
+  mock::set_pin(EBS_SENSOR1, HIGH);
+  mock::set_pin(EBS_SENSOR2, HIGH);
+  mock::set_pin(SDC_TSMS_STATE_PIN, HIGH);
+  mock::set_pin(ASATS, HIGH);
+  mock::set_analog(AMI, AMI_ACCELERATION);
+  mock::set_analog(SOC, SOC_ADC);
+  mock::schedule_once(1'500'000, [] { mock::set_pin(ASATS, LOW); });
+  mock::schedule_once(2'000'000, [] { mock::set_pin(ASATS, HIGH); });
+  mock::schedule_once(11'000'000, [] { mock::set_pin(ASMS_IN_PIN, LOW); });
+
+  // The dash samples the front sensor and sends it every HYDRAULIC_MSG_PERIOD_MS, faster while
+  // the master reports ASMS on and a state before AS_READY
+  static bool master_asms_on = false;
+  static uint8_t master_state = AS_OFF;
+  mock::can_bus(CAN3).on_transmit = [](const CAN_message_t &msg) {
+    if (msg.id == MASTER_ID && msg.buf[0] == ASMS) master_asms_on = msg.buf[1] != 0;
+    if (msg.id == MASTER_ID && msg.buf[0] == STATE_MSG) master_state = msg.buf[1];
+  };
+  mock::schedule_periodic(1'000, [] {
+    static uint64_t last_sent_us = 0;
+    const bool checkup = master_asms_on && master_state < AS_READY;
+    const uint64_t period_us =
+        (checkup ? HYDRAULIC_CHECKUP_MSG_PERIOD_MS : HYDRAULIC_MSG_PERIOD_MS) * 1000ULL;
+    if (mock::now_us() - last_sent_us < period_us) {
+      return;
+    }
+    last_sent_us = mock::now_us();
+    CAN_message_t msg;
+    msg.id = DASH_ID;
+    msg.len = 3;
+    const int front = axle_pressure(EBS_VALVE_FRONT_PIN);
+    msg.buf[0] = HYDRAULIC_LINE;
+    msg.buf[1] = front & 0xFF;
+    msg.buf[2] = (front >> 8) & 0xFF;
+    mock::can_bus(CAN3).inject(msg);
+  });
+}
+
+void record(can_replay::StateTrace &trace) {
+  const auto state = to_underlying(as_state.state_);
+  const auto checkup = to_underlying(as_state._checkup_manager_.checkup_state_);
+  const auto phase = to_underlying(as_state._checkup_manager_.pressure_test_phase_);
+  trace.record("state", state, STATE_NAMES[state]);
+  trace.record("checkup", checkup, CHECKUP_NAMES[checkup]);
+  trace.record("ebs_phase", phase, EBS_PHASE_NAMES[phase]);
+  trace.record("mission", to_underlying(system_data.mission_));
+  trace.record("asms_on", system_data.hardware_data_.asms_on_);
+  trace.record("ts_on", system_data.failure_detection_.ts_on_);
+  trace.record("emergency_signal", system_data.failure_detection_.emergency_signal_);
+  trace.record("sdc_close_pin", mock::pin(CLOSE_SDC));
+  trace.record("ebs_valve_rear", mock::pin(EBS_VALVE_REAR_PIN));
+  trace.record("ebs_valve_front", mock::pin(EBS_VALVE_FRONT_PIN));
+}
+
+struct ReplayResult {
+  can_replay::StateTrace trace;
+  can_replay::Stats stats;
+  uint64_t start_us = 0;                  // virtual time of the first frame
+  std::vector<uint64_t> sdc_opened_at_us;  // every CLOSE_SDC LOW write
+};
+
+bool is_res_emergency(const CAN_message_t &msg) {
+  return msg.id == RES_STATE && (msg.buf[0] & 0x01) == 0 && (msg.buf[3] & 0x80) == 0;
+}
+
+/**
+ * @brief Boots the firmware and replays the whole trace once; the tests share the result
+ */
+const ReplayResult &replay() {
+  static ReplayResult result;
+  static bool done = false;
+  if (done) {
+    return result;
+  }
+  done = true;
+  wire_test_bench();
+  setup();
+  const auto frames = can_replay::load_candump(trace_path());
+  can_replay::Options options;
+  options.tail_us = 200'000;
+  mock::runtime().on_digital_write = [](int pin, int value) {
+    if (pin == CLOSE_SDC && value == LOW) result.sdc_opened_at_us.push_back(mock::now_us());
+  };
+  result.start_us = mock::now_us();
+  result.stats = can_replay::run(
+      frames, mock::can_bus(CAN3),
+      [] {
+        mock::set_analog(BRAKE_SENSOR, axle_pressure(EBS_VALVE_REAR_PIN));
+        loop();
+        record(result.trace);
+      },
+      can_replay::Options::from_env(options));
+  return result;
+}
+
+}  // namespace
+
+void test_replay_matches_golden_trace() {
+  const ReplayResult &result = replay();
+  TEST_ASSERT_GREATER_THAN(0, result.stats.frames);
+  const std::string diff = can_replay::compare_with_golden(result.trace.text(), golden_path());
+  TEST_ASSERT_TRUE_MESSAGE(diff.empty(), diff.c_str());
+}
+
+void test_res_emergency_reaches_emergency_state() {
+  const ReplayResult &result = replay();
+  const std::string &text = result.trace.text();
+  const auto driving = text.find("state AS_DRIVING");
+  TEST_ASSERT_TRUE(driving != std::string::npos);
+  TEST_ASSERT_TRUE(text.find("state AS_EMERGENCY", driving) != std::string::npos);
+}
+
+void test_transition_metrics_match_trace() {
+  replay();
+  const auto &metrics = as_state.metrics();
+  auto count = [&](State from, State to) {
+    uint32_t total = 0;
+    for (std::size_t i = 0; i < ASState::Table::size(); i++) {
+      const auto &transition = ASState::TRANSITIONS.row(i);
+      if (transition.from == from && transition.to == to) total += metrics.transition_count(i);
+    }
+    return total;
+  };
+  TEST_ASSERT_EQUAL_UINT32(1, count(State::AS_OFF, State::AS_READY));
+  TEST_ASSERT_EQUAL_UINT32(1, count(State::AS_READY, State::AS_DRIVING));
+  TEST_ASSERT_EQUAL_UINT32(1, count(State::AS_DRIVING, State::AS_EMERGENCY));
+  TEST_ASSERT_EQUAL_UINT32(1, count(State::AS_EMERGENCY, State::AS_OFF));
+  // READY lasted ~5.6 s: bucket 13 is [4096, 8192) ms
+  TEST_ASSERT_EQUAL_UINT32(1, metrics.time_in_state(to_underlying(State::AS_READY))[13]);
+}
+
+void test_res_emergency_frame_opens_sdc_immediately() {
+  const ReplayResult &result = replay();
+  uint64_t frame_us = 0;
+  for (const auto &frame : can_replay::load_candump(trace_path())) {
+    if (is_res_emergency(frame.msg)) {
+      frame_us = result.start_us + frame.time_us;
+      break;
+    }
+  }
+  TEST_ASSERT_TRUE(frame_us != 0);
+  uint64_t opened_us = 0;
+  for (const uint64_t at : result.sdc_opened_at_us) {
+    if (at >= frame_us) {
+      opened_us = at;
+      break;
+    }
+  }
+  TEST_ASSERT_TRUE(opened_us != 0);
+  // Opened from the receive interrupt itself, not on a later loop() or timer tick
+  TEST_ASSERT_EQUAL_UINT64(frame_us, opened_us);
+  TEST_ASSERT_EQUAL_UINT32(0, as_state.emergency_latency_us());
+}
+
+void test_res_emergency_path_host_time() {
+  replay();
+  as_state.state_ = State::AS_DRIVING;
+  digitalWrite(CLOSE_SDC, HIGH);
+  CAN_message_t stop;
+  stop.id = RES_STATE;
+  stop.len = 8;
+  const auto start = std::chrono::steady_clock::now();
+  mock::can_bus(CAN3).inject(stop);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  TEST_ASSERT_EQUAL(LOW, mock::pin(CLOSE_SDC));
+  TEST_ASSERT_EQUAL(State::AS_EMERGENCY, as_state.state_);
+  const std::string message =
+      "CAN frame to SDC open: " +
+      std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) +
+      " ns on the host";
+  TEST_MESSAGE(message.c_str());
+}
+
+void test_res_boot_is_answered() {
+  replay();
+  bool activated = false;
+  for (const auto &sent : mock::can_bus(CAN3).tx) {
+    if (sent.msg.id == RES_ACTIVATE && sent.msg.len == 2 && sent.msg.buf[0] == 0x01 &&
+        sent.msg.buf[1] == NODE_ID) {
+      activated = true;
+    }
+  }
+  TEST_ASSERT_TRUE(activated);
+}
+
+void test_acceptance_filters_drop_unlisted_frames() {
+  const ReplayResult &result = replay();
+  // Cell temperatures and the master's own frames are on the bus but not in the FIFO filters
+  TEST_ASSERT_GREATER_THAN(0, mock::can_bus(CAN3).rx_filtered);
+  TEST_ASSERT_LESS_THAN(result.stats.frames, result.stats.accepted);
+}
+
+void test_paced_replay_follows_recorded_timing() {
+  replay();
+  std::vector<can_replay::Frame> frames;
+  for (const auto &frame : can_replay::load_candump(trace_path())) {
+    if (frame.time_us <= 200'000) frames.push_back(frame);
+  }
+  can_replay::Options options;
+  options.speed = 4;  // 200 ms of traffic in ~50 ms
+  mock::can_bus(CAN1).main_handler = [](const CAN_message_t &) {};
+  TEST_ASSERT_FALSE(frames.empty());
+  const auto stats = can_replay::run(frames, mock::can_bus(CAN1), [] {}, options);
+  TEST_ASSERT_EQUAL_UINT64(frames.size(), stats.frames);
+  TEST_ASSERT_TRUE(stats.virtual_us >= frames.back().time_us);
+  TEST_ASSERT_TRUE(stats.virtual_us < frames.back().time_us + options.idle_step_us);
+  TEST_ASSERT_TRUE(stats.wall_s >= 0.045);
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_replay_matches_golden_trace);
+  RUN_TEST(test_res_emergency_reaches_emergency_state);
+  RUN_TEST(test_transition_metrics_match_trace);
+  RUN_TEST(test_res_boot_is_answered);
+  RUN_TEST(test_acceptance_filters_drop_unlisted_frames);
+  RUN_TEST(test_paced_replay_follows_recorded_timing);
+  RUN_TEST(test_res_emergency_frame_opens_sdc_immediately);
+  RUN_TEST(test_res_emergency_path_host_time);  // leaves the firmware in AS_EMERGENCY, keep last
+  return UNITY_END();
+}
@@ -0,0 +1,156 @@
+#include <unity.h>
+
+#include <Arduino.h>
+
+#include <cmath>
+
+#include "comm/utils.hpp"
+#include "model/timeoutManager.hpp"
+
+namespace {
+
+enum class Probe : uint8_t { FAST, MEDIUM, SLOW };
+using Probes = TimeoutManager<Probe, 3>;
+
+Probes make_probes() { return Probes{{100, 200, 500}}; }
+
+}  // namespace
+
+void test_earliest_is_shortest_timeout() {
+  const Probes probes = make_probes();
+  TEST_ASSERT_EQUAL(Probe::FAST, probes.earliest());
+  TEST_ASSERT_FALSE(probes.any_expired());
+}
+
+void test_kick_moves_deadline_forward() {
+  Probes probes = make_probes();
+  mock::advance_us(150'000);
+  TEST_ASSERT_TRUE(probes.any_expired());
+  TEST_ASSERT_TRUE(probes.expired(Probe::FAST));
+  TEST_ASSERT_FALSE(probes.expired(Probe::MEDIUM));
+
+  probes.kick(Probe::FAST);  // FAST now due at 250 ms, MEDIUM at 200 ms
+  TEST_ASSERT_FALSE(probes.any_expired());
+  TEST_ASSERT_EQUAL(Probe::MEDIUM, probes.earliest());
+
+  mock::advance_us(60'000);
+  TEST_ASSERT_TRUE(probes.any_expired());
+  TEST_ASSERT_TRUE(probes.expired(Probe::MEDIUM));
+  TEST_ASSERT_FALSE(probes.expired(Probe::FAST));
+}
+
+void test_any_expired_matches_per_key_check() {
+  Probes probes = make_probes();
+  for (int ms = 0; ms < 1'000; ms += 10) {
+    if (ms % 80 == 0) {
+      probes.kick(Probe::FAST);
+    }
+    if (ms % 150 == 0) {
+      probes.kick(Probe::MEDIUM);
+    }
+    if (ms % 400 == 0) {
+      probes.kick(Probe::SLOW);
+    }
+    const bool any = probes.expired(Probe::FAST) || probes.expired(Probe::MEDIUM) ||
+                     probes.expired(Probe::SLOW);
+    TEST_ASSERT_EQUAL(any, probes.any_expired());
+    mock::advance_us(10'000);
+  }
+}
+
+void test_deadlines_survive_micros_wrap() {
+  mock::advance_us(UINT32_MAX - 50'000ULL);
+  Probes probes = make_probes();
+  mock::advance_us(80'000);  // micros() wrapped
+  TEST_ASSERT_FALSE(probes.any_expired());
+  mock::advance_us(20'000);
+  TEST_ASSERT_TRUE(probes.expired(Probe::FAST));
+}
+
+void test_long_silence_stays_expired() {
+  Probes probes = make_probes();
+  mock::advance_us(37ULL * 60 * 1'000'000);  // past 2^31 us
+  TEST_ASSERT_TRUE(probes.any_expired());
+  TEST_ASSERT_TRUE(probes.expired(Probe::SLOW));
+  mock::advance_us(40ULL * 60 * 1'000'000);  // past 2^32 us, elapsed alone wraps
+  TEST_ASSERT_TRUE(probes.any_expired());
+  TEST_ASSERT_TRUE(probes.expired(Probe::FAST));
+  TEST_ASSERT_TRUE(probes.expired(Probe::SLOW));
+
+  probes.kick(Probe::FAST);
+  probes.kick(Probe::MEDIUM);
+  TEST_ASSERT_TRUE(probes.any_expired());
+  TEST_ASSERT_EQUAL(Probe::SLOW, probes.earliest());
+  probes.kick(Probe::SLOW);
+  TEST_ASSERT_FALSE(probes.any_expired());
+  TEST_ASSERT_EQUAL(Probe::FAST, probes.earliest());
+}
+
+void test_stats_track_interval_distribution() {
+  Probes probes = make_probes();  // SLOW: 500 ms timeout, 15.625 ms buckets, near miss > 400 ms
+  for (int i = 0; i < 200; i++) {
+    probes.kick(Probe::SLOW);
+    mock::advance_us(i % 2 == 0 ? 9'000 : 11'000);
+  }
+  probes.kick(Probe::SLOW);
+  mock::advance_us(450'000);  // one late heartbeat
+  probes.kick(Probe::SLOW);
+
+  const HeartbeatStats &stats = probes.stats(Probe::SLOW);
+  TEST_ASSERT_EQUAL_UINT32(202, stats.arrivals());
+  TEST_ASSERT_EQUAL_UINT32(201, stats.intervals());
+  TEST_ASSERT_EQUAL_UINT32(9'000, stats.min_interval_us());
+  TEST_ASSERT_EQUAL_UINT32(450'000, stats.max_interval_us());
+  TEST_ASSERT_UINT32_WITHIN(50, 12'189, stats.mean_interval_us());
+  TEST_ASSERT_EQUAL_UINT32(1, stats.near_misses());
+  // 200 of 201 intervals sit in the first bucket
+  TEST_ASSERT_EQUAL_UINT32(15'625, stats.p99_interval_us());
+  TEST_ASSERT_EQUAL_UINT32(0, probes.stats(Probe::FAST).intervals());
+}
+
+void test_p99_follows_the_tail() {
+  HeartbeatStats stats(100'000);  // 3125 us buckets
+  uint32_t now_us = 0;
+  for (int i = 0; i < 1'000; i++) {
+    stats.record(now_us);
+    now_us += i % 50 == 0 ? 85'000 : 10'000;  // 2 % of the intervals are near misses
+  }
+  TEST_ASSERT_EQUAL_UINT32(20, stats.near_misses());
+  TEST_ASSERT_EQUAL_UINT32(85'000, stats.p99_interval_us());
+  TEST_ASSERT_DOUBLE_WITHIN(2'000.0, 10'773.0, std::sqrt(stats.variance_us2()));
+}
+
+void test_heartbeat_stats_frame_layout() {
+  HeartbeatStats stats(500'000);
+  stats.record(0);
+  stats.record(20'000);
+  stats.record(30'250);
+  const auto msg = create_heartbeat_stats_msg(Component::INVERTER, stats);
+  uint64_t fields = 0;
+  for (std::size_t i = 0; i < 6; i++) {
+    fields |= static_cast<uint64_t>(msg[i + 2]) << (8 * i);
+  }
+  TEST_ASSERT_EQUAL_UINT8(to_underlying(Component::INVERTER), msg[0]);
+  TEST_ASSERT_EQUAL_UINT8(0, msg[1]);
+  TEST_ASSERT_EQUAL_UINT32(41, fields & 0xFFF);          // 10.25 ms
+  TEST_ASSERT_EQUAL_UINT32(60, (fields >> 12) & 0xFFF);  // 15.125 ms
+  TEST_ASSERT_EQUAL_UINT32(stats.p99_interval_us() / 250, (fields >> 24) & 0xFFF);
+  TEST_ASSERT_EQUAL_UINT32(80, (fields >> 36) & 0xFFF);  // 20 ms
+}
+
+void setUp() { mock::reset(); }
+
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_earliest_is_shortest_timeout);
+  RUN_TEST(test_kick_moves_deadline_forward);
+  RUN_TEST(test_any_expired_matches_per_key_check);
+  RUN_TEST(test_deadlines_survive_micros_wrap);
+  RUN_TEST(test_long_silence_stays_expired);
+  RUN_TEST(test_stats_track_interval_distribution);
+  RUN_TEST(test_p99_follows_the_tail);
+  RUN_TEST(test_heartbeat_stats_frame_layout);
+  return UNITY_END();
+}
@@ -0,0 +1,300 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// Ring buffers shared by the boards (C++20), in place of the vendored Circular_Buffer copies.
+// Each ring has one producer and one consumer, typically the loop and an interrupt, and never
+// locks: the producer only moves the tail, the consumer only moves the head, and an index is
+// published with release ordering after the data it covers. Queued data is handed out as
+// std::span views into the ring, so nothing is copied to look at it.
+
+namespace ring {
+
+template <std::size_t N>
+constexpr bool is_power_of_two = N > 0 && (N & (N - 1)) == 0;
+
+/**
+ * @brief Contiguous parts of a ring's queued elements, oldest first; the second part is empty
+ * unless the elements wrap around the end of the storage
+ */
+template <typename T>
+using Regions = std::array<std::span<const T>, 2>;
+
+/**
+ * @brief Bounded single-producer single-consumer queue of elements
+ */
+template <typename T, std::size_t Capacity>
+class SpscRing {
+  static_assert(is_power_of_two<Capacity>, "capacity must be a power of two");
+  static_assert(Capacity <= UINT32_MAX / 2, "indices are free running 32 bit counters");
+  static_assert(std::is_trivially_copyable_v<T>, "elements are copied in and out as bytes");
+  static constexpr uint32_t MASK = Capacity - 1;
+
+public:
+  static constexpr std::size_t capacity() { return Capacity; }
+
+  [[nodiscard]] std::size_t size() const {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] bool empty() const { return size() == 0; }
+  [[nodiscard]] bool full() const { return size() == Capacity; }
+
+  /**
+   * @brief Producer only
+   * @return false if the ring is full, the value is not queued
+   */
+  bool push(const T &value) {
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+    items_[tail & MASK] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Consumer only
+   */
+  bool pop(T &value) {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    if (tail_.load(std::memory_order_acquire) == head) {
+      return false;
+    }
+    value = items_[head & MASK];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Consumer only: the queued elements in place, valid until they are consumed
+   */
+  [[nodiscard]] Regions<T> peek() const {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    const uint32_t count = tail_.load(std::memory_order_acquire) - head;
+    const uint32_t start = head & MASK;
+    const uint32_t first = std::min<uint32_t>(count, Capacity - start);
+    return {std::span<const T>(&items_[start], first),
+            std::span<const T>(items_.data(), count - first)};
+  }
+
+  /**
+   * @brief Consumer only: drops the count oldest elements, after reading them through peek()
+   */
+  void consume(const std::size_t count) {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    const auto queued = tail_.load(std::memory_order_acquire) - head;
+    head_.store(head + static_cast<uint32_t>(std::min<std::size_t>(count, queued)),
+                std::memory_order_release);
+  }
+
+private:
+  std::array<T, Capacity> items_{};
+  std::atomic<uint32_t> head_{0};  ///< next to read, written by the consumer
+  std::atomic<uint32_t> tail_{0};  ///< next to write, written by the producer
+};
+
+/**
+ * @brief Bounded single-producer single-consumer queue of packets of up to MaxLength elements,
+ * one fixed size slot each
+ * @details The consumer reads the front packet in place for as long as it needs (e.g. a whole SPI
+ * transaction) and pops it when done. The producer can update a queued packet with replace(),
+ * which never touches the front one for that reason.
+ */
+template <typename T, std::size_t Slots, std::size_t MaxLength>
+class PacketRing {
+  static_assert(is_power_of_two<Slots>, "slot count must be a power of two");
+  static_assert(MaxLength > 0 && MaxLength <= UINT16_MAX, "packet length is kept in 16 bits");
+  static_assert(std::is_trivially_copyable_v<T>, "packets are copied in as bytes");
+  static constexpr uint32_t MASK = Slots - 1;
+
+public:
+  static constexpr std::size_t capacity() { return Slots; }
+  static constexpr std::size_t max_length() { return MaxLength; }
+
+  [[nodiscard]] std::size_t size() const {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Producer only
+   * @return false if the ring is full or the packet longer than MaxLength
+   */
+  bool push(const std::span<const T> packet) {
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (packet.size() > MaxLength || tail - head_.load(std::memory_order_acquire) == Slots) {
+      return false;
+    }
+    write(slots_[tail & MASK], packet);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Producer only: overwrites the first queued packet after the front one for which
+   * match(packet) is true
+   * @details The consumer may start reading a replaced packet while it is written if it pops the
+   * front one at that moment; packets that must not be torn need their own check (e.g. checksum).
+   * @return false if none matched or the packet is longer than MaxLength
+   */
+  template <typename Match>
+  bool replace(const std::span<const T> packet, Match &&match) {
+    if (packet.size() > MaxLength) {
+      return false;
+    }
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    for (uint32_t i = head_.load(std::memory_order_acquire) + 1;
+         static_cast<int32_t>(tail - i) > 0; i++) {
+      Slot &slot = slots_[i & MASK];
+      if (match(view(slot))) {
+        write(slot, packet);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Queued packet in place, 0 being the oldest; empty past the last one
+   */
+  [[nodiscard]] std::span<const T> peek(const std::size_t entry = 0) const {
+    const uint32_t head = head_.load(std::memory_order_acquire);
+    if (entry >= tail_.load(std::memory_order_acquire) - head) {
+      return {};
+    }
+    return view(slots_[(head + entry) & MASK]);
+  }
+
+  /**
+   * @brief Consumer only: the oldest packet, stable until pop()
+   */
+  [[nodiscard]] std::span<const T> front() const { return peek(0); }
+
+  /**
+   * @brief Consumer only
+   */
+  void pop() {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    if (tail_.load(std::memory_order_acquire) != head) {
+      head_.store(head + 1, std::memory_order_release);
+    }
+  }
+
+private:
+  struct Slot {
+    uint16_t length;
+    std::array<T, MaxLength> items;
+  };
+
+  static std::span<const T> view(const Slot &slot) {
+    return std::span<const T>(slot.items.data(), slot.length);
+  }
+
+  static void write(Slot &slot, const std::span<const T> packet) {
+    std::copy(packet.begin(), packet.end(), slot.items.begin());
+    slot.length = static_cast<uint16_t>(packet.size());
+  }
+
+  std::array<Slot, Slots> slots_{};
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+};
+
+/**
+ * @brief Statistics over a ring's queued elements (SpscRing::peek()), which they never reorder
+ */
+namespace stats {
+
+template <typename T, typename F>
+void for_each(const Regions<T> &regions, F &&f) {
+  for (const auto &region : regions) {
+    for (const T &value : region) {
+      f(value);
+    }
+  }
+}
+
+template <typename T>
+std::size_t count(const Regions<T> &regions) {
+  return regions[0].size() + regions[1].size();
+}
+
+template <typename T>
+double sum(const Regions<T> &regions) {
+  double total = 0;
+  for_each(regions, [&total](const T &value) { total += static_cast<double>(value); });
+  return total;
+}
+
+template <typename T>
+double mean(const Regions<T> &regions) {
+  const std::size_t n = count(regions);
+  return n == 0 ? 0.0 : sum(regions) / static_cast<double>(n);
+}
+
+/**
+ * @brief Population variance
+ */
+template <typename T>
+double variance(const Regions<T> &regions) {
+  const std::size_t n = count(regions);
+  if (n == 0) {
+    return 0.0;
+  }
+  const double average = mean(regions);
+  double squares = 0;
+  for_each(regions, [&](const T &value) {
+    const double deviation = static_cast<double>(value) - average;
+    squares += deviation * deviation;
+  });
+  return squares / static_cast<double>(n);
+}
+
+template <typename T>
+T min(const Regions<T> &regions) {
+  T result{};
+  bool first = true;
+  for_each(regions, [&](const T &value) {
+    result = first || value < result ? value : result;
+    first = false;
+  });
+  return result;
+}
+
+template <typename T>
+T max(const Regions<T> &regions) {
+  T result{};
+  bool first = true;
+  for_each(regions, [&](const T &value) {
+    result = first || result < value ? value : result;
+    first = false;
+  });
+  return result;
+}
+
+/**
+ * @brief Median (upper one for an even count), ordered in scratch, which must hold every element
+ * @return T{} if there are no elements or scratch is too small
+ */
+template <typename T>
+T median(const Regions<T> &regions, const std::span<T> scratch) {
+  const std::size_t n = count(regions);
+  if (n == 0 || scratch.size() < n) {
+    return T{};
+  }
+  auto out = std::copy(regions[0].begin(), regions[0].end(), scratch.begin());
+  std::copy(regions[1].begin(), regions[1].end(), out);
+  const auto middle = scratch.begin() + static_cast<std::ptrdiff_t>(n / 2);
+  std::nth_element(scratch.begin(), middle, scratch.begin() + static_cast<std::ptrdiff_t>(n));
+  return *middle;
+}
+
+}  // namespace stats
+
+}  // namespace ring
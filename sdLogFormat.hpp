@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief On-card binary format written by the master SD logger and read by the host decoder
+ * @details The file is a sequence of fixed 512-byte blocks. Every block starts with a BlockHeader.
+ * The first block(s) of a file are SCHEMA blocks, listing one ColumnDescriptor per column of each
+ * table. The remaining blocks hold data for exactly one table, stored column by column: column i
+ * starts at sizeof(BlockHeader) + capacity * (sum of the sizes of columns 0..i-1), so a decoder
+ * only needs the schema to locate any value. All values are little-endian.
+ *
+ * The first SCHEMA block carries a per-file base sequence and every later block continues it by
+ * one, in file order. The file is preallocated and the car may be switched off before the logger
+ * trims it, so it can end in unused clusters holding anything, blocks of older logs included; the
+ * first block that does not continue the sequence is the end of the data.
+ */
+namespace sdlog {
+
+constexpr std::size_t BLOCK_SIZE = 512;
+constexpr uint16_t BLOCK_MAGIC = 0xB10C;
+constexpr uint32_t FILE_MAGIC = 0x474F4C46;  // "FLOG"
+constexpr uint16_t FORMAT_VERSION = 1;
+constexpr std::size_t COLUMN_NAME_LENGTH = 28;
+
+enum class BlockKind : uint8_t {
+  SCHEMA = 0,
+  DATA = 1,
+};
+
+enum class TableId : uint8_t {
+  SAMPLES = 0,  // periodic snapshot of the system data
+  CAN_RX = 1,   // every frame received on the AS bus
+};
+
+enum class ColumnType : uint8_t {
+  U8 = 0,
+  I8 = 1,
+  U16 = 2,
+  I16 = 3,
+  U32 = 4,
+  I32 = 5,
+  F32 = 6,
+  U64 = 7,
+  F64 = 8,
+};
+
+constexpr std::size_t column_type_size(ColumnType type) {
+  switch (type) {
+    case ColumnType::U8:
+    case ColumnType::I8:
+      return 1;
+    case ColumnType::U16:
+    case ColumnType::I16:
+      return 2;
+    case ColumnType::U32:
+    case ColumnType::I32:
+    case ColumnType::F32:
+      return 4;
+    case ColumnType::U64:
+    case ColumnType::F64:
+      return 8;
+  }
+  return 0;
+}
+
+#pragma pack(push, 1)
+struct BlockHeader {
+  uint16_t magic;     // BLOCK_MAGIC
+  uint8_t kind;       // BlockKind
+  uint8_t table;      // TableId for DATA blocks, unused for SCHEMA blocks
+  uint16_t rows;      // valid rows (DATA) or descriptors (SCHEMA) in this block
+  uint16_t capacity;  // rows the column layout was sized for
+  uint32_t sequence;  // previous block's + 1, wraps
+  uint32_t dropped;   // rows dropped by the producer since the previous block of this table
+};
+
+/**
+ * @brief Present right after the BlockHeader of the first SCHEMA block only
+ */
+struct FileInfo {
+  uint32_t magic;           // FILE_MAGIC
+  uint16_t version;         // FORMAT_VERSION
+  uint16_t column_count;    // total descriptors over all SCHEMA blocks
+  uint16_t schema_blocks;   // number of SCHEMA blocks at the start of the file
+  uint16_t reserved;
+  uint32_t start_millis;    // millis() when the file was opened
+};
+
+struct ColumnDescriptor {
+  char name[COLUMN_NAME_LENGTH];  // NUL padded
+  uint8_t type;                   // ColumnType
+  uint8_t table;                  // TableId
+  uint16_t reserved;
+};
+#pragma pack(pop)
+
+/**
+ * @brief Whether sequence a was written before b, across the wrap
+ */
+constexpr bool sequence_before(const uint32_t a, const uint32_t b) {
+  return static_cast<int32_t>(a - b) < 0;
+}
+
+static_assert(sizeof(BlockHeader) == 16);
+static_assert(sizeof(FileInfo) == 16);
+static_assert(sizeof(ColumnDescriptor) == 32);
+
+constexpr std::size_t BLOCK_PAYLOAD = BLOCK_SIZE - sizeof(BlockHeader);
+constexpr std::size_t FIRST_SCHEMA_DESCRIPTORS =
+    (BLOCK_PAYLOAD - sizeof(FileInfo)) / sizeof(ColumnDescriptor);
+constexpr std::size_t SCHEMA_DESCRIPTORS = BLOCK_PAYLOAD / sizeof(ColumnDescriptor);
+
+/**
+ * @brief Number of rows of a table that fit in one DATA block
+ * @param row_size sum of the sizes of all columns of the table
+ */
+constexpr uint16_t rows_per_block(std::size_t row_size) {
+  return row_size == 0 ? 0 : static_cast<uint16_t>(BLOCK_PAYLOAD / row_size);
+}
+
+}  // namespace sdlog
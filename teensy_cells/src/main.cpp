@@ -307,6 +307,8 @@ void can_receive_from_master(const CAN_message_t& msg) {
   if (msg.id == CELL_TEMPS_BASE_ID) {
     last_master_message_time = millis();
     master_has_communicated = true;
+  } else if (msg.id == DEBUG_LOG_CONFIG_ID) {
+    debug_log::apply_log_config(msg.buf, msg.len, DEBUG_LOG_BOARD_CELLS);
   }
   last_message_received_time = millis();
 }
@@ -314,16 +316,15 @@ void can_receive_from_master(const CAN_message_t& msg) {
 #endif
 
 void can_snifflas(const CAN_message_t& msg) {
-  // DEBUG_PRINT("Received CAN message with ID: ");
-  // Serial.println(msg.id, HEX);
-  if (msg.id >= CELL_TEMPS_BASE_ID && msg.id < CELL_TEMPS_BASE_ID + TOTAL_BOARDS && msg.len == 4) {
+  if (msg.id == DEBUG_LOG_CONFIG_ID) {
+    debug_log::apply_log_config(msg.buf, msg.len, DEBUG_LOG_BOARD_CELLS);
+  } else if (msg.id >= CELL_TEMPS_BASE_ID && msg.id < CELL_TEMPS_BASE_ID + TOTAL_BOARDS &&
+             msg.len == 4) {
     uint8_t board_from_id = msg.id - CELL_TEMPS_BASE_ID;
     uint8_t board_from_buf = msg.buf[0];
     if (board_from_id != board_from_buf) {
-      DEBUG_PRINT("Warning: Board ID mismatch - ID from message: ");
-      DEBUG_PRINT(board_from_id);
-      DEBUG_PRINT(", ID from payload: ");
-      DEBUG_PRINTLN(board_from_buf);
+      LOG_WARN(LOG_CAN, "Board ID mismatch - ID from message: %u, ID from payload: %u",
+               board_from_id, board_from_buf);
       return;
     }
 
@@ -334,8 +335,7 @@ void can_snifflas(const CAN_message_t& msg) {
       board_temps[board_from_id].has_communicated = true;
       board_temps[board_from_id].last_update_ms = millis();
     } else {
-      DEBUG_PRINT("Error: Invalid board ID: ");
-      DEBUG_PRINTLN(board_from_id);
+      LOG_ERROR(LOG_CAN, "Invalid board ID: %u", board_from_id);
     }
   }
   last_message_received_time = millis();
@@ -382,6 +382,7 @@ void initialize_can(uint32_t baudRate) {
   can1.setFIFOFilter(TOTAL_BOARDS, HC_ID, STD);
   can1.setFIFOFilter(TOTAL_BOARDS + 1, MASTER_ID, STD);  // Set filter for master messages
   can1.setFIFOFilter(TOTAL_BOARDS + 2, BMS_ID_CCL, STD);  // Set filter for master messages
+  can1.setFIFOFilter(TOTAL_BOARDS + 3, DEBUG_LOG_CONFIG_ID, STD);
 
   can1.onReceive(can_snifflas);
   DEBUG_PRINTLN("CAN filters configured for all board IDs");
@@ -391,6 +392,7 @@ void initialize_can(uint32_t baudRate) {
   can1.setFIFOFilter(1, HC_ID, STD);
   can1.setFIFOFilter(2, MASTER_ID, STD);  // Set filter for master messages
   can1.setFIFOFilter(3, BMS_ID_CCL, STD);  // Set filter for master messages
+  can1.setFIFOFilter(4, DEBUG_LOG_CONFIG_ID, STD);
 
   can1.onReceive(can_receive_from_master);
   DEBUG_PRINTLN("CAN filter configured for master messages");
@@ -431,8 +433,7 @@ void send_can_all_temps() {
     if (send_can_message(msg)) {
       // DEBUG_PRINTLN("Sent CAN message chunk with temperatures");
     } else {
-      DEBUG_PRINT("Failed to send CAN message chunk ");
-      DEBUG_PRINTLN(msg_index);
+      LOG_WARN(LOG_CAN, "Failed to send CAN message chunk %u", msg_index);
     }
   }
 }
@@ -523,9 +524,10 @@ void loop() {
     no_error_iterations = 0;
   }
   static elapsedMillis debug_timer;
-  if (debug_timer >= 1500) {
+  if (LOG_ENABLED(LOG_LEVEL_INFO, LOG_TEMP) && debug_timer >= 1500) {
     debug_helper();
     show_temperatures();
     debug_timer = 0;
   }
+  DEBUG_LOG_FLUSH();
 }
\ No newline at end of file
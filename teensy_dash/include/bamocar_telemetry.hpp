@@ -0,0 +1,99 @@
+#pragma once
+#include <FlexCAN_T4.h>
+
+#include <array>
+#include <cstdint>
+
+#include "../../CAN_IDs.h"
+
+/**
+ * @brief Which Bamocar registers the dash reads and how often: the inverter is asked to send each
+ * one cyclically (0x3D, RegID, period), replies are timed as they arrive and a register that goes
+ * quiet is asked for again
+ * @details on_reply() runs in the CAN receive interrupt, everything else in the loop. The reply
+ * fields are single 32 bit words, so the loop reads them without masking interrupts.
+ */
+class BamocarTelemetry {
+public:
+  struct Register {
+    uint8_t reg;
+    uint8_t period_ms;  ///< cyclic transmission period asked of the inverter, 1..254
+  };
+
+  static constexpr std::size_t SIZE = 5;
+  // Periods are a few ms apart so the replies drift instead of always arriving together
+  static constexpr std::array<Register, SIZE> PLAN{{
+      {DC_VOLTAGE, 100},
+      {SPEED_ACTUAL, 251},
+      {CURRENT_ACTUAL, 250},
+      {LOGICMAP_ERRORS, 238},
+      {MOTOR_TEMPERATURE, 239},
+  }};
+
+  static constexpr uint32_t QUIET_PERIODS = 4;          ///< periods without a reply until quiet
+  static constexpr uint32_t RETRY_INTERVAL_MS = 500;    ///< between requests of a quiet register
+  static constexpr uint8_t MAX_REQUESTS_PER_UPDATE = 2;  ///< TX queue is shared with the loop
+  static constexpr uint32_t MAX_REPLIES_PER_SECOND = 100;
+  static constexpr uint32_t NEVER = UINT32_MAX;
+
+  static constexpr uint32_t replies_per_second() {
+    uint32_t total = 0;
+    for (const auto& entry : PLAN) {
+      total += (1000 + entry.period_ms - 1) / entry.period_ms;
+    }
+    return total;
+  }
+
+  /**
+   * @brief Records a reply, called from the CAN receive interrupt; other registers are ignored
+   */
+  void on_reply(uint8_t reg, uint32_t now_ms);
+
+  /**
+   * @brief Next cyclic transmission request that is due: registers never requested, then quiet
+   * ones, each at most every RETRY_INTERVAL_MS
+   * @return false if none is due
+   */
+  bool next_request(uint32_t now_ms, CAN_message_t& request);
+
+  /**
+   * @brief Time since the last reply of a register, NEVER if it has not replied (or is not in
+   * the plan)
+   */
+  [[nodiscard]] uint32_t age_ms(uint8_t reg, uint32_t now_ms) const;
+
+  /**
+   * @brief Average time between replies, 0 until two arrived
+   */
+  [[nodiscard]] uint32_t measured_period_ms(uint8_t reg) const;
+
+  [[nodiscard]] bool is_fresh(const uint8_t reg, const uint32_t now_ms) const {
+    const int index = index_of(reg);
+    return index >= 0 && age_ms(reg, now_ms) <= QUIET_PERIODS * PLAN[index].period_ms;
+  }
+
+  [[nodiscard]] uint16_t requests(uint8_t reg) const;
+
+private:
+  struct State {
+    volatile uint32_t last_reply_ms = 0;
+    volatile uint32_t period_ms = 0;  ///< moving average (1/8) of the reply interval
+    volatile uint32_t replies = 0;
+    uint32_t last_request_ms = 0;
+    uint16_t requests = 0;
+  };
+
+  static constexpr int index_of(const uint8_t reg) {
+    for (std::size_t i = 0; i < SIZE; i++) {
+      if (PLAN[i].reg == reg) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+  std::array<State, SIZE> states{};
+};
+
+static_assert(BamocarTelemetry::replies_per_second() <= BamocarTelemetry::MAX_REPLIES_PER_SECOND,
+              "telemetry plan is too dense");
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "can_comm_handler.hpp"
+#include "data_struct.hpp"
+#include "pedal_map.hpp"
+#include "torque_task.hpp"
+
+/**
+ * @brief Pedal calibration: records the ends of both APPS and the brake sensor, keeps them in
+ * EEPROM and hands them to the torque task
+ * @details Starts in IDLE with the TS off, when R2D and display are held together for
+ * config::calibration::HOLD_MS or on CALIBRATION_START; the driver then presses the pedal and the
+ * brake fully a few times. The same hold or CALIBRATION_SAVE checks the recorded ends and stores
+ * them, CALIBRATION_ABORT, the TS coming on or TIMEOUT_MS drop them. The EEPROM record carries a
+ * CRC-32; begin() loads it and falls back to the io_settings ends when it is missing or corrupt.
+ * Runs in the loop, every change goes out in a CALIBRATION_STATUS frame.
+ */
+class CalibrationMode {
+public:
+  enum Result : uint8_t {
+    NONE,
+    SAVED,
+    ABORTED,
+    TIMED_OUT,
+    REFUSED,              ///< not in IDLE or TS on
+    APPS_HIGHER_INVALID,  ///< span too short or an end out of the range bounds
+    APPS_LOWER_INVALID,
+    APPS_TOO_CLOSE,  ///< the two APPS would read as shorted
+    BRAKE_INVALID,
+  };
+
+  CalibrationMode(SystemData& system_data, SystemVolatileData& current_updated_data,
+                  TorqueTask& torque_task, CanCommHandler& can_handler);
+
+  /**
+   * @brief Loads the stored calibration into the torque task, before it starts
+   */
+  void begin();
+  void update();
+
+  [[nodiscard]] bool recording() const { return recording_; }
+  [[nodiscard]] Result result() const { return result_; }
+  [[nodiscard]] bool stored() const { return stored_; }
+  [[nodiscard]] const PedalCalibration& calibration() const { return calibration_; }
+
+  /**
+   * @return NONE if the calibration can be used, otherwise what is wrong with it
+   */
+  static Result check(const PedalCalibration& calibration);
+  /**
+   * @return false if there is no valid record, calibration is left untouched
+   */
+  static bool load(PedalCalibration& calibration);
+  static void save(const PedalCalibration& calibration);
+  static uint32_t crc32(const uint8_t* bytes, std::size_t size);
+
+private:
+  struct Record {
+    uint32_t magic;
+    PedalCalibration calibration;
+    uint32_t crc;  ///< of everything before it
+  };
+
+  void start();
+  void record();
+  void finish();
+  void stop(Result result);
+  void report() const;
+
+  SystemData& data;
+  SystemVolatileData& updated_data;
+  TorqueTask& torque_task;
+  CanCommHandler& can_handler;
+
+  PedalCalibration calibration_;
+  PedalCalibration recorded;
+  bool recording_ = false;
+  bool stored_ = false;
+  Result result_ = NONE;
+  uint32_t start_ms = 0;
+};
@@ -4,7 +4,9 @@
 
 #include <cstdint>
 
+#include "bamocar_telemetry.hpp"
 #include "data_struct.hpp"
+#include "inverter_profiles.hpp"
 // #include "spi/SPI_MSTransfer_T4.h"
 
 class CanCommHandler {
@@ -15,15 +17,37 @@ public:
   void setup();
   bool init_bamocar();
   void reset_bamocar_init();
+  void recover_bamocar();
+  [[nodiscard]] bool bamocar_init_failed() const { return bamocar_state == ERROR; }
+  [[nodiscard]] const BamocarInitReport& bamocar_init_report() const { return init_report; }
   void stop_bamocar();
   void write_messages();
+  // From the torque task interrupt, straight to the controller
   void send_torque(int torque);
+  void send_torque_status(uint32_t frames, uint16_t command, uint16_t target,
+                          uint32_t max_latency_us);
+
+  /**
+   * @brief CALIBRATION_STATUS frame: recording, CalibrationMode::Result, calibration from EEPROM
+   */
+  void write_calibration_status(bool recording, uint8_t result, bool stored);
+  /**
+   * @brief Latest DASH_CALIBRATION_ID command, 0 if none arrived since the last call
+   */
+  uint8_t take_calibration_command();
+
+  [[nodiscard]] const BamocarTelemetry& bamocar_telemetry() const { return telemetry; }
+  [[nodiscard]] const InverterProfiles& inverter_profiles() const { return profiles; }
 
 private:
   BamocarState bamocar_state = CLEAR_ERRORS;
   unsigned long state_start_time = millis();
   unsigned long last_action_time = 0;
   bool command_sent = false;
+  uint8_t init_attempt = 0;
+  unsigned long attempt_start_time = 0;
+  unsigned long retry_delay_ms = 0;
+  BamocarInitReport init_report;
   static inline std::function<void(const CAN_message_t&)> static_callback;
   static void can_snifflas(const CAN_message_t& msg);
   void handle_can_message(const CAN_message_t& msg);
@@ -45,8 +69,14 @@ private:
   elapsedMillis apps_timer;       // Timer for APPS messages
   volatile bool transmission_enabled = false;
   volatile bool btb_ready = false;
+  volatile uint8_t calibration_command = 0;
+  BamocarTelemetry telemetry;
+  InverterProfiles profiles;
 
+  void write(const CAN_message_t& msg);
   void send_bamo_requests();
+  void enter_init_step(BamocarState next, unsigned long now);
+  void retry_bamocar_init(unsigned long now);
   void write_rpm();
   void write_apps();
   void write_dash_state();
@@ -37,10 +37,23 @@ enum BamocarState {
   DEC_RAMP,
   INITIALIZED,
   ERROR,
-  CLEAR_ERRORS
+  CLEAR_ERRORS,
+  RETRY_WAIT,  // backoff between attempts
+  BAMOCAR_STATE_COUNT
 };
 constexpr unsigned long STABLE_TIME_MS = 150;
 
+/**
+ * @brief Outcome and timing of the latest inverter bring-up attempt
+ */
+struct BamocarInitReport {
+  uint8_t attempt = 0;                     // 1.. since the last fresh start
+  BamocarState failed_step = INITIALIZED;  // INITIALIZED if it did not fail
+  uint16_t error_bitmap = 0;               // inverter errors when it ended
+  uint32_t step_ms[BAMOCAR_STATE_COUNT] = {};
+  uint32_t total_ms = 0;
+};
+
 struct InverterModeParams {
   int i_max_pk_percent = 0;
   int speed_limit_percent = 0;
@@ -57,6 +70,7 @@ struct SystemData {
   bool ats_pressed = false;
   bool implausibility = false;
   bool display_pressed = false;
+  bool calibration_combo = false;  // R2D and display held for config::calibration::HOLD_MS
   SwitchMode switch_mode = SwitchMode::INVERTER_MODE_SCRUT;
   bool buzzer_active = false;
   unsigned long buzzer_start_time;
@@ -94,6 +108,10 @@ struct SystemVolatileData {
   unsigned long second_to_last_wheel_pulse_fr = 0;
   unsigned long last_wheel_pulse_fl = 0;
   unsigned long second_to_last_wheel_pulse_fl = 0;
+
+  uint16_t apps_higher = 0;  // latest samples of the torque task
+  uint16_t apps_lower = 0;
+  uint16_t hydraulic_pressure = 0;
 };
 
 inline void copy_volatile_data(SystemVolatileData& dest, volatile SystemVolatileData const& src) {
@@ -120,5 +138,8 @@ inline void copy_volatile_data(SystemVolatileData& dest, volatile SystemVolatile
     }
   }
   dest.hv_soc = src.hv_soc;
+  dest.apps_higher = src.apps_higher;
+  dest.apps_lower = src.apps_lower;
+  dest.hydraulic_pressure = src.hydraulic_pressure;
   interrupts();
 }
\ No newline at end of file
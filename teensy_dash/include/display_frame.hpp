@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../../CAN_IDs.h"
+
+/**
+ * @brief Widget values sent to the display as one WIDGET_FRAME packet, in a single transaction
+ * @details TLV entries: widget ID, value count, values. Adding a widget that is already in the frame
+ * replaces its values, so a frame the display has not read yet can be merged into the next one.
+ */
+class DisplayFrame {
+public:
+  static constexpr uint16_t PACKET_WORDS = 128;  ///< SPI_MST_DATA_BUFFER_MAX, see spi_handler.hpp
+  static constexpr uint16_t CAPACITY = PACKET_WORDS - 5;  // transfer16 header words
+
+  /**
+   * @return false if the entry does not fit, the frame is left as it was
+   */
+  bool add(uint16_t widget_id, const uint16_t* values, uint16_t count);
+  bool add(const uint16_t widget_id, const uint16_t value) { return add(widget_id, &value, 1); }
+  void clear() { length = 0; }
+
+  [[nodiscard]] const uint16_t* data() const { return words; }
+  [[nodiscard]] uint16_t size() const { return length; }
+
+private:
+  uint16_t words[CAPACITY] = {};
+  uint16_t length = 0;
+};
+
+/**
+ * @brief Shadow of what the display shows, so only widgets that changed are sent
+ * @details A widget is dirty when its value moved from the last one sent by more than its
+ * dead-band, or when everything is invalidated (full refresh, display form change).
+ */
+class WidgetCache {
+public:
+  struct Widget {
+    uint16_t id;
+    uint16_t deadband;  ///< change too small to be worth a transfer
+    uint16_t value = 0;
+    uint16_t sent = 0;
+  };
+
+  static constexpr std::size_t SIZE = 11;
+
+  void set(uint16_t id, uint16_t value);
+  void invalidate() { dirty = ALL_DIRTY; }
+
+  /**
+   * @brief Adds the dirty widgets to the frame and records them as sent
+   * @return widgets added
+   */
+  uint8_t flush(DisplayFrame& frame);
+
+private:
+  static_assert(SIZE <= 16, "one dirty bit per widget");
+  static constexpr uint16_t ALL_DIRTY = (1U << SIZE) - 1;
+
+  std::array<Widget, SIZE> widgets{{
+      {WIDGET_THROTTLE, 1},  // %
+      {WIDGET_BRAKE, 3},     // ADC counts
+      {WIDGET_SPEED, 0},
+      {WIDGET_CELLS_MIN, 0},
+      {WIDGET_CELLS_MAX, 0},
+      {WIDGET_INVERTER_ERRORS, 0},
+      {WIDGET_INVERTER_WARNINGS, 0},
+      {WIDGET_LV_SOC, 0},
+      {WIDGET_HV_SOC, 0},
+      {WIDGET_INVERTER_MODE, 0},
+      {WIDGET_AUTONOMOUS_MISSION, 0},
+  }};
+  uint16_t dirty = ALL_DIRTY;  ///< bit i: widgets[i]
+};
@@ -1,9 +1,9 @@
 #pragma once
-#include <Bounce2.h>
-
 #include <cstdint>
 
+#include "../../inputConditioning.hpp"
 #include "data_struct.hpp"
+#include "io_settings.hpp"
 
 class IOManager {
 public:
@@ -29,7 +29,12 @@ private:
   inline static IOManager* instance = nullptr;
   void update_buzzer() const;
   static void read_pins_handle_leds();
-  Bounce r2d_button = Bounce();
-  Bounce ats_button = Bounce();
-  Bounce display_button = Bounce();
+  static int read_analog(uint8_t pin);
+  void read_buttons();
+
+  enum Button : uint8_t { R2D_BUTTON, ATS_BUTTON, DISPLAY_BUTTON, NUM_BUTTONS };
+  InputConditioner<NUM_BUTTONS> buttons{{config::buttons::STABLE_US, config::buttons::STABLE_US,
+                                         config::buttons::STABLE_US}};
+  bool combo_armed = false;
+  uint32_t combo_start_us = 0;
 };
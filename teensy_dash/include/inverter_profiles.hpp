@@ -0,0 +1,169 @@
+#pragma once
+#include <FlexCAN_T4.h>
+
+#include <array>
+#include <cstdint>
+
+#include "../../CAN_IDs.h"
+#include "data_struct.hpp"
+
+/**
+ * @brief Inverter limits of each SwitchMode and what the inverter was last confirmed to hold
+ * @details A mode change only writes the registers whose value differs from the cache. Every
+ * write is followed by a read of the register (0x3D, RegID, 0); the value is cached once the reply
+ * matches what was written, otherwise it is written again after READBACK_TIMEOUT_MS, at most
+ * MAX_WRITES times. Only the bits a reply carries are cached: a 16 bit reply confirms the low half
+ * of a 32 bit ramp and stops the rewrites, but the ramp stays out of sync and is uploaded again on
+ * the next mode change. on_reply() runs in the CAN receive interrupt, everything else in the loop.
+ */
+class InverterProfiles {
+public:
+  static constexpr std::size_t MODES = static_cast<std::size_t>(SwitchMode::INVERTER_MODE_INIT);
+  static constexpr std::array<InverterModeParams, MODES> PROFILES{{
+      {.i_max_pk_percent = 11,  // SCRUT
+       .speed_limit_percent = 11,
+       .i_cont_percent = 11,
+       .speed_ramp_acc = 1000,
+       .moment_ramp_acc = 500,
+       .speed_ramp_brake = 1000,
+       .moment_ramp_decc = 500},
+      {.i_max_pk_percent = 44,  // CRUISING
+       .speed_limit_percent = 33,
+       .i_cont_percent = 22,
+       .speed_ramp_acc = 1000,
+       .moment_ramp_acc = 500,
+       .speed_ramp_brake = 1000,
+       .moment_ramp_decc = 500},
+      {.i_max_pk_percent = 44,  // AS_ACCELERATION
+       .speed_limit_percent = 33,
+       .i_cont_percent = 33,
+       .speed_ramp_acc = 1000,
+       .moment_ramp_acc = 500,
+       .speed_ramp_brake = 1000,
+       .moment_ramp_decc = 500},
+      {.i_max_pk_percent = 50,  // SKIDPAD, Mangueiras Skidpad
+       .speed_limit_percent = 100,
+       .i_cont_percent = 44,
+       .speed_ramp_acc = 1000,
+       .moment_ramp_acc = 500,
+       .speed_ramp_brake = 1000,
+       .moment_ramp_decc = 500},
+      {.i_max_pk_percent = 55,  // ENDURANCE, Chicão Endurance
+       .speed_limit_percent = 55,
+       .i_cont_percent = 44,
+       .speed_ramp_acc = 1000,
+       .moment_ramp_acc = 500,
+       .speed_ramp_brake = 1000,
+       .moment_ramp_decc = 500},
+      {.i_max_pk_percent = 66,  // AUTOCROSS, FAST ENDURANCE
+       .speed_limit_percent = 55,
+       .i_cont_percent = 44,
+       .speed_ramp_acc = 1000,
+       .moment_ramp_acc = 500,
+       .speed_ramp_brake = 500,
+       .moment_ramp_decc = 250},
+      {.i_max_pk_percent = 60,  // ACCELERATION, Aceleração
+       .speed_limit_percent = 70,
+       .i_cont_percent = 44,
+       .speed_ramp_acc = 1000,
+       .moment_ramp_acc = 500,
+       .speed_ramp_brake = 1000,
+       .moment_ramp_decc = 500},
+      {.i_max_pk_percent = 55,  // FAST_ACCELERATION
+       .speed_limit_percent = 75,
+       .i_cont_percent = 44,
+       .speed_ramp_acc = 1000,
+       .moment_ramp_acc = 500,
+       .speed_ramp_brake = 1000,
+       .moment_ramp_decc = 500},
+  }};
+
+  // Registers in upload order; the ramps are 32 bit, speed ramp in the low half
+  static constexpr std::size_t SIZE = 5;
+  static constexpr std::array<uint8_t, SIZE> REGISTERS = {
+      DEVICE_I_MAX, SPEED_LIMIT, DEVICE_I_CNT, SPEED_DELTAMA_ACC, SPEED_DELTAMA_DECC};
+  using Values = std::array<uint32_t, SIZE>;
+
+  static constexpr uint32_t MAX_I_VALUE = 16383;
+  static constexpr uint32_t MAX_SPEED_VALUE = 32767;
+  static constexpr uint32_t READBACK_TIMEOUT_MS = 100;
+  static constexpr uint8_t MAX_WRITES = 3;
+  static constexpr uint8_t MAX_FRAMES_PER_UPDATE = 4;  ///< TX queue is shared with the loop
+
+  /**
+   * @brief Register values of a mode, all zero for INVERTER_MODE_INIT
+   */
+  static constexpr Values values_of(const SwitchMode mode) {
+    const auto index = static_cast<std::size_t>(mode);
+    if (index >= MODES) {
+      return {};
+    }
+    const InverterModeParams& params = PROFILES[index];
+    const auto percent = [](const int value, const uint32_t max) {
+      return static_cast<uint32_t>(value) * max / 100;
+    };
+    const auto ramp = [](const int speed, const int moment) {
+      return static_cast<uint32_t>(speed) | static_cast<uint32_t>(moment) << 16;
+    };
+    return {percent(params.i_max_pk_percent, MAX_I_VALUE),
+            percent(params.speed_limit_percent, MAX_SPEED_VALUE),
+            percent(params.i_cont_percent, MAX_I_VALUE),
+            ramp(params.speed_ramp_acc, params.moment_ramp_acc),
+            ramp(params.speed_ramp_brake, params.moment_ramp_decc)};
+  }
+
+  /**
+   * @brief Makes mode the one to upload
+   * @return number of registers that differ from what the inverter holds
+   */
+  uint8_t select(SwitchMode mode);
+
+  /**
+   * @brief Next write or read-back frame that is due
+   * @return false if none is due
+   */
+  bool next_frame(uint32_t now_ms, CAN_message_t& frame);
+
+  /**
+   * @brief Records a read-back, called from the CAN receive interrupt; other registers are
+   * ignored
+   * @param mask bits the reply carries, 16 bit replies only confirm the low half
+   */
+  void on_reply(uint8_t reg, uint32_t value, uint32_t mask);
+
+  /**
+   * @brief Forgets the cached values, e.g. when the inverter may have restarted
+   */
+  void invalidate();
+
+  [[nodiscard]] bool in_sync() const;
+  [[nodiscard]] bool failed() const;
+  [[nodiscard]] uint16_t writes() const { return total_writes; }
+
+private:
+  struct State {
+    volatile uint32_t acked = 0;       ///< value read back from the inverter
+    volatile uint32_t known_mask = 0;  ///< bits of acked that were read back
+    volatile bool confirmed = false;   ///< the last reply matched written in the bits it carried
+    uint32_t written = 0;
+    uint32_t sent_ms = 0;
+    uint8_t writes = 0;  ///< since the wanted value changed
+    bool read_due = false;
+    bool failed = false;
+  };
+
+  static constexpr uint32_t width_mask(const std::size_t index) {
+    return REGISTERS[index] == SPEED_DELTAMA_ACC || REGISTERS[index] == SPEED_DELTAMA_DECC
+               ? 0xFFFFFFFF
+               : 0xFFFF;
+  }
+  [[nodiscard]] bool in_sync(std::size_t index) const {
+    return (states[index].known_mask & width_mask(index)) == width_mask(index) &&
+           states[index].acked == wanted[index];
+  }
+
+  SwitchMode mode = SwitchMode::INVERTER_MODE_INIT;
+  Values wanted{};
+  std::array<State, SIZE> states{};
+  uint16_t total_writes = 0;
+};
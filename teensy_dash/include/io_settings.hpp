@@ -76,8 +76,6 @@ constexpr uint16_t AVG_MAX = 596;
 constexpr uint16_t MIN_FOR_TORQUE = 0;
 constexpr uint16_t MAX_FOR_TORQUE = LOWER_MAX - LOWER_MIN;
 
-constexpr int ERROR_PLAUSIBILITY = -4;
-
 constexpr uint8_t MAX_ERROR_PERCENT = 60;
 constexpr uint16_t MAX_ERROR_ABS = UPPER_BOUND_APPS_HIGHER * MAX_ERROR_PERCENT / 100;
 
@@ -101,8 +99,91 @@ namespace r2d {
 constexpr uint32_t TIMEOUT_MS = 1'000;
 }
 
+namespace buttons {
+constexpr uint32_t STABLE_US = 100'000;  // time a button must hold a new level
+}  // namespace buttons
+
 namespace bamocar {
 constexpr uint16_t MAX = 32'760;
 constexpr uint16_t MIN = 0;
+
+namespace init {
+constexpr uint32_t ACTION_INTERVAL_MS = 101;  // between repeated register reads
+constexpr uint32_t STEP_TIMEOUT_MS = 2'000;   // BTB and transmission replies
+constexpr uint8_t MAX_ATTEMPTS = 4;
+constexpr uint32_t BACKOFF_BASE_MS = 250;  // before attempt 2, doubling after each failure
+constexpr uint32_t BACKOFF_MAX_MS = 2'000;
+constexpr uint32_t STABLE_MS = 5'000;  // initialized this long: a later error starts afresh
+// LOGICMAP_ERRORS bits a retry cannot fix: 0 BADPARAS, 1 POWERFAULT, 4 FEEDBACK, 14 HW_ERR
+constexpr uint16_t FATAL_ERRORS = (1U << 0) | (1U << 1) | (1U << 4) | (1U << 14);
+}  // namespace init
 }  // namespace bamocar
+
+namespace calibration {
+constexpr uint32_t HOLD_MS = 3'000;         // R2D and display buttons held together: start or save
+constexpr uint32_t TIMEOUT_MS = 120'000;    // recording dropped if not saved by then
+constexpr uint16_t MIN_APPS_SPAN = 200;     // counts between the recorded ends of each APPS
+constexpr uint16_t MIN_APPS_DISTANCE = 40;  // between the two APPS at either end
+constexpr uint16_t MIN_BRAKE_SPAN = 50;
+constexpr uint16_t BRAKE_PRESSED_MARGIN = 20;  // over the released brake reading
+
+constexpr int EEPROM_ADDRESS = 0;
+constexpr uint32_t RECORD_MAGIC = 0x5043'4101;  // "PCA", record layout 1
+
+// Used until a calibration is saved: the apps:: ends, the brake at the old fixed threshold
+constexpr uint16_t DEFAULT_BRAKE_RELEASED = brake::BLOCK_THRESHOLD - BRAKE_PRESSED_MARGIN;
+constexpr uint16_t DEFAULT_BRAKE_PRESSED = adc::MAX_VALUE;
+}  // namespace calibration
+
+namespace plausibility {
+// Pedal travel is taken from the calibrated ends of each sensor, both drop as the pedal goes down.
+// T11.8.9 allows 10 % between the sensors, kept at the old limit while APPS higher misbehaves
+constexpr uint16_t DEVIATION_PERMILLE = apps::MAX_ERROR_PERCENT * 10;
+// Signals closer than this fraction of their calibrated distance at the ends are shorted together
+constexpr uint16_t SHORTED_DIVISOR = 4;
+constexpr uint16_t BRAKE_APPS_SET_PERMILLE = 250;   // EV2.3.1, with the brake pressed
+constexpr uint16_t BRAKE_APPS_CLEAR_PERMILLE = 50;  // EV2.3.2, whatever the brake does
+
+// A rule trips once its condition held for longer than window_us; disabled rules are still
+// counted but do not cut the torque
+struct Rule {
+  uint32_t window_us;
+  bool enabled;
+};
+// Indexed by PedalPlausibility::Rule
+constexpr Rule RULES[] = {
+    {apps::IMPLAUSIBLE_TIMEOUT_MS * 1'000, false},        // APPS_HIGHER_RANGE, sensor misbehaves
+    {apps::IMPLAUSIBLE_TIMEOUT_MS * 1'000, true},         // APPS_LOWER_RANGE
+    {apps::IMPLAUSIBLE_TIMEOUT_MS * 1'000, true},         // APPS_SHORTED
+    {apps::IMPLAUSIBLE_TIMEOUT_MS * 1'000, true},         // APPS_DEVIATION
+    {apps::BRAKE_PLAUSIBILITY_TIMEOUT_MS * 1'000, true},  // APPS_BRAKE
+};
+}  // namespace plausibility
+
+namespace torque {
+constexpr uint32_t PERIOD_US = 1'000;          // torque task tick, one command frame each
+constexpr uint8_t APPS_WINDOW = 4;             // samples averaged, one per tick
+constexpr uint32_t STATUS_PERIOD_TICKS = 100;  // TORQUE_STATUS frame
+constexpr uint32_t LATENCY_SCALE_US = 4;       // TORQUE_STATUS latency unit
+
+// Command change per tick in bamocar counts (MAX is full torque); the rise rate itself grows by
+// at most jerk per tick, releasing the pedal is only bounded by fall
+struct Limits {
+  uint16_t rise;
+  uint16_t fall;
+  uint16_t jerk;
+};
+// Indexed by SwitchMode
+constexpr Limits LIMITS[] = {
+    {33, 328, 2},      // SCRUT: about 1 s to full torque
+    {44, 328, 2},      // CRUISING
+    {164, 1'092, 16},  // AS_ACCELERATION
+    {66, 546, 4},      // SKIDPAD
+    {66, 546, 4},      // ENDURANCE
+    {109, 546, 8},     // AUTOCROSS
+    {164, 1'092, 16},  // ACCELERATION: about 200 ms to full torque
+    {328, 1'092, 32},  // FAST_ACCELERATION
+    {33, 328, 2},      // INIT
+};
+}  // namespace torque
 }  // namespace config
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+
+#include "io_settings.hpp"
+
+/**
+ * @brief Raw ADC readings at the ends of each pedal sensor; both APPS drop as the pedal goes down,
+ * the brake rises with the pressure
+ */
+struct PedalCalibration {
+  uint16_t higher_released = config::apps::HIGHER_MAX;
+  uint16_t higher_pressed = config::apps::HIGHER_MIN;
+  uint16_t lower_released = config::apps::LOWER_MAX;
+  uint16_t lower_pressed = config::apps::LOWER_MIN;
+  uint16_t brake_released = config::calibration::DEFAULT_BRAKE_RELEASED;
+  uint16_t brake_pressed = config::calibration::DEFAULT_BRAKE_PRESSED;
+};
+
+/**
+ * @brief Pedal map built once from a PedalCalibration, in Q16 fixed point so the torque task
+ * interrupt neither divides nor touches the FPU
+ * @details Holds the travel of each APPS from its own ends, the linear mapping of APPS lower onto
+ * the APPS higher scale (the two ends fix gain and offset) that the deviation rule compares
+ * against, the torque map of APPS lower and the brake pressed threshold.
+ */
+class PedalMap {
+public:
+  static constexpr uint8_t FRACTION_BITS = 16;
+
+  PedalMap() : PedalMap(PedalCalibration{}) {}
+  explicit PedalMap(const PedalCalibration& calibration);
+
+  [[nodiscard]] const PedalCalibration& calibration() const { return calibration_; }
+
+  /**
+   * @brief Pedal travel seen by a sensor, 0 released to 1000 fully pressed
+   */
+  [[nodiscard]] uint16_t higher_travel(const uint16_t raw) const { return higher.travel(raw); }
+  [[nodiscard]] uint16_t lower_travel(const uint16_t raw) const { return lower.travel(raw); }
+
+  /**
+   * @brief APPS lower in APPS higher counts
+   */
+  [[nodiscard]] uint16_t lower_in_higher_scale(uint16_t raw_lower) const;
+  /**
+   * @brief Distance between APPS higher and the mapped APPS lower, in permille of the higher span
+   */
+  [[nodiscard]] uint16_t deviation_permille(uint16_t raw_higher, uint16_t raw_lower) const;
+  /**
+   * @brief Signals closer than this are shorted together
+   */
+  [[nodiscard]] uint16_t shorted_counts() const { return shorted_counts_; }
+
+  /**
+   * @brief Bamocar torque value of APPS lower, 0 within the DEADBAND and MAX fully pressed
+   */
+  [[nodiscard]] uint16_t torque(uint16_t raw_lower) const;
+
+  [[nodiscard]] uint16_t brake_threshold() const { return brake_threshold_; }
+  [[nodiscard]] bool brake_pressed(const uint16_t raw) const { return raw > brake_threshold_; }
+
+private:
+  struct Axis {
+    uint16_t released = 0;
+    uint16_t pressed = 0;
+    uint16_t span = 1;
+    uint32_t permille_q16 = 0;  ///< travel permille per count
+
+    [[nodiscard]] uint16_t travel(uint16_t raw) const;
+  };
+
+  static Axis axis(uint16_t released, uint16_t pressed);
+
+  PedalCalibration calibration_;
+  Axis higher;
+  Axis lower;
+  int32_t gain_q16 = 0;     ///< APPS higher counts per APPS lower count
+  int32_t offset = 0;       ///< APPS higher counts
+  uint32_t torque_q16 = 0;  ///< bamocar value per APPS lower count past the DEADBAND
+  uint16_t shorted_counts_ = 0;
+  uint16_t brake_threshold_ = 0;
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "io_settings.hpp"
+#include "pedal_map.hpp"
+
+/**
+ * @brief Pedal plausibility rules, evaluated on every torque task sample
+ * @details Each rule has a condition on the APPS and brake samples and a window from
+ * config::plausibility::RULES; it trips once the condition held for longer than the window and
+ * clears as soon as it no longer holds, except APPS_BRAKE which clears only when the pedal is
+ * back under BRAKE_APPS_CLEAR_PERMILLE. Travel, deviation, shorted distance and brake threshold
+ * come from the PedalMap of the current calibration. Times are micros() and may wrap. Integer
+ * only, it runs in the torque task interrupt.
+ */
+class PedalPlausibility {
+public:
+  enum Rule : uint8_t {
+    APPS_HIGHER_RANGE,  ///< out of its range: open, shorted to a rail or miscalibrated
+    APPS_LOWER_RANGE,
+    APPS_SHORTED,    ///< both signals read the same
+    APPS_DEVIATION,  ///< the sensors disagree on pedal travel
+    APPS_BRAKE,      ///< pedal pressed while braking
+    RULE_COUNT
+  };
+
+  struct Sample {
+    uint16_t apps_higher;
+    uint16_t apps_lower;
+    uint16_t brake;
+  };
+
+  /**
+   * @brief Evaluates every rule on a sample
+   * @return false while an enabled rule is tripped
+   */
+  bool update(uint32_t now_us, const Sample& sample);
+
+  [[nodiscard]] bool plausible() const { return (tripped_ & enforced_mask()) == 0; }
+  /**
+   * @brief Bitmap of the tripped rules, 1 << Rule, enabled or not
+   */
+  [[nodiscard]] uint8_t tripped() const { return tripped_; }
+  /**
+   * @brief Times a rule tripped
+   */
+  [[nodiscard]] uint32_t violations(const Rule rule) const { return rules[rule].violations; }
+
+  [[nodiscard]] const PedalMap& map() const { return map_; }
+  /**
+   * @brief Takes a new calibration, the rule states are kept
+   */
+  void set_map(const PedalMap& map) { map_ = map; }
+
+private:
+  struct RuleState {
+    bool pending = false;  ///< condition holds, window running
+    uint32_t since_us = 0;
+    uint32_t violations = 0;
+  };
+
+  static constexpr uint8_t enforced_mask() {
+    uint8_t mask = 0;
+    for (uint8_t rule = 0; rule < RULE_COUNT; rule++) {
+      mask |= config::plausibility::RULES[rule].enabled ? 1U << rule : 0;
+    }
+    return mask;
+  }
+
+  void evaluate(Rule rule, bool condition, uint32_t now_us);
+
+  PedalMap map_;
+  std::array<RuleState, RULE_COUNT> rules{};
+  uint8_t tripped_ = 0;
+};
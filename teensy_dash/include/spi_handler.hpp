@@ -1,27 +1,31 @@
 #pragma once
 #include <Arduino.h>
 
+#include <array>
+
+#include "../../CAN_IDs.h"
 #include "data_struct.hpp"
+#include "display_frame.hpp"
 #include "io_settings.hpp"
 #include "spi/SPI_MSTransfer_T4.h"
 
+static_assert(DisplayFrame::PACKET_WORDS == SPI_MST_DATA_BUFFER_MAX, "a frame fills one packet");
+
 class SpiHandler {
 private:
   SPI_MSTransfer_T4<&SPI>& display_spi;
+  DisplayFrame frame;
+  WidgetCache widgets;
+  std::array<int8_t, NUM_BOARDS * NTC_SENSOR_COUNT> all_temps_sent{};
+  bool all_temps_dirty = true;
   uint16_t current_form;
-  elapsedMillis temp_timer;
-  elapsedMillis error_timer;
-  elapsedMillis soc_timer;
+  elapsedMillis update_timer;
   elapsedMillis all_temps_timer;
-  elapsedMillis inverter_timer;
-  elapsedMillis fast_timer;
+  elapsedMillis refresh_timer;
 
-  static constexpr uint16_t TEMP_INTERVAL = 2000;       // 2 seconds
-  static constexpr uint16_t ERROR_INTERVAL = 500;       // 500ms
-  static constexpr uint16_t SOC_INTERVAL = 3000;        // 3 seconds
-  static constexpr uint16_t INVERTER_INTERVAL = 500;    // 500ms
-  static constexpr uint16_t FAST_UPDATE_INTERVAL = 30;  // 30ms
-  static constexpr uint16_t ALL_TEMPS_INTERVAL = 2000;  // 2 seconds
+  static constexpr uint16_t UPDATE_INTERVAL = 20;          // 20ms, every loop, only changes sent
+  static constexpr uint16_t ALL_TEMPS_INTERVAL = 500;       // 500ms
+  static constexpr uint16_t FULL_REFRESH_INTERVAL = 1000;  // 1 second, in case a frame was lost
 
 public:
   SpiHandler(SPI_MSTransfer_T4<&SPI>& spi);
@@ -3,10 +3,12 @@
 #include "can_comm_handler.hpp"
 #include "hw_io_manager.hpp"
 #include "logic_handler.hpp"
+#include "torque_task.hpp"
 
 class StateMachine {
 public:
-  StateMachine(CanCommHandler& can_handler, LogicHandler& logic_handler, IOManager& io_manager);
+  StateMachine(CanCommHandler& can_handler, LogicHandler& logic_handler, IOManager& io_manager,
+               TorqueTask& torque_task);
   void update();
   State get_state() const;
 
@@ -14,6 +16,7 @@ private:
   CanCommHandler& can_handler;
   LogicHandler& logic_handler;
   IOManager& io_manager;
+  TorqueTask& torque_task;
   State current_state_ = State::IDLE;
   [[nodiscard]] bool transition_to_driving() const;
   void transition_to_idle();
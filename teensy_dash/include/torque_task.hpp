@@ -0,0 +1,81 @@
+#pragma once
+#include <Arduino.h>
+#include <TeensyTimerTool.h>
+
+#include <array>
+#include <cstdint>
+
+#include "can_comm_handler.hpp"
+#include "data_struct.hpp"
+#include "io_settings.hpp"
+#include "pedal_map.hpp"
+#include "pedal_plausibility.hpp"
+
+/**
+ * @brief Pedal to inverter path, run from a timer every config::torque::PERIOD_US instead of the
+ * 20 ms loop
+ * @details Each tick samples both APPS and the brake, runs the PedalPlausibility rules (a tripped
+ * rule cuts the torque), maps APPS lower to a target through the calibrated PedalMap and moves the
+ * command towards it within the rise, fall and jerk limits of the selected SwitchMode. While
+ * enabled the command goes out every tick, and every STATUS_PERIOD_TICKS a TORQUE_STATUS frame
+ * carries the frame count so a logger can check the cadence. The loop only enables it, picks the
+ * limits and hands over a new calibration.
+ */
+class TorqueTask {
+public:
+  struct Stats {
+    uint32_t ticks;
+    uint32_t frames;           ///< torque commands sent, the TORQUE_STATUS counter
+    uint32_t last_latency_us;  ///< APPS sample to command written to the controller
+    uint32_t max_latency_us;
+    uint32_t max_jitter_us;  ///< largest deviation of a tick from PERIOD_US
+  };
+
+  TorqueTask(CanCommHandler& can_handler, volatile SystemVolatileData& volatile_updatable_data);
+
+  void begin();
+  void set_enabled(bool enabled);
+  void set_mode(SwitchMode mode);
+  /**
+   * @brief Pedal map for the plausibility rules and the torque target, from the loop
+   */
+  void set_calibration(const PedalCalibration& calibration);
+
+  [[nodiscard]] bool implausible() const { return implausible_; }
+  [[nodiscard]] const PedalPlausibility& plausibility() const { return plausibility_; }
+  [[nodiscard]] uint16_t command() const { return command_; }
+  [[nodiscard]] Stats stats() const;
+
+  /**
+   * @brief One period of the task, called from the timer interrupt
+   */
+  void tick();
+
+private:
+  CanCommHandler& can_handler;
+  volatile SystemVolatileData& updatable_data;
+  TeensyTimerTool::PeriodicTimer timer;
+
+  volatile bool enabled = false;
+  volatile uint8_t mode = static_cast<uint8_t>(SwitchMode::INVERTER_MODE_SCRUT);
+  volatile bool implausible_ = false;
+  volatile uint16_t command_ = 0;
+
+  std::array<uint16_t, config::torque::APPS_WINDOW> higher_window{};
+  std::array<uint16_t, config::torque::APPS_WINDOW> lower_window{};
+  uint8_t window_index = 0;
+  PedalPlausibility plausibility_;
+  uint16_t target = 0;
+  uint16_t rise_rate = 0;
+  uint32_t last_tick_us = 0;
+  uint32_t period_max_latency_us = 0;  ///< since the last TORQUE_STATUS
+
+  volatile uint32_t ticks = 0;
+  volatile uint32_t frames = 0;
+  volatile uint32_t last_latency_us = 0;
+  volatile uint32_t max_latency_us = 0;
+  volatile uint32_t max_jitter_us = 0;
+
+  void sample_apps(uint32_t& higher_avg, uint32_t& lower_avg);
+  void slew(const config::torque::Limits& limits);
+};
@@ -3,16 +3,9 @@
 #include <cstdint>
 #include <deque>
 
+#include "../../debugUtils.hpp"
 #include "data_struct.hpp"
 
-#ifdef DEBUG_PRINTS
-#define DEBUG_PRINT(x) Serial.print(x)
-#define DEBUG_PRINTLN(x) Serial.println(x)
-#else
-#define DEBUG_PRINT(x)
-#define DEBUG_PRINTLN(x)
-#endif
-
 // Add values to the front of the queue and remove from back if necessary
 void insert_value_queue(uint16_t value, std::deque<uint16_t>& queue);
 
@@ -30,5 +23,3 @@ std::array<uint8_t, 4> rpm_to_bytes(float rpm);
 
 // Print all temperature sensor data from the boards
 void print_all_board_temps(const int8_t temps[6][18]);
-
-InverterModeParams get_inverter_mode_config(SwitchMode switch_mode);
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "bamocar_telemetry.hpp"
+
+#include "../../debugUtils.hpp"
+
+void BamocarTelemetry::on_reply(const uint8_t reg, const uint32_t now_ms) {
+  const int index = index_of(reg);
+  if (index < 0) {
+    return;
+  }
+  State& state = states[index];
+  if (state.replies > 0) {
+    const uint32_t interval = now_ms - state.last_reply_ms;
+    state.period_ms = state.period_ms == 0 ? interval : (state.period_ms * 7 + interval) / 8;
+  }
+  state.last_reply_ms = now_ms;
+  state.replies = state.replies + 1;
+}
+
+bool BamocarTelemetry::next_request(const uint32_t now_ms, CAN_message_t& request) {
+  for (std::size_t i = 0; i < SIZE; i++) {
+    State& state = states[i];
+    const Register& entry = PLAN[i];
+    if (state.requests > 0) {
+      const uint32_t age = age_ms(entry.reg, now_ms);
+      if (age <= QUIET_PERIODS * entry.period_ms ||
+          now_ms - state.last_request_ms < RETRY_INTERVAL_MS) {
+        continue;
+      }
+      LOG_WARN(LOG_CAN, "Bamocar reg 0x%02X quiet (%u ms, %u requests), requesting again",
+               entry.reg, age, state.requests);
+    }
+    request.id = BAMO_COMMAND_ID;
+    request.len = 3;
+    request.buf[0] = 0x3D;  // read register, cyclic when the last byte is 1..254 ms
+    request.buf[1] = entry.reg;
+    request.buf[2] = entry.period_ms;
+    state.last_request_ms = now_ms;
+    state.requests++;
+    return true;
+  }
+  return false;
+}
+
+uint32_t BamocarTelemetry::age_ms(const uint8_t reg, const uint32_t now_ms) const {
+  const int index = index_of(reg);
+  if (index < 0 || states[index].replies == 0) {
+    return NEVER;
+  }
+  const uint32_t age = now_ms - states[index].last_reply_ms;
+  return static_cast<int32_t>(age) < 0 ? 0 : age;  // a reply arrived after now_ms was read
+}
+
+uint32_t BamocarTelemetry::measured_period_ms(const uint8_t reg) const {
+  const int index = index_of(reg);
+  return index < 0 ? 0 : states[index].period_ms;
+}
+
+uint16_t BamocarTelemetry::requests(const uint8_t reg) const {
+  const int index = index_of(reg);
+  return index < 0 ? 0 : states[index].requests;
+}
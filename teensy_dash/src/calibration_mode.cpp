@@ -0,0 +1,175 @@
+#include "calibration_mode.hpp"
+
+#include <EEPROM.h>
+
+#include <type_traits>
+
+#include "../../CAN_IDs.h"
+#include "../../debugUtils.hpp"
+#include "utils.hpp"
+
+static_assert(std::is_trivially_copyable_v<PedalCalibration>, "stored byte for byte");
+static_assert(sizeof(PedalCalibration) == 12, "changing it needs a new RECORD_MAGIC");
+
+CalibrationMode::CalibrationMode(SystemData& system_data, SystemVolatileData& current_updated_data,
+                                 TorqueTask& torque_task, CanCommHandler& can_handler)
+    : data(system_data),
+      updated_data(current_updated_data),
+      torque_task(torque_task),
+      can_handler(can_handler) {}
+
+void CalibrationMode::begin() {
+  stored_ = load(calibration_);
+  if (!stored_) {
+    calibration_ = {};
+    LOG_WARN(LOG_IO, "No pedal calibration stored, using the defaults");
+  }
+  torque_task.set_calibration(calibration_);
+  report();
+}
+
+void CalibrationMode::update() {
+  const uint8_t command = can_handler.take_calibration_command();
+  const bool combo = data.calibration_combo;
+  if (!recording_) {
+    if (command == CALIBRATION_START || combo) {
+      start();
+    }
+    return;
+  }
+  if (updated_data.TSOn || command == CALIBRATION_ABORT) {
+    stop(ABORTED);
+    return;
+  }
+  if (millis() - start_ms >= config::calibration::TIMEOUT_MS) {
+    stop(TIMED_OUT);
+    return;
+  }
+  record();
+  if (command == CALIBRATION_SAVE || combo) {
+    finish();
+  }
+}
+
+CalibrationMode::Result CalibrationMode::check(const PedalCalibration& calibration) {
+  using namespace config::apps;
+  using namespace config::calibration;
+
+  const auto valid_apps = [](const uint16_t released, const uint16_t pressed,
+                             const uint16_t lower_bound, const uint16_t upper_bound) {
+    return released >= pressed + MIN_APPS_SPAN && pressed >= lower_bound &&
+           released <= upper_bound;
+  };
+  const auto distance = [](const uint16_t a, const uint16_t b) { return a > b ? a - b : b - a; };
+
+  if (!valid_apps(calibration.higher_released, calibration.higher_pressed,
+                  LOWER_BOUND_APPS_HIGHER, UPPER_BOUND_APPS_HIGHER)) {
+    return APPS_HIGHER_INVALID;
+  }
+  if (!valid_apps(calibration.lower_released, calibration.lower_pressed, LOWER_BOUND_APPS_LOWER,
+                  UPPER_BOUND_APPS_LOWER)) {
+    return APPS_LOWER_INVALID;
+  }
+  if (distance(calibration.higher_released, calibration.lower_released) < MIN_APPS_DISTANCE ||
+      distance(calibration.higher_pressed, calibration.lower_pressed) < MIN_APPS_DISTANCE) {
+    return APPS_TOO_CLOSE;
+  }
+  if (calibration.brake_pressed < calibration.brake_released + MIN_BRAKE_SPAN) {
+    return BRAKE_INVALID;
+  }
+  return NONE;
+}
+
+bool CalibrationMode::load(PedalCalibration& calibration) {
+  Record record{};
+  EEPROM.get(config::calibration::EEPROM_ADDRESS, record);
+  if (record.magic != config::calibration::RECORD_MAGIC ||
+      record.crc != crc32(reinterpret_cast<const uint8_t*>(&record), offsetof(Record, crc)) ||
+      check(record.calibration) != NONE) {
+    return false;
+  }
+  calibration = record.calibration;
+  return true;
+}
+
+void CalibrationMode::save(const PedalCalibration& calibration) {
+  Record record{};
+  record.magic = config::calibration::RECORD_MAGIC;
+  record.calibration = calibration;
+  record.crc = crc32(reinterpret_cast<const uint8_t*>(&record), offsetof(Record, crc));
+  EEPROM.put(config::calibration::EEPROM_ADDRESS, record);
+}
+
+uint32_t CalibrationMode::crc32(const uint8_t* bytes, const std::size_t size) {
+  // CRC-32/ISO-HDLC bit by bit, a record is a few bytes written once per calibration
+  uint32_t crc = 0xFFFF'FFFF;
+  for (std::size_t i = 0; i < size; i++) {
+    crc ^= bytes[i];
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 1U) != 0 ? (crc >> 1) ^ 0xEDB8'8320 : crc >> 1;
+    }
+  }
+  return ~crc;
+}
+
+void CalibrationMode::start() {
+  if (data.current_state != State::IDLE || updated_data.TSOn) {
+    LOG_WARN(LOG_IO, "Pedal calibration refused in state %u, TS %u",
+             static_cast<uint8_t>(data.current_state), static_cast<uint8_t>(updated_data.TSOn));
+    result_ = REFUSED;
+    report();
+    return;
+  }
+  const auto higher = average_queue(data.apps_higher_readings);
+  const auto lower = average_queue(data.apps_lower_readings);
+  const auto brake = average_queue(data.brake_readings);
+  recorded = {higher, higher, lower, lower, brake, brake};
+  recording_ = true;
+  result_ = NONE;
+  start_ms = millis();
+  LOG_INFO(LOG_IO, "Pedal calibration started, press the pedal and the brake fully");
+  report();
+}
+
+void CalibrationMode::record() {
+  const auto higher = average_queue(data.apps_higher_readings);
+  const auto lower = average_queue(data.apps_lower_readings);
+  const auto brake = average_queue(data.brake_readings);
+  recorded.higher_released = max(recorded.higher_released, higher);
+  recorded.higher_pressed = min(recorded.higher_pressed, higher);
+  recorded.lower_released = max(recorded.lower_released, lower);
+  recorded.lower_pressed = min(recorded.lower_pressed, lower);
+  recorded.brake_released = min(recorded.brake_released, brake);
+  recorded.brake_pressed = max(recorded.brake_pressed, brake);
+}
+
+void CalibrationMode::finish() {
+  LOG_INFO(LOG_IO, "APPS higher %u to %u, lower %u to %u", recorded.higher_released,
+           recorded.higher_pressed, recorded.lower_released, recorded.lower_pressed);
+  LOG_INFO(LOG_IO, "Brake %u to %u", recorded.brake_released, recorded.brake_pressed);
+  const Result problem = check(recorded);
+  if (problem != NONE) {
+    stop(problem);
+    return;
+  }
+  save(recorded);
+  calibration_ = recorded;
+  stored_ = true;
+  torque_task.set_calibration(calibration_);
+  stop(SAVED);
+}
+
+void CalibrationMode::stop(const Result result) {
+  if (result == SAVED) {
+    LOG_INFO(LOG_IO, "Pedal calibration saved");
+  } else {
+    LOG_WARN(LOG_IO, "Pedal calibration dropped, result %u", static_cast<uint8_t>(result));
+  }
+  recording_ = false;
+  result_ = result;
+  report();
+}
+
+void CalibrationMode::report() const {
+  can_handler.write_calibration_status(recording_, result_, stored_);
+}
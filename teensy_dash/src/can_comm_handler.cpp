@@ -22,48 +22,36 @@ void CanCommHandler::setup() {
   DEBUG_PRINTLN("Setting up CAN communication handler...");
   can1.begin();
   can1.setBaudRate(1'000'000);
-  +can1.setRFFN(RFFN_32);
+  can1.setRFFN(RFFN_32);
   can1.enableFIFO();
   can1.enableFIFOInterrupt();
   can1.setFIFOFilter(REJECT_ALL);
   can1.setFIFOFilter(0, BMS_THERMISTOR_ID, EXT);
   can1.setFIFOFilter(1, BAMO_RESPONSE_ID, STD);
   can1.setFIFOFilter(2, MASTER_ID, STD);
-  +can1.setFIFOFilter(3, ALL_TEMPS_ID, STD);
-  +can1.setFIFOFilter(4, ALL_TEMPS_ID + 1, STD);
-  +can1.setFIFOFilter(5, ALL_TEMPS_ID + 2, STD);
-  +can1.setFIFOFilter(6, ALL_TEMPS_ID + 3, STD);
-  +can1.setFIFOFilter(7, ALL_TEMPS_ID + 4, STD);
-  +can1.setFIFOFilter(8, ALL_TEMPS_ID + 5, STD);
+  can1.setFIFOFilter(3, ALL_TEMPS_ID, STD);
+  can1.setFIFOFilter(4, ALL_TEMPS_ID + 1, STD);
+  can1.setFIFOFilter(5, ALL_TEMPS_ID + 2, STD);
+  can1.setFIFOFilter(6, ALL_TEMPS_ID + 3, STD);
+  can1.setFIFOFilter(7, ALL_TEMPS_ID + 4, STD);
+  can1.setFIFOFilter(8, ALL_TEMPS_ID + 5, STD);
+  can1.setFIFOFilter(9, DEBUG_LOG_CONFIG_ID, STD);
+  can1.setFIFOFilter(10, DASH_CALIBRATION_ID, STD);
   can1.onReceive(can_snifflas);
   delay(100);
 
+  constexpr CAN_message_t disable = {.id = BAMO_COMMAND_ID, .len = 3, .buf = {0x51, 0x04, 0x00}};
+  write(disable);
   send_bamo_requests();
 }
 
 void CanCommHandler::send_bamo_requests() {
-  constexpr CAN_message_t disable = {.id = BAMO_COMMAND_ID, .len = 3, .buf = {0x51, 0x04, 0x00}};
-
-  // DC voltage request
-  constexpr CAN_message_t dc_voltage_request = {
-      .id = BAMO_COMMAND_ID, .len = 3, .buf = {0x3D, 0xEB, 0x64}};
-
-  // Speed actual request
-  constexpr CAN_message_t speed_actual_request = {
-      .id = BAMO_COMMAND_ID, .len = 3, .buf = {0x3D, SPEED_ACTUAL, 0xFB}};
-  constexpr CAN_message_t current_actual_request = {
-      .id = BAMO_COMMAND_ID, .len = 3, .buf = {0x3D, CURRENT_ACTUAL, 0xFA}};
-  constexpr CAN_message_t logicmap_errors_request = {
-      .id = BAMO_COMMAND_ID, .len = 3, .buf = {0x3D, LOGICMAP_ERRORS, 0xEE}};
-  constexpr CAN_message_t motor_temperature_request = {
-      .id = BAMO_COMMAND_ID, .len = 3, .buf = {0x3D, MOTOR_TEMPERATURE, 0xEF}};
-  // Send all messages (don't exceed 8 requests)
-  can1.write(disable);
-  can1.write(dc_voltage_request);
-  can1.write(speed_actual_request);
-  can1.write(current_actual_request);
-  can1.write(logicmap_errors_request);
-  can1.write(motor_temperature_request);
+  CAN_message_t request;
+  for (uint8_t sent = 0; sent < BamocarTelemetry::MAX_REQUESTS_PER_UPDATE &&
+                         telemetry.next_request(millis(), request);
+       sent++) {
+    write(request);
+  }
 }
 
 void CanCommHandler::can_snifflas(const CAN_message_t& msg) {
@@ -105,70 +93,33 @@ void CanCommHandler::handle_can_message(const CAN_message_t& msg) {
     case MASTER_ID:
       master_callback(msg.buf, msg.len);
       break;
+    case DEBUG_LOG_CONFIG_ID:
+      debug_log::apply_log_config(msg.buf, msg.len, DEBUG_LOG_BOARD_DASH);
+      break;
+    case DASH_CALIBRATION_ID:
+      if (msg.len >= 1) {
+        calibration_command = msg.buf[0];
+      }
+      break;
     case BMS_TX_ID: {
-      uint8_t inst_voltage = msg.buf[3];
-      DEBUG_PRINTLN("BMS Instantaneous Voltage: " + String(inst_voltage) + " V");
-
-      uint8_t pack_soc = msg.buf[4];
-      DEBUG_PRINTLN("BMS Pack SOC: " + String(pack_soc) + "%");
+      const uint8_t inst_voltage = msg.buf[3];
+      const uint8_t pack_soc = msg.buf[4];
       updatable_data.hv_soc = pack_soc;
 
-      uint8_t error_bitmap_1 = msg.buf[5];
-      DEBUG_PRINTLN("BMS ERRORS #1: 0x" + String(error_bitmap_1, HEX));
-      DEBUG_PRINTLN("DTC Status #1 error bits:");
-      DEBUG_PRINTLN("  Bit 1 (0x01): P0A07 (Discharge Limit Enforcement Fault): " +
-                    String((error_bitmap_1 & (1 << 0)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 2 (0x02): P0A08 (Charger Safety Relay Fault): " +
-                    String((error_bitmap_1 & (1 << 1)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 3 (0x04): P0A09 (Internal Hardware Fault): " +
-                    String((error_bitmap_1 & (1 << 2)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 4 (0x08): P0A0A (Internal Heatsink Thermistor Fault): " +
-                    String((error_bitmap_1 & (1 << 3)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 5 (0x10): P0A0B (Internal Software Fault): " +
-                    String((error_bitmap_1 & (1 << 4)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 6 (0x20): P0A0C (Highest Cell Voltage Too High Fault): " +
-                    String((error_bitmap_1 & (1 << 5)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 7 (0x40): P0A0E (Lowest Cell Voltage Too Low Fault): " +
-                    String((error_bitmap_1 & (1 << 6)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 8 (0x80): P0A10 (Pack Too Hot Fault): " +
-                    String((error_bitmap_1 & (1 << 7)) ? 1 : 0));
-
-      // Handle DTC Status #2 (indices 2 and 3)
-      uint16_t error_bitmap_2 = (msg.buf[7] << 8) | msg.buf[6];
-      DEBUG_PRINTLN("BMS ERRORS #2: 0x" + String(error_bitmap_2, HEX));
-      DEBUG_PRINTLN("DTC Status #2 error bits:");
-      DEBUG_PRINTLN("  Bit 1 (0x0001): P0A1F (Internal Communication Fault): " +
-                    String((error_bitmap_2 & (1 << 0)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 2 (0x0002): P0A12 (Cell Balancing Stuck Off Fault): " +
-                    String((error_bitmap_2 & (1 << 1)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 3 (0x0004): P0A80 (Weak Cell Fault): " +
-                    String((error_bitmap_2 & (1 << 2)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 4 (0x0008): P0AFA (Low Cell Voltage Fault): " +
-                    String((error_bitmap_2 & (1 << 3)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 5 (0x0010): P0A04 (Open Wiring Fault): " +
-                    String((error_bitmap_2 & (1 << 4)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 6 (0x0020): P0AC0 (Current Sensor Fault): " +
-                    String((error_bitmap_2 & (1 << 5)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 7 (0x0040): P0A0D (Highest Cell Voltage Over 5V Fault): " +
-                    String((error_bitmap_2 & (1 << 6)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 8 (0x0080): P0A0F (Cell ASIC Fault): " +
-                    String((error_bitmap_2 & (1 << 7)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 9 (0x0100): P0A02 (Weak Pack Fault): " +
-                    String((error_bitmap_2 & (1 << 8)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 10 (0x0200): P0A81 (Fan Monitor Fault): " +
-                    String((error_bitmap_2 & (1 << 9)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 11 (0x0400): P0A9C (Thermistor Fault): " +
-                    String((error_bitmap_2 & (1 << 10)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 12 (0x0800): U0100 (External Communication Fault): " +
-                    String((error_bitmap_2 & (1 << 11)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 13 (0x1000): P0560 (Redundant Power Supply Fault): " +
-                    String((error_bitmap_2 & (1 << 12)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 14 (0x2000): P0AA6 (High Voltage Isolation Fault): " +
-                    String((error_bitmap_2 & (1 << 13)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 15 (0x4000): P0A05 (Input Power Supply Fault): " +
-                    String((error_bitmap_2 & (1 << 14)) ? 1 : 0));
-      DEBUG_PRINTLN("  Bit 16 (0x8000): P0A06 (Charge Limit Enforcement Fault): " +
-                    String((error_bitmap_2 & (1 << 15)) ? 1 : 0));
+      // DTC Status #1, bit: 0 P0A07 Discharge Limit Enforcement, 1 P0A08 Charger Safety Relay,
+      // 2 P0A09 Internal Hardware, 3 P0A0A Internal Heatsink Thermistor, 4 P0A0B Internal Software,
+      // 5 P0A0C Highest Cell Voltage Too High, 6 P0A0E Lowest Cell Voltage Too Low,
+      // 7 P0A10 Pack Too Hot
+      const uint8_t error_bitmap_1 = msg.buf[5];
+      // DTC Status #2, bit: 0 P0A1F Internal Communication, 1 P0A12 Cell Balancing Stuck Off,
+      // 2 P0A80 Weak Cell, 3 P0AFA Low Cell Voltage, 4 P0A04 Open Wiring, 5 P0AC0 Current Sensor,
+      // 6 P0A0D Highest Cell Voltage Over 5V, 7 P0A0F Cell ASIC, 8 P0A02 Weak Pack,
+      // 9 P0A81 Fan Monitor, 10 P0A9C Thermistor, 11 U0100 External Communication,
+      // 12 P0560 Redundant Power Supply, 13 P0AA6 High Voltage Isolation,
+      // 14 P0A05 Input Power Supply, 15 P0A06 Charge Limit Enforcement
+      const uint16_t error_bitmap_2 = (msg.buf[7] << 8) | msg.buf[6];
+      LOG_DEBUG(LOG_CAN, "BMS: %u V, SOC %u%%, DTC #1 0x%02X, DTC #2 0x%04X", inst_voltage,
+                pack_soc, error_bitmap_1, error_bitmap_2);
     } break;
     default:
       break;
@@ -189,6 +140,8 @@ void CanCommHandler::bamocar_callback(const uint8_t* const msg_data, const uint8
   // "To get the drive to send all replies as 6 byte messages (32-bit data) a bit in RegID 0xDC
   // has to be manually modified." - CAN-BUS BAMOCAR Manual
 
+  telemetry.on_reply(msg_data[0], millis());
+
   // almost all messages seem to be signed
   int32_t message_value = 0;
   if (len == 4) {
@@ -198,6 +151,10 @@ void CanCommHandler::bamocar_callback(const uint8_t* const msg_data, const uint8
     // Extended 32-bit data format
     message_value = (msg_data[4] << 24) | (msg_data[3] << 16) | (msg_data[2] << 8) | msg_data[1];
   }
+  if (len == 4 || len == 6) {
+    profiles.on_reply(msg_data[0], static_cast<uint32_t>(message_value),
+                      len == 6 ? 0xFFFFFFFF : 0xFFFF);
+  }
 
   switch (msg_data[0]) {
     case DC_VOLTAGE: {
@@ -206,12 +163,12 @@ void CanCommHandler::bamocar_callback(const uint8_t* const msg_data, const uint8
     }
     case BTB_READY_0:
       btb_ready = check_sequence(msg_data, BTB_READY_SEQUENCE);
-      DEBUG_PRINTLN("BTB ready");
+      LOG_DEBUG(LOG_CAN, "BTB ready %u", static_cast<uint8_t>(btb_ready));
       break;
 
     case ENABLE_0:
       transmission_enabled = check_sequence(msg_data, ENABLE_SEQUENCE);
-      DEBUG_PRINTLN("Transmission enabled");
+      LOG_DEBUG(LOG_CAN, "Transmission enabled %u", static_cast<uint8_t>(transmission_enabled));
       break;
 
     case SPEED_ACTUAL:
@@ -262,12 +219,16 @@ void CanCommHandler::master_callback(const uint8_t* const msg_data, const uint8_
 }
 
 void CanCommHandler::write_messages() {
+  send_bamo_requests();
+
   if (rpm_timer >= RPM_MSG_PERIOD_MS) {
     write_rpm();
     rpm_timer = 0;
   }
 
-  if (hydraulic_timer >= HYDRAULIC_MSG_PERIOD_MS) {
+  // The master's initial checkup (ASMS on, not ready yet) times the EBS on the front line
+  const bool checkup = updated_data.asms_on && updated_data.as_state < AS_READY;
+  if (hydraulic_timer >= (checkup ? HYDRAULIC_CHECKUP_MSG_PERIOD_MS : HYDRAULIC_MSG_PERIOD_MS)) {
     write_hydraulic_line();
     hydraulic_timer = 0;
     // DEBUG_PRINTLN("Hydraulic line message sent");
@@ -279,12 +240,7 @@ void CanCommHandler::write_messages() {
     apps_timer = 0;
   }
 
-  const auto& current_mode = data.switch_mode;
-  static auto previous_mode = SwitchMode::INVERTER_MODE_SCRUT;
-  if (previous_mode != current_mode) {
-    write_inverter_mode(current_mode);
-    previous_mode = current_mode;
-  }
+  write_inverter_mode(data.switch_mode);
 }
 
 void CanCommHandler::write_dash_state() {
@@ -297,7 +253,27 @@ void CanCommHandler::write_dash_state() {
   dash_state.buf[0] = DRIVING_STATE;
   dash_state.buf[1] = static_cast<uint8_t>(this->data.current_state);
   dash_state.buf[2] = normalize_bool(this->data.implausibility);
-  this->can1.write(dash_state);
+  write(dash_state);
+}
+
+void CanCommHandler::write_calibration_status(const bool recording, const uint8_t result,
+                                              const bool stored) {
+  CAN_message_t status;
+  status.id = DASH_ID;
+  status.len = 4;
+  status.buf[0] = CALIBRATION_STATUS;
+  status.buf[1] = recording ? 1 : 0;
+  status.buf[2] = result;
+  status.buf[3] = stored ? 1 : 0;
+  write(status);
+}
+
+uint8_t CanCommHandler::take_calibration_command() {
+  noInterrupts();
+  const uint8_t command = calibration_command;
+  calibration_command = 0;
+  interrupts();
+  return command;
 }
 
 void CanCommHandler::write_rpm() {
@@ -312,7 +288,7 @@ void CanCommHandler::write_rpm() {
     rpm_message.buf[2] = rpm_bytes[1];
     rpm_message.buf[3] = rpm_bytes[2];
     rpm_message.buf[4] = rpm_bytes[3];
-    this->can1.write(rpm_message);
+    write(rpm_message);
   };
 
   send_rpm(FR_RPM, data.fr_rpm);
@@ -329,7 +305,7 @@ void CanCommHandler::write_hydraulic_line() {
   hydraulic_message.buf[1] = hydraulic_value & 0xFF;         // Lower byte
   hydraulic_message.buf[2] = (hydraulic_value >> 8) & 0xFF;  // Upper byte
 
-  can1.write(hydraulic_message);
+  write(hydraulic_message);
 }
 
 void CanCommHandler::write_apps() {
@@ -346,7 +322,7 @@ void CanCommHandler::write_apps() {
     apps_message.buf[2] = (apps_value >> 8) & 0xFF;
     apps_message.buf[3] = (apps_value >> 16) & 0xFF;
     apps_message.buf[4] = (apps_value >> 24) & 0xFF;
-    can1.write(apps_message);
+    write(apps_message);
   };
 
   send_apps(APPS_HIGHER, apps_higher);
@@ -354,93 +330,18 @@ void CanCommHandler::write_apps() {
 }
 
 void CanCommHandler::write_inverter_mode(const SwitchMode switch_mode) {
-  constexpr int MAX_I_VALUE = 16383;
-  constexpr int MAX_SPEED_VALUE = 32767;
-
-  InverterModeParams params = get_inverter_mode_config(switch_mode);
-
-#ifdef DEBUG_PRINTS
-  auto mode_to_string = [](SwitchMode mode) -> const char* {
-    switch (mode) {
-      case SwitchMode::INVERTER_MODE_SCRUT:
-        return "SCRUT";
-      case SwitchMode::INVERTER_MODE_CRUISING:
-        return "CRUISING";
-      case SwitchMode::INVERTER_MODE_AS_ACCELERATION:
-        return "AS_ACCELERATION";
-      case SwitchMode::INVERTER_MODE_SKIDPAD:
-        return "SKIDPAD";
-      case SwitchMode::INVERTER_MODE_ENDURANCE:
-        return "ENDURANCE";
-      case SwitchMode::INVERTER_MODE_AUTOCROSS:
-        return "AUTOCROSS";
-      case SwitchMode::INVERTER_MODE_ACCELERATION:
-        return "ACCELERATION";
-      case SwitchMode::INVERTER_MODE_FAST_ACCELERATION:
-        return "FAST_ACCELERATION";
-      default:
-        return "UNKNOWN";
-    }
-  };
-
-  DEBUG_PRINT("Mode: ");
-  DEBUG_PRINT(mode_to_string(switch_mode));
-  DEBUG_PRINT(" | i_max: ");
-  DEBUG_PRINT(params.i_max_pk_percent);
-  DEBUG_PRINT("% | speed: ");
-  DEBUG_PRINT(params.speed_limit_percent);
-  DEBUG_PRINT("% | i_cont: ");
-  DEBUG_PRINT(params.i_cont_percent);
-  DEBUG_PRINT("% | s_acc: ");
-  DEBUG_PRINT(params.speed_ramp_acc);
-  DEBUG_PRINT(" | m_acc: ");
-  DEBUG_PRINT(params.moment_ramp_acc);
-  DEBUG_PRINT(" | s_brk: ");
-  DEBUG_PRINT(params.speed_ramp_brake);
-  DEBUG_PRINT(" | m_dec: ");
-  DEBUG_PRINTLN(params.moment_ramp_decc);
-#endif
-
-  int i_max_pk = map(params.i_max_pk_percent, 0, 100, 0, MAX_I_VALUE);
-  int i_cont = map(params.i_cont_percent, 0, 100, 0, MAX_I_VALUE);
-  int speed_lim = map(params.speed_limit_percent, 0, 100, 0, MAX_SPEED_VALUE);
-
-  CAN_message_t speed_limit_msg = {
-      .id = BAMO_COMMAND_ID, .len = 3, .buf = {SPEED_LIMIT, 0x00, 0x00}};
-  CAN_message_t i_max_msg = {.id = BAMO_COMMAND_ID, .len = 3, .buf = {DEVICE_I_MAX, 0x00, 0x00}};
-  CAN_message_t i_cont_msg = {.id = BAMO_COMMAND_ID, .len = 3, .buf = {DEVICE_I_CNT, 0x00, 0x00}};
-  CAN_message_t accRamp_msg = {
-      .id = BAMO_COMMAND_ID, .len = 5, .buf = {SPEED_DELTAMA_ACC, 0x00, 0x00}};
-  CAN_message_t deccRamp_msg = {
-      .id = BAMO_COMMAND_ID, .len = 5, .buf = {SPEED_DELTAMA_DECC, 0x00, 0x00}};
-
-  i_max_msg.buf[1] = i_max_pk & 0xFF;                // Lower byte
-  i_max_msg.buf[2] = (i_max_pk >> 8) & 0xFF;         // Upper byte
-  speed_limit_msg.buf[1] = speed_lim & 0xFF;         // Lower byte
-  speed_limit_msg.buf[2] = (speed_lim >> 8) & 0xFF;  // Upper byte
-  i_cont_msg.buf[1] = i_cont & 0xFF;                 // Lower byte
-  i_cont_msg.buf[2] = (i_cont >> 8) & 0xFF;          // Upper byte
-
-  accRamp_msg.buf[1] = params.speed_ramp_acc & 0xFF;          // Lower byte
-  accRamp_msg.buf[2] = (params.speed_ramp_acc >> 8) & 0xFF;   // Upper byte
-  accRamp_msg.buf[3] = params.moment_ramp_acc & 0xFF;         // Lower byte
-  accRamp_msg.buf[4] = (params.moment_ramp_acc >> 8) & 0xFF;  // Upper byte
-
-  deccRamp_msg.buf[1] = params.speed_ramp_brake & 0xFF;         // Lower byte
-  deccRamp_msg.buf[2] = (params.speed_ramp_brake >> 8) & 0xFF;  // Upper byte
-  deccRamp_msg.buf[3] = params.moment_ramp_decc & 0xFF;         // Lower byte
-  deccRamp_msg.buf[4] = (params.moment_ramp_decc >> 8) & 0xFF;  // Upper byte
-
-  can1.write(i_max_msg);
-  can1.write(speed_limit_msg);
-  can1.write(i_cont_msg);
-  can1.write(accRamp_msg);
-  can1.write(deccRamp_msg);
+  // only the registers the inverter does not hold yet, each one read back
+  profiles.select(switch_mode);
+  CAN_message_t frame;
+  for (uint8_t sent = 0; sent < InverterProfiles::MAX_FRAMES_PER_UPDATE &&
+                         profiles.next_frame(millis(), frame);
+       sent++) {
+    write(frame);
+  }
 }
 
 bool CanCommHandler::init_bamocar() {
-  constexpr unsigned long actionInterval = 101;
-  constexpr unsigned long timeout = 2000;
+  using namespace config::bamocar::init;
 
   // Drive disabled Enable internally switched off
   constexpr CAN_message_t disable = {.id = BAMO_COMMAND_ID, .len = 3, .buf = {0x51, 0x04, 0x00}};
@@ -457,99 +358,159 @@ bool CanCommHandler::init_bamocar() {
   constexpr CAN_message_t clear_error_message = {
       .id = BAMO_COMMAND_ID, .len = 3, .buf = {0x8E, 0x00, 0x00}};
 
-  static unsigned long currentTime = 0;
-  currentTime = millis();
+  const unsigned long currentTime = millis();
 
   switch (bamocar_state) {
     case CLEAR_ERRORS:
-      DEBUG_PRINTLN("Clearing errors");
-      can1.write(clear_error_message);
-      bamocar_state = CHECK_BTB;
+      init_attempt++;
+      LOG_INFO(LOG_CAN, "Bamocar init attempt %u, clearing errors", init_attempt);
+      init_report = {};
+      init_report.attempt = init_attempt;
+      attempt_start_time = currentTime;
+      // replies of an earlier attempt do not count
+      btb_ready = false;
+      transmission_enabled = false;
+      write(clear_error_message);
+      enter_init_step(CHECK_BTB, currentTime);
       break;
     case CHECK_BTB:
-      if (currentTime - last_action_time >= actionInterval) {
-        DEBUG_PRINTLN("Checking BTB status");
-        can1.write(checkBTBStatus);
+      if (currentTime - last_action_time >= ACTION_INTERVAL_MS) {
+        LOG_DEBUG(LOG_CAN, "Checking BTB status");
+        write(checkBTBStatus);
         last_action_time = currentTime;
       }
       if (btb_ready) {
-        bamocar_state = DISABLE;
+        enter_init_step(DISABLE, currentTime);
         command_sent = false;
-      } else if (currentTime - state_start_time >= timeout) {
-        DEBUG_PRINTLN("Timeout checking BTB");
-        DEBUG_PRINTLN("Error during initialization");
-        bamocar_state = ERROR;
+      } else if (currentTime - state_start_time >= STEP_TIMEOUT_MS) {
+        LOG_DEBUG(LOG_CAN, "Timeout checking BTB");
+        retry_bamocar_init(currentTime);
       }
       break;
 
     case DISABLE:
-      DEBUG_PRINTLN("Disabling");
-      can1.write(disable);
-      bamocar_state = ENABLE_TRANSMISSION;
+      LOG_DEBUG(LOG_CAN, "Disabling");
+      write(disable);
+      enter_init_step(ENABLE_TRANSMISSION, currentTime);
       break;
 
     case ENABLE_TRANSMISSION:
-      if (currentTime - last_action_time >= actionInterval) {
-        DEBUG_PRINTLN("Enabling transmission");
-        can1.write(enableTransmission);
+      if (currentTime - last_action_time >= ACTION_INTERVAL_MS) {
+        LOG_DEBUG(LOG_CAN, "Enabling transmission");
+        write(enableTransmission);
         last_action_time = currentTime;
       }
       if (transmission_enabled) {
-        bamocar_state = ENABLE;
+        enter_init_step(ENABLE, currentTime);
         command_sent = false;
-        state_start_time = currentTime;
         last_action_time = currentTime;
-      } else if (currentTime - state_start_time >= timeout) {
-        DEBUG_PRINTLN("Timeout enabling transmission");
-        DEBUG_PRINTLN("Error during initialization");
-        bamocar_state = ERROR;
+      } else if (currentTime - state_start_time >= STEP_TIMEOUT_MS) {
+        LOG_DEBUG(LOG_CAN, "Timeout enabling transmission");
+        retry_bamocar_init(currentTime);
       }
       break;
 
     case ENABLE:
       if (!command_sent) {
-        DEBUG_PRINTLN("Removing disable");
-        can1.write(removeDisable);
+        LOG_DEBUG(LOG_CAN, "Removing disable");
+        write(removeDisable);
         command_sent = true;
-        bamocar_state = ACC_RAMP;
+        enter_init_step(ACC_RAMP, currentTime);
       }
       break;
 
     case ACC_RAMP:
-      DEBUG_PRINT("Transmitting acceleration ramp: ");
-      DEBUG_PRINT(rampAccRequest.buf[1] | (rampAccRequest.buf[2] << 8));
-      DEBUG_PRINTLN("ms");
-      can1.write(rampAccRequest);
-      bamocar_state = DEC_RAMP;
+      LOG_DEBUG(LOG_CAN, "Transmitting acceleration ramp: %u ms",
+                rampAccRequest.buf[1] | (rampAccRequest.buf[2] << 8));
+      write(rampAccRequest);
+      enter_init_step(DEC_RAMP, currentTime);
       break;
 
     case DEC_RAMP:
-      DEBUG_PRINT("Transmitting deceleration ramp: ");
-      DEBUG_PRINT(rampDecRequest.buf[1] | (rampDecRequest.buf[2] << 8));
-      DEBUG_PRINTLN("ms");
-      can1.write(rampDecRequest);
-      bamocar_state = INITIALIZED;
+      LOG_DEBUG(LOG_CAN, "Transmitting deceleration ramp: %u ms",
+                rampDecRequest.buf[1] | (rampDecRequest.buf[2] << 8));
+      write(rampDecRequest);
+      enter_init_step(INITIALIZED, currentTime);
+      init_report.total_ms = currentTime - attempt_start_time;
+      LOG_INFO(LOG_CAN, "Bamocar init attempt %u done in %u ms (BTB %u ms, transmission %u ms)",
+               init_attempt, init_report.total_ms, init_report.step_ms[CHECK_BTB],
+               init_report.step_ms[ENABLE_TRANSMISSION]);
       break;
     case INITIALIZED:
       return true;
-    case ERROR:  // in the future add a retry mechanism
+    case RETRY_WAIT:
+      if (currentTime - state_start_time >= retry_delay_ms) {
+        enter_init_step(CLEAR_ERRORS, currentTime);
+      }
+      break;
+    case ERROR:  // until reset_bamocar_init, e.g. the next R2D
+    default:
       break;
   }
 
   return false;
 }
 
+void CanCommHandler::enter_init_step(const BamocarState next, const unsigned long now) {
+  if (bamocar_state < BAMOCAR_STATE_COUNT) {
+    init_report.step_ms[bamocar_state] = now - state_start_time;
+  }
+  bamocar_state = next;
+  state_start_time = now;
+}
+
+/**
+ * @brief Ends the current attempt: waits and starts another one, unless the attempts are used up
+ * or the inverter reports an error a retry cannot clear
+ */
+void CanCommHandler::retry_bamocar_init(const unsigned long now) {
+  using namespace config::bamocar::init;
+
+  const uint16_t errors = updated_data.error_bitmap;
+  init_report.failed_step = bamocar_state;
+  init_report.error_bitmap = errors;
+  init_report.total_ms = now - attempt_start_time;
+  if ((errors & FATAL_ERRORS) != 0 || init_attempt >= MAX_ATTEMPTS) {
+    LOG_ERROR(LOG_CAN, "Bamocar init gave up after attempt %u in step %u, errors 0x%04X",
+              init_attempt, static_cast<uint8_t>(init_report.failed_step), errors);
+    enter_init_step(ERROR, now);
+    return;
+  }
+  static_assert(MAX_ATTEMPTS <= 16, "backoff is shifted once per attempt");
+  const unsigned long backoff = BACKOFF_BASE_MS << (init_attempt > 0 ? init_attempt - 1 : 0);
+  retry_delay_ms = backoff < BACKOFF_MAX_MS ? backoff : BACKOFF_MAX_MS;
+  LOG_WARN(LOG_CAN, "Bamocar init attempt %u failed in step %u, errors 0x%04X, retry in %u ms",
+           init_attempt, static_cast<uint8_t>(init_report.failed_step), errors, retry_delay_ms);
+  enter_init_step(RETRY_WAIT, now);
+}
+
 void CanCommHandler::reset_bamocar_init() {
   bamocar_state = CLEAR_ERRORS;
   state_start_time = millis();
   last_action_time = 0;
   command_sent = false;
+  init_attempt = 0;
+  init_report = {};
+  profiles.invalidate();  // the inverter may have restarted since
+}
+
+void CanCommHandler::recover_bamocar() {
+  const unsigned long now = millis();
+  if (bamocar_state == INITIALIZED &&
+      now - state_start_time >= config::bamocar::init::STABLE_MS) {
+    init_attempt = 0;  // it ran fine for a while, this is a new fault
+  }
+  LOG_WARN(LOG_CAN, "Bamocar errors 0x%04X, warnings 0x%04X in step %u, recovering",
+           updated_data.error_bitmap, updated_data.warning_bitmap,
+           static_cast<uint8_t>(bamocar_state));
+  command_sent = false;
+  retry_bamocar_init(now);
 }
 
 void CanCommHandler::stop_bamocar() {
   constexpr CAN_message_t disable = {.id = BAMO_COMMAND_ID, .len = 3, .buf = {0x51, 0x04, 0x00}};
 
-  can1.write(disable);
+  write(disable);
 }
 
 void CanCommHandler::send_torque(const int torque) {
@@ -561,4 +522,28 @@ void CanCommHandler::send_torque(const int torque) {
   torque_message.buf[2] = (torque >> 8) & 0xFF;  // Upper byte
 
   can1.write(torque_message);
-}
\ No newline at end of file
+}
+
+void CanCommHandler::send_torque_status(const uint32_t frames, const uint16_t command,
+                                        const uint16_t target, const uint32_t max_latency_us) {
+  const uint32_t latency = max_latency_us / config::torque::LATENCY_SCALE_US;
+  CAN_message_t status;
+  status.id = DASH_ID;
+  status.len = 8;
+  status.buf[0] = TORQUE_STATUS;
+  status.buf[1] = frames & 0xFF;
+  status.buf[2] = (frames >> 8) & 0xFF;
+  status.buf[3] = command & 0xFF;
+  status.buf[4] = (command >> 8) & 0xFF;
+  status.buf[5] = target & 0xFF;
+  status.buf[6] = (target >> 8) & 0xFF;
+  status.buf[7] = latency > 0xFF ? 0xFF : latency;
+
+  can1.write(status);
+}
+
+void CanCommHandler::write(const CAN_message_t& msg) {
+  noInterrupts();  // the torque task writes from its timer interrupt
+  can1.write(msg);
+  interrupts();
+}
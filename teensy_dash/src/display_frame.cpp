@@ -0,0 +1,56 @@
+#include "display_frame.hpp"
+
+#include <cstring>
+
+bool DisplayFrame::add(const uint16_t widget_id, const uint16_t* values, const uint16_t count) {
+  uint16_t pos = 0;
+  while (pos < length && words[pos] != widget_id) {
+    pos += 2 + words[pos + 1];
+  }
+  if (pos < length && words[pos + 1] == count) {
+    memcpy(&words[pos + 2], values, count * sizeof(uint16_t));
+    return true;
+  }
+  const uint16_t old_entry = pos < length ? 2 + words[pos + 1] : 0;
+  if (length - old_entry + 2 + count > CAPACITY) {
+    return false;
+  }
+  if (old_entry != 0) {  // value count changed, the entry moves to the end
+    memmove(&words[pos], &words[pos + old_entry], (length - pos - old_entry) * sizeof(uint16_t));
+    length -= old_entry;
+  }
+  words[length++] = widget_id;
+  words[length++] = count;
+  memcpy(&words[length], values, count * sizeof(uint16_t));
+  length += count;
+  return true;
+}
+
+void WidgetCache::set(const uint16_t id, const uint16_t value) {
+  for (std::size_t i = 0; i < SIZE; i++) {
+    Widget& widget = widgets[i];
+    if (widget.id != id) {
+      continue;
+    }
+    widget.value = value;
+    const uint16_t change = value > widget.sent ? value - widget.sent : widget.sent - value;
+    if (change > widget.deadband) {
+      dirty |= 1U << i;
+    }
+    return;
+  }
+}
+
+uint8_t WidgetCache::flush(DisplayFrame& frame) {
+  uint8_t added = 0;
+  for (std::size_t i = 0; i < SIZE; i++) {
+    Widget& widget = widgets[i];
+    if ((dirty & (1U << i)) == 0 || !frame.add(widget.id, widget.value)) {
+      continue;
+    }
+    widget.sent = widget.value;
+    dirty &= ~(1U << i);
+    added++;
+  }
+  return added;
+}
@@ -12,12 +12,7 @@ IOManager::IOManager(SystemData& system_data, volatile SystemVolatileData& volat
 }
 
 void IOManager::manage() {
-  r2d_button.update();
-  ats_button.update();
-  display_button.update();
-  data.r2d_pressed = r2d_button.fell();
-  data.ats_pressed = ats_button.fell();
-  data.display_pressed = display_button.fell();
+  read_buttons();
   read_hydraulic_pressure();
   read_rotative_switch();
   read_pins_handle_leds();
@@ -28,13 +23,39 @@ void IOManager::manage() {
   update_R2D_timer();
 }
 
+void IOManager::read_buttons() {
+  auto bit = [](uint8_t pin, Button button) {
+    return static_cast<uint32_t>(digitalRead(pin)) << button;
+  };
+  const uint32_t now = micros();
+  buttons.update(bit(pins::digital::R2D, R2D_BUTTON) | bit(pins::digital::ATS, ATS_BUTTON) |
+                     bit(pins::output::DISPLAY_MODE, DISPLAY_BUTTON),
+                 now);
+  data.r2d_pressed = buttons.fell(R2D_BUTTON);
+  data.ats_pressed = buttons.fell(ATS_BUTTON);
+  data.display_pressed = buttons.fell(DISPLAY_BUTTON);
+
+  // R2D and display held together, timed from the press that completes the combo
+  if (buttons.state(R2D_BUTTON) || buttons.state(DISPLAY_BUTTON)) {
+    combo_armed = false;
+  } else if (data.r2d_pressed || data.display_pressed) {
+    combo_armed = true;
+    combo_start_us = now;
+  }
+  data.calibration_combo =
+      combo_armed && now - combo_start_us >= config::calibration::HOLD_MS * 1'000;
+  if (data.calibration_combo) {
+    combo_armed = false;  // once per hold
+  }
+}
+
 void IOManager::read_rotative_switch() const {
-  int pos = map(analogRead(pins::analog::ROTARY_SWITCH), 0, config::adc::MAX_VALUE, 0, 7);
+  int pos = map(read_analog(pins::analog::ROTARY_SWITCH), 0, config::adc::MAX_VALUE, 0, 7);
   data.switch_mode = static_cast<SwitchMode>(pos);
 }
 
 void IOManager::read_hydraulic_pressure() const {
-  insert_value_queue(analogRead(pins::analog::BRAKE_PRESSURE), data.brake_readings);
+  insert_value_queue(updatable_data.hydraulic_pressure, data.brake_readings);  // torque task
 }
 
 void IOManager::update_R2D_timer() const {
@@ -89,30 +110,31 @@ void IOManager::setup() {
   attachInterrupt(
       digitalPinToInterrupt(pins::encoder::FRONT_LEFT_WHEEL),
       []() {
-        DEBUG_PRINTLN("Front left wheel pulse detected");
+        LOG_DEBUG(LOG_IO, "Front left wheel pulse detected");
         instance->updatable_data.second_to_last_wheel_pulse_fl =
             instance->updatable_data.last_wheel_pulse_fl;
         instance->updatable_data.last_wheel_pulse_fl = micros();
       },
       RISING);
-  r2d_button.attach(pins::digital::R2D, INPUT);
-  r2d_button.interval(100);
-  ats_button.attach(pins::digital::ATS, INPUT);
-  ats_button.interval(100);
-  display_button.attach(pins::output::DISPLAY_MODE, INPUT);
-  display_button.interval(100);
+  pinMode(pins::digital::R2D, INPUT);
+  pinMode(pins::digital::ATS, INPUT);
+  pinMode(pins::output::DISPLAY_MODE, INPUT);
 }
 
 void IOManager::read_apps() const {
-  insert_value_queue(analogRead(pins::analog::APPS_HIGHER), data.apps_higher_readings);
-  insert_value_queue(analogRead(pins::analog::APPS_LOWER), data.apps_lower_readings);
+  // sampled every tick by the torque task, the queues only feed the logs and the display
+  insert_value_queue(updatable_data.apps_higher, data.apps_higher_readings);
+  insert_value_queue(updatable_data.apps_lower, data.apps_lower_readings);
   //print value
-  DEBUG_PRINT("APPS LOW:");
-  DEBUG_PRINTLN(average_queue(data.apps_lower_readings));
-  DEBUG_PRINT("APPS HIG:");
-  DEBUG_PRINTLN(average_queue(data.apps_higher_readings));
-  DEBUG_PRINTLN("");
+  LOG_DEBUG(LOG_IO, "APPS low %u, high %u", average_queue(data.apps_lower_readings),
+            average_queue(data.apps_higher_readings));
+}
 
+int IOManager::read_analog(const uint8_t pin) {
+  noInterrupts();  // the ADC is shared with the torque task interrupt
+  const int value = analogRead(pin);
+  interrupts();
+  return value;
 }
 
 void IOManager::play_r2d_sound() const { play_buzzer(1); }
@@ -121,7 +143,7 @@ void IOManager::play_buzzer(const uint8_t duration_seconds) const {
   data.buzzer_active = true;
   data.buzzer_start_time = millis();
   data.buzzer_duration_ms = duration_seconds * 1000;
-  DEBUG_PRINTLN("Playing buzzer for " + String(data.buzzer_duration_ms) + " ms");
+  LOG_DEBUG(LOG_IO, "Playing buzzer for %u ms", data.buzzer_duration_ms);
   // tone(pins::output::BUZZER, config::buzzer::BUZZER_FREQUENCY);  // TODO(romain): tone has time
   //                                                                // limite maybe timer not needed
   digitalWrite(pins::output::BUZZER, HIGH);  // Use digitalWrite for buzzer
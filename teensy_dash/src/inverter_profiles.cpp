@@ -0,0 +1,115 @@
+#include "inverter_profiles.hpp"
+
+#include "../../debugUtils.hpp"
+
+uint8_t InverterProfiles::select(const SwitchMode mode) {
+  const Values values = values_of(mode);
+  uint8_t differing = 0;
+  for (std::size_t i = 0; i < SIZE; i++) {
+    if (values[i] != wanted[i]) {
+      wanted[i] = values[i];
+      states[i].writes = 0;
+      states[i].confirmed = false;
+      states[i].failed = false;
+    } else if (mode != this->mode && !in_sync(i) && !states[i].failed) {
+      // only partly read back, e.g. a ramp confirmed by a 16 bit reply
+      states[i].writes = 0;
+      states[i].confirmed = false;
+    }
+    differing += in_sync(i) ? 0 : 1;
+  }
+  if (mode != this->mode) {
+    LOG_INFO(LOG_CAN, "Inverter mode %u, %u of %u registers to upload",
+             static_cast<uint8_t>(mode), differing, static_cast<uint8_t>(SIZE));
+    this->mode = mode;
+  }
+  return differing;
+}
+
+bool InverterProfiles::next_frame(const uint32_t now_ms, CAN_message_t& frame) {
+  if (mode == SwitchMode::INVERTER_MODE_INIT) {
+    return false;  // nothing selected yet
+  }
+  frame.id = BAMO_COMMAND_ID;
+  for (std::size_t i = 0; i < SIZE; i++) {
+    State& state = states[i];
+    if (state.read_due) {
+      frame.len = 3;
+      frame.buf[0] = 0x3D;  // read register once
+      frame.buf[1] = REGISTERS[i];
+      frame.buf[2] = 0x00;
+      state.read_due = false;
+      state.sent_ms = now_ms;
+      return true;
+    }
+  }
+  for (std::size_t i = 0; i < SIZE; i++) {
+    State& state = states[i];
+    // a late reply to the write of a previous mode confirms a value that is no longer wanted
+    const bool confirmed = state.confirmed && state.written == wanted[i];
+    if (in_sync(i) || confirmed || state.failed ||
+        (state.writes > 0 && now_ms - state.sent_ms < READBACK_TIMEOUT_MS)) {
+      continue;
+    }
+    if (state.writes >= MAX_WRITES) {
+      LOG_WARN(LOG_CAN, "Inverter reg 0x%02X not confirmed after %u writes", REGISTERS[i],
+               state.writes);
+      state.failed = true;
+      continue;
+    }
+    const uint32_t value = wanted[i];
+    frame.len = width_mask(i) > 0xFFFF ? 5 : 3;
+    frame.buf[0] = REGISTERS[i];
+    frame.buf[1] = value & 0xFF;
+    frame.buf[2] = (value >> 8) & 0xFF;
+    frame.buf[3] = (value >> 16) & 0xFF;
+    frame.buf[4] = (value >> 24) & 0xFF;
+    state.written = value;
+    state.writes++;
+    state.read_due = true;
+    state.sent_ms = now_ms;
+    total_writes++;
+    return true;
+  }
+  return false;
+}
+
+void InverterProfiles::on_reply(const uint8_t reg, const uint32_t value, const uint32_t mask) {
+  for (std::size_t i = 0; i < SIZE; i++) {
+    if (REGISTERS[i] == reg) {
+      State& state = states[i];
+      state.acked = (state.acked & ~mask) | (value & mask);
+      state.known_mask = state.known_mask | mask;
+      state.confirmed = ((value ^ state.written) & mask) == 0;
+      return;
+    }
+  }
+}
+
+void InverterProfiles::invalidate() {
+  for (State& state : states) {
+    state.known_mask = 0;
+    state.confirmed = false;
+    state.writes = 0;
+    state.read_due = false;
+    state.failed = false;
+  }
+}
+
+bool InverterProfiles::in_sync() const {
+  for (std::size_t i = 0; i < SIZE; i++) {
+    if (!in_sync(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool InverterProfiles::failed() const {
+  for (const State& state : states) {
+    if (state.failed) {
+      return true;
+    }
+  }
+  return false;
+}
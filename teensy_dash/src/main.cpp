@@ -1,6 +1,7 @@
 #include <Arduino.h>
 
 #include "../../CAN_IDs.h"
+#include "calibration_mode.hpp"
 #include "can_comm_handler.hpp"
 #include "data_struct.hpp"
 #include "hw_io_manager.hpp"
@@ -8,6 +9,7 @@
 #include "spi/SPI_MSTransfer_T4.h"
 #include "spi_handler.hpp"
 #include "state_machine.hpp"
+#include "torque_task.hpp"
 
 SystemData data;
 SystemVolatileData updated_data;
@@ -19,7 +21,9 @@ SPI_MSTransfer_T4<&SPI> display_spi;
 IOManager io_manager(data, updatable_data, updated_data);
 CanCommHandler can_comm_handler(data, updatable_data, updated_data /*, display_spi*/);
 LogicHandler logic_handler(data, updated_data);
-StateMachine state_machine(can_comm_handler, logic_handler, io_manager);
+TorqueTask torque_task(can_comm_handler, updatable_data);
+StateMachine state_machine(can_comm_handler, logic_handler, io_manager, torque_task);
+CalibrationMode calibration_mode(data, updated_data, torque_task, can_comm_handler);
 SpiHandler spi_handler(display_spi);
 
 void setup() {
@@ -35,6 +39,8 @@ void setup() {
 
 
   spi_handler.setup();
+  calibration_mode.begin();
+  torque_task.begin();
 
 }
 
@@ -44,10 +50,14 @@ void loop() {
     io_manager.manage();
     can_comm_handler.write_messages();
     copy_volatile_data(updated_data, updatable_data);
+    calibration_mode.update();
+    torque_task.set_mode(data.switch_mode);
     state_machine.update();
     data.current_state = state_machine.get_state();
+    data.implausibility = torque_task.implausible();
     spi_handler.handle_display_update(data, updated_data);
 
+    DEBUG_LOG_FLUSH();
     loop_timer = 0;
   }
 }
@@ -0,0 +1,75 @@
+#include "pedal_map.hpp"
+
+namespace {
+constexpr uint32_t ONE_Q16 = 1UL << PedalMap::FRACTION_BITS;
+
+uint16_t distance(const uint16_t a, const uint16_t b) { return a > b ? a - b : b - a; }
+}  // namespace
+
+PedalMap::PedalMap(const PedalCalibration& calibration)
+    : calibration_(calibration),
+      higher(axis(calibration.higher_released, calibration.higher_pressed)),
+      lower(axis(calibration.lower_released, calibration.lower_pressed)) {
+  gain_q16 = static_cast<int32_t>(static_cast<uint32_t>(higher.span) * ONE_Q16 / lower.span);
+  offset = higher.released -
+           static_cast<int32_t>((static_cast<int64_t>(gain_q16) * lower.released) >> FRACTION_BITS);
+
+  // rounded up so a fully pressed pedal reaches MAX
+  const uint32_t torque_span =
+      lower.span > config::apps::DEADBAND ? lower.span - config::apps::DEADBAND : 1;
+  torque_q16 = (static_cast<uint32_t>(config::bamocar::MAX) * ONE_Q16 + torque_span - 1) /
+               torque_span;
+
+  const uint16_t released_distance = distance(higher.released, lower.released);
+  const uint16_t pressed_distance = distance(higher.pressed, lower.pressed);
+  shorted_counts_ = (released_distance < pressed_distance ? released_distance : pressed_distance) /
+                    config::plausibility::SHORTED_DIVISOR;
+  brake_threshold_ = calibration.brake_released + config::calibration::BRAKE_PRESSED_MARGIN;
+}
+
+PedalMap::Axis PedalMap::axis(const uint16_t released, const uint16_t pressed) {
+  Axis axis;
+  axis.released = released;
+  axis.pressed = pressed;
+  axis.span = released > pressed ? released - pressed : 1;  // never divide by zero
+  axis.permille_q16 = 1000 * ONE_Q16 / axis.span;
+  return axis;
+}
+
+uint16_t PedalMap::Axis::travel(const uint16_t raw) const {
+  if (raw >= released) {
+    return 0;
+  }
+  if (raw <= pressed) {
+    return 1000;
+  }
+  return static_cast<uint16_t>((released - raw) * permille_q16 >> FRACTION_BITS);
+}
+
+uint16_t PedalMap::lower_in_higher_scale(const uint16_t raw_lower) const {
+  const int32_t mapped =
+      offset + static_cast<int32_t>((static_cast<int64_t>(gain_q16) * raw_lower) >> FRACTION_BITS);
+  return static_cast<uint16_t>(mapped < 0 ? 0 : mapped);
+}
+
+uint16_t PedalMap::deviation_permille(const uint16_t raw_higher, const uint16_t raw_lower) const {
+  const uint32_t counts = distance(raw_higher, lower_in_higher_scale(raw_lower));
+  if (counts >= higher.span) {
+    return 1000;
+  }
+  return static_cast<uint16_t>(counts * higher.permille_q16 >> FRACTION_BITS);
+}
+
+uint16_t PedalMap::torque(const uint16_t raw_lower) const {
+  if (raw_lower >= lower.released) {
+    return 0;
+  }
+  const uint16_t clamped = raw_lower < lower.pressed ? lower.pressed : raw_lower;
+  const uint32_t counts = lower.released - clamped;
+  if (counts <= config::apps::DEADBAND) {
+    return 0;
+  }
+  // at most MAX << 16 plus one span, within 32 bits
+  const uint32_t value = (counts - config::apps::DEADBAND) * torque_q16 >> FRACTION_BITS;
+  return static_cast<uint16_t>(value > config::bamocar::MAX ? config::bamocar::MAX : value);
+}
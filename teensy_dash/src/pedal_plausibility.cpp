@@ -0,0 +1,51 @@
+#include "pedal_plausibility.hpp"
+
+static_assert(sizeof(config::plausibility::RULES) / sizeof(config::plausibility::RULES[0]) ==
+                  PedalPlausibility::RULE_COUNT,
+              "one plausibility window per rule");
+
+bool PedalPlausibility::update(const uint32_t now_us, const Sample& sample) {
+  using namespace config::apps;
+  using namespace config::plausibility;
+
+  const uint16_t higher = sample.apps_higher;
+  const uint16_t lower = sample.apps_lower;
+  const uint16_t higher_travel = map_.higher_travel(higher);
+  const uint16_t lower_travel = map_.lower_travel(lower);
+  const uint16_t travel = higher_travel > lower_travel ? higher_travel : lower_travel;
+  const uint16_t distance = higher > lower ? higher - lower : lower - higher;
+
+  evaluate(APPS_HIGHER_RANGE,
+           higher < LOWER_BOUND_APPS_HIGHER || higher > UPPER_BOUND_APPS_HIGHER, now_us);
+  evaluate(APPS_LOWER_RANGE, lower < LOWER_BOUND_APPS_LOWER || lower > UPPER_BOUND_APPS_LOWER,
+           now_us);
+  evaluate(APPS_SHORTED, distance < map_.shorted_counts(), now_us);
+  evaluate(APPS_DEVIATION, map_.deviation_permille(higher, lower) > DEVIATION_PERMILLE, now_us);
+
+  const bool brake_latched = (tripped_ & (1U << APPS_BRAKE)) != 0;
+  const bool brake_condition = brake_latched ? travel >= BRAKE_APPS_CLEAR_PERMILLE
+                                             : map_.brake_pressed(sample.brake) &&
+                                                   travel > BRAKE_APPS_SET_PERMILLE;
+  evaluate(APPS_BRAKE, brake_condition, now_us);
+
+  return plausible();
+}
+
+void PedalPlausibility::evaluate(const Rule rule, const bool condition, const uint32_t now_us) {
+  RuleState& state = rules[rule];
+  const uint8_t bit = 1U << rule;
+  if (!condition) {
+    state.pending = false;
+    tripped_ &= ~bit;
+    return;
+  }
+  if (!state.pending) {
+    state.pending = true;
+    state.since_us = now_us;
+  }
+  const uint32_t window_us = config::plausibility::RULES[rule].window_us;
+  if ((tripped_ & bit) == 0 && now_us - state.since_us > window_us) {
+    tripped_ |= bit;
+    state.violations++;
+  }
+}
@@ -1,7 +1,5 @@
 #include "spi_handler.hpp"
 
-#include "../../CAN_IDs.h"
-
 SpiHandler::SpiHandler(SPI_MSTransfer_T4<&SPI>& spi) : display_spi(spi), current_form(0) {}
 
 void SpiHandler::setup() {
@@ -13,12 +11,25 @@ void SpiHandler::handle_display_update(SystemData& data, const SystemVolatileDat
   if (data.display_pressed) {
     current_form = (current_form % 4) + 1;
     display_spi.transfer16(&current_form, 1, WIDGET_FORM_CMD, millis() & 0xFFFF);
+    LOG_DEBUG(LOG_SPI, "Display form %u", current_form);
     data.display_pressed = false;
+    refresh_timer = FULL_REFRESH_INTERVAL;  // the new form starts from what is sent next
+  }
+
+  if (refresh_timer >= FULL_REFRESH_INTERVAL) {
+    refresh_timer = 0;
+    widgets.invalidate();
+    all_temps_dirty = true;
+    if (LOG_ENABLED(LOG_LEVEL_DEBUG, LOG_SPI)) {
+      const MSTStats link = display_spi.stats();
+      LOG_DEBUG(LOG_SPI,
+                "Display link: %u transactions, %u us max, queue %u max, ISR %u cycles max",
+                link.transactions, link.max_duration_us, link.max_queue_depth, link.max_isr_cycles);
+    }
   }
 
-  if (fast_timer >= FAST_UPDATE_INTERVAL) {
-    fast_timer = 0;
-    // Fast updates (every loop iteration) - critical for pilot feedback
+  if (update_timer >= UPDATE_INTERVAL) {
+    update_timer = 0;
     const uint16_t apps_higher = average_queue(data.apps_higher_readings);
     uint16_t torque_value = constrain(apps_higher, config::apps::LOWER_MIN, config::apps::LOWER_MAX);
     torque_value = config::apps::LOWER_MAX - torque_value;
@@ -29,68 +40,50 @@ void SpiHandler::handle_display_update(SystemData& data, const SystemVolatileDat
           static_cast<float>(config::apps::MAX_FOR_TORQUE - config::apps::DEADBAND);
       apps_percent = static_cast<uint8_t>(normalized * 100.0f);
     }
-    display_spi.transfer16(&apps_percent, 1, WIDGET_THROTTLE, millis() & 0xFFFF);
-
-    // Hydraulic brake - fast for pilot feedback
-    const uint16_t hydraulic_value = average_queue(data.brake_readings);
-    display_spi.transfer16(&hydraulic_value, 1, WIDGET_BRAKE, millis() & 0xFFFF);
-
-    // Speed - fast for pilot feedback
+    widgets.set(WIDGET_THROTTLE, apps_percent);
+    widgets.set(WIDGET_BRAKE, average_queue(data.brake_readings));
     const uint16_t avg_rpm = static_cast<uint16_t>((data.fr_rpm + data.fl_rpm) / 2);
     const uint16_t speed_kmh = avg_rpm * 0.07656;
-    display_spi.transfer16(&speed_kmh, 1, WIDGET_SPEED, millis() & 0xFFFF);
-  }
+    widgets.set(WIDGET_SPEED, speed_kmh);
 
-  // Temperature updates every 2 seconds
-  if (temp_timer >= TEMP_INTERVAL) {
-    uint16_t min_temp_16 = updated_data.min_temp;
-    display_spi.transfer16(&min_temp_16, 1, WIDGET_CELLS_MIN, millis() & 0xFFFF);
-    uint16_t max_temp_16 = updated_data.max_temp;
-    display_spi.transfer16(&max_temp_16, 1, WIDGET_CELLS_MAX, millis() & 0xFFFF);
-    temp_timer = 0;
-  }
+    widgets.set(WIDGET_CELLS_MIN, updated_data.min_temp);
+    widgets.set(WIDGET_CELLS_MAX, updated_data.max_temp);
+    widgets.set(WIDGET_INVERTER_ERRORS, updated_data.error_bitmap);
+    widgets.set(WIDGET_INVERTER_WARNINGS, updated_data.warning_bitmap);
+    widgets.set(WIDGET_LV_SOC, updated_data.soc);
+    widgets.set(WIDGET_HV_SOC, updated_data.hv_soc);
+    widgets.set(WIDGET_INVERTER_MODE, static_cast<uint16_t>(data.switch_mode));
+    widgets.set(WIDGET_AUTONOMOUS_MISSION, updated_data.autonomous_mission);
 
-  // Error updates every 300ms
-  if (error_timer >= ERROR_INTERVAL) {
-    uint16_t error_bitmap = updated_data.error_bitmap;
-    display_spi.transfer16(&error_bitmap, 1, WIDGET_INVERTER_ERRORS, millis() & 0xFFFF);
-    uint16_t warning_bitmap = updated_data.warning_bitmap;
-    display_spi.transfer16(&warning_bitmap, 1, WIDGET_INVERTER_WARNINGS, millis() & 0xFFFF);
-    error_timer = 0;
-  }
-
-  // SOC updates every 2/3 seconds
-  if (soc_timer >= SOC_INTERVAL) {
-    uint16_t soc = updated_data.soc;
-    display_spi.transfer16(&soc, 1, WIDGET_LV_SOC, millis() & 0xFFFF);
-    soc = updated_data.hv_soc;
-    display_spi.transfer16(&soc, 1, WIDGET_HV_SOC, millis() & 0xFFFF);
-    soc_timer = 0;
-  }
-
-  // Inverter mode updates every 500ms
-  if (inverter_timer >= INVERTER_INTERVAL) {
-    const auto inverter_mode = static_cast<uint16_t>(data.switch_mode);
-    display_spi.transfer16(&inverter_mode, 1, WIDGET_INVERTER_MODE, millis() & 0xFFFF);
-    inverter_timer = 0;
-    //publish autonomous mission
-    uint16_t autonomous_mission = updated_data.autonomous_mission;
-    display_spi.transfer16(&autonomous_mission, 1, WIDGET_AUTONOMOUS_MISSION, millis() & 0xFFFF); 
+    // Changed widgets go out together; until the display reads the frame, later changes are
+    // merged into it instead of queueing one packet per widget
+    if (!display_spi.queued(WIDGET_FRAME)) {
+      frame.clear();
+    }
+    if (widgets.flush(frame) > 0) {
+      display_spi.transfer16(frame.data(), frame.size(), WIDGET_FRAME, millis() & 0xFFFF);
+    }
   }
 
-  // All temperatures every 2 seconds
+  // All temperatures, too long to share a packet with the frame
   if (all_temps_timer >= ALL_TEMPS_INTERVAL) {
+    all_temps_timer = 0;
     constexpr int total_temps = NUM_BOARDS * NTC_SENSOR_COUNT;
-    uint16_t temp_array[total_temps];
-
     for (int board = 0; board < NUM_BOARDS; ++board) {
       for (int sensor = 0; sensor < NTC_SENSOR_COUNT; ++sensor) {
         const int8_t temp = updated_data.cell_board_all_temps[board][sensor];
-        temp_array[board * NTC_SENSOR_COUNT + sensor] = static_cast<uint16_t>(temp);
+        int8_t& sent = all_temps_sent[board * NTC_SENSOR_COUNT + sensor];
+        all_temps_dirty |= temp != sent;
+        sent = temp;
       }
     }
-
-    display_spi.transfer16(temp_array, total_temps, WIDGET_ALL_TEMPS, millis() & 0xFFFF);
-    all_temps_timer = 0;
+    if (all_temps_dirty) {
+      uint16_t temp_array[total_temps];
+      for (int i = 0; i < total_temps; ++i) {
+        temp_array[i] = static_cast<uint16_t>(all_temps_sent[i]);
+      }
+      display_spi.transfer16(temp_array, total_temps, WIDGET_ALL_TEMPS, millis() & 0xFFFF);
+      all_temps_dirty = false;
+    }
   }
-}
\ No newline at end of file
+}
@@ -3,17 +3,19 @@
 #include <io_settings.hpp>
 elapsedMillis print_state_timer;
 StateMachine::StateMachine(CanCommHandler& can_handler, LogicHandler& logic_handler,
-                           IOManager& io_manager)
-    : can_handler(can_handler), logic_handler(logic_handler), io_manager(io_manager) {}
+                           IOManager& io_manager, TorqueTask& torque_task)
+    : can_handler(can_handler),
+      logic_handler(logic_handler),
+      io_manager(io_manager),
+      torque_task(torque_task) {}
 
 void StateMachine::update() {
-  int torque_from_apps = 0;
   switch (current_state_) {
     case State::IDLE:
       if (logic_handler.should_start_manual_driving()) {
         can_handler.reset_bamocar_init();
         current_state_ = State::INITIALIZING_DRIVING;
-        DEBUG_PRINTLN("Starting manual driving");
+        LOG_INFO(LOG_STATE, "Starting manual driving");
         io_manager.play_r2d_sound();  // tapem os ouvidos!
       } else if (logic_handler.should_start_as_driving()) {
         can_handler.reset_bamocar_init();
@@ -24,67 +26,59 @@ void StateMachine::update() {
       break;
     case State::INITIALIZING_DRIVING:
       if (transition_to_driving()) {
-        DEBUG_PRINTLN("Transitioning to driving state");
+        LOG_INFO(LOG_STATE, "Transitioning to driving state");
         current_state_ = State::DRIVING;
+        torque_task.set_enabled(true);
+      } else if (can_handler.bamocar_init_failed()) {
+        LOG_ERROR(LOG_STATE, "Inverter did not initialize, going idle");
+        current_state_ = State::IDLE;
       }
       break;  // wait for transition to finish
     case State::INITIALIZING_AS_DRIVING:
       if (transition_to_driving()) {
         current_state_ = State::AS_DRIVING;
+      } else if (can_handler.bamocar_init_failed()) {
+        LOG_ERROR(LOG_STATE, "Inverter did not initialize, going idle");
+        current_state_ = State::IDLE;
       }
       break;  // wait for transition to finish
     case State::DRIVING:
       if (logic_handler.bamocar_has_error()) {
-        transition_to_idle();
-        can_handler.reset_bamocar_init();
+        // re-initialize with the retries left instead of starting over
+        torque_task.set_enabled(false);
+        can_handler.stop_bamocar();
+        can_handler.recover_bamocar();
         current_state_ = State::INITIALIZING_DRIVING;
-      } 
-      torque_from_apps = logic_handler.calculate_torque();
+        break;
+      }
       if (logic_handler.should_go_idle()) {
-        DEBUG_PRINTLN("Going idle from driving state");
-        DEBUG_PRINTLN("Going idle from driving state");
-        DEBUG_PRINTLN("Going idle from driving state");
-        DEBUG_PRINTLN("Going idle from driving state");
+        LOG_INFO(LOG_STATE, "Going idle from driving state");
 
         transition_to_idle();
         return;
       }
-      if (torque_from_apps == config::apps::ERROR_PLAUSIBILITY) {
-        DEBUG_PRINTLN("Torque implausible, sending 0 torque");
-        DEBUG_PRINTLN("Torque implausible, sending 0 torque");
-        DEBUG_PRINTLN("Torque implausible, sending 0 torque");
-        torque_from_apps = 0;
-      }
-      if (torque_from_apps >= 0 && torque_from_apps <= config::bamocar::MAX) {
-        can_handler.send_torque(
-            torque_from_apps); /* VVVVVRRRRRRRRRRUUUUUUMMMMMMMMMMMMMMMMMMMMMMMm*/
+      // torque goes out from the torque task, VVVVVRRRRRRRRRRUUUUUUMMMMMMMMMMMMMMMMMMMMMMMm
+      if (torque_task.implausible()) {
+        LOG_WARN(LOG_STATE, "Torque implausible (rules 0x%02X), sending 0 torque",
+                 torque_task.plausibility().tripped());
       }
       break;
     case State::AS_DRIVING:
 
       if (logic_handler.just_entered_driving()) {
-        DEBUG_PRINTLN("Going idle from AS driving state");
-        DEBUG_PRINTLN("Going idle from AS driving state");
-        DEBUG_PRINTLN("Going idle from AS driving state");
-        DEBUG_PRINTLN("Going idle from AS driving state");
+        LOG_INFO(LOG_STATE, "AS driving started");
 
         io_manager.play_r2d_sound();
       }
 
       if (logic_handler.just_entered_emergency()) {
-        DEBUG_PRINTLN("Going idle from AS driving state");
-        DEBUG_PRINTLN("Going idle from AS driving state");
-        DEBUG_PRINTLN("Going idle from AS driving state");
-        DEBUG_PRINTLN("Going idle from AS driving state");
+        LOG_WARN(LOG_STATE, "Emergency, going idle from AS driving state");
 
         transition_to_idle();
         io_manager.play_emergency_buzzer();
       }
       if (logic_handler.should_go_idle()) {
-        DEBUG_PRINTLN("Going idle from AS driving state");
-        DEBUG_PRINTLN("Going idle from AS driving state");
-        DEBUG_PRINTLN("Going idle from AS driving state");
-        DEBUG_PRINTLN("Going idle from AS driving state");
+        LOG_INFO(LOG_STATE, "Going idle from AS driving state");
         transition_to_idle();
       }
       break;
@@ -93,7 +87,7 @@ void StateMachine::update() {
   }
   if (print_state_timer >= 700) {
     // DEBUG_PRINTLN("Current state: " + String(static_cast<int>(current_state_)));
-    // DEBUG_PRINTLN("Current torque: " + String(torque_from_apps));
+    // DEBUG_PRINTLN("Current torque: " + String(torque_task.command()));
     print_state_timer = 0;
   }
 }
@@ -107,6 +101,7 @@ State StateMachine::get_state() const { return this->current_state_; }
 
 void StateMachine::transition_to_idle() {
   if (current_state_ == State::DRIVING || current_state_ == State::AS_DRIVING) {
+    torque_task.set_enabled(false);
     can_handler.stop_bamocar();
     can_handler.reset_bamocar_init();
     current_state_ = State::IDLE;
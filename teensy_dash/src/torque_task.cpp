@@ -0,0 +1,119 @@
+#include "torque_task.hpp"
+
+#include "../../debugUtils.hpp"
+
+static_assert(sizeof(config::torque::LIMITS) / sizeof(config::torque::LIMITS[0]) ==
+                  static_cast<std::size_t>(SwitchMode::INVERTER_MODE_INIT) + 1,
+              "one torque limit per SwitchMode");
+
+TorqueTask::TorqueTask(CanCommHandler& can_handler,
+                       volatile SystemVolatileData& volatile_updatable_data)
+    : can_handler(can_handler), updatable_data(volatile_updatable_data) {}
+
+void TorqueTask::begin() { timer.begin([this] { tick(); }, config::torque::PERIOD_US); }
+
+void TorqueTask::set_enabled(const bool enabled) {
+  if (enabled && !this->enabled) {
+    LOG_INFO(LOG_STATE, "Torque task enabled, mode %u", static_cast<uint8_t>(mode));
+  } else if (!enabled && this->enabled) {
+    LOG_INFO(LOG_STATE, "Torque task disabled, %u frames sent", static_cast<uint32_t>(frames));
+  }
+  this->enabled = enabled;
+}
+
+void TorqueTask::set_mode(const SwitchMode mode) { this->mode = static_cast<uint8_t>(mode); }
+
+void TorqueTask::set_calibration(const PedalCalibration& calibration) {
+  const PedalMap map(calibration);  // divides, kept out of the interrupt
+  noInterrupts();
+  plausibility_.set_map(map);
+  interrupts();
+}
+
+TorqueTask::Stats TorqueTask::stats() const {
+  noInterrupts();
+  const Stats copy = {ticks, frames, last_latency_us, max_latency_us, max_jitter_us};
+  interrupts();
+  return copy;
+}
+
+void TorqueTask::tick() {
+  const uint32_t start_us = micros();
+  if (ticks > 0) {
+    const uint32_t interval = start_us - last_tick_us;
+    const uint32_t jitter = interval > config::torque::PERIOD_US
+                                ? interval - config::torque::PERIOD_US
+                                : config::torque::PERIOD_US - interval;
+    if (jitter > max_jitter_us) {
+      max_jitter_us = jitter;
+    }
+  }
+  last_tick_us = start_us;
+  ticks = ticks + 1;
+
+  uint32_t higher_avg = 0;
+  uint32_t lower_avg = 0;
+  sample_apps(higher_avg, lower_avg);
+  const auto brake = static_cast<uint16_t>(analogRead(pins::analog::BRAKE_PRESSURE));
+  updatable_data.hydraulic_pressure = brake;
+  implausible_ = !plausibility_.update(
+      start_us, {static_cast<uint16_t>(higher_avg), static_cast<uint16_t>(lower_avg), brake});
+
+  if (!enabled) {
+    target = 0;
+    command_ = 0;
+    rise_rate = 0;
+    return;
+  }
+  target = implausible_ ? 0 : plausibility_.map().torque(static_cast<uint16_t>(lower_avg));
+  slew(config::torque::LIMITS[mode]);
+  can_handler.send_torque(command_);
+
+  const uint32_t latency = micros() - start_us;
+  last_latency_us = latency;
+  if (latency > max_latency_us) {
+    max_latency_us = latency;
+  }
+  if (latency > period_max_latency_us) {
+    period_max_latency_us = latency;
+  }
+  frames = frames + 1;
+  if (frames % config::torque::STATUS_PERIOD_TICKS == 0) {
+    can_handler.send_torque_status(frames, command_, target, period_max_latency_us);
+    period_max_latency_us = 0;
+  }
+}
+
+void TorqueTask::sample_apps(uint32_t& higher_avg, uint32_t& lower_avg) {
+  const auto higher = static_cast<uint16_t>(analogRead(pins::analog::APPS_HIGHER));
+  const auto lower = static_cast<uint16_t>(analogRead(pins::analog::APPS_LOWER));
+  updatable_data.apps_higher = higher;
+  updatable_data.apps_lower = lower;
+
+  higher_window[window_index] = higher;
+  lower_window[window_index] = lower;
+  window_index = (window_index + 1) % config::torque::APPS_WINDOW;
+  for (uint8_t i = 0; i < config::torque::APPS_WINDOW; i++) {
+    higher_avg += higher_window[i];
+    lower_avg += lower_window[i];
+  }
+  higher_avg /= config::torque::APPS_WINDOW;
+  lower_avg /= config::torque::APPS_WINDOW;
+}
+
+void TorqueTask::slew(const config::torque::Limits& limits) {
+  if (implausible_) {
+    rise_rate = 0;
+    command_ = 0;
+    return;
+  }
+  if (target > command_) {
+    const uint32_t rate = rise_rate + limits.jerk;
+    rise_rate = rate > limits.rise ? limits.rise : rate;
+    const uint32_t next = command_ + rise_rate;
+    command_ = next > target ? target : next;
+  } else {
+    rise_rate = 0;
+    command_ = command_ - target > limits.fall ? command_ - limits.fall : target;
+  }
+}
@@ -48,84 +48,3 @@ std::array<uint8_t, 4> rpm_to_bytes(const float rpm) {
           static_cast<uint8_t>((scaled_value >> 16) & 0xFF),
           static_cast<uint8_t>((scaled_value >> 24) & 0xFF)};
 }
-
-InverterModeParams get_inverter_mode_config(const SwitchMode switch_mode) {
-  InverterModeParams params{};
-  switch (switch_mode) {
-    case SwitchMode::INVERTER_MODE_SCRUT:
-      params = {.i_max_pk_percent = 11,
-                .speed_limit_percent = 11,
-                .i_cont_percent = 11,
-                .speed_ramp_acc = 1000,
-                .moment_ramp_acc = 500,
-                .speed_ramp_brake = 1000,
-                .moment_ramp_decc = 500};
-      break;
-    case SwitchMode::INVERTER_MODE_CRUISING:
-      params = {.i_max_pk_percent = 44,
-                .speed_limit_percent = 33,
-                .i_cont_percent = 22,
-                .speed_ramp_acc = 1000,
-                .moment_ramp_acc = 500,
-                .speed_ramp_brake = 1000,
-                .moment_ramp_decc = 500};
-      break;
-    case SwitchMode::INVERTER_MODE_AS_ACCELERATION:
-      params = {.i_max_pk_percent = 44,
-                .speed_limit_percent = 33,
-                .i_cont_percent = 33,
-                .speed_ramp_acc = 1000,
-                .moment_ramp_acc = 500,
-                .speed_ramp_brake = 1000,
-                .moment_ramp_decc = 500};
-      break;
-    case SwitchMode::INVERTER_MODE_SKIDPAD: //Mangueiras Skidpad
-      params = {.i_max_pk_percent = 50,
-                .speed_limit_percent = 100,
-                .i_cont_percent = 44,
-                .speed_ramp_acc = 1000,
-                .moment_ramp_acc = 500,
-                .speed_ramp_brake = 1000,
-                .moment_ramp_decc = 500};
-      break;
-    case SwitchMode::INVERTER_MODE_ENDURANCE: //Chicão Endurance
-      params = {.i_max_pk_percent = 55,
-                .speed_limit_percent = 55,
-                .i_cont_percent = 44,
-                .speed_ramp_acc = 1000,
-                .moment_ramp_acc = 500,
-                .speed_ramp_brake = 1000,
-                .moment_ramp_decc = 500};
-      break;
-    case SwitchMode::INVERTER_MODE_AUTOCROSS: //FAST ENDURANCE
-      params = {.i_max_pk_percent = 66,
-                .speed_limit_percent = 55,
-                .i_cont_percent = 44,
-                .speed_ramp_acc = 1000,
-                .moment_ramp_acc = 500,
-                .speed_ramp_brake = 500,
-                .moment_ramp_decc = 250};
-      break;
-    case SwitchMode::INVERTER_MODE_ACCELERATION: // Aceleração
-      params = {.i_max_pk_percent = 60,
-                .speed_limit_percent = 70,
-                .i_cont_percent = 44,
-                .speed_ramp_acc = 1000,
-                .moment_ramp_acc = 500,
-                .speed_ramp_brake = 1000,
-                .moment_ramp_decc = 500};
-      break;
-    case SwitchMode::INVERTER_MODE_FAST_ACCELERATION:
-      params = {.i_max_pk_percent = 55,
-                .speed_limit_percent = 75,
-                .i_cont_percent = 44,
-                .speed_ramp_acc = 1000,
-                .moment_ramp_acc = 500,
-                .speed_ramp_brake = 1000,
-                .moment_ramp_decc = 500};
-      break;
-    default:
-      break;
-  }
-  return params;
-}
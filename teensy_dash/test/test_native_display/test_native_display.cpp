@@ -0,0 +1,189 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "display_frame.hpp"
+
+namespace {
+
+struct Entry {
+  uint16_t id;
+  std::vector<uint16_t> values;
+};
+
+/**
+ * @brief Walks the TLV entries the way the display program does
+ */
+std::vector<Entry> entries(const DisplayFrame& frame) {
+  std::vector<Entry> result;
+  const uint16_t* words = frame.data();
+  uint16_t pos = 0;
+  while (pos + 1 < frame.size()) {
+    const uint16_t count = words[pos + 1];
+    TEST_ASSERT_LESS_OR_EQUAL(frame.size(), pos + 2 + count);
+    result.push_back({words[pos], std::vector<uint16_t>(&words[pos + 2], &words[pos + 2 + count])});
+    pos += 2 + count;
+  }
+  TEST_ASSERT_EQUAL_UINT16(frame.size(), pos);
+  return result;
+}
+
+uint16_t value_of(const DisplayFrame& frame, const uint16_t id) {
+  for (const Entry& entry : entries(frame)) {
+    if (entry.id == id) {
+      TEST_ASSERT_EQUAL(1, entry.values.size());
+      return entry.values[0];
+    }
+  }
+  TEST_FAIL_MESSAGE("widget not in the frame");
+  return 0;
+}
+
+uint8_t flush(WidgetCache& cache, DisplayFrame& frame) {
+  frame.clear();
+  return cache.flush(frame);
+}
+
+}  // namespace
+
+void test_frame_replaces_a_queued_widget_in_place() {
+  DisplayFrame frame;
+  TEST_ASSERT_TRUE(frame.add(WIDGET_SPEED, 40));
+  TEST_ASSERT_TRUE(frame.add(WIDGET_BRAKE, 100));
+  TEST_ASSERT_EQUAL_UINT16(6, frame.size());
+
+  TEST_ASSERT_TRUE(frame.add(WIDGET_SPEED, 41));
+  TEST_ASSERT_EQUAL_UINT16(6, frame.size());
+  const std::vector<Entry> merged = entries(frame);
+  TEST_ASSERT_EQUAL(2, merged.size());
+  TEST_ASSERT_EQUAL_UINT16(WIDGET_SPEED, merged[0].id);
+  TEST_ASSERT_EQUAL_UINT16(41, merged[0].values[0]);
+  TEST_ASSERT_EQUAL_UINT16(100, merged[1].values[0]);
+
+  frame.clear();
+  TEST_ASSERT_EQUAL_UINT16(0, frame.size());
+  TEST_ASSERT_TRUE(entries(frame).empty());
+}
+
+void test_frame_moves_a_widget_whose_value_count_changed() {
+  DisplayFrame frame;
+  const uint16_t pair[] = {1, 2};
+  const uint16_t triple[] = {7, 8, 9};
+  TEST_ASSERT_TRUE(frame.add(WIDGET_CELLS_MIN, pair, 2));
+  TEST_ASSERT_TRUE(frame.add(WIDGET_SPEED, 40));
+  TEST_ASSERT_TRUE(frame.add(WIDGET_BRAKE, 100));
+
+  TEST_ASSERT_TRUE(frame.add(WIDGET_CELLS_MIN, triple, 3));
+  TEST_ASSERT_EQUAL_UINT16(3 + 3 + 5, frame.size());
+  std::vector<Entry> moved = entries(frame);
+  TEST_ASSERT_EQUAL(3, moved.size());
+  TEST_ASSERT_EQUAL_UINT16(WIDGET_SPEED, moved[0].id);
+  TEST_ASSERT_EQUAL_UINT16(40, moved[0].values[0]);
+  TEST_ASSERT_EQUAL_UINT16(WIDGET_BRAKE, moved[1].id);
+  TEST_ASSERT_EQUAL_UINT16(100, moved[1].values[0]);
+  TEST_ASSERT_EQUAL_UINT16(WIDGET_CELLS_MIN, moved[2].id);
+  TEST_ASSERT_EQUAL_UINT16_ARRAY(triple, moved[2].values.data(), 3);
+
+  // shrinking back, from the last entry
+  TEST_ASSERT_TRUE(frame.add(WIDGET_CELLS_MIN, pair, 2));
+  moved = entries(frame);
+  TEST_ASSERT_EQUAL(3, moved.size());
+  TEST_ASSERT_EQUAL_UINT16(WIDGET_CELLS_MIN, moved[2].id);
+  TEST_ASSERT_EQUAL_UINT16_ARRAY(pair, moved[2].values.data(), 2);
+}
+
+void test_frame_refuses_what_does_not_fit() {
+  DisplayFrame frame;
+  std::vector<uint16_t> values(DisplayFrame::CAPACITY, 0xAAAA);
+  TEST_ASSERT_FALSE(frame.add(WIDGET_ALL_TEMPS, values.data(), DisplayFrame::CAPACITY - 1));
+  TEST_ASSERT_EQUAL_UINT16(0, frame.size());
+
+  // exactly full with a single value left for the last entry
+  const uint16_t first = DisplayFrame::CAPACITY - 2 - 3;
+  TEST_ASSERT_TRUE(frame.add(WIDGET_ALL_TEMPS, values.data(), first));
+  TEST_ASSERT_TRUE(frame.add(WIDGET_SPEED, 40));
+  TEST_ASSERT_EQUAL_UINT16(DisplayFrame::CAPACITY, frame.size());
+  TEST_ASSERT_FALSE(frame.add(WIDGET_BRAKE, 100));
+
+  // replacing in place still works, growing an entry does not and leaves the frame as it was
+  TEST_ASSERT_TRUE(frame.add(WIDGET_SPEED, 41));
+  const uint16_t pair[] = {1, 2};
+  TEST_ASSERT_FALSE(frame.add(WIDGET_SPEED, pair, 2));
+  TEST_ASSERT_EQUAL_UINT16(DisplayFrame::CAPACITY, frame.size());
+  const std::vector<Entry> kept = entries(frame);
+  TEST_ASSERT_EQUAL(2, kept.size());
+  TEST_ASSERT_EQUAL(first, kept[0].values.size());
+  TEST_ASSERT_EQUAL_UINT16(41, kept[1].values[0]);
+}
+
+void test_cache_sends_changes_past_the_deadband_only() {
+  WidgetCache cache;
+  DisplayFrame frame;
+  cache.set(WIDGET_THROTTLE, 50);  // dead-band 1
+  cache.set(WIDGET_BRAKE, 500);    // dead-band 3
+  TEST_ASSERT_EQUAL_UINT8(WidgetCache::SIZE, flush(cache, frame));
+  TEST_ASSERT_EQUAL_UINT8(0, flush(cache, frame));
+
+  cache.set(WIDGET_THROTTLE, 51);
+  cache.set(WIDGET_BRAKE, 497);
+  TEST_ASSERT_EQUAL_UINT8(0, flush(cache, frame));
+  cache.set(WIDGET_THROTTLE, 52);  // measured from the value sent, not the last one set
+  TEST_ASSERT_EQUAL_UINT8(1, flush(cache, frame));
+  TEST_ASSERT_EQUAL_UINT16(52, value_of(frame, WIDGET_THROTTLE));
+
+  cache.set(WIDGET_BRAKE, 504);
+  TEST_ASSERT_EQUAL_UINT8(1, flush(cache, frame));
+  TEST_ASSERT_EQUAL_UINT16(504, value_of(frame, WIDGET_BRAKE));
+  cache.set(WIDGET_BRAKE, 500);
+  cache.set(WIDGET_SPEED, 0);  // no dead-band, unchanged
+  TEST_ASSERT_EQUAL_UINT8(1, flush(cache, frame));
+  TEST_ASSERT_EQUAL_UINT16(500, value_of(frame, WIDGET_BRAKE));
+
+  cache.set(WIDGET_SPEED, 1);
+  cache.set(0xFFFF, 1);  // not a cached widget
+  TEST_ASSERT_EQUAL_UINT8(1, flush(cache, frame));
+  TEST_ASSERT_EQUAL(1, entries(frame).size());
+}
+
+void test_cache_keeps_widgets_dirty_until_they_are_sent() {
+  WidgetCache cache;
+  DisplayFrame frame;
+  TEST_ASSERT_EQUAL_UINT8(WidgetCache::SIZE, flush(cache, frame));
+  cache.invalidate();
+  TEST_ASSERT_EQUAL_UINT8(WidgetCache::SIZE, flush(cache, frame));
+  TEST_ASSERT_EQUAL(WidgetCache::SIZE, entries(frame).size());
+
+  // a nearly full frame takes one widget, the others stay dirty for the next one
+  frame.clear();
+  std::vector<uint16_t> values(DisplayFrame::CAPACITY, 0);
+  TEST_ASSERT_TRUE(frame.add(WIDGET_ALL_TEMPS, values.data(), DisplayFrame::CAPACITY - 2 - 3));
+  cache.set(WIDGET_SPEED, 10);
+  cache.set(WIDGET_HV_SOC, 80);
+  TEST_ASSERT_EQUAL_UINT8(1, cache.flush(frame));
+  TEST_ASSERT_EQUAL_UINT8(1, flush(cache, frame));
+  TEST_ASSERT_EQUAL_UINT8(0, flush(cache, frame));
+
+  // merged into a frame that still holds the widget
+  cache.set(WIDGET_SPEED, 20);
+  frame.clear();
+  TEST_ASSERT_EQUAL_UINT8(1, cache.flush(frame));
+  cache.set(WIDGET_SPEED, 30);
+  TEST_ASSERT_EQUAL_UINT8(1, cache.flush(frame));
+  TEST_ASSERT_EQUAL(1, entries(frame).size());
+  TEST_ASSERT_EQUAL_UINT16(30, value_of(frame, WIDGET_SPEED));
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_replaces_a_queued_widget_in_place);
+  RUN_TEST(test_frame_moves_a_widget_whose_value_count_changed);
+  RUN_TEST(test_frame_refuses_what_does_not_fit);
+  RUN_TEST(test_cache_sends_changes_past_the_deadband_only);
+  RUN_TEST(test_cache_keeps_widgets_dirty_until_they_are_sent);
+  return UNITY_END();
+}
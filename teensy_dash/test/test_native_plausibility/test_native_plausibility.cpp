@@ -0,0 +1,259 @@
+#include <unity.h>
+
+#include <cstdint>
+
+#include "io_settings.hpp"
+#include "pedal_map.hpp"
+#include "pedal_plausibility.hpp"
+
+namespace {
+
+using Rule = PedalPlausibility::Rule;
+using enum PedalPlausibility::Rule;
+
+const PedalMap MAP;  // default calibration
+const uint16_t BRAKE_ON = MAP.brake_threshold() + 1;
+constexpr uint16_t BRAKE_OFF = 0;
+
+constexpr uint32_t window_of(const Rule rule) {
+  return config::plausibility::RULES[rule].window_us;
+}
+
+/**
+ * @brief Both sensors at the same pedal travel, 0 released to 1000 fully pressed
+ */
+PedalPlausibility::Sample pedal(const uint32_t travel, const uint16_t brake = BRAKE_OFF) {
+  using namespace config::apps;
+  return {static_cast<uint16_t>(HIGHER_MAX - travel * (HIGHER_MAX - HIGHER_MIN) / 1000),
+          static_cast<uint16_t>(LOWER_MAX - travel * (LOWER_MAX - LOWER_MIN) / 1000), brake};
+}
+
+bool is_tripped(const PedalPlausibility& engine, const Rule rule) {
+  return (engine.tripped() & (1U << rule)) != 0;
+}
+
+/**
+ * @brief Holds a sample from t0 to just past the window of rule
+ * @return whether rule tripped exactly one microsecond after its window, not before
+ */
+bool trips_after_window(const PedalPlausibility::Sample& sample, const Rule rule,
+                        const uint32_t t0 = 0) {
+  PedalPlausibility engine;
+  engine.update(t0, sample);
+  engine.update(t0 + window_of(rule) / 2, sample);
+  engine.update(t0 + window_of(rule), sample);
+  if (is_tripped(engine, rule)) {
+    return false;
+  }
+  engine.update(t0 + window_of(rule) + 1, sample);
+  return is_tripped(engine, rule);
+}
+
+}  // namespace
+
+void test_travel_is_taken_from_the_calibrated_ends() {
+  using namespace config::apps;
+  const auto lower_travel = [](const uint16_t raw) { return MAP.lower_travel(raw); };
+  TEST_ASSERT_EQUAL_UINT16(0, lower_travel(LOWER_MAX));
+  TEST_ASSERT_EQUAL_UINT16(0, lower_travel(1023));
+  TEST_ASSERT_EQUAL_UINT16(1000, lower_travel(LOWER_MIN));
+  TEST_ASSERT_EQUAL_UINT16(1000, lower_travel(0));
+  TEST_ASSERT_INT_WITHIN(2, 500, lower_travel((LOWER_MAX + LOWER_MIN) / 2));
+  uint16_t previous = 0;
+  for (uint16_t raw = HIGHER_MAX; raw >= HIGHER_MIN; raw--) {
+    const uint16_t travel = MAP.higher_travel(raw);
+    TEST_ASSERT_GREATER_OR_EQUAL(previous, travel);
+    previous = travel;
+  }
+}
+
+void test_whole_pedal_sweep_is_plausible() {
+  PedalPlausibility engine;
+  uint32_t now = 0;
+  for (int pass = 0; pass < 2; pass++) {
+    for (uint32_t travel = 0; travel <= 1000; travel++, now += 1'000) {
+      const uint32_t position = pass == 0 ? travel : 1000 - travel;
+      TEST_ASSERT_TRUE(engine.update(now, pedal(position)));
+      TEST_ASSERT_EQUAL_HEX8(0, engine.tripped());
+    }
+  }
+  // braking with the pedal up to the EV2.3.1 threshold is fine for any time
+  for (uint32_t travel = 0; travel <= config::plausibility::BRAKE_APPS_SET_PERMILLE;
+       travel++, now += 10'000) {
+    TEST_ASSERT_TRUE(engine.update(now, pedal(travel, BRAKE_ON)));
+  }
+  for (uint8_t rule = 0; rule < PedalPlausibility::RULE_COUNT; rule++) {
+    TEST_ASSERT_EQUAL_UINT32(0, engine.violations(static_cast<Rule>(rule)));
+  }
+}
+
+void test_lower_range_trips_for_every_out_of_range_value() {
+  using namespace config::apps;
+  for (uint16_t raw = 0; raw < 1024; raw++) {
+    PedalPlausibility::Sample sample = pedal(0);
+    sample.apps_lower = raw;
+    const bool out_of_range = raw < LOWER_BOUND_APPS_LOWER || raw > UPPER_BOUND_APPS_LOWER;
+    TEST_ASSERT_EQUAL(out_of_range, trips_after_window(sample, APPS_LOWER_RANGE));
+  }
+}
+
+void test_higher_range_is_counted_but_not_enforced() {
+  using namespace config::apps;
+  for (uint16_t raw = 0; raw < 1024; raw++) {
+    PedalPlausibility::Sample sample = pedal(500);
+    sample.apps_higher = raw;
+    const bool out_of_range = raw < LOWER_BOUND_APPS_HIGHER || raw > UPPER_BOUND_APPS_HIGHER;
+    TEST_ASSERT_EQUAL(out_of_range, trips_after_window(sample, APPS_HIGHER_RANGE));
+  }
+  TEST_ASSERT_FALSE(config::plausibility::RULES[APPS_HIGHER_RANGE].enabled);
+  PedalPlausibility engine;
+  PedalPlausibility::Sample sample = pedal(0);
+  sample.apps_higher = UPPER_BOUND_APPS_HIGHER + 10;  // still no travel, nothing else trips
+  engine.update(0, sample);
+  TEST_ASSERT_TRUE(engine.update(window_of(APPS_HIGHER_RANGE) + 1, sample));
+  TEST_ASSERT_EQUAL_HEX8(1U << APPS_HIGHER_RANGE, engine.tripped());
+  TEST_ASSERT_EQUAL_UINT32(1, engine.violations(APPS_HIGHER_RANGE));
+}
+
+void test_deviation_trips_above_the_threshold_only() {
+  using namespace config::apps;
+  for (uint16_t raw = LOWER_BOUND_APPS_HIGHER; raw <= UPPER_BOUND_APPS_HIGHER; raw++) {
+    PedalPlausibility::Sample sample = pedal(0);
+    sample.apps_higher = raw;
+    TEST_ASSERT_EQUAL(MAP.higher_travel(raw) > config::plausibility::DEVIATION_PERMILLE,
+                      trips_after_window(sample, APPS_DEVIATION));
+  }
+}
+
+void test_shorted_signals_trip() {
+  for (uint16_t lower = 0; lower < 1024 - 100; lower += 7) {
+    for (uint16_t distance = 0; distance < 100; distance++) {
+      const PedalPlausibility::Sample sample = {static_cast<uint16_t>(lower + distance), lower,
+                                                BRAKE_OFF};
+      TEST_ASSERT_EQUAL(distance < MAP.shorted_counts(),
+                        trips_after_window(sample, APPS_SHORTED));
+    }
+  }
+}
+
+void test_window_restarts_when_the_condition_clears() {
+  PedalPlausibility engine;
+  PedalPlausibility::Sample bad = pedal(0);
+  bad.apps_lower = 0;
+  const uint32_t window = window_of(APPS_LOWER_RANGE);
+  engine.update(0, bad);
+  engine.update(window, bad);
+  TEST_ASSERT_TRUE(engine.update(window + 1, pedal(0)));  // cleared just in time
+  engine.update(window + 2, bad);
+  TEST_ASSERT_TRUE(engine.update(2 * window + 2, bad));
+  TEST_ASSERT_FALSE(engine.update(2 * window + 3, bad));
+  TEST_ASSERT_TRUE(engine.update(2 * window + 4, pedal(0)));  // clears at once
+  TEST_ASSERT_EQUAL_UINT32(1, engine.violations(APPS_LOWER_RANGE));
+}
+
+void test_brake_rule_holds_until_the_pedal_is_released() {
+  using namespace config::plausibility;
+  const uint32_t window = window_of(APPS_BRAKE);
+  TEST_ASSERT_FALSE(trips_after_window(pedal(BRAKE_APPS_SET_PERMILLE, BRAKE_ON), APPS_BRAKE));
+  TEST_ASSERT_FALSE(trips_after_window(pedal(1000, BRAKE_ON - 1), APPS_BRAKE));
+  // one ADC count is a little over 2 permille of travel
+  TEST_ASSERT_TRUE(trips_after_window(pedal(BRAKE_APPS_SET_PERMILLE + 3, BRAKE_ON), APPS_BRAKE));
+
+  PedalPlausibility engine;
+  engine.update(0, pedal(400, BRAKE_ON));
+  TEST_ASSERT_FALSE(engine.update(window + 1, pedal(400, BRAKE_ON)));
+  // brake released, pedal partly lifted: still cut (EV2.3.2)
+  TEST_ASSERT_FALSE(engine.update(window + 2, pedal(400)));
+  TEST_ASSERT_FALSE(engine.update(window + 3, pedal(BRAKE_APPS_CLEAR_PERMILLE + 1)));
+  TEST_ASSERT_TRUE(engine.update(window + 4, pedal(BRAKE_APPS_CLEAR_PERMILLE - 1)));
+  TEST_ASSERT_TRUE(engine.update(window + 5, pedal(400)));  // brake off, driving again
+  TEST_ASSERT_EQUAL_UINT32(1, engine.violations(APPS_BRAKE));
+}
+
+void test_windows_are_exact_across_micros_wraparound() {
+  PedalPlausibility::Sample bad = pedal(0);
+  bad.apps_lower = config::apps::UPPER_BOUND_APPS_LOWER + 1;
+  for (uint32_t before_wrap = 0; before_wrap <= 2 * window_of(APPS_LOWER_RANGE);
+       before_wrap += 997) {
+    TEST_ASSERT_TRUE(trips_after_window(bad, APPS_LOWER_RANGE, UINT32_MAX - before_wrap));
+  }
+}
+
+void test_violations_are_counted_per_rule() {
+  PedalPlausibility engine;
+  PedalPlausibility::Sample bad = pedal(0);
+  bad.apps_lower = 0;
+  uint32_t now = 0;
+  for (int i = 0; i < 3; i++) {
+    engine.update(now, bad);
+    now += window_of(APPS_LOWER_RANGE) + 1;
+    engine.update(now, bad);
+    engine.update(++now, pedal(0));
+    now++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(3, engine.violations(APPS_LOWER_RANGE));
+  TEST_ASSERT_EQUAL_UINT32(0, engine.violations(APPS_SHORTED));
+  TEST_ASSERT_EQUAL_UINT32(0, engine.violations(APPS_BRAKE));
+}
+
+void test_torque_map_matches_the_float_map() {
+  using namespace config::apps;
+  for (uint16_t raw = 0; raw < 1024; raw++) {
+    // the map the torque used to take, in float
+    const int clamped = raw < LOWER_MIN ? LOWER_MIN : raw > LOWER_MAX ? LOWER_MAX : raw;
+    const int counts = LOWER_MAX - clamped;
+    const float normalized = static_cast<float>(counts - DEADBAND) / (MAX_FOR_TORQUE - DEADBAND);
+    const int expected =
+        counts <= DEADBAND ? 0 : static_cast<int>(normalized * config::bamocar::MAX);
+    TEST_ASSERT_INT_WITHIN(1, expected, MAP.torque(raw));
+  }
+  TEST_ASSERT_EQUAL_UINT16(config::bamocar::MAX, MAP.torque(LOWER_MIN));
+}
+
+void test_map_follows_a_new_calibration() {
+  const PedalMap map({690, 260, 500, 120, 150, 600});
+  TEST_ASSERT_EQUAL_UINT16(0, map.higher_travel(690));
+  TEST_ASSERT_EQUAL_UINT16(1000, map.higher_travel(260));
+  TEST_ASSERT_EQUAL_UINT16(0, map.lower_travel(500));
+  TEST_ASSERT_EQUAL_UINT16(1000, map.lower_travel(120));
+  TEST_ASSERT_EQUAL_UINT16(690, map.lower_in_higher_scale(500));
+  TEST_ASSERT_INT_WITHIN(1, 260, map.lower_in_higher_scale(120));
+  TEST_ASSERT_INT_WITHIN(1, 475, map.lower_in_higher_scale(310));
+  for (uint16_t lower = 120; lower <= 500; lower++) {
+    TEST_ASSERT_LESS_OR_EQUAL(2, map.deviation_permille(map.lower_in_higher_scale(lower), lower));
+  }
+  TEST_ASSERT_EQUAL_UINT16(0, map.torque(500 - config::apps::DEADBAND));
+  TEST_ASSERT_GREATER_THAN(0, map.torque(500 - config::apps::DEADBAND - 1));
+  TEST_ASSERT_EQUAL_UINT16(config::bamocar::MAX, map.torque(120));
+  TEST_ASSERT_EQUAL_UINT16(140 / config::plausibility::SHORTED_DIVISOR, map.shorted_counts());
+  TEST_ASSERT_FALSE(map.brake_pressed(150 + config::calibration::BRAKE_PRESSED_MARGIN));
+  TEST_ASSERT_TRUE(map.brake_pressed(150 + config::calibration::BRAKE_PRESSED_MARGIN + 1));
+
+  // the rules take it over: fully pressed on the new pedal box is plausible
+  PedalPlausibility engine;
+  engine.set_map(map);
+  const PedalPlausibility::Sample pressed = {260, 120, BRAKE_OFF};
+  engine.update(0, pressed);
+  TEST_ASSERT_TRUE(engine.update(config::apps::BRAKE_PLAUSIBILITY_TIMEOUT_MS * 1'000, pressed));
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_travel_is_taken_from_the_calibrated_ends);
+  RUN_TEST(test_whole_pedal_sweep_is_plausible);
+  RUN_TEST(test_lower_range_trips_for_every_out_of_range_value);
+  RUN_TEST(test_higher_range_is_counted_but_not_enforced);
+  RUN_TEST(test_deviation_trips_above_the_threshold_only);
+  RUN_TEST(test_shorted_signals_trip);
+  RUN_TEST(test_window_restarts_when_the_condition_clears);
+  RUN_TEST(test_brake_rule_holds_until_the_pedal_is_released);
+  RUN_TEST(test_windows_are_exact_across_micros_wraparound);
+  RUN_TEST(test_violations_are_counted_per_rule);
+  RUN_TEST(test_torque_map_matches_the_float_map);
+  RUN_TEST(test_map_follows_a_new_calibration);
+  return UNITY_END();
+}
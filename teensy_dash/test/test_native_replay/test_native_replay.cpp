@@ -0,0 +1,726 @@
+#include <unity.h>
+
+#include <EEPROM.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "../../CAN_IDs.h"
+#include "bamocar_telemetry.hpp"
+#include "calibration_mode.hpp"
+#include "can_comm_handler.hpp"
+#include "can_replay.hpp"
+#include "data_struct.hpp"
+#include "hw_io_manager.hpp"
+#include "inverter_profiles.hpp"
+#include "io_settings.hpp"
+#include "logic_handler.hpp"
+#include "state_machine.hpp"
+#include "torque_task.hpp"
+#include "utils.hpp"
+
+namespace {
+
+const std::string TEST_DIR = std::string(__FILE__).substr(0, std::string(__FILE__).rfind('/'));
+const std::string DEFAULT_TRACE =
+    TEST_DIR + "/../../../tools/can_replay/traces/autonomous_res_emergency.log";
+
+constexpr const char *STATE_NAMES[] = {"IDLE", "INITIALIZING_DRIVING", "DRIVING",
+                                       "INITIALIZING_AS_DRIVING", "AS_DRIVING"};
+constexpr uint8_t MAIN_LOOP_INTERVAL = 20;
+
+// Same wiring as main.cpp, without the display
+SystemData data;
+SystemVolatileData updated_data;
+volatile SystemVolatileData updatable_data;
+elapsedMillis loop_timer;
+
+IOManager io_manager(data, updatable_data, updated_data);
+CanCommHandler can_comm_handler(data, updatable_data, updated_data);
+LogicHandler logic_handler(data, updated_data);
+TorqueTask torque_task(can_comm_handler, updatable_data);
+StateMachine state_machine(can_comm_handler, logic_handler, io_manager, torque_task);
+CalibrationMode calibration_mode(data, updated_data, torque_task, can_comm_handler);
+
+std::string trace_path() {
+  const char *path = std::getenv("CAN_REPLAY_TRACE");
+  return path != nullptr ? path : DEFAULT_TRACE;
+}
+
+std::string golden_path() {
+  return std::getenv("CAN_REPLAY_TRACE") != nullptr ? trace_path() + ".dash.golden"
+                                                    : TEST_DIR + "/golden_state_trace.txt";
+}
+
+void setup() {
+  io_manager.setup();
+  io_manager.manage();
+  can_comm_handler.setup();
+  delay(100);
+  calibration_mode.begin();
+  torque_task.begin();
+}
+
+void loop() {
+  if (loop_timer >= MAIN_LOOP_INTERVAL) {
+    io_manager.manage();
+    can_comm_handler.write_messages();
+    copy_volatile_data(updated_data, updatable_data);
+    calibration_mode.update();
+    torque_task.set_mode(data.switch_mode);
+    state_machine.update();
+    data.current_state = state_machine.get_state();
+    data.implausibility = torque_task.implausible();
+    loop_timer = 0;
+  }
+}
+
+void record(can_replay::StateTrace &trace) {
+  const auto state = static_cast<int>(data.current_state);
+  trace.record("state", state, STATE_NAMES[state]);
+  trace.record("as_state", updated_data.as_state);
+  trace.record("ts_on", updated_data.TSOn);
+  trace.record("buzzer", mock::pin(pins::output::BUZZER));
+}
+
+struct ReplayResult {
+  can_replay::StateTrace trace;
+  can_replay::Stats stats;
+};
+
+/**
+ * @brief Boots the dash and replays the whole trace once; the tests share the result
+ */
+const ReplayResult &replay() {
+  static ReplayResult result;
+  static bool done = false;
+  if (done) {
+    return result;
+  }
+  done = true;
+  setup();
+  const auto frames = can_replay::load_candump(trace_path());
+  can_replay::Options options;
+  options.tail_us = 200'000;
+  result.stats = can_replay::run(
+      frames, mock::can_bus(CAN2),
+      [] {
+        loop();
+        record(result.trace);
+      },
+      can_replay::Options::from_env(options));
+  return result;
+}
+
+bool sent(uint32_t id, std::initializer_list<uint8_t> payload) {
+  for (const auto &frame : mock::can_bus(CAN2).tx) {
+    if (frame.msg.id == id && frame.msg.len >= payload.size() &&
+        std::equal(payload.begin(), payload.end(), frame.msg.buf)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+void test_replay_matches_golden_trace() {
+  const ReplayResult &result = replay();
+  TEST_ASSERT_GREATER_THAN(0, result.stats.frames);
+  const std::string diff = can_replay::compare_with_golden(result.trace.text(), golden_path());
+  TEST_ASSERT_TRUE_MESSAGE(diff.empty(), diff.c_str());
+}
+
+void test_as_driving_ends_in_idle_on_emergency() {
+  const ReplayResult &result = replay();
+  const std::string &text = result.trace.text();
+  const auto driving = text.find("state AS_DRIVING");
+  TEST_ASSERT_TRUE(driving != std::string::npos);
+  TEST_ASSERT_TRUE(text.find("state IDLE", driving) != std::string::npos);
+}
+
+void test_inverter_is_enabled_and_stopped() {
+  replay();
+  TEST_ASSERT_TRUE(sent(BAMO_COMMAND_ID, {0x3D, BTB_READY_0}));
+  TEST_ASSERT_TRUE(sent(BAMO_COMMAND_ID, {0x51, 0x04, 0x00}));
+  TEST_ASSERT_TRUE(sent(BAMO_COMMAND_ID, {0x51, 0x00, 0x00}));
+}
+
+void test_cell_temperatures_are_decoded() {
+  replay();
+  // make_synthetic_trace.py sends 25 + board + chunk for every sensor
+  TEST_ASSERT_EQUAL_INT(25, updated_data.cell_board_all_temps[0][0]);
+  TEST_ASSERT_EQUAL_INT(25 + 5 + 2, updated_data.cell_board_all_temps[5][12]);
+}
+
+/**
+ * @brief Counts R2D presses seen by manage() while the button follows levels, one per step_us
+ */
+int count_r2d_presses(const std::initializer_list<int> &levels, uint32_t step_us) {
+  int presses = 0;
+  for (const int level : levels) {
+    digitalWrite(pins::digital::R2D, level);
+    for (uint32_t t = 0; t < 20'000; t += step_us) {
+      io_manager.manage();
+      presses += data.r2d_pressed ? 1 : 0;
+      mock::advance_us(step_us);
+    }
+  }
+  return presses;
+}
+
+void test_r2d_press_needs_a_stable_level_at_any_loop_rate() {
+  replay();  // after the replay, so its golden does not see the presses
+  for (const uint32_t step_us : {1'000U, 20'000U}) {
+    // released, 60 ms bounce low, released, then held for 120 ms
+    TEST_ASSERT_EQUAL_INT(0, count_r2d_presses({1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1}, step_us));
+    TEST_ASSERT_EQUAL_INT(1, count_r2d_presses({0, 0, 0, 0, 0, 0, 1}, step_us));
+  }
+}
+
+void test_bamocar_telemetry_plan_is_requested() {
+  replay();
+  for (const auto &entry : BamocarTelemetry::PLAN) {
+    TEST_ASSERT_TRUE(sent(BAMO_COMMAND_ID, {0x3D, entry.reg, entry.period_ms}));
+  }
+}
+
+void test_quiet_bamocar_register_is_requested_again() {
+  BamocarTelemetry telemetry;
+  CAN_message_t request;
+  int requested = 0;
+  while (telemetry.next_request(0, request)) {
+    requested++;
+  }
+  TEST_ASSERT_EQUAL_INT(BamocarTelemetry::SIZE, requested);
+  TEST_ASSERT_EQUAL_UINT32(BamocarTelemetry::NEVER, telemetry.age_ms(DC_VOLTAGE, 0));
+
+  // everything replies at its period, DC voltage only for the first 2 s
+  uint32_t now = 0;
+  const auto advance = [&](const uint32_t to) {
+    for (; now < to; now++) {
+      for (const auto &entry : BamocarTelemetry::PLAN) {
+        if (now % entry.period_ms == 0 && (entry.reg != DC_VOLTAGE || now <= 2'000)) {
+          telemetry.on_reply(entry.reg, now);
+        }
+      }
+      telemetry.on_reply(0x42, now);  // not in the plan
+    }
+  };
+  for (uint32_t t = 0; t <= 2'000; t++) {
+    advance(t + 1);
+    TEST_ASSERT_FALSE(telemetry.next_request(t, request));
+  }
+  TEST_ASSERT_EQUAL_UINT32(100, telemetry.measured_period_ms(DC_VOLTAGE));
+  TEST_ASSERT_EQUAL_UINT32(50, telemetry.age_ms(DC_VOLTAGE, 2'050));
+  advance(2'401);
+  TEST_ASSERT_TRUE(telemetry.is_fresh(DC_VOLTAGE, 2'400));
+  TEST_ASSERT_FALSE(telemetry.next_request(2'400, request));
+
+  advance(2'402);
+  TEST_ASSERT_FALSE(telemetry.is_fresh(DC_VOLTAGE, 2'401));
+  TEST_ASSERT_TRUE(telemetry.next_request(2'401, request));
+  TEST_ASSERT_EQUAL_UINT8(DC_VOLTAGE, request.buf[1]);
+  TEST_ASSERT_EQUAL_UINT8(100, request.buf[2]);
+  advance(2'901);
+  TEST_ASSERT_FALSE(telemetry.next_request(2'900, request));  // waits RETRY_INTERVAL_MS
+  advance(2'902);
+  TEST_ASSERT_TRUE(telemetry.next_request(2'901, request));
+  TEST_ASSERT_EQUAL_UINT16(3, telemetry.requests(DC_VOLTAGE));
+
+  advance(2'951);
+  telemetry.on_reply(DC_VOLTAGE, 2'950);
+  TEST_ASSERT_TRUE(telemetry.is_fresh(DC_VOLTAGE, 2'950));
+  advance(3'501);
+  TEST_ASSERT_FALSE(telemetry.next_request(3'300, request));
+  TEST_ASSERT_EQUAL_UINT16(1, telemetry.requests(SPEED_ACTUAL));
+}
+
+/**
+ * @brief Runs init_bamocar() every 10 ms until it finishes, fails or max_ms pass
+ * @return loop time (ms) at which each attempt started
+ */
+std::vector<uint32_t> run_bamocar_init(const uint32_t max_ms,
+                                       const std::function<void(uint8_t)> &inverter = {}) {
+  std::vector<uint32_t> starts;
+  uint8_t attempt = can_comm_handler.bamocar_init_report().attempt;
+  for (uint32_t ms = 0; ms < max_ms && !can_comm_handler.bamocar_init_failed(); ms += 10) {
+    if (can_comm_handler.init_bamocar()) {
+      break;
+    }
+    if (can_comm_handler.bamocar_init_report().attempt != attempt) {
+      attempt = can_comm_handler.bamocar_init_report().attempt;
+      starts.push_back(ms);
+    }
+    if (inverter) {
+      inverter(attempt);
+    }
+    mock::advance_us(10'000);
+  }
+  return starts;
+}
+
+void reply_from_bamocar(const uint8_t reg, const std::array<uint8_t, 3> &sequence) {
+  CAN_message_t reply;
+  reply.id = BAMO_RESPONSE_ID;
+  reply.len = 4;
+  reply.buf[0] = reg;
+  std::copy(sequence.begin(), sequence.end(), reply.buf + 1);
+  mock::can_bus(CAN2).inject(reply);
+}
+
+void test_bamocar_init_backs_off_then_gives_up() {
+  using namespace config::bamocar::init;
+  replay();
+  can_comm_handler.reset_bamocar_init();
+  const std::vector<uint32_t> starts = run_bamocar_init(30'000);  // no inverter on the bus
+  TEST_ASSERT_TRUE(can_comm_handler.bamocar_init_failed());
+  const BamocarInitReport &report = can_comm_handler.bamocar_init_report();
+  TEST_ASSERT_EQUAL_INT(MAX_ATTEMPTS, report.attempt);
+  TEST_ASSERT_EQUAL_INT(CHECK_BTB, report.failed_step);
+  TEST_ASSERT_EQUAL_INT(MAX_ATTEMPTS, starts.size());
+  for (std::size_t i = 1; i < starts.size(); i++) {
+    const uint32_t backoff = std::min<uint32_t>(BACKOFF_BASE_MS << (i - 1), BACKOFF_MAX_MS);
+    TEST_ASSERT_INT_WITHIN(20, STEP_TIMEOUT_MS + backoff, starts[i] - starts[i - 1]);
+  }
+}
+
+void test_bamocar_init_recovers_on_a_later_attempt() {
+  replay();
+  can_comm_handler.reset_bamocar_init();
+  // the inverter answers from the second attempt on
+  run_bamocar_init(10'000, [](const uint8_t attempt) {
+    if (attempt >= 2) {
+      reply_from_bamocar(BTB_READY_0, BTB_READY_SEQUENCE);
+      reply_from_bamocar(ENABLE_0, ENABLE_SEQUENCE);
+    }
+  });
+  TEST_ASSERT_TRUE(can_comm_handler.init_bamocar());
+  const BamocarInitReport &report = can_comm_handler.bamocar_init_report();
+  TEST_ASSERT_EQUAL_INT(2, report.attempt);
+  TEST_ASSERT_EQUAL_INT(INITIALIZED, report.failed_step);
+  TEST_ASSERT_LESS_OR_EQUAL(20, report.step_ms[CHECK_BTB]);
+  TEST_ASSERT_GREATER_THAN(0, report.total_ms);
+
+  // an error while driving continues with the attempts left
+  can_comm_handler.recover_bamocar();
+  TEST_ASSERT_FALSE(can_comm_handler.init_bamocar());
+  const std::vector<uint32_t> starts = run_bamocar_init(10'000);
+  TEST_ASSERT_TRUE(can_comm_handler.bamocar_init_failed());
+  TEST_ASSERT_EQUAL_INT(config::bamocar::init::MAX_ATTEMPTS - 2, starts.size());
+}
+
+/**
+ * @brief Pedal position on both APPS, plausible; 0 is released, 1 fully pressed
+ */
+void press_pedal(const float position) {
+  constexpr int TRAVEL = config::apps::LOWER_MAX - config::apps::LOWER_MIN;
+  const auto lower = static_cast<int>(config::apps::LOWER_MAX - position * TRAVEL);
+  mock::set_analog(pins::analog::APPS_LOWER, lower);
+  mock::set_analog(pins::analog::APPS_HIGHER, lower + config::apps::LINEAR_OFFSET);
+}
+
+/**
+ * @brief Torque commands and TORQUE_STATUS frames sent while advancing duration_us
+ */
+std::vector<CAN_message_t> run_torque_task(const uint64_t duration_us) {
+  const std::size_t first = mock::can_bus(CAN2).tx.size();
+  mock::advance_us(duration_us);
+  std::vector<CAN_message_t> frames;
+  for (std::size_t i = first; i < mock::can_bus(CAN2).tx.size(); i++) {
+    const CAN_message_t &msg = mock::can_bus(CAN2).tx[i].msg;
+    if ((msg.id == BAMO_COMMAND_ID && msg.buf[0] == 0x90) ||
+        (msg.id == DASH_ID && msg.buf[0] == TORQUE_STATUS)) {
+      frames.push_back(msg);
+    }
+  }
+  return frames;
+}
+
+uint16_t torque_of(const CAN_message_t &msg) { return msg.buf[1] | (msg.buf[2] << 8); }
+
+void test_torque_is_sent_every_period_within_the_mode_limits() {
+  using namespace config::torque;
+  replay();
+  press_pedal(0);
+  torque_task.set_mode(SwitchMode::INVERTER_MODE_SCRUT);
+  TEST_ASSERT_TRUE(run_torque_task(50'000).empty());  // disabled, nothing goes out
+
+  torque_task.set_enabled(true);
+  press_pedal(1);
+  const std::vector<CAN_message_t> frames = run_torque_task(2'000'000);
+  const Limits &limits = LIMITS[static_cast<int>(SwitchMode::INVERTER_MODE_SCRUT)];
+  uint16_t previous = 0;
+  int previous_step = 0;
+  uint32_t commands = 0;
+  uint32_t statuses = 0;
+  for (const CAN_message_t &msg : frames) {
+    if (msg.id == DASH_ID) {
+      statuses++;
+      TEST_ASSERT_EQUAL_UINT32(commands, msg.buf[1] | (msg.buf[2] << 8));
+      continue;
+    }
+    commands++;
+    const int step = torque_of(msg) - previous;
+    TEST_ASSERT_GREATER_OR_EQUAL(0, step);
+    TEST_ASSERT_LESS_OR_EQUAL(limits.rise, step);
+    TEST_ASSERT_LESS_OR_EQUAL(limits.jerk, step - previous_step);
+    previous = torque_of(msg);
+    previous_step = step;
+  }
+  TEST_ASSERT_EQUAL_UINT32(2'000'000 / PERIOD_US, commands);
+  TEST_ASSERT_EQUAL_UINT32(commands / STATUS_PERIOD_TICKS, statuses);
+  TEST_ASSERT_EQUAL_UINT16(config::bamocar::MAX, previous);
+  TEST_ASSERT_EQUAL_UINT32(0, torque_task.stats().max_jitter_us);
+
+  // releasing is bounded by the fall limit only
+  press_pedal(0);
+  const std::vector<CAN_message_t> released = run_torque_task(200'000);
+  uint32_t ticks_to_zero = 0;
+  for (const CAN_message_t &msg : released) {
+    if (msg.id == BAMO_COMMAND_ID) {
+      TEST_ASSERT_LESS_OR_EQUAL(limits.fall, previous - torque_of(msg));
+      previous = torque_of(msg);
+      ticks_to_zero += previous > 0 ? 1 : 0;
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT16(0, previous);
+  TEST_ASSERT_LESS_OR_EQUAL(config::bamocar::MAX / limits.fall + APPS_WINDOW, ticks_to_zero);
+  torque_task.set_enabled(false);
+}
+
+void test_implausible_apps_cut_the_torque() {
+  using namespace config::torque;
+  replay();
+  torque_task.set_mode(SwitchMode::INVERTER_MODE_FAST_ACCELERATION);
+  torque_task.set_enabled(true);
+  press_pedal(1);
+  run_torque_task(500'000);
+  TEST_ASSERT_EQUAL_UINT16(config::bamocar::MAX, torque_task.command());
+
+  // APPS lower shorted below its range, still reads as full pedal: held for the timeout, then 0
+  // until plausible again
+  mock::set_analog(pins::analog::APPS_LOWER, config::apps::LOWER_BOUND_APPS_LOWER / 2);
+  const std::vector<CAN_message_t> frames = run_torque_task(200'000);
+  TEST_ASSERT_TRUE(torque_task.implausible());
+  std::vector<uint16_t> commands;
+  for (const CAN_message_t &msg : frames) {
+    if (msg.id == BAMO_COMMAND_ID) {
+      commands.push_back(torque_of(msg));
+    }
+  }
+  const auto first_zero = std::find(commands.begin(), commands.end(), 0) - commands.begin();
+  constexpr auto WINDOW_TICKS =
+      config::plausibility::RULES[PedalPlausibility::APPS_LOWER_RANGE].window_us / PERIOD_US;
+  TEST_ASSERT_GREATER_THAN(WINDOW_TICKS, first_zero);
+  TEST_ASSERT_LESS_OR_EQUAL(WINDOW_TICKS + APPS_WINDOW, first_zero);
+  TEST_ASSERT_EQUAL_HEX8(1U << PedalPlausibility::APPS_LOWER_RANGE,
+                         torque_task.plausibility().tripped());
+  TEST_ASSERT_EQUAL_UINT16(config::bamocar::MAX, commands[first_zero - 1]);  // no ramp down
+  TEST_ASSERT_TRUE(std::all_of(commands.begin() + first_zero, commands.end(),
+                               [](const uint16_t torque) { return torque == 0; }));
+
+  torque_task.set_enabled(false);
+  press_pedal(0);
+  TEST_ASSERT_TRUE(run_torque_task(10'000).empty());
+  TEST_ASSERT_FALSE(torque_task.implausible());
+}
+
+/**
+ * @brief Frames of one update; read-backs are answered by a fake inverter register file that
+ * ignores writes to ignored_reg
+ */
+std::vector<CAN_message_t> run_profiles(InverterProfiles &profiles, const uint32_t now_ms,
+                                        std::array<uint32_t, 256> &inverter,
+                                        const uint32_t reply_mask = 0xFFFFFFFF,
+                                        const uint8_t ignored_reg = 0) {
+  std::vector<CAN_message_t> frames;
+  CAN_message_t frame;
+  while (profiles.next_frame(now_ms, frame)) {
+    frames.push_back(frame);
+    if (frame.buf[0] == 0x3D) {
+      profiles.on_reply(frame.buf[1], inverter[frame.buf[1]] & reply_mask, reply_mask);
+    } else if (frame.buf[0] != ignored_reg) {
+      inverter[frame.buf[0]] = frame.buf[1] | frame.buf[2] << 8 |
+                               (frame.len == 5 ? frame.buf[3] << 16 | frame.buf[4] << 24 : 0);
+    }
+  }
+  return frames;
+}
+
+void test_mode_change_uploads_only_the_differing_registers() {
+  replay();
+  TEST_ASSERT_TRUE(sent(BAMO_COMMAND_ID, {DEVICE_I_MAX, 0x0A, 0x07}));  // SCRUT at boot
+  TEST_ASSERT_TRUE(sent(BAMO_COMMAND_ID, {0x3D, DEVICE_I_MAX, 0x00}));
+
+  InverterProfiles profiles;
+  std::array<uint32_t, 256> inverter{};
+  TEST_ASSERT_TRUE(run_profiles(profiles, 0, inverter).empty());  // no mode selected yet
+  TEST_ASSERT_EQUAL_UINT8(InverterProfiles::SIZE,
+                          profiles.select(SwitchMode::INVERTER_MODE_SCRUT));
+  TEST_ASSERT_EQUAL(2 * InverterProfiles::SIZE, run_profiles(profiles, 0, inverter).size());
+  TEST_ASSERT_TRUE(profiles.in_sync());
+
+  // same ramps, different currents and speed limit
+  TEST_ASSERT_EQUAL_UINT8(3, profiles.select(SwitchMode::INVERTER_MODE_CRUISING));
+  const std::vector<CAN_message_t> frames = run_profiles(profiles, 20, inverter);
+  TEST_ASSERT_EQUAL(6, frames.size());
+  const auto values = InverterProfiles::values_of(SwitchMode::INVERTER_MODE_CRUISING);
+  TEST_ASSERT_EQUAL_UINT8(DEVICE_I_MAX, frames[0].buf[0]);
+  TEST_ASSERT_EQUAL_UINT32(values[0], frames[0].buf[1] | frames[0].buf[2] << 8);
+  TEST_ASSERT_EQUAL_UINT8(0x3D, frames[1].buf[0]);
+  TEST_ASSERT_EQUAL_UINT8(DEVICE_I_MAX, frames[1].buf[1]);
+  TEST_ASSERT_TRUE(profiles.in_sync());
+  TEST_ASSERT_EQUAL_UINT16(InverterProfiles::SIZE + 3, profiles.writes());
+
+  TEST_ASSERT_EQUAL_UINT8(0, profiles.select(SwitchMode::INVERTER_MODE_CRUISING));
+  TEST_ASSERT_TRUE(run_profiles(profiles, 40, inverter).empty());
+  TEST_ASSERT_EQUAL_UINT8(4, profiles.select(SwitchMode::INVERTER_MODE_AUTOCROSS));
+  TEST_ASSERT_EQUAL_UINT8(3, profiles.select(SwitchMode::INVERTER_MODE_SKIDPAD));
+
+  profiles.invalidate();
+  TEST_ASSERT_EQUAL_UINT8(InverterProfiles::SIZE,
+                          profiles.select(SwitchMode::INVERTER_MODE_SKIDPAD));
+}
+
+void test_unconfirmed_register_is_written_again_then_given_up() {
+  constexpr uint32_t TIMEOUT = InverterProfiles::READBACK_TIMEOUT_MS;
+  InverterProfiles profiles;
+  std::array<uint32_t, 256> inverter{};
+  const auto run = [&](const uint32_t now_ms) {
+    return run_profiles(profiles, now_ms, inverter, 0xFFFFFFFF, SPEED_LIMIT);
+  };
+  profiles.select(SwitchMode::INVERTER_MODE_AUTOCROSS);
+  TEST_ASSERT_EQUAL(2 * InverterProfiles::SIZE, run(0).size());
+  TEST_ASSERT_FALSE(profiles.in_sync());
+  TEST_ASSERT_TRUE(run(TIMEOUT - 1).empty());
+  for (uint8_t write = 2; write <= InverterProfiles::MAX_WRITES; write++) {
+    const std::vector<CAN_message_t> frames = run(write * TIMEOUT);
+    TEST_ASSERT_EQUAL(2, frames.size());
+    TEST_ASSERT_EQUAL_UINT8(SPEED_LIMIT, frames[0].buf[0]);
+  }
+  TEST_ASSERT_FALSE(profiles.failed());
+  TEST_ASSERT_TRUE(run(10 * TIMEOUT).empty());
+  TEST_ASSERT_TRUE(profiles.failed());
+
+  // a new speed limit is tried again; 16 bit replies only confirm the low half of a ramp
+  profiles.select(SwitchMode::INVERTER_MODE_SKIDPAD);
+  TEST_ASSERT_EQUAL(6, run_profiles(profiles, 11 * TIMEOUT, inverter, 0xFFFF).size());
+  TEST_ASSERT_TRUE(run_profiles(profiles, 13 * TIMEOUT, inverter, 0xFFFF).empty());
+  TEST_ASSERT_FALSE(profiles.in_sync());
+  TEST_ASSERT_FALSE(profiles.failed());
+
+  // so the next mode uploads that ramp again, even with the same value
+  TEST_ASSERT_EQUAL_UINT8(3, profiles.select(SwitchMode::INVERTER_MODE_ENDURANCE));
+  const std::vector<CAN_message_t> frames = run_profiles(profiles, 14 * TIMEOUT, inverter);
+  TEST_ASSERT_EQUAL(6, frames.size());
+  TEST_ASSERT_EQUAL_UINT8(SPEED_DELTAMA_DECC, frames[4].buf[0]);
+  TEST_ASSERT_TRUE(profiles.in_sync());
+}
+
+void test_late_reply_of_the_previous_mode_does_not_confirm_the_new_value() {
+  InverterProfiles profiles;
+  std::array<uint32_t, 256> inverter{};
+  profiles.select(SwitchMode::INVERTER_MODE_SCRUT);
+  run_profiles(profiles, 0, inverter);
+  TEST_ASSERT_TRUE(profiles.in_sync());
+
+  const uint32_t cruising = InverterProfiles::values_of(SwitchMode::INVERTER_MODE_CRUISING)[0];
+  const uint32_t autocross = InverterProfiles::values_of(SwitchMode::INVERTER_MODE_AUTOCROSS)[0];
+  TEST_ASSERT_TRUE(cruising != autocross);
+  profiles.select(SwitchMode::INVERTER_MODE_CRUISING);
+  CAN_message_t frame;
+  TEST_ASSERT_TRUE(profiles.next_frame(20, frame));
+  TEST_ASSERT_EQUAL_UINT8(DEVICE_I_MAX, frame.buf[0]);
+  TEST_ASSERT_TRUE(profiles.next_frame(20, frame));
+  TEST_ASSERT_EQUAL_UINT8(0x3D, frame.buf[0]);
+  inverter[DEVICE_I_MAX] = cruising;
+
+  // the read-back is answered only after the driver switched on
+  profiles.select(SwitchMode::INVERTER_MODE_AUTOCROSS);
+  profiles.on_reply(DEVICE_I_MAX, cruising, 0xFFFF);
+  const std::vector<CAN_message_t> frames = run_profiles(profiles, 21, inverter);
+  TEST_ASSERT_FALSE(frames.empty());
+  TEST_ASSERT_EQUAL_UINT8(DEVICE_I_MAX, frames[0].buf[0]);
+  TEST_ASSERT_EQUAL_UINT32(autocross, frames[0].buf[1] | frames[0].buf[2] << 8);
+  TEST_ASSERT_EQUAL_UINT32(autocross, inverter[DEVICE_I_MAX]);
+  TEST_ASSERT_TRUE(profiles.in_sync());
+}
+
+/**
+ * @brief Runs the main loop for duration_ms
+ */
+void run_loop(const uint32_t duration_ms) {
+  for (uint32_t ms = 0; ms < duration_ms; ms += MAIN_LOOP_INTERVAL) {
+    mock::advance_us(MAIN_LOOP_INTERVAL * 1'000);
+    loop();
+  }
+}
+
+void command_calibration(const uint8_t command) {
+  CAN_message_t msg;
+  msg.id = DASH_CALIBRATION_ID;
+  msg.len = 1;
+  msg.buf[0] = command;
+  mock::can_bus(CAN2).inject(msg);
+}
+
+/**
+ * @brief Payload of the latest CALIBRATION_STATUS: recording, result, stored
+ */
+std::array<uint8_t, 3> calibration_status() {
+  const auto &tx = mock::can_bus(CAN2).tx;
+  for (auto frame = tx.rbegin(); frame != tx.rend(); ++frame) {
+    if (frame->msg.id == DASH_ID && frame->msg.buf[0] == CALIBRATION_STATUS) {
+      return {frame->msg.buf[1], frame->msg.buf[2], frame->msg.buf[3]};
+    }
+  }
+  return {0xFF, 0xFF, 0xFF};
+}
+
+void set_pedals(const int higher, const int lower, const int brake) {
+  mock::set_analog(pins::analog::APPS_HIGHER, higher);
+  mock::set_analog(pins::analog::APPS_LOWER, lower);
+  mock::set_analog(pins::analog::BRAKE_PRESSURE, brake);
+}
+
+void assert_calibration_equal(const PedalCalibration &expected, const PedalCalibration &actual) {
+  TEST_ASSERT_EQUAL_UINT16(expected.higher_released, actual.higher_released);
+  TEST_ASSERT_EQUAL_UINT16(expected.higher_pressed, actual.higher_pressed);
+  TEST_ASSERT_EQUAL_UINT16(expected.lower_released, actual.lower_released);
+  TEST_ASSERT_EQUAL_UINT16(expected.lower_pressed, actual.lower_pressed);
+  TEST_ASSERT_EQUAL_UINT16(expected.brake_released, actual.brake_released);
+  TEST_ASSERT_EQUAL_UINT16(expected.brake_pressed, actual.brake_pressed);
+}
+
+void test_pedal_calibration_is_saved_and_loaded_at_boot() {
+  using Result = CalibrationMode::Result;
+  replay();
+  updatable_data.TSOn = false;
+  constexpr PedalCalibration NEW_PEDAL_BOX = {690, 260, 500, 120, 150, 600};
+  set_pedals(690, 500, 150);
+  run_loop(200);
+  command_calibration(CALIBRATION_START);
+  run_loop(MAIN_LOOP_INTERVAL);
+  TEST_ASSERT_TRUE(calibration_mode.recording());
+  TEST_ASSERT_EQUAL_UINT8(1, calibration_status()[0]);
+
+  for (int press = 0; press < 3; press++) {
+    set_pedals(260, 120, 600);
+    run_loop(200);
+    set_pedals(690, 500, 150);
+    run_loop(200);
+  }
+  command_calibration(CALIBRATION_SAVE);
+  run_loop(MAIN_LOOP_INTERVAL);
+  TEST_ASSERT_FALSE(calibration_mode.recording());
+  const std::array<uint8_t, 3> saved = {0, Result::SAVED, 1};
+  TEST_ASSERT_TRUE(calibration_status() == saved);
+  assert_calibration_equal(NEW_PEDAL_BOX, calibration_mode.calibration());
+  assert_calibration_equal(NEW_PEDAL_BOX, torque_task.plausibility().map().calibration());
+
+  // the next boot reads it back, a flipped bit brings the defaults back
+  PedalCalibration loaded;
+  TEST_ASSERT_TRUE(CalibrationMode::load(loaded));
+  assert_calibration_equal(NEW_PEDAL_BOX, loaded);
+  CalibrationMode after_reboot(data, updated_data, torque_task, can_comm_handler);
+  after_reboot.begin();
+  TEST_ASSERT_TRUE(after_reboot.stored());
+  assert_calibration_equal(NEW_PEDAL_BOX, torque_task.plausibility().map().calibration());
+
+  mock::eeprom()[config::calibration::EEPROM_ADDRESS + 6] ^= 0x10;
+  TEST_ASSERT_FALSE(CalibrationMode::load(loaded));
+  after_reboot.begin();
+  TEST_ASSERT_FALSE(after_reboot.stored());
+  assert_calibration_equal(PedalCalibration{}, torque_task.plausibility().map().calibration());
+  TEST_ASSERT_EQUAL_UINT8(0, calibration_status()[2]);
+}
+
+void test_pedal_calibration_by_buttons_keeps_a_bad_sweep_out() {
+  using Result = CalibrationMode::Result;
+  using config::calibration::HOLD_MS;
+  replay();
+  updatable_data.TSOn = false;
+  set_pedals(config::apps::HIGHER_MAX, config::apps::LOWER_MAX, 100);
+  digitalWrite(pins::digital::R2D, HIGH);
+  digitalWrite(pins::output::DISPLAY_MODE, HIGH);
+  run_loop(200);
+  const auto hold_buttons = [](const uint32_t duration_ms) {
+    digitalWrite(pins::digital::R2D, LOW);
+    run_loop(500);  // R2D alone does nothing with the TS off
+    digitalWrite(pins::output::DISPLAY_MODE, LOW);
+    run_loop(duration_ms);
+    digitalWrite(pins::digital::R2D, HIGH);
+    digitalWrite(pins::output::DISPLAY_MODE, HIGH);
+    run_loop(200);
+  };
+  hold_buttons(HOLD_MS - 200);
+  TEST_ASSERT_FALSE(calibration_mode.recording());
+  hold_buttons(3 * HOLD_MS);  // starts once, however long it is held
+  TEST_ASSERT_TRUE(calibration_mode.recording());
+
+  // pedal pushed half way only: the span is too short to be saved
+  set_pedals(config::apps::HIGHER_MAX - 100, config::apps::LOWER_MAX - 100, 400);
+  run_loop(200);
+  hold_buttons(HOLD_MS + 200);
+  TEST_ASSERT_FALSE(calibration_mode.recording());
+  TEST_ASSERT_EQUAL_UINT8(Result::APPS_HIGHER_INVALID, calibration_mode.result());
+  assert_calibration_equal(PedalCalibration{}, torque_task.plausibility().map().calibration());
+
+  // the TS coming on drops a recording, and none starts while it is on
+  command_calibration(CALIBRATION_START);
+  run_loop(MAIN_LOOP_INTERVAL);
+  TEST_ASSERT_TRUE(calibration_mode.recording());
+  updatable_data.TSOn = true;
+  run_loop(MAIN_LOOP_INTERVAL);
+  TEST_ASSERT_EQUAL_UINT8(Result::ABORTED, calibration_mode.result());
+  command_calibration(CALIBRATION_START);
+  run_loop(MAIN_LOOP_INTERVAL);
+  TEST_ASSERT_FALSE(calibration_mode.recording());
+  TEST_ASSERT_EQUAL_UINT8(Result::REFUSED, calibration_mode.result());
+  updatable_data.TSOn = false;
+  run_loop(200);
+}
+
+void test_calibration_record_crc() {
+  const auto *check = reinterpret_cast<const uint8_t *>("123456789");
+  TEST_ASSERT_EQUAL_HEX32(0xCBF43926, CalibrationMode::crc32(check, 9));
+  TEST_ASSERT_EQUAL_UINT8(CalibrationMode::NONE, CalibrationMode::check(PedalCalibration{}));
+  PedalCalibration crossed;
+  crossed.lower_pressed = crossed.higher_pressed - config::calibration::MIN_APPS_DISTANCE + 1;
+  TEST_ASSERT_EQUAL_UINT8(CalibrationMode::APPS_TOO_CLOSE, CalibrationMode::check(crossed));
+  PedalCalibration no_brake;
+  no_brake.brake_pressed = no_brake.brake_released;
+  TEST_ASSERT_EQUAL_UINT8(CalibrationMode::BRAKE_INVALID, CalibrationMode::check(no_brake));
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_replay_matches_golden_trace);
+  RUN_TEST(test_as_driving_ends_in_idle_on_emergency);
+  RUN_TEST(test_inverter_is_enabled_and_stopped);
+  RUN_TEST(test_cell_temperatures_are_decoded);
+  RUN_TEST(test_r2d_press_needs_a_stable_level_at_any_loop_rate);
+  RUN_TEST(test_bamocar_telemetry_plan_is_requested);
+  RUN_TEST(test_quiet_bamocar_register_is_requested_again);
+  RUN_TEST(test_bamocar_init_backs_off_then_gives_up);
+  RUN_TEST(test_bamocar_init_recovers_on_a_later_attempt);
+  RUN_TEST(test_torque_is_sent_every_period_within_the_mode_limits);
+  RUN_TEST(test_implausible_apps_cut_the_torque);
+  RUN_TEST(test_mode_change_uploads_only_the_differing_registers);
+  RUN_TEST(test_unconfirmed_register_is_written_again_then_given_up);
+  RUN_TEST(test_late_reply_of_the_previous_mode_does_not_confirm_the_new_value);
+  RUN_TEST(test_pedal_calibration_is_saved_and_loaded_at_boot);
+  RUN_TEST(test_pedal_calibration_by_buttons_keeps_a_bad_sweep_out);
+  RUN_TEST(test_calibration_record_crc);
+  return UNITY_END();
+}
@@ -5,7 +5,7 @@
 #include <functional>
 
 #include "Arduino.h"
-#include "circular_buffer.h"
+#include "../../ringBuffer.hpp"
 // #include "../../debugUtils.hpp"
 
 #if defined(__IMXRT1062__)
@@ -21,28 +21,11 @@
 #define SLAVE_SR spiAddr[5]
 #define SLAVE_TCR_REFRESH spiAddr[24] = (2UL << 27) | LPSPI_TCR_FRAMESZ(16 - 1) // Prescale Divide by 4 | Frame Size 16 bits
 
-#define SPI_WAIT_STATE \
-    { \
-        uint32_t __spi_wait_start_cycles__ = ARM_DWT_CYCCNT; \
-        while (!(SLAVE_SR & (1UL << 9))) { \
-            if ((ARM_DWT_CYCCNT - __spi_wait_start_cycles__) > F_CPU / 20) { \
-                SPI_ISR_EXIT \
-            } \
-            if (!(SLAVE_FSR & 0x1F0000)) continue; \
-            if ((SLAVE_SR & (1UL << 8))) {
-
-#define SPI_ENDWAIT_STATE \
-            } \
-        } \
-    }
-
-#define SPI_ISR_EXIT \
-    SLAVE_SR = 0x3F00; \
-    asm volatile ("dsb"); \
-    return;
+#define SLAVE_RX_COUNT ((SLAVE_FSR >> 16) & 0x1F) // words waiting in the RX FIFO
+#define SLAVE_SR_FCF (1UL << 9) // Frame Complete Flag, set when PCS deasserts
 #endif
 
-#define SPI_MST_QUEUE_SLOTS 20
+#define SPI_MST_QUEUE_SLOTS 32
 #define SPI_MST_DATA_BUFFER_MAX 20
 
 struct AsyncMST {
@@ -50,6 +33,19 @@ struct AsyncMST {
   uint16_t slaveID = 0;
 };
 
+/**
+ * @brief Display link statistics, kept by the slave interrupt since boot
+ */
+struct MSTStats {
+  uint32_t transactions = 0;      ///< FEED handshakes
+  uint32_t packets_sent = 0;      ///< packets acknowledged (CE0A) and removed from the queue
+  uint32_t last_duration_us = 0;  ///< FEED to chip select release
+  uint32_t max_duration_us = 0;
+  uint32_t max_isr_cycles = 0;    ///< longest single interrupt
+  uint16_t queue_depth = 0;       ///< packets waiting at the last handshake
+  uint16_t max_queue_depth = 0;
+};
+
 using slave_handler_ptr = void(*)(uint16_t* buffer, uint16_t length, AsyncMST info);
 using detectPtr = std::function<void(AsyncMST info)>;
 
@@ -69,21 +65,34 @@ class SPI_MSTransfer_T4_Base {
 static SPI_MSTransfer_T4_Base* LPSPI4 = nullptr;
 
 
-// The size (2nd template argument) must always be a power of 2
-// This example doesn't work bcs it's not a compile-time constant:
-// (uint32_t)pow(2, ceil(log(SPI_MST_QUEUE_SLOTS) / log(2)))
-inline Circular_Buffer<uint16_t, SPI_MST_QUEUE_SLOTS, SPI_MST_DATA_BUFFER_MAX> smtqueue;
+// Packets for the display: the loop queues them (transfer16), the slave ISR sends them in place
+inline ring::PacketRing<uint16_t, SPI_MST_QUEUE_SLOTS, SPI_MST_DATA_BUFFER_MAX> smtqueue;
 
 SPI_MSTransfer_T4_CLASS class SPI_MSTransfer_T4 : public SPI_MSTransfer_T4_Base {
   public:
     SPI_MSTransfer_T4();
     void begin() const;
     uint16_t transfer16(const uint16_t *buffer, uint16_t length, uint16_t widgetID, uint16_t packetID);
+    MSTStats stats() const;
 
   private:
+    /**
+     * @brief Where the slave is in a display transaction, all of it with chip select held:
+     * FEED handshake, status polls until F00D, packet words until CE0A, then acks
+     */
+    enum class SlaveState : uint8_t { WAIT_FEED, NO_PACKET, COMMAND, DATA, ACK };
+
     volatile uint32_t *spiAddr;
     void SPI_MSTransfer_SLAVE_ISR() override;
+    uint16_t respond(uint16_t command);
+    void end_transaction();
     uint32_t nvic_irq = 0;
+
+    SlaveState state = SlaveState::WAIT_FEED;
+    std::span<const uint16_t> packet; ///< front of smtqueue, sent from the ring itself
+    uint16_t packet_pos = 0;
+    uint32_t transaction_start_us = 0;
+    MSTStats link_stats;
 };
 
 #include "SPI_MSTransfer_T4.tpp"
@@ -59,8 +59,7 @@ void SPI_MSTransfer_T4_OPT::begin() const {
     SLAVE_CR = LPSPI_CR_RST; /* Reset Module */
     SLAVE_CR = 0; /* Disable Module */
     SLAVE_FCR = 0;
-    SLAVE_IER = 0x1; /* RX Interrupt */
-    // todo yves: this is weird bcs bit 0 zero corresponds to TDIE (Transmit Data Interrupt Enable)
+    SLAVE_IER = (1UL << 1) | (1UL << 9); /* RDIE: word received, FCIE: chip select released */
     SLAVE_CFGR0 = 0;
     SLAVE_CFGR1 = (LPSPI_CFGR1_OUTCFG & 0xFCFFFFFF) | (3UL << 24);
 
@@ -73,57 +72,85 @@ void SPI_MSTransfer_T4_OPT::begin() const {
     NVIC_ENABLE_IRQ(nvic_irq);
 }
 
+// The ISR never waits for the bus: each interrupt answers the words already in the RX FIFO and
+// returns. An answer is written as soon as its command arrives and goes out while the master
+// clocks the next word, as before, so the display sees the same protocol.
 SPI_MSTransfer_T4_FUNC
 void SPI_MSTransfer_T4_OPT::SPI_MSTransfer_SLAVE_ISR() {
-    static uint16_t header;
-    // Blocking loop; Wait for FEED command
-    SPI_WAIT_STATE
-        header = SLAVE_RDR;
-        header = (header << 1) | (header >> 15); // Apply circular left shift of 1
-        if ((header != 0xFEED)) {
-            SLAVE_TDR(header);
-            continue;
-        } else
-            SLAVE_TDR(0xCC00);
-
-        break;
-    SPI_ENDWAIT_STATE
-
-    if (!smtqueue.size()) // No slave queue
-    {
-        SPI_WAIT_STATE
-            SLAVE_RDR;
-            SLAVE_TDR(0x6900);
-        SPI_ENDWAIT_STATE
-    } else // Access Slave Queue
-    {
-        uint16_t buf[smtqueue.length_front()] = {0}, pos = 0, command = 0;
-        smtqueue.peek_front(buf, sizeof(buf) >> 1);
-        SPI_WAIT_STATE
-            command = SLAVE_RDR;
-            command = (command << 1) | (command >> 15);
-            SLAVE_TDR(0x6900 | smtqueue.size());
+    const uint32_t start_cycles = ARM_DWT_CYCCNT;
+    const uint32_t status = SLAVE_SR;
+    while (SLAVE_RX_COUNT) {
+        uint16_t command = SLAVE_RDR;
+        command = (command << 1) | (command >> 15); // Apply circular left shift of 1
+        SLAVE_TDR(respond(command));
+    }
+    if (status & SLAVE_SR_FCF) {
+        end_transaction();
+    }
+    SLAVE_SR = status & 0x3F00; /* only the flags handled here, a later FCF fires again */
+    const uint32_t cycles = ARM_DWT_CYCCNT - start_cycles;
+    if (cycles > link_stats.max_isr_cycles) {
+        link_stats.max_isr_cycles = cycles;
+    }
+    asm volatile ("dsb");
+}
+
+SPI_MSTransfer_T4_FUNC
+uint16_t SPI_MSTransfer_T4_OPT::respond(const uint16_t command) {
+    switch (state) {
+        case SlaveState::WAIT_FEED:
+            if (command != 0xFEED) {
+                return command;
+            }
+            transaction_start_us = micros();
+            link_stats.transactions++;
+            link_stats.queue_depth = smtqueue.size();
+            if (link_stats.queue_depth > link_stats.max_queue_depth) {
+                link_stats.max_queue_depth = link_stats.queue_depth;
+            }
+            if (!smtqueue.size()) { // No slave queue
+                state = SlaveState::NO_PACKET;
+            } else { // Access Slave Queue
+                packet = smtqueue.front();
+                state = SlaveState::COMMAND;
+            }
+            return 0xCC00;
+        case SlaveState::NO_PACKET:
+            return 0x6900;
+        case SlaveState::COMMAND:
             if (command == 0xF00D) {
-                SPI_WAIT_STATE
-                    command = SLAVE_RDR;
-                    command = (command << 1) | (command >> 15);
-                    if (pos >= (sizeof(buf) >> 1))
-                        pos = 0;
-                    SLAVE_TDR(buf[pos]);
-                    pos++;
-                    if (command == 0xCE0A) {
-                        smtqueue.pop_front();
-                        SPI_WAIT_STATE
-                            command = SLAVE_RDR;
-                            command = (command << 1) | (command >> 15);
-                            SLAVE_TDR(0xD632);
-                        SPI_ENDWAIT_STATE
-                    }
-                SPI_ENDWAIT_STATE
+                packet_pos = 0;
+                state = SlaveState::DATA;
+            }
+            return 0x6900 | smtqueue.size();
+        case SlaveState::DATA: {
+            if (packet_pos >= packet.size()) {
+                packet_pos = 0;
+            }
+            const uint16_t word = packet.empty() ? 0 : packet[packet_pos++];
+            if (command == 0xCE0A) {
+                smtqueue.pop();
+                link_stats.packets_sent++;
+                state = SlaveState::ACK;
             }
-        SPI_ENDWAIT_STATE
-    } /* end of 0xFEED CMD */
-    SPI_ISR_EXIT
+            return word;
+        }
+        case SlaveState::ACK:
+            return 0xD632;
+    }
+    return command;
+}
+
+SPI_MSTransfer_T4_FUNC
+void SPI_MSTransfer_T4_OPT::end_transaction() {
+    if (state == SlaveState::WAIT_FEED) {
+        return;
+    }
+    state = SlaveState::WAIT_FEED;
+    link_stats.last_duration_us = micros() - transaction_start_us;
+    if (link_stats.last_duration_us > link_stats.max_duration_us) {
+        link_stats.max_duration_us = link_stats.last_duration_us;
+    }
 }
 
 SPI_MSTransfer_T4_FUNC
@@ -161,20 +188,24 @@ uint16_t SPI_MSTransfer_T4_OPT::transfer16(const uint16_t *buffer, const uint16_
     data[data_pos] = checksum;
 
     // Try to replace existing packet with same widgetID (position 2 in the packet)
-    if (smtqueue.replace(data, length + 5, 2, -1, -1)) {
-        // DEBUG_PRINT("Replaced existing packet for widget ");
-        // DEBUG_PRINT_VAR(widgetID)
+    const std::span<const uint16_t> packet(data, length + 5);
+    if (smtqueue.replace(packet, [widgetID](const std::span<const uint16_t> queued) {
+            return queued.size() > 2 && queued[2] == widgetID;
+        })) {
         return widgetID;
     }
 
     // If no existing packet found, try to add new one
-    if (smtqueue.size() == smtqueue.capacity()) {
-        // DEBUG_PRINT("Queue is full, cannot transfer data.");
+    if (!smtqueue.push(packet)) {
         return 0;
     }
-
-    smtqueue.push_back(data, length + 5);
-    // DEBUG_PRINT("Added new packet for widget ");
-    // DEBUG_PRINT_VAR(widgetID);
     return widgetID;
 }
+
+SPI_MSTransfer_T4_FUNC
+MSTStats SPI_MSTransfer_T4_OPT::stats() const {
+    NVIC_DISABLE_IRQ(nvic_irq);
+    const MSTStats copy = link_stats;
+    NVIC_ENABLE_IRQ(nvic_irq);
+    return copy;
+}
@@ -19,6 +19,9 @@
 #define LATCHING_ERROR_PIN 34
 #define DISPLAY_BUTTON_PIN 17
 
+#define SDC_BUTTON_STABLE_US 0         // reported on the display as soon as it changes
+#define DISPLAY_BUTTON_STABLE_US 10'000
+
 #define MAX_VOLTAGE 600'000
 #define SET_CURRENT 14'000
 
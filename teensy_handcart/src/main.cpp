@@ -1,9 +1,10 @@
 #include <Arduino.h>
-#include <Bounce2.h>
 #include <FlexCAN_T4.h>
 #include <elapsedMillis.h>
 
 #include "../../CAN_IDs.h"
+#include "../../debugUtils.hpp"
+#include "../../inputConditioning.hpp"
 #include "SPI_MSTransfer_T4.h"
 #include "constants.hpp"
 #include "structs.hpp"
@@ -24,7 +25,8 @@ const CAN_message_t HC_msg = {.id = HC_ID, .len = 1, .buf = {0x00}};
 bool ch_enable_pin = 1;    // This was CH enable pin status
 bool shutdown_status = 1;  // latching status, 1(high) for shutdown
 bool sdc_status_pin = 0;
-auto sdc_reset_button = Bounce();
+enum Button : uint8_t { SDC_BUTTON, DISPLAY_BUTTON, NUM_BUTTONS };
+InputConditioner<NUM_BUTTONS> buttons({SDC_BUTTON_STABLE_US, DISPLAY_BUTTON_STABLE_US});
 bool sdc_reset_button_pressed = false;
 int a = 0;
 bool last_shutdown_status = false;
@@ -36,13 +38,13 @@ void handle_set_data_response(const CAN_message_t &message) {
   switch (message.buf[1]) {
     case SET_VOLTAGE_RESPONSE: {
       extract_value(param.set_voltage, message.buf);
-      print_value("Voltage Set= ", param.set_voltage);
+      LOG_DEBUG(LOG_CAN, "Voltage Set= %u", param.set_voltage);
       break;
     }
 
     case SET_CURRENT_RESPONSE: {
       extract_value(param.set_current, message.buf);
-      print_value("Current Set= ", param.set_current);
+      LOG_DEBUG(LOG_CAN, "Current Set= %u", param.set_current);
       break;
     }
 
@@ -97,10 +99,11 @@ void parse_charger_message(const CAN_message_t &message) {
 }
 
 void can_snifflas(const CAN_message_t &message) {
-  // Serial.print("Received CAN message with ID: ");
-  // Serial.print(message.id, HEX);
+  LOG_DEBUG(LOG_CAN, "Received CAN message with ID: 0x%X", message.id);
   received = true;
-  if (message.id == CHARGER_ID) {
+  if (message.id == DEBUG_LOG_CONFIG_ID) {
+    debug_log::apply_log_config(message.buf, message.len, DEBUG_LOG_BOARD_HANDCART);
+  } else if (message.id == CHARGER_ID) {
     parse_charger_message(message);
   } else if (message.id == BMS_ID_CCL) {
     param.ccl = message.buf[0] * 1000;        // Assuming conversion is correct
@@ -119,7 +122,7 @@ void can_snifflas(const CAN_message_t &message) {
 
   } else if (message.id == BMS_ID_ERR) {
     // Handle error messages if needed
-    Serial.println("Error message received");
+    LOG_WARN(LOG_CAN, "Error message received");
   } else if (message.id >= CELL_TEMPS_BASE_ID && message.id < (CELL_TEMPS_BASE_ID + TOTAL_BOARDS)) {
     // Handles new teensy_cells temperature messages
     uint8_t board_id_from_can_id = message.id - CELL_TEMPS_BASE_ID;
@@ -222,32 +225,35 @@ void charger_machine() {
       break;
     }
     case Status::SHUTDOWN:
-      Serial.println("SHUTDOWN!");
+      LOG_WARN(LOG_STATE, "SHUTDOWN!");
       break;
 
     default: {
-      Serial.println("invalid charger state");
+      LOG_ERROR(LOG_STATE, "invalid charger state %u", static_cast<uint8_t>(charger_status));
       break;
     }
   }
 }
 
+uint32_t sample_buttons() {
+  return static_cast<uint32_t>(digitalRead(SDC_BUTTON_PIN)) << SDC_BUTTON |
+         static_cast<uint32_t>(digitalRead(DISPLAY_BUTTON_PIN)) << DISPLAY_BUTTON;
+}
+
 void read_inputs() {
-  static bool last_sdc_status = false;
   shutdown_status = digitalRead(SHUTDOWN_PIN);
   ch_enable_pin = digitalRead(CH_ENABLE_PIN);
 
-  sdc_status_pin = digitalRead(SDC_BUTTON_PIN);
+  buttons.update(sample_buttons(), micros());
+  sdc_status_pin = buttons.state(SDC_BUTTON);
   // Serial.print("SDC: ");
   // Serial.println(sdc_status_pin ? "ON" : "OFF");
-  if (sdc_status_pin != last_sdc_status) {
-    last_sdc_status = sdc_status_pin;
+  if (buttons.rose(SDC_BUTTON) || buttons.fell(SDC_BUTTON)) {
     const uint16_t buf[] = {sdc_status_pin};
     displaySPI.transfer16(buf, 1, WIDGET_SDC_BUTTON, millis() & 0xFFFF);
   }
 
-  sdc_reset_button.update();
-  sdc_reset_button_pressed = sdc_reset_button.rose();
+  sdc_reset_button_pressed = buttons.rose(DISPLAY_BUTTON);
 }
 
 void power_on_module(const bool OnOff) {
@@ -415,6 +421,9 @@ void can_init(uint32_t baud_rate = 125'000) {
       break;
     }
   }
+  if (!can2.setFIFOFilter(all_temps_filter_start + TOTAL_BOARDS, DEBUG_LOG_CONFIG_ID, STD)) {
+    Serial.println("Failed to set FIFO filter to DEBUG_LOG_CONFIG_ID");
+  }
 
   can2.onReceive(can_snifflas);
 }
@@ -432,8 +441,9 @@ void setup() {
   pinMode(SDC_BUTTON_PIN, INPUT);
   pinMode(SDC_BUTTON_OUTPUT_PIN, OUTPUT);
   digitalWrite(SDC_BUTTON_OUTPUT_PIN, LOW);  // Set SDC button output pin to low (open drain)
-  sdc_reset_button.attach(DISPLAY_BUTTON_PIN, INPUT);
-  sdc_reset_button.interval(10);  // 50ms debounce time
+  pinMode(DISPLAY_BUTTON_PIN, INPUT);
+  // The display button idles high, start from the pins so it does not rise at boot
+  buttons.reset(sample_buttons(), micros());
 
   displaySPI.begin();
 
@@ -475,10 +485,11 @@ void setup() {
   delay(100);
   constexpr uint16_t buf[] = {0x0000};
   displaySPI.transfer16(buf, 1, WIDGET_CH_STATUS, millis() & 0xFFFF);
-  // DBUG_PRINT_VAR(widgetID);
+  // DEBUG_PRINT_VAR(widgetID);
 }
 
 void loop() {
+  DEBUG_LOG_FLUSH();
   if (step < 500) {
     return;
   }
@@ -489,26 +500,15 @@ void loop() {
   read_inputs();
 
   charger_machine();
-  Serial.println("charger machine");
-  Serial.println("Charger status: ");
-  switch (charger_status) {
-    case Status::IDLE:
-      Serial.println("IDLE");
-      break;
-    case Status::CHARGING:
-      Serial.println("CHARGING");
-      break;
-    case Status::SHUTDOWN:
-      Serial.println("SHUTDOWN");
-      break;
-    default:
-      Serial.println("UNKNOWN STATUS");
-      break;
+  LOG_INFO(LOG_STATE, "Charger status: %u (0 IDLE, 1 CHARGING, 2 SHUTDOWN)",
+           static_cast<uint8_t>(charger_status));
+  LOG_INFO(LOG_IO, "Shutdown %u, CH enable %u, CH safety %u, SDC %u", shutdown_status,
+           ch_enable_pin, param.ch_safety, sdc_status_pin);
+  if (LOG_ENABLED(LOG_LEVEL_DEBUG, LOG_SPI)) {
+    const MSTStats link = displaySPI.stats();
+    LOG_DEBUG(LOG_SPI, "Display link: %u transactions, %u us max, queue %u max, ISR %u cycles max",
+              link.transactions, link.max_duration_us, link.max_queue_depth, link.max_isr_cycles);
   }
-  print_value("Shutdown status: ", shutdown_status);
-  print_value("CH enable pin: ", ch_enable_pin);
-  print_value("param.ch_safety: ", param.ch_safety);
-  print_value("SDC status pin: ", sdc_status_pin);
 
   param.allowed_current = /* (param.ccl < SET_CURRENT) ? param.ccl :  */ SET_CURRENT;
 
@@ -521,7 +521,7 @@ void loop() {
 
   // Toggle display every 20 seconds instead of button press
   if (display_timer >= 20000) {  // 20000 ms = 20 seconds
-    Serial.println("Display toggle - 20s elapsed");
+    LOG_DEBUG(LOG_SPI, "Display toggle - 20s elapsed");
     form_num = (form_num == 1) ? 2 : 1;  // toggle 1 and 2
     data[0] = form_num;
     displaySPI.transfer16(data, 1, WIDGET_FORM_CMD, millis() & 0xFFFF);
@@ -530,7 +530,7 @@ void loop() {
 
   // Keep the button functionality for manual toggle if needed
   if (sdc_reset_button_pressed && a == 0) {
-    Serial.println("button pressed - manual toggle");
+    LOG_DEBUG(LOG_SPI, "button pressed - manual toggle");
     form_num = (form_num == 1) ? 2 : 1;  // toggle 1 and 2
     data[0] = form_num;
     displaySPI.transfer16(data, 1, 0x9999, millis() & 0xFFFF);
@@ -538,6 +538,8 @@ void loop() {
     display_timer = 0;  // Reset timer when manually toggled
   }
 
-  print_all_board_temps();
-  // print_temps();
+  if (LOG_ENABLED(LOG_LEVEL_INFO, LOG_TEMP)) {
+    print_all_board_temps();
+    // print_temps();
+  }
 }
\ No newline at end of file
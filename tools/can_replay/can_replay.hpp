@@ -0,0 +1,237 @@
+#pragma once
+#include <FlexCAN_T4.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "native_mock.hpp"
+
+/**
+ * @brief Replays a recorded CAN trace into firmware running on the native mocks
+ *
+ * Frames are delivered through mock::CanBus::inject at their recorded offsets on the virtual
+ * clock, so they land between (or during the delay() of) loop iterations exactly as the receive
+ * interrupt would. The virtual timeline is always the recorded one; Options::speed only decides
+ * how fast it is walked in wall-clock time.
+ */
+namespace can_replay {
+
+struct Frame {
+  uint64_t time_us = 0;  // relative to the first frame of the trace
+  CAN_message_t msg;
+};
+
+/**
+ * @brief Parses `candump -l` lines: "(1700000000.123456) can0 181#8F0400"
+ *
+ * 8 hex digit ids are extended. Remote, CAN FD and malformed lines are skipped.
+ */
+inline std::vector<Frame> parse_candump(std::istream &in) {
+  std::vector<Frame> frames;
+  std::string line;
+  bool have_origin = false;
+  uint64_t origin_us = 0;
+  while (std::getline(in, line)) {
+    unsigned long long seconds = 0;
+    unsigned long long micros = 0;
+    char interface[32];
+    char payload[64];
+    if (std::sscanf(line.c_str(), " (%llu.%6llu) %31s %63s", &seconds, &micros, interface,
+                    payload) != 4) {
+      continue;
+    }
+    const std::string text = payload;
+    const auto hash = text.find('#');
+    if (hash == std::string::npos || hash == 0 || text.find("##") != std::string::npos ||
+        text.find("#R") != std::string::npos) {
+      continue;
+    }
+    const std::string data = text.substr(hash + 1);
+    if (data.size() % 2 != 0 || data.size() > 16) {
+      continue;
+    }
+    Frame frame;
+    frame.msg.id = static_cast<uint32_t>(std::strtoul(text.substr(0, hash).c_str(), nullptr, 16));
+    frame.msg.flags.extended = hash == 8;
+    frame.msg.len = static_cast<uint8_t>(data.size() / 2);
+    for (uint8_t i = 0; i < frame.msg.len; i++) {
+      frame.msg.buf[i] =
+          static_cast<uint8_t>(std::strtoul(data.substr(2 * i, 2).c_str(), nullptr, 16));
+    }
+    const uint64_t stamp_us = seconds * 1'000'000ULL + micros;
+    if (!have_origin) {
+      origin_us = stamp_us;
+      have_origin = true;
+    }
+    frame.time_us = stamp_us >= origin_us ? stamp_us - origin_us : 0;
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+inline std::vector<Frame> load_candump(const std::string &path) {
+  std::ifstream in(path);
+  return parse_candump(in);
+}
+
+struct Options {
+  double speed = 0;            // 0 = as fast as possible, 1 = original timing, N = N times faster
+  uint64_t tail_us = 0;        // keep running the firmware this long after the last frame
+  uint64_t idle_step_us = 1000;  // clock step when a loop iteration does not advance time itself
+
+  /**
+   * @brief CAN_REPLAY_SPEED overrides the speed, e.g. CAN_REPLAY_SPEED=1 to watch a run live
+   */
+  static Options from_env(Options options) {
+    if (const char *speed = std::getenv("CAN_REPLAY_SPEED")) {
+      options.speed = std::atof(speed);
+    }
+    return options;
+  }
+  static Options from_env() { return from_env(Options{}); }
+};
+
+struct Stats {
+  uint64_t frames = 0;
+  uint64_t accepted = 0;  // passed the acceptance filters configured by the firmware
+  uint64_t iterations = 0;
+  uint64_t virtual_us = 0;
+  double wall_s = 0;
+};
+
+/**
+ * @brief Streams frames into bus while calling step() (one loop() iteration) until the trace
+ * and the tail are done
+ */
+template <class Step>
+Stats run(const std::vector<Frame> &frames, mock::CanBus &bus, Step &&step,
+          const Options &options = {}) {
+  Stats stats;
+  const uint64_t start_us = mock::now_us();
+  const auto wall_start = std::chrono::steady_clock::now();
+  const uint64_t accepted_before = bus.rx_accepted;
+  std::size_t next = 0;
+
+  // One pending event at a time: deliver everything sharing a timestamp, then arm the next one
+  std::function<void()> deliver;
+  deliver = [&] {
+    const uint64_t due = frames[next].time_us;
+    while (next < frames.size() && frames[next].time_us == due) {
+      bus.inject(frames[next++].msg);
+      stats.frames++;
+    }
+    if (next < frames.size()) {
+      mock::schedule_once(frames[next].time_us - due, deliver);
+    }
+  };
+  if (!frames.empty()) {
+    mock::schedule_once(frames.front().time_us, deliver);
+  }
+
+  const uint64_t end_us = start_us + (frames.empty() ? 0 : frames.back().time_us) + options.tail_us;
+  while (mock::now_us() < end_us || next < frames.size()) {
+    const uint64_t before = mock::now_us();
+    step();
+    stats.iterations++;
+    if (mock::now_us() == before) {
+      mock::advance_us(options.idle_step_us);
+    }
+    if (options.speed > 0) {
+      const auto target = wall_start + std::chrono::duration<double, std::micro>(
+                                           (mock::now_us() - start_us) / options.speed);
+      std::this_thread::sleep_until(target);
+    }
+  }
+  stats.accepted = bus.rx_accepted - accepted_before;
+  stats.virtual_us = mock::now_us() - start_us;
+  stats.wall_s =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+  return stats;
+}
+
+/**
+ * @brief Text log of value changes, one "<time ms> <name> <value>" line per change
+ */
+class StateTrace {
+public:
+  void record(const std::string &name, long value, const char *label = nullptr) {
+    for (auto &entry : last_) {
+      if (entry.first == name) {
+        if (entry.second == value) {
+          return;
+        }
+        entry.second = value;
+        append(name, value, label);
+        return;
+      }
+    }
+    last_.emplace_back(name, value);
+    append(name, value, label);
+  }
+
+  void note(const std::string &text) {
+    char stamp[32];
+    std::snprintf(stamp, sizeof(stamp), "%10.3f ", static_cast<double>(mock::now_us()) / 1000.0);
+    text_ += stamp + text + "\n";
+  }
+
+  [[nodiscard]] const std::string &text() const { return text_; }
+
+private:
+  void append(const std::string &name, long value, const char *label) {
+    note(name + " " + (label != nullptr ? std::string(label) : std::to_string(value)));
+  }
+
+  std::vector<std::pair<std::string, long>> last_;
+  std::string text_;
+};
+
+/**
+ * @brief Compares a trace with its golden file, or rewrites the golden when UPDATE_GOLDEN is set
+ * @return empty when they match, otherwise a short description of the first differences
+ */
+inline std::string compare_with_golden(const std::string &actual, const std::string &golden_path) {
+  if (std::getenv("UPDATE_GOLDEN") != nullptr) {
+    std::ofstream(golden_path) << actual;
+    return {};
+  }
+  std::ifstream golden_file(golden_path);
+  if (!golden_file) {
+    return "missing golden file " + golden_path + " (run with UPDATE_GOLDEN=1 to create it)";
+  }
+  std::stringstream golden_text;
+  golden_text << golden_file.rdbuf();
+
+  std::istringstream expected(golden_text.str());
+  std::istringstream got(actual);
+  std::string diff;
+  std::string expected_line;
+  std::string got_line;
+  int line = 1;
+  int reported = 0;
+  constexpr int MAX_REPORTED = 5;
+  while (reported < MAX_REPORTED) {
+    const bool has_expected = static_cast<bool>(std::getline(expected, expected_line));
+    const bool has_got = static_cast<bool>(std::getline(got, got_line));
+    if (!has_expected && !has_got) {
+      break;
+    }
+    if (!has_expected) expected_line = "<end of golden>";
+    if (!has_got) got_line = "<end of trace>";
+    if (expected_line != got_line) {
+      diff += "line " + std::to_string(line) + ":\n  - " + expected_line + "\n  + " + got_line +
+              "\n";
+      reported++;
+    }
+    line++;
+  }
+  return diff;
+}
+
+}  // namespace can_replay
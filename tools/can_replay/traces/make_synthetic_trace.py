@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Writes autonomous_res_emergency.log, a candump -l trace of an acceleration run.
+
+Until a recording from the car is checked in, this stands in for one: every node the
+master and dash listen to keeps its usual heartbeat, the inverter reports TS on after
+1 s, the RES sends GO at 8 s and an emergency stop at 10 s, and the master's own state
+frames follow the sequence the master replay golden records. Front hydraulic pressure
+is not in here, the master test models the dash sensor from the EBS valve outputs.
+"""
+import pathlib
+
+EPOCH = 1_718_000_000_000_000  # arbitrary wall clock origin, only the deltas matter
+END_US = 19_000_000
+
+RES_STATE = 0x191
+AS_CU = 0x400
+STEERING = 0x295D
+BAMO_RESPONSE = 0x181
+BMS = 0x101
+MASTER = 0x300
+ALL_TEMPS = 0x280
+
+AS_OFF, AS_READY, AS_DRIVING, AS_EMERGENCY = 1, 2, 3, 5
+READY_US, GO_US, EMERGENCY_US = 2_480_000, 8_000_000, 10_000_000
+# (time, state) published by the master at 40 ms, taken from the master golden
+MASTER_STATES = [(0, AS_OFF), (READY_US, AS_READY), (8_110_000, AS_DRIVING),
+                 (10_110_000, AS_EMERGENCY), (18_130_000, AS_OFF)]
+
+frames = []
+
+
+def frame(t_us, can_id, data, extended=False):
+    frames.append((t_us, can_id, bytes(data), extended))
+
+
+def periodic(period_us, start_us=0):
+    return range(start_us, END_US, period_us)
+
+
+for t in periodic(50_000, 5_000):
+    go = GO_US <= t < GO_US + 150_000
+    stopped = t >= EMERGENCY_US
+    byte0 = 0x00 if stopped else 0x01 | (0x04 if go else 0x00)
+    byte3 = 0x00 if stopped else 0x80
+    frame(t, RES_STATE, [byte0, 0, 0, byte3, 0, 0, 92, 0])
+for t in periodic(100_000, 10_000):
+    frame(t, AS_CU, [0x41])
+for t in periodic(100_000, 15_000):
+    frame(t, STEERING, [0x00, 0x7B, 0, 0, 0, 0, 0x1E, 0], extended=True)
+for t in periodic(20_000, 2_000):
+    volts = 0 if t < 1_000_000 else min(2600, (t - 1_000_000) // 1_000 * 10)
+    frame(t, BAMO_RESPONSE, [0xEB, volts & 0xFF, volts >> 8, 0])
+for t in periodic(100_000, 20_000):
+    frame(t, BMS, [0, 0, 0, 0, 0, 0, 0, 0])
+for t in periodic(500_000, 25_000):
+    for board in range(6):
+        for chunk in range(3):
+            frame(t + board * 100 + chunk * 20, ALL_TEMPS + board,
+                  [board, chunk] + [25 + board + chunk] * 6)
+for start, state in MASTER_STATES:
+    following = [s for s, _ in MASTER_STATES if s > start]
+    stop = following[0] if following else END_US
+    for t in range(start + 3_000, stop, 40_000):
+        frame(t, MASTER, [0x31, state])
+# Inverter answers the dash's init sequence once the master is ready
+frame(READY_US + 150_000, BAMO_RESPONSE, [0xE2, 0x01, 0x00, 0x00])
+frame(READY_US + 400_000, BAMO_RESPONSE, [0xE8, 0x01, 0x00, 0x00])
+frame(600, 0x711, [0x00])  # RES boot-up
+
+frames.sort(key=lambda f: f[0])
+out = pathlib.Path(__file__).with_name("autonomous_res_emergency.log")
+with out.open("w") as f:
+    for t, can_id, data, extended in frames:
+        stamp = EPOCH + t
+        ident = f"{can_id:08X}" if extended else f"{can_id:03X}"
+        f.write(f"({stamp // 1_000_000}.{stamp % 1_000_000:06d}) can0 {ident}#{data.hex().upper()}\n")
+print(f"{out.name}: {len(frames)} frames")
@@ -0,0 +1,82 @@
+#pragma once
+#include <charconv>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Buffered CSV writer using std::to_chars, which is several times faster than iostreams
+ */
+class CsvWriter {
+public:
+  explicit CsvWriter(const std::string& path) : file_(std::fopen(path.c_str(), "wb")) {
+    if (file_ == nullptr) {
+      throw std::runtime_error("cannot create " + path);
+    }
+    buffer_.reserve(FLUSH_SIZE + 256);
+  }
+  ~CsvWriter() {
+    flush();
+    std::fclose(file_);
+  }
+  CsvWriter(const CsvWriter&) = delete;
+  CsvWriter& operator=(const CsvWriter&) = delete;
+
+  CsvWriter& field(std::string_view text) {
+    separator();
+    buffer_.append(text);
+    return *this;
+  }
+
+  CsvWriter& field(double value) {
+    separator();
+    char tmp[32];
+    const auto result = std::to_chars(tmp, tmp + sizeof(tmp), value);
+    buffer_.append(tmp, result.ptr);
+    return *this;
+  }
+
+  CsvWriter& field(uint64_t value) {
+    separator();
+    char tmp[24];
+    const auto result = std::to_chars(tmp, tmp + sizeof(tmp), value);
+    buffer_.append(tmp, result.ptr);
+    return *this;
+  }
+
+  /**
+   * @brief Leaves the field empty (signal not present in this row)
+   */
+  CsvWriter& empty() {
+    separator();
+    return *this;
+  }
+
+  void end_row() {
+    buffer_.push_back('\n');
+    first_in_row_ = true;
+    if (buffer_.size() >= FLUSH_SIZE) {
+      flush();
+    }
+  }
+
+private:
+  static constexpr std::size_t FLUSH_SIZE = 1 << 20;
+
+  void separator() {
+    if (!first_in_row_) {
+      buffer_.push_back(',');
+    }
+    first_in_row_ = false;
+  }
+
+  void flush() {
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    buffer_.clear();
+  }
+
+  std::FILE* file_;
+  std::string buffer_;
+  bool first_in_row_ = true;
+};
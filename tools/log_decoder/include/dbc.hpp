@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief One SG_ entry of a DBC file
+ */
+struct DbcSignal {
+  std::string name;
+  uint16_t start_bit = 0;
+  uint16_t length = 0;
+  bool little_endian = true;  // @1 (Intel) or @0 (Motorola)
+  bool is_signed = false;
+  double factor = 1.0;
+  double offset = 0.0;
+  double minimum = 0.0;
+  double maximum = 0.0;
+  std::string unit;
+  bool is_multiplexor = false;
+  std::optional<uint32_t> mux_value;  // set for signals only present for one multiplexor value
+
+  /**
+   * @brief Extracts the raw (unscaled) value from a frame payload
+   */
+  [[nodiscard]] int64_t raw(const uint8_t* data, uint8_t len) const;
+
+  /**
+   * @brief Extracts and scales the physical value from a frame payload
+   */
+  [[nodiscard]] double decode(const uint8_t* data, uint8_t len) const {
+    return static_cast<double>(raw(data, len)) * factor + offset;
+  }
+
+  /**
+   * @brief Whether the signal lies fully inside a payload of len bytes
+   */
+  [[nodiscard]] bool fits(uint8_t len) const;
+};
+
+/**
+ * @brief One BO_ entry of a DBC file
+ */
+struct DbcMessage {
+  uint32_t id = 0;  // without the extended flag bit
+  bool extended = false;
+  std::string name;
+  uint8_t length = 0;
+  std::vector<DbcSignal> signals;
+  int multiplexor = -1;  // index into signals, -1 if the message is not multiplexed
+
+  /**
+   * @brief Whether the signal at index is present in this payload (multiplexing)
+   */
+  [[nodiscard]] bool is_present(std::size_t index, const uint8_t* data, uint8_t len) const;
+};
+
+/**
+ * @brief Minimal DBC database: messages and signals, enough to decode the car's buses
+ */
+class Dbc {
+public:
+  /**
+   * @brief Parses a DBC document
+   * @throws std::runtime_error on malformed BO_/SG_ lines
+   */
+  static Dbc parse(std::string_view text);
+  static Dbc load(const std::string& path);
+
+  [[nodiscard]] const DbcMessage* find(uint32_t id, bool extended) const;
+  [[nodiscard]] const DbcMessage* find_by_name(std::string_view name) const;
+  [[nodiscard]] const std::vector<DbcMessage>& messages() const { return messages_; }
+
+private:
+  static uint64_t key(uint32_t id, bool extended) {
+    return (static_cast<uint64_t>(extended) << 32) | id;
+  }
+
+  std::vector<DbcMessage> messages_;
+  std::unordered_map<uint64_t, std::size_t> by_id_;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../../../debugLogFormat.hpp"
+
+/**
+ * @brief LOG_ERROR/WARN/INFO/DEBUG format strings by ID, recovered from the firmware sources
+ *
+ * The boards only send the FNV-1a hash of each format string (debugLogFormat.hpp), so the table
+ * is rebuilt by hashing the format literal of every log call found in the sources the capture was
+ * made with (debugUtils.hpp). Only a single string literal is recognised as the format.
+ */
+class FormatTable {
+public:
+  FormatTable();
+
+  void add(const std::string& format);
+
+  /**
+   * @brief Adds the log formats of one source file's text
+   * @return formats found
+   */
+  std::size_t add_source(std::string_view text);
+
+  /**
+   * @brief Adds the formats of every .cpp, .hpp and .h file under dir
+   * @return formats found
+   */
+  std::size_t add_sources(const std::filesystem::path& dir);
+
+  [[nodiscard]] const std::string* find(uint32_t id) const;
+  [[nodiscard]] std::size_t size() const { return formats_.size(); }
+
+private:
+  std::unordered_map<uint32_t, std::string> formats_;
+};
+
+/**
+ * @brief printf of a record's format with its arguments; each argument is read as the type the
+ * board recorded and converted to what the conversion expects
+ */
+std::string format_record(const std::string& format, const dlog::Record& record);
+
+struct DebugLogSummary {
+  uint64_t records = 0;
+  uint64_t unknown_records = 0;  ///< ID not in the table, sources out of date
+  uint64_t text_bytes = 0;
+};
+
+/**
+ * @brief Turns a serial capture into text: records become "[seconds] message" lines, the plain
+ * prints around them are passed through unchanged
+ */
+DebugLogSummary decode_debug_log(const FormatTable& table, const uint8_t* data, std::size_t size,
+                                 std::string& out);
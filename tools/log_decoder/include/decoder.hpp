@@ -0,0 +1,70 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "dbc.hpp"
+#include "log_source.hpp"
+
+/**
+ * @brief Streaming statistics of one signal (Welford, so a single pass is numerically stable)
+ */
+struct SignalStats {
+  uint64_t count = 0;
+  double min = std::numeric_limits<double>::infinity();
+  double max = -std::numeric_limits<double>::infinity();
+  double mean = 0;
+  double m2 = 0;
+  double first_s = 0;
+  double last_s = 0;
+
+  void add(double time_s, double value) {
+    if (count == 0) {
+      first_s = time_s;
+    }
+    last_s = time_s;
+    count++;
+    min = std::min(min, value);
+    max = std::max(max, value);
+    const double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+  }
+
+  [[nodiscard]] double stddev() const {
+    return count > 1 ? std::sqrt(m2 / static_cast<double>(count - 1)) : 0.0;
+  }
+};
+
+struct MessageSummary {
+  const DbcMessage* message = nullptr;
+  uint64_t frames = 0;
+  std::vector<SignalStats> signals;  // same order as message->signals
+};
+
+struct DecodeSummary {
+  std::vector<MessageSummary> messages;
+  uint64_t unknown_frames = 0;
+};
+
+/**
+ * @brief Groups frames by DBC message and, in parallel per message, writes
+ * <out_dir>/<message>.csv (time_s plus one column per signal, empty when muxed out)
+ * @param t0_us timestamp mapped to time 0 in every output
+ */
+DecodeSummary export_messages(const Dbc& dbc, const std::vector<CanFrame>& frames, uint64_t t0_us,
+                              const std::string& out_dir, unsigned threads);
+
+/**
+ * @brief Writes a non-CAN SD table as <out_dir>/<name>.csv, adding a time_s column
+ */
+void export_table(const LogTableData& table, const std::string& name, uint64_t t0_us,
+                  const std::string& out_dir);
+
+/**
+ * @brief Writes <path> with one row per signal: count, min, max, mean, stddev and time span
+ */
+void write_stats(const DecodeSummary& summary, const std::string& path);
@@ -0,0 +1,65 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Read-only memory mapping of a whole file, so multi-GB logs are paged in on demand
+ */
+class MappedFile {
+public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  [[nodiscard]] const uint8_t* data() const { return data_; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+
+private:
+  const uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+struct CanFrame {
+  uint64_t timestamp_us = 0;
+  uint32_t id = 0;
+  bool extended = false;
+  uint8_t len = 0;
+  std::array<uint8_t, 8> data{};
+};
+
+/**
+ * @brief A non-CAN table of an SD log, every value widened to double
+ */
+struct LogTableData {
+  uint8_t id = 0;
+  std::vector<std::string> names;
+  std::vector<std::vector<double>> columns;  // columns[c][row]
+};
+
+struct LogContents {
+  std::vector<CanFrame> frames;       // time ordered
+  std::vector<LogTableData> tables;   // SD logs only
+  uint64_t dropped_rows = 0;          // rows the logger reported as dropped
+  uint64_t trailing_blocks = 0;       // past the end of the data, see sdLogFormat.hpp
+  uint64_t corrupt_blocks = 0;        // blocks with a bad magic
+};
+
+/**
+ * @brief Decodes a master SD card log (sdLogFormat.hpp), splitting the data blocks over threads
+ * @throws std::runtime_error if the file does not start with a valid schema
+ */
+LogContents read_sd_log(const MappedFile& file, unsigned threads);
+
+/**
+ * @brief Decodes a candump -l style text log ("(sec.usec) iface ID#DATA"), in parallel chunks
+ */
+LogContents read_candump(const MappedFile& file, unsigned threads);
+
+/**
+ * @brief Picks the reader from the file contents
+ */
+LogContents read_log(const MappedFile& file, unsigned threads);
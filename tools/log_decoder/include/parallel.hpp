@@ -0,0 +1,36 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Splits [0, count) into one contiguous range per worker and runs fn(begin, end, worker)
+ * @details Ranges are in order, so per-worker results can be concatenated to keep the input order.
+ * @return the number of workers actually used
+ */
+template <typename Fn>
+unsigned parallel_ranges(std::size_t count, unsigned threads, Fn&& fn) {
+  const unsigned workers =
+      static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, count)));
+  if (workers == 1) {
+    fn(std::size_t{0}, count, 0U);
+    return 1;
+  }
+  std::vector<std::thread> pool;
+  pool.reserve(workers);
+  const std::size_t step = (count + workers - 1) / workers;
+  for (unsigned w = 0; w < workers; w++) {
+    const std::size_t begin = std::min(count, w * step);
+    const std::size_t end = std::min(count, begin + step);
+    pool.emplace_back([&fn, begin, end, w] { fn(begin, end, w); });
+  }
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  return workers;
+}
+
+inline unsigned default_thread_count() {
+  return std::max(1U, std::thread::hardware_concurrency());
+}
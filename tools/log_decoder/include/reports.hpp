@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../../../CAN_IDs.h"
+#include "log_source.hpp"
+
+/**
+ * @brief Time spent in one master state (State enum in master/include/model/structure.hpp)
+ */
+struct StateInterval {
+  int state = 0;
+  double start_s = 0;
+  double end_s = 0;
+};
+
+/**
+ * @brief Builds the state timeline from the master's STATE_MSG frames, when they were recorded
+ */
+std::vector<StateInterval> state_timeline_from_frames(const std::vector<CanFrame>& frames,
+                                                      uint64_t t0_us);
+
+/**
+ * @brief Builds the state timeline from the "state" column of the SD log SAMPLES table
+ */
+std::vector<StateInterval> state_timeline_from_samples(const LogTableData& samples,
+                                                       uint64_t t0_us);
+
+void write_state_timeline(const std::vector<StateInterval>& timeline, const std::string& path);
+
+struct CellTemperature {
+  uint64_t count = 0;
+  int last = 0;
+  int min = std::numeric_limits<int>::max();
+  int max = std::numeric_limits<int>::min();
+  double sum = 0;
+
+  [[nodiscard]] double mean() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+};
+
+using TemperatureGrid = std::array<std::array<CellTemperature, NTC_SENSOR_COUNT>, NUM_BOARDS>;
+
+/**
+ * @brief Accumulates the chunked ALL_TEMPS_ID + board frames into the 6x18 thermistor grid
+ */
+TemperatureGrid build_temperature_grid(const std::vector<CanFrame>& frames);
+
+/**
+ * @brief Writes board x sensor matrices of max, mean and last temperature
+ */
+void write_temperature_heatmap(const TemperatureGrid& grid, const std::string& path);
+
+/**
+ * @brief Prints the max temperature grid with shading, hottest cells stand out at a glance
+ */
+void print_temperature_heatmap(const TemperatureGrid& grid, std::FILE* out);
+
+/**
+ * @brief Interval during which one bit of the Bamocar error (or warning) bitmap was set
+ */
+struct BitInterval {
+  bool warning = false;
+  int bit = 0;
+  double start_s = 0;
+  double end_s = 0;  // last time it was still seen set if never cleared
+};
+
+/**
+ * @brief Builds per-bit intervals from the Bamocar LOGICMAP_ERRORS (0x8F) responses
+ */
+std::vector<BitInterval> bamocar_error_timeline(const std::vector<CanFrame>& frames,
+                                                uint64_t t0_us);
+
+void write_bamocar_error_timeline(const std::vector<BitInterval>& timeline,
+                                  const std::string& path);
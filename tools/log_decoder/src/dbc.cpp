@@ -0,0 +1,215 @@
+#include "dbc.hpp"
+
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint32_t DBC_EXTENDED_FLAG = 0x80000000U;
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t' || s.front() == '\r')) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+/**
+ * @brief Tiny cursor over one line, consuming tokens separated by the given delimiters
+ */
+class LineCursor {
+public:
+  explicit LineCursor(std::string_view line) : rest_(line) {}
+
+  std::string_view until(char delimiter) {
+    rest_ = trim(rest_);
+    const auto pos = rest_.find(delimiter);
+    if (pos == std::string_view::npos) {
+      throw std::runtime_error("dbc: expected '" + std::string(1, delimiter) + "'");
+    }
+    const auto token = trim(rest_.substr(0, pos));
+    rest_.remove_prefix(pos + 1);
+    return token;
+  }
+
+  std::string_view word() {
+    rest_ = trim(rest_);
+    const auto pos = rest_.find_first_of(" \t");
+    const auto token = rest_.substr(0, pos);
+    rest_.remove_prefix(pos == std::string_view::npos ? rest_.size() : pos);
+    return token;
+  }
+
+  std::string_view rest() const { return trim(rest_); }
+
+private:
+  std::string_view rest_;
+};
+
+template <typename T>
+T to_number(std::string_view token) {
+  T value{};
+  const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+  if (ec != std::errc() || ptr != token.data() + token.size()) {
+    throw std::runtime_error("dbc: bad number '" + std::string(token) + "'");
+  }
+  return value;
+}
+
+DbcSignal parse_signal(std::string_view line) {
+  // SG_ name [M|mNN] : start|length@order sign (factor,offset) [min|max] "unit" receivers
+  LineCursor cursor(line);
+  cursor.word();  // SG_
+  DbcSignal signal;
+  const auto head = cursor.until(':');
+  LineCursor head_cursor(head);
+  signal.name = std::string(head_cursor.word());
+  const auto mux = head_cursor.word();
+  if (mux == "M") {
+    signal.is_multiplexor = true;
+  } else if (!mux.empty() && mux.front() == 'm') {
+    signal.mux_value = to_number<uint32_t>(mux.substr(1));
+  }
+
+  signal.start_bit = to_number<uint16_t>(cursor.until('|'));
+  signal.length = to_number<uint16_t>(cursor.until('@'));
+  const auto layout = cursor.word();
+  if (layout.size() != 2) {
+    throw std::runtime_error("dbc: bad byte order in signal " + signal.name);
+  }
+  signal.little_endian = layout[0] == '1';
+  signal.is_signed = layout[1] == '-';
+
+  cursor.until('(');
+  signal.factor = to_number<double>(cursor.until(','));
+  signal.offset = to_number<double>(cursor.until(')'));
+  cursor.until('[');
+  signal.minimum = to_number<double>(cursor.until('|'));
+  signal.maximum = to_number<double>(cursor.until(']'));
+  cursor.until('"');
+  signal.unit = std::string(cursor.until('"'));
+  return signal;
+}
+
+DbcMessage parse_message(std::string_view line) {
+  // BO_ id name: length transmitter
+  LineCursor cursor(line);
+  cursor.word();  // BO_
+  DbcMessage message;
+  const auto raw_id = to_number<uint32_t>(cursor.word());
+  message.extended = (raw_id & DBC_EXTENDED_FLAG) != 0;
+  message.id = raw_id & ~DBC_EXTENDED_FLAG;
+  message.name = std::string(cursor.until(':'));
+  message.length = to_number<uint8_t>(cursor.word());
+  return message;
+}
+
+}  // namespace
+
+int64_t DbcSignal::raw(const uint8_t* data, uint8_t len) const {
+  uint64_t value = 0;
+  if (little_endian) {
+    for (uint16_t i = 0; i < length; i++) {
+      const uint16_t bit = start_bit + i;
+      if (bit / 8 < len && (data[bit / 8] >> (bit % 8) & 1U)) {
+        value |= 1ULL << i;
+      }
+    }
+  } else {
+    // Motorola: start_bit is the MSB, walking towards lower bits then into the next byte
+    uint16_t bit = start_bit;
+    for (uint16_t i = 0; i < length; i++) {
+      value <<= 1;
+      if (bit / 8 < len && (data[bit / 8] >> (bit % 8) & 1U)) {
+        value |= 1U;
+      }
+      bit = (bit % 8 == 0) ? static_cast<uint16_t>(bit + 15) : static_cast<uint16_t>(bit - 1);
+    }
+  }
+  if (is_signed && length < 64 && (value >> (length - 1) & 1U)) {
+    value |= ~0ULL << length;  // sign extend
+  }
+  return static_cast<int64_t>(value);
+}
+
+bool DbcSignal::fits(uint8_t len) const {
+  if (little_endian) {
+    return start_bit + length <= len * 8;
+  }
+  const int msb_byte = start_bit / 8;
+  const int lsb_byte = msb_byte + (length - 1 - (start_bit % 8) + 7) / 8;
+  return lsb_byte < len;
+}
+
+bool DbcMessage::is_present(std::size_t index, const uint8_t* data, uint8_t len) const {
+  const auto& signal = signals[index];
+  if (!signal.fits(len)) {
+    return false;
+  }
+  if (!signal.mux_value || multiplexor < 0) {
+    return true;
+  }
+  const auto& mux = signals[static_cast<std::size_t>(multiplexor)];
+  return mux.fits(len) && static_cast<uint64_t>(mux.raw(data, len)) == *signal.mux_value;
+}
+
+Dbc Dbc::parse(std::string_view text) {
+  Dbc dbc;
+  std::size_t line_number = 0;
+  while (!text.empty()) {
+    const auto end = text.find('\n');
+    const auto line = trim(text.substr(0, end));
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    line_number++;
+    try {
+      if (line.starts_with("BO_ ")) {
+        dbc.messages_.push_back(parse_message(line));
+      } else if (line.starts_with("SG_ ") && !dbc.messages_.empty()) {
+        auto& message = dbc.messages_.back();
+        message.signals.push_back(parse_signal(line));
+        if (message.signals.back().is_multiplexor) {
+          message.multiplexor = static_cast<int>(message.signals.size() - 1);
+        }
+      }
+    } catch (const std::runtime_error& e) {
+      throw std::runtime_error(std::string(e.what()) + " (line " + std::to_string(line_number) +
+                               ")");
+    }
+  }
+  for (std::size_t i = 0; i < dbc.messages_.size(); i++) {
+    dbc.by_id_[key(dbc.messages_[i].id, dbc.messages_[i].extended)] = i;
+  }
+  return dbc;
+}
+
+Dbc Dbc::load(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("cannot open " + path);
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return parse(buffer.str());
+}
+
+const DbcMessage* Dbc::find(uint32_t id, bool extended) const {
+  auto it = by_id_.find(key(id, extended));
+  if (it == by_id_.end() && !extended && id > 0x7FF) {
+    it = by_id_.find(key(id, true));  // some logs lose the IDE bit
+  }
+  return it == by_id_.end() ? nullptr : &messages_[it->second];
+}
+
+const DbcMessage* Dbc::find_by_name(std::string_view name) const {
+  for (const auto& message : messages_) {
+    if (message.name == name) {
+      return &message;
+    }
+  }
+  return nullptr;
+}
@@ -0,0 +1,251 @@
+#include "debug_log.hpp"
+
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::array<std::string_view, 4> LOG_MACROS = {"LOG_ERROR(", "LOG_WARN(", "LOG_INFO(",
+                                                         "LOG_DEBUG("};
+
+int hex_digit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+/**
+ * @brief Reads the string literal starting at text[pos] == '"' into the bytes the compiler
+ * would store
+ * @return position after the closing quote, npos if it is not a complete literal
+ */
+std::size_t read_literal(std::string_view text, std::size_t pos, std::string& value) {
+  value.clear();
+  for (pos++; pos < text.size(); pos++) {
+    const char c = text[pos];
+    if (c == '"') {
+      return pos + 1;
+    }
+    if (c == '\n') {
+      return std::string_view::npos;
+    }
+    if (c != '\\' || pos + 1 >= text.size()) {
+      value += c;
+      continue;
+    }
+    const char escaped = text[++pos];
+    switch (escaped) {
+      case 'n':
+        value += '\n';
+        break;
+      case 't':
+        value += '\t';
+        break;
+      case 'r':
+        value += '\r';
+        break;
+      case '0':
+        value += '\0';
+        break;
+      case 'x': {
+        int byte = 0;
+        while (pos + 1 < text.size() && hex_digit(text[pos + 1]) >= 0) {
+          byte = byte * 16 + hex_digit(text[++pos]);
+        }
+        value += static_cast<char>(byte);
+      } break;
+      default:
+        value += escaped;  // \" \\ \'
+        break;
+    }
+  }
+  return std::string_view::npos;
+}
+
+/**
+ * @brief One printf conversion applied to a recorded argument, length modifiers replaced by the
+ * ones that match the value handed to snprintf
+ */
+void format_argument(std::string spec, char conversion, dlog::ArgType type, uint32_t bits,
+                     std::string& out) {
+  char buffer[64];
+  const auto as_float = [bits] {
+    float value = 0;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  };
+  switch (conversion) {
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A': {
+      const double value = type == dlog::ArgType::F32   ? as_float()
+                           : type == dlog::ArgType::I32 ? static_cast<int32_t>(bits)
+                                                        : bits;
+      spec += conversion;
+      std::snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+    } break;
+    case 'c':
+      spec += conversion;
+      std::snprintf(buffer, sizeof(buffer), spec.c_str(), static_cast<int>(bits));
+      break;
+    case 'd':
+    case 'i': {
+      const long long value = type == dlog::ArgType::F32   ? static_cast<long long>(as_float())
+                              : type == dlog::ArgType::I32 ? static_cast<int32_t>(bits)
+                                                           : static_cast<long long>(bits);
+      spec += "ll";
+      spec += conversion;
+      std::snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+    } break;
+    default: {  // u x X o
+      const unsigned long long value =
+          type == dlog::ArgType::F32 ? static_cast<unsigned long long>(as_float()) : bits;
+      spec += "ll";
+      spec += conversion;
+      std::snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+    } break;
+  }
+  out += buffer;
+}
+
+}  // namespace
+
+FormatTable::FormatTable() { add(dlog::DROPPED_FORMAT); }
+
+void FormatTable::add(const std::string& format) {
+  formats_[dlog::fnv1a(format.c_str())] = format;
+}
+
+std::size_t FormatTable::add_source(std::string_view text) {
+  std::size_t found = 0;
+  std::string format;
+  for (const auto macro : LOG_MACROS) {
+    for (auto pos = text.find(macro); pos != std::string_view::npos;
+         pos = text.find(macro, pos + 1)) {
+      if (pos > 0 && (std::isalnum(static_cast<unsigned char>(text[pos - 1])) != 0 ||
+                      text[pos - 1] == '_')) {
+        continue;
+      }
+      // the format is the first argument after the module; a definition has no literal
+      const auto quote = text.find_first_of("\");)", pos + macro.size());
+      if (quote != std::string_view::npos && text[quote] == '"' &&
+          read_literal(text, quote, format) != std::string_view::npos) {
+        add(format);
+        found++;
+      }
+    }
+  }
+  return found;
+}
+
+std::size_t FormatTable::add_sources(const std::filesystem::path& dir) {
+  if (!std::filesystem::is_directory(dir)) {
+    throw std::runtime_error("cannot open " + dir.string());
+  }
+  std::size_t found = 0;
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+    const auto extension = entry.path().extension();
+    if (!entry.is_regular_file() ||
+        (extension != ".cpp" && extension != ".hpp" && extension != ".h")) {
+      continue;
+    }
+    std::ifstream file(entry.path());
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    found += add_source(buffer.str());
+  }
+  return found;
+}
+
+const std::string* FormatTable::find(uint32_t id) const {
+  const auto it = formats_.find(id);
+  return it == formats_.end() ? nullptr : &it->second;
+}
+
+std::string format_record(const std::string& format, const dlog::Record& record) {
+  std::string out;
+  std::size_t arg = 0;
+  for (std::size_t i = 0; i < format.size(); i++) {
+    if (format[i] != '%') {
+      out += format[i];
+      continue;
+    }
+    if (i + 1 < format.size() && format[i + 1] == '%') {
+      out += '%';
+      i++;
+      continue;
+    }
+    std::string spec = "%";
+    std::size_t end = i + 1;
+    while (end < format.size() && std::strchr("-+ #0123456789.", format[end]) != nullptr) {
+      spec += format[end++];
+    }
+    while (end < format.size() && std::strchr("hlLzjt", format[end]) != nullptr) {
+      end++;  // the value handed to snprintf gets its own modifier
+    }
+    if (end >= format.size() || std::strchr("diuxXocfFeEgGaA", format[end]) == nullptr ||
+        arg >= record.arg_count) {
+      out += format.substr(i, end + 1 - i);  // not a conversion we can fill, kept as written
+      i = end;
+      continue;
+    }
+    format_argument(spec, format[end], record.type(arg), record.args[arg], out);
+    arg++;
+    i = end;
+  }
+  return out;
+}
+
+DebugLogSummary decode_debug_log(const FormatTable& table, const uint8_t* data, std::size_t size,
+                                 std::string& out) {
+  DebugLogSummary summary;
+  dlog::Record record{};
+  char stamp[32];
+  for (std::size_t pos = 0; pos < size;) {
+    const std::size_t length =
+        data[pos] == dlog::FRAME_MAGIC[0] ? dlog::decode_frame(data + pos, size - pos, record) : 0;
+    if (length == 0) {
+      out += static_cast<char>(data[pos++]);
+      summary.text_bytes++;
+      continue;
+    }
+    pos += length;
+    summary.records++;
+    if (!out.empty() && out.back() != '\n') {
+      out += '\n';
+    }
+    std::snprintf(stamp, sizeof(stamp), "[%11.6f] ",
+                  static_cast<double>(record.timestamp_us) * 1e-6);
+    out += stamp;
+    if (const std::string* format = table.find(record.id)) {
+      out += format_record(*format, record);
+    } else {
+      summary.unknown_records++;
+      std::snprintf(stamp, sizeof(stamp), "<unknown format 0x%08X>", record.id);
+      out += stamp;
+      for (std::size_t i = 0; i < record.arg_count; i++) {
+        std::snprintf(stamp, sizeof(stamp), " 0x%08X", record.args[i]);
+        out += stamp;
+      }
+    }
+    out += '\n';
+  }
+  return summary;
+}
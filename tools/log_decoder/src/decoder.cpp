@@ -0,0 +1,161 @@
+#include "decoder.hpp"
+
+#include <atomic>
+#include <thread>
+
+#include "csv_writer.hpp"
+#include "parallel.hpp"
+
+namespace {
+
+double seconds_since(uint64_t timestamp_us, uint64_t t0_us) {
+  return static_cast<double>(static_cast<int64_t>(timestamp_us - t0_us)) * 1e-6;
+}
+
+}  // namespace
+
+DecodeSummary export_messages(const Dbc& dbc, const std::vector<CanFrame>& frames, uint64_t t0_us,
+                              const std::string& out_dir, unsigned threads) {
+  const auto& messages = dbc.messages();
+  constexpr int32_t UNKNOWN = -1;
+
+  // 1. Resolve every frame to its message, in parallel slices
+  std::vector<int32_t> owner(frames.size(), UNKNOWN);
+  parallel_ranges(frames.size(), threads, [&](std::size_t begin, std::size_t end, unsigned) {
+    for (std::size_t i = begin; i < end; i++) {
+      const DbcMessage* message = dbc.find(frames[i].id, frames[i].extended);
+      if (message != nullptr) {
+        owner[i] = static_cast<int32_t>(message - messages.data());
+      }
+    }
+  });
+
+  // 2. Counting sort of frame indices by message, keeping time order inside each bucket
+  std::vector<std::size_t> bucket_start(messages.size() + 1, 0);
+  DecodeSummary summary;
+  for (const int32_t m : owner) {
+    if (m == UNKNOWN) {
+      summary.unknown_frames++;
+    } else {
+      bucket_start[static_cast<std::size_t>(m) + 1]++;
+    }
+  }
+  for (std::size_t m = 0; m < messages.size(); m++) {
+    bucket_start[m + 1] += bucket_start[m];
+  }
+  std::vector<std::size_t> order(bucket_start.back());
+  std::vector<std::size_t> fill(bucket_start.begin(), bucket_start.end() - 1);
+  for (std::size_t i = 0; i < owner.size(); i++) {
+    if (owner[i] != UNKNOWN) {
+      order[fill[static_cast<std::size_t>(owner[i])]++] = i;
+    }
+  }
+
+  // 3. Decode and write each message on whichever worker is free
+  summary.messages.resize(messages.size());
+  std::atomic<std::size_t> next{0};
+  auto worker = [&] {
+    for (std::size_t m = next++; m < messages.size(); m = next++) {
+      const DbcMessage& message = messages[m];
+      MessageSummary& result = summary.messages[m];
+      result.message = &message;
+      result.frames = bucket_start[m + 1] - bucket_start[m];
+      result.signals.resize(message.signals.size());
+      if (result.frames == 0) {
+        continue;
+      }
+      CsvWriter csv(out_dir + "/" + message.name + ".csv");
+      csv.field("time_s");
+      for (const auto& signal : message.signals) {
+        csv.field(signal.name);
+      }
+      csv.end_row();
+      for (std::size_t k = bucket_start[m]; k < bucket_start[m + 1]; k++) {
+        const CanFrame& frame = frames[order[k]];
+        const double time_s = seconds_since(frame.timestamp_us, t0_us);
+        csv.field(time_s);
+        for (std::size_t s = 0; s < message.signals.size(); s++) {
+          if (!message.is_present(s, frame.data.data(), frame.len)) {
+            csv.empty();
+            continue;
+          }
+          const double value = message.signals[s].decode(frame.data.data(), frame.len);
+          result.signals[s].add(time_s, value);
+          csv.field(value);
+        }
+        csv.end_row();
+      }
+    }
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < std::max(1U, threads); t++) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  return summary;
+}
+
+void export_table(const LogTableData& table, const std::string& name, uint64_t t0_us,
+                  const std::string& out_dir) {
+  if (table.columns.empty() || table.columns.front().empty()) {
+    return;
+  }
+  int time_column = -1;
+  for (std::size_t c = 0; c < table.names.size(); c++) {
+    if (table.names[c] == "timestamp_us") {
+      time_column = static_cast<int>(c);
+    }
+  }
+  CsvWriter csv(out_dir + "/" + name + ".csv");
+  if (time_column >= 0) {
+    csv.field("time_s");
+  }
+  for (const auto& column_name : table.names) {
+    csv.field(column_name);
+  }
+  csv.end_row();
+  const std::size_t rows = table.columns.front().size();
+  for (std::size_t r = 0; r < rows; r++) {
+    if (time_column >= 0) {
+      csv.field(seconds_since(static_cast<uint64_t>(table.columns[time_column][r]), t0_us));
+    }
+    for (const auto& column : table.columns) {
+      csv.field(column[r]);
+    }
+    csv.end_row();
+  }
+}
+
+void write_stats(const DecodeSummary& summary, const std::string& path) {
+  CsvWriter csv(path);
+  for (const char* header :
+       {"message", "signal", "unit", "count", "min", "max", "mean", "stddev", "first_s", "last_s"}) {
+    csv.field(header);
+  }
+  csv.end_row();
+  for (const auto& message : summary.messages) {
+    if (message.frames == 0) {
+      continue;
+    }
+    for (std::size_t s = 0; s < message.signals.size(); s++) {
+      const SignalStats& stats = message.signals[s];
+      if (stats.count == 0) {
+        continue;
+      }
+      csv.field(message.message->name)
+          .field(message.message->signals[s].name)
+          .field(message.message->signals[s].unit)
+          .field(stats.count)
+          .field(stats.min)
+          .field(stats.max)
+          .field(stats.mean)
+          .field(stats.stddev())
+          .field(stats.first_s)
+          .field(stats.last_s);
+      csv.end_row();
+    }
+  }
+}
@@ -0,0 +1,394 @@
+#include "log_source.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+#include "../../../sdLogFormat.hpp"
+#include "parallel.hpp"
+
+MappedFile::MappedFile(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("cannot open " + path);
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("cannot stat " + path);
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ > 0) {
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("cannot map " + path);
+    }
+    ::madvise(mapping, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const uint8_t*>(mapping);
+  }
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+  }
+}
+
+namespace {
+
+struct TableLayout {
+  uint8_t id = 0;
+  std::vector<std::string> names;
+  std::vector<sdlog::ColumnType> types;
+  std::size_t row_size = 0;
+
+  [[nodiscard]] int index_of(const std::string& name) const {
+    const auto it = std::find(names.begin(), names.end(), name);
+    return it == names.end() ? -1 : static_cast<int>(it - names.begin());
+  }
+};
+
+template <typename T>
+T load(const uint8_t* p) {
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+double read_value(const uint8_t* p, sdlog::ColumnType type) {
+  switch (type) {
+    case sdlog::ColumnType::U8:
+      return load<uint8_t>(p);
+    case sdlog::ColumnType::I8:
+      return load<int8_t>(p);
+    case sdlog::ColumnType::U16:
+      return load<uint16_t>(p);
+    case sdlog::ColumnType::I16:
+      return load<int16_t>(p);
+    case sdlog::ColumnType::U32:
+      return load<uint32_t>(p);
+    case sdlog::ColumnType::I32:
+      return load<int32_t>(p);
+    case sdlog::ColumnType::F32:
+      return load<float>(p);
+    case sdlog::ColumnType::U64:
+      return static_cast<double>(load<uint64_t>(p));
+    case sdlog::ColumnType::F64:
+      return load<double>(p);
+  }
+  return 0;
+}
+
+/**
+ * @brief Widens wrapping 32-bit microsecond timestamps into a monotonic 64-bit timeline
+ */
+class TimestampUnwrapper {
+public:
+  uint64_t operator()(uint32_t raw) {
+    if (started_ && raw < last_ && last_ - raw > 0x80000000U) {
+      epoch_ += 1ULL << 32;
+    }
+    started_ = true;
+    last_ = raw;
+    return epoch_ + raw;
+  }
+
+private:
+  bool started_ = false;
+  uint32_t last_ = 0;
+  uint64_t epoch_ = 0;
+};
+
+struct SdPartial {
+  std::vector<CanFrame> frames;
+  std::vector<std::vector<std::vector<double>>> tables;  // [table][column][row]
+  uint64_t dropped_rows = 0;
+  uint64_t corrupt_blocks = 0;
+};
+
+std::vector<TableLayout> read_schema(const uint8_t* data, std::size_t size, std::size_t& blocks) {
+  if (size < sdlog::BLOCK_SIZE) {
+    throw std::runtime_error("sd log: file shorter than one block");
+  }
+  const auto header = load<sdlog::BlockHeader>(data);
+  const auto info = load<sdlog::FileInfo>(data + sizeof(sdlog::BlockHeader));
+  if (header.magic != sdlog::BLOCK_MAGIC ||
+      header.kind != static_cast<uint8_t>(sdlog::BlockKind::SCHEMA) ||
+      info.magic != sdlog::FILE_MAGIC) {
+    throw std::runtime_error("sd log: missing schema block");
+  }
+  if (info.version != sdlog::FORMAT_VERSION) {
+    throw std::runtime_error("sd log: unsupported format version " + std::to_string(info.version));
+  }
+  blocks = info.schema_blocks;
+  if (blocks * sdlog::BLOCK_SIZE > size) {
+    throw std::runtime_error("sd log: truncated schema");
+  }
+
+  std::vector<TableLayout> layouts;
+  for (std::size_t b = 0; b < blocks; b++) {
+    const uint8_t* block = data + b * sdlog::BLOCK_SIZE;
+    const auto schema_header = load<sdlog::BlockHeader>(block);
+    std::size_t offset = sizeof(sdlog::BlockHeader) + (b == 0 ? sizeof(sdlog::FileInfo) : 0);
+    for (uint16_t i = 0; i < schema_header.rows; i++, offset += sizeof(sdlog::ColumnDescriptor)) {
+      const auto descriptor = load<sdlog::ColumnDescriptor>(block + offset);
+      auto it = std::find_if(layouts.begin(), layouts.end(),
+                             [&](const TableLayout& l) { return l.id == descriptor.table; });
+      if (it == layouts.end()) {
+        layouts.push_back(TableLayout{descriptor.table, {}, {}, 0});
+        it = layouts.end() - 1;
+      }
+      const auto type = static_cast<sdlog::ColumnType>(descriptor.type);
+      it->names.emplace_back(descriptor.name,
+                             strnlen(descriptor.name, sdlog::COLUMN_NAME_LENGTH));
+      it->types.push_back(type);
+      it->row_size += sdlog::column_type_size(type);
+    }
+  }
+  return layouts;
+}
+
+void decode_data_block(const uint8_t* block, const std::vector<TableLayout>& layouts,
+                       SdPartial& out) {
+  const auto header = load<sdlog::BlockHeader>(block);
+  if (header.magic != sdlog::BLOCK_MAGIC) {
+    out.corrupt_blocks++;
+    return;
+  }
+  if (header.kind != static_cast<uint8_t>(sdlog::BlockKind::DATA)) {
+    return;
+  }
+  const auto it = std::find_if(layouts.begin(), layouts.end(),
+                               [&](const TableLayout& l) { return l.id == header.table; });
+  if (it == layouts.end() || header.rows > header.capacity ||
+      sizeof(sdlog::BlockHeader) + header.capacity * it->row_size > sdlog::BLOCK_SIZE) {
+    out.corrupt_blocks++;
+    return;
+  }
+  const TableLayout& layout = *it;
+  out.dropped_rows += header.dropped;
+
+  std::vector<const uint8_t*> column_start(layout.types.size());
+  std::size_t offset = sizeof(sdlog::BlockHeader);
+  for (std::size_t c = 0; c < layout.types.size(); c++) {
+    column_start[c] = block + offset;
+    offset += header.capacity * sdlog::column_type_size(layout.types[c]);
+  }
+
+  if (layout.id == static_cast<uint8_t>(sdlog::TableId::CAN_RX)) {
+    const int ts = layout.index_of("timestamp_us");
+    const int id = layout.index_of("id");
+    const int len = layout.index_of("len");
+    const int flags = layout.index_of("flags");
+    const int payload = layout.index_of("data");
+    if (ts < 0 || id < 0 || len < 0 || flags < 0 || payload < 0) {
+      out.corrupt_blocks++;
+      return;
+    }
+    for (uint16_t r = 0; r < header.rows; r++) {
+      CanFrame frame;
+      frame.timestamp_us = load<uint32_t>(column_start[ts] + r * 4);
+      frame.id = load<uint32_t>(column_start[id] + r * 4);
+      frame.len = std::min<uint8_t>(load<uint8_t>(column_start[len] + r), 8);
+      frame.extended = (load<uint8_t>(column_start[flags] + r) & 0x01) != 0;
+      const auto bytes = load<uint64_t>(column_start[payload] + r * 8);
+      for (int i = 0; i < 8; i++) {
+        frame.data[i] = static_cast<uint8_t>(bytes >> (8 * i));
+      }
+      out.frames.push_back(frame);
+    }
+    return;
+  }
+
+  const auto table_index = static_cast<std::size_t>(it - layouts.begin());
+  auto& columns = out.tables[table_index];
+  for (std::size_t c = 0; c < layout.types.size(); c++) {
+    const std::size_t size = sdlog::column_type_size(layout.types[c]);
+    for (uint16_t r = 0; r < header.rows; r++) {
+      columns[c].push_back(read_value(column_start[c] + r * size, layout.types[c]));
+    }
+  }
+}
+
+uint8_t hex_digit(char c) {
+  if (c >= '0' && c <= '9') return static_cast<uint8_t>(c - '0');
+  if (c >= 'a' && c <= 'f') return static_cast<uint8_t>(c - 'a' + 10);
+  if (c >= 'A' && c <= 'F') return static_cast<uint8_t>(c - 'A' + 10);
+  return 0xFF;
+}
+
+/**
+ * @brief Parses "(1700000000.123456) can0 123#DEADBEEF"; returns false for anything else
+ */
+bool parse_candump_line(const char* begin, const char* end, CanFrame& frame) {
+  const char* p = begin;
+  if (p == end || *p != '(') return false;
+  p++;
+  uint64_t seconds = 0;
+  auto result = std::from_chars(p, end, seconds);
+  if (result.ec != std::errc() || result.ptr == end || *result.ptr != '.') return false;
+  p = result.ptr + 1;
+  uint64_t fraction = 0;
+  int digits = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    if (digits < 6) {
+      fraction = fraction * 10 + static_cast<uint64_t>(*p - '0');
+      digits++;
+    }
+    p++;
+  }
+  for (; digits < 6; digits++) fraction *= 10;
+  frame.timestamp_us = seconds * 1000000ULL + fraction;
+
+  p = static_cast<const char*>(std::memchr(p, ' ', static_cast<std::size_t>(end - p)));
+  if (p == nullptr) return false;
+  while (p < end && *p == ' ') p++;
+  p = static_cast<const char*>(std::memchr(p, ' ', static_cast<std::size_t>(end - p)));  // iface
+  if (p == nullptr) return false;
+  while (p < end && *p == ' ') p++;
+
+  const char* hash = static_cast<const char*>(std::memchr(p, '#', static_cast<std::size_t>(end - p)));
+  if (hash == nullptr) return false;
+  frame.extended = (hash - p) > 3;
+  result = std::from_chars(p, hash, frame.id, 16);
+  if (result.ec != std::errc()) return false;
+  p = hash + 1;
+  if (p < end && *p == 'R') {
+    frame.len = 0;
+    return true;
+  }
+  frame.len = 0;
+  while (p + 1 < end && frame.len < 8) {
+    const uint8_t hi = hex_digit(p[0]);
+    const uint8_t lo = hex_digit(p[1]);
+    if (hi == 0xFF || lo == 0xFF) break;
+    frame.data[frame.len++] = static_cast<uint8_t>(hi << 4 | lo);
+    p += 2;
+  }
+  return true;
+}
+
+}  // namespace
+
+LogContents read_sd_log(const MappedFile& file, unsigned threads) {
+  std::size_t schema_blocks = 0;
+  const auto layouts = read_schema(file.data(), file.size(), schema_blocks);
+  const std::size_t total_blocks = file.size() / sdlog::BLOCK_SIZE;
+
+  // The data ends at the first block that does not continue the sequence; past it is the
+  // preallocated tail, unused or still holding blocks of older logs
+  const uint32_t first_sequence = load<sdlog::BlockHeader>(file.data()).sequence;
+  std::size_t data_blocks = 0;
+  while (schema_blocks + data_blocks < total_blocks) {
+    const auto header =
+        load<sdlog::BlockHeader>(file.data() + (schema_blocks + data_blocks) * sdlog::BLOCK_SIZE);
+    if (header.magic != sdlog::BLOCK_MAGIC ||
+        header.sequence != first_sequence + static_cast<uint32_t>(schema_blocks + data_blocks)) {
+      break;
+    }
+    data_blocks++;
+  }
+
+  std::vector<SdPartial> partials(std::max(1U, threads));
+  const unsigned workers =
+      parallel_ranges(data_blocks, threads, [&](std::size_t begin, std::size_t end, unsigned w) {
+        SdPartial& partial = partials[w];
+        partial.tables.resize(layouts.size());
+        for (std::size_t t = 0; t < layouts.size(); t++) {
+          partial.tables[t].resize(layouts[t].names.size());
+        }
+        for (std::size_t b = begin; b < end; b++) {
+          decode_data_block(file.data() + (schema_blocks + b) * sdlog::BLOCK_SIZE, layouts,
+                            partial);
+        }
+      });
+  partials.resize(workers);
+
+  LogContents contents;
+  contents.trailing_blocks = total_blocks - schema_blocks - data_blocks;
+  for (const auto& layout : layouts) {
+    if (layout.id != static_cast<uint8_t>(sdlog::TableId::CAN_RX)) {
+      contents.tables.push_back(LogTableData{layout.id, layout.names,
+                                             std::vector<std::vector<double>>(layout.names.size())});
+    }
+  }
+  for (auto& partial : partials) {
+    contents.frames.insert(contents.frames.end(), partial.frames.begin(), partial.frames.end());
+    std::size_t table = 0;
+    for (std::size_t t = 0; t < layouts.size(); t++) {
+      if (layouts[t].id == static_cast<uint8_t>(sdlog::TableId::CAN_RX)) {
+        continue;
+      }
+      for (std::size_t c = 0; c < layouts[t].names.size(); c++) {
+        auto& dst = contents.tables[table].columns[c];
+        dst.insert(dst.end(), partial.tables[t][c].begin(), partial.tables[t][c].end());
+      }
+      table++;
+    }
+    contents.dropped_rows += partial.dropped_rows;
+    contents.corrupt_blocks += partial.corrupt_blocks;
+  }
+
+  TimestampUnwrapper unwrap_frames;
+  for (auto& frame : contents.frames) {
+    frame.timestamp_us = unwrap_frames(static_cast<uint32_t>(frame.timestamp_us));
+  }
+  for (auto& table : contents.tables) {
+    const auto it = std::find(table.names.begin(), table.names.end(), "timestamp_us");
+    if (it != table.names.end()) {
+      TimestampUnwrapper unwrap;
+      for (auto& value : table.columns[static_cast<std::size_t>(it - table.names.begin())]) {
+        value = static_cast<double>(unwrap(static_cast<uint32_t>(value)));
+      }
+    }
+  }
+  return contents;
+}
+
+LogContents read_candump(const MappedFile& file, unsigned threads) {
+  const char* text = reinterpret_cast<const char*>(file.data());
+  const std::size_t size = file.size();
+  std::vector<std::vector<CanFrame>> partials(std::max(1U, threads));
+  const unsigned workers =
+      parallel_ranges(size, threads, [&](std::size_t begin, std::size_t end, unsigned w) {
+        // Each worker owns the lines that start inside its byte range
+        if (begin > 0) {
+          const void* nl = std::memchr(text + begin - 1, '\n', size - begin + 1);
+          begin = nl == nullptr ? size : static_cast<std::size_t>(static_cast<const char*>(nl) - text) + 1;
+        }
+        auto& frames = partials[w];
+        std::size_t pos = begin;
+        while (pos < end && pos < size) {
+          const void* nl = std::memchr(text + pos, '\n', size - pos);
+          const std::size_t line_end =
+              nl == nullptr ? size : static_cast<std::size_t>(static_cast<const char*>(nl) - text);
+          CanFrame frame;
+          if (parse_candump_line(text + pos, text + line_end, frame)) {
+            frames.push_back(frame);
+          }
+          pos = line_end + 1;
+        }
+      });
+  partials.resize(workers);
+
+  LogContents contents;
+  for (auto& frames : partials) {
+    contents.frames.insert(contents.frames.end(), frames.begin(), frames.end());
+  }
+  return contents;
+}
+
+LogContents read_log(const MappedFile& file, unsigned threads) {
+  if (file.size() >= sizeof(uint16_t) && load<uint16_t>(file.data()) == sdlog::BLOCK_MAGIC) {
+    return read_sd_log(file, threads);
+  }
+  return read_candump(file, threads);
+}
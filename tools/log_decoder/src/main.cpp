@@ -0,0 +1,164 @@
+#ifndef PIO_UNIT_TESTING
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dbc.hpp"
+#include "debug_log.hpp"
+#include "decoder.hpp"
+#include "log_source.hpp"
+#include "parallel.hpp"
+#include "reports.hpp"
+
+namespace {
+
+void usage(const char* program) {
+  std::fprintf(stderr,
+               "Usage: %s <log> [--dbc candb.dbc] [--out dir] [--threads N]\n"
+               "       %s <capture> --debug-log [--sources dir]... [--out dir]\n"
+               "  <log>      master SD card log (LOGxxxxx.BIN) or candump -l text log\n"
+               "  <capture>  serial capture of a board built with DEBUG_LOG enabled\n",
+               program, program);
+}
+
+int decode_debug_capture(const std::string& capture_path, std::vector<std::string> sources,
+                         const std::string& out_dir) {
+  if (sources.empty()) {
+    sources = {"../../master", "../../teensy_dash", "../../teensy_cells", "../../teensy_handcart"};
+  }
+  FormatTable table;
+  for (const auto& dir : sources) {
+    table.add_sources(dir);
+  }
+  const MappedFile file(capture_path);
+  std::string text;
+  const DebugLogSummary summary = decode_debug_log(table, file.data(), file.size(), text);
+  std::filesystem::create_directories(out_dir);
+  const std::string out_path = out_dir + "/debug_log.txt";
+  std::FILE* out = std::fopen(out_path.c_str(), "wb");
+  if (out == nullptr) {
+    throw std::runtime_error("cannot write " + out_path);
+  }
+  std::fwrite(text.data(), 1, text.size(), out);
+  std::fclose(out);
+  std::printf("%s: %llu records (%llu with unknown format), %llu text bytes, %zu formats, "
+              "output in %s\n",
+              capture_path.c_str(), static_cast<unsigned long long>(summary.records),
+              static_cast<unsigned long long>(summary.unknown_records),
+              static_cast<unsigned long long>(summary.text_bytes), table.size(),
+              out_path.c_str());
+  return 0;
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point since) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string log_path;
+  std::string dbc_path = "../../candb.dbc";
+  std::string out_dir = "decoded";
+  unsigned threads = default_thread_count();
+  bool debug_log = false;
+  std::vector<std::string> sources;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--dbc" && i + 1 < argc) {
+      dbc_path = argv[++i];
+    } else if (arg == "--out" && i + 1 < argc) {
+      out_dir = argv[++i];
+    } else if (arg == "--threads" && i + 1 < argc) {
+      threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+    } else if (arg == "--debug-log") {
+      debug_log = true;
+    } else if (arg == "--sources" && i + 1 < argc) {
+      sources.emplace_back(argv[++i]);
+    } else if (arg == "-h" || arg == "--help") {
+      usage(argv[0]);
+      return 0;
+    } else if (log_path.empty()) {
+      log_path = arg;
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (log_path.empty()) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  try {
+    if (debug_log) {
+      return decode_debug_capture(log_path, sources, out_dir);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const Dbc dbc = Dbc::load(dbc_path);
+    const MappedFile file(log_path);
+    const LogContents log = read_log(file, threads);
+    const double read_ms = elapsed_ms(start);
+    std::filesystem::create_directories(out_dir);
+
+    uint64_t t0_us = log.frames.empty() ? 0 : log.frames.front().timestamp_us;
+    for (const auto& table : log.tables) {
+      for (std::size_t c = 0; c < table.names.size(); c++) {
+        if (table.names[c] == "timestamp_us" && !table.columns[c].empty()) {
+          const auto first = static_cast<uint64_t>(table.columns[c].front());
+          t0_us = log.frames.empty() ? first : std::min(t0_us, first);
+        }
+      }
+    }
+
+    const DecodeSummary summary = export_messages(dbc, log.frames, t0_us, out_dir, threads);
+    write_stats(summary, out_dir + "/stats.csv");
+    const LogTableData* samples = nullptr;
+    for (const auto& table : log.tables) {
+      const std::string name = table.id == 0 ? "samples" : "table_" + std::to_string(table.id);
+      export_table(table, name, t0_us, out_dir);
+      if (table.id == 0) {
+        samples = &table;
+      }
+    }
+
+    auto timeline = state_timeline_from_frames(log.frames, t0_us);
+    if (timeline.empty() && samples != nullptr) {
+      timeline = state_timeline_from_samples(*samples, t0_us);
+    }
+    write_state_timeline(timeline, out_dir + "/state_timeline.csv");
+    const TemperatureGrid grid = build_temperature_grid(log.frames);
+    write_temperature_heatmap(grid, out_dir + "/temperature_heatmap.csv");
+    write_bamocar_error_timeline(bamocar_error_timeline(log.frames, t0_us),
+                                 out_dir + "/bamocar_errors.csv");
+
+    std::printf("%s: %.1f MB, %zu frames (%llu not in dbc), %zu sample rows\n", log_path.c_str(),
+                static_cast<double>(file.size()) / 1e6, log.frames.size(),
+                static_cast<unsigned long long>(summary.unknown_frames),
+                samples == nullptr || samples->columns.empty() ? std::size_t{0}
+                                                               : samples->columns.front().size());
+    if (log.trailing_blocks != 0) {
+      std::printf("Ignored %llu blocks after the end of the data\n",
+                  static_cast<unsigned long long>(log.trailing_blocks));
+    }
+    if (log.dropped_rows != 0 || log.corrupt_blocks != 0) {
+      std::printf("WARNING: %llu rows dropped on the car, %llu blocks corrupt\n",
+                  static_cast<unsigned long long>(log.dropped_rows),
+                  static_cast<unsigned long long>(log.corrupt_blocks));
+    }
+    std::printf("State transitions: %zu\n", timeline.empty() ? 0 : timeline.size() - 1);
+    print_temperature_heatmap(grid, stdout);
+    std::printf("Read %.0f ms, total %.0f ms on %u threads, output in %s/\n", read_ms,
+                elapsed_ms(start), threads, out_dir.c_str());
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "error: %s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
+#endif
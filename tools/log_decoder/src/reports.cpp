@@ -0,0 +1,239 @@
+#include "reports.hpp"
+
+#include <algorithm>
+
+#include "csv_writer.hpp"
+
+namespace {
+
+constexpr std::array<const char*, 6> STATE_NAMES = {
+    "AS_MANUAL", "AS_OFF", "AS_READY", "AS_DRIVING", "AS_FINISHED", "AS_EMERGENCY"};
+
+const char* state_name(int state) {
+  return state >= 0 && state < static_cast<int>(STATE_NAMES.size()) ? STATE_NAMES[state]
+                                                                     : "UNKNOWN";
+}
+
+double seconds_since(uint64_t timestamp_us, uint64_t t0_us) {
+  return static_cast<double>(static_cast<int64_t>(timestamp_us - t0_us)) * 1e-6;
+}
+
+/**
+ * @brief Collapses a (time, state) sequence into intervals
+ */
+class TimelineBuilder {
+public:
+  void add(double time_s, int state) {
+    if (timeline_.empty() || timeline_.back().state != state) {
+      if (!timeline_.empty()) {
+        timeline_.back().end_s = time_s;
+      }
+      timeline_.push_back(StateInterval{state, time_s, time_s});
+    } else {
+      timeline_.back().end_s = time_s;
+    }
+  }
+
+  std::vector<StateInterval> take() { return std::move(timeline_); }
+
+private:
+  std::vector<StateInterval> timeline_;
+};
+
+}  // namespace
+
+std::vector<StateInterval> state_timeline_from_frames(const std::vector<CanFrame>& frames,
+                                                      uint64_t t0_us) {
+  TimelineBuilder builder;
+  for (const auto& frame : frames) {
+    if (frame.id == MASTER_ID && !frame.extended && frame.len >= 2 && frame.data[0] == STATE_MSG) {
+      builder.add(seconds_since(frame.timestamp_us, t0_us), frame.data[1]);
+    }
+  }
+  return builder.take();
+}
+
+std::vector<StateInterval> state_timeline_from_samples(const LogTableData& samples,
+                                                       uint64_t t0_us) {
+  const auto find = [&samples](const char* name) {
+    const auto it = std::find(samples.names.begin(), samples.names.end(), name);
+    return it == samples.names.end() ? -1 : static_cast<int>(it - samples.names.begin());
+  };
+  const int time_column = find("timestamp_us");
+  const int state_column = find("state");
+  TimelineBuilder builder;
+  if (time_column < 0 || state_column < 0) {
+    return builder.take();
+  }
+  const auto& times = samples.columns[time_column];
+  const auto& states = samples.columns[state_column];
+  for (std::size_t r = 0; r < times.size(); r++) {
+    builder.add(seconds_since(static_cast<uint64_t>(times[r]), t0_us), static_cast<int>(states[r]));
+  }
+  return builder.take();
+}
+
+void write_state_timeline(const std::vector<StateInterval>& timeline, const std::string& path) {
+  CsvWriter csv(path);
+  csv.field("start_s").field("end_s").field("duration_s").field("state").field("name");
+  csv.end_row();
+  for (const auto& interval : timeline) {
+    csv.field(interval.start_s)
+        .field(interval.end_s)
+        .field(interval.end_s - interval.start_s)
+        .field(static_cast<uint64_t>(interval.state))
+        .field(state_name(interval.state));
+    csv.end_row();
+  }
+}
+
+TemperatureGrid build_temperature_grid(const std::vector<CanFrame>& frames) {
+  // Same chunking as teensy_cells send_can_all_temps: board_id, msg_index, then up to 6 temps
+  constexpr uint8_t TEMPS_PER_MESSAGE = 6;
+  TemperatureGrid grid{};
+  for (const auto& frame : frames) {
+    if (frame.extended || frame.id < ALL_TEMPS_ID || frame.id >= ALL_TEMPS_ID + NUM_BOARDS ||
+        frame.len < 2) {
+      continue;
+    }
+    const uint8_t board = static_cast<uint8_t>(frame.id - ALL_TEMPS_ID);
+    if (frame.data[0] != board) {
+      continue;
+    }
+    const unsigned first = frame.data[1] * TEMPS_PER_MESSAGE;
+    for (unsigned i = 0; i + 2 < frame.len; i++) {
+      const unsigned sensor = first + i;
+      if (sensor >= NTC_SENSOR_COUNT) {
+        break;
+      }
+      const int temperature = static_cast<int8_t>(frame.data[2 + i]);
+      CellTemperature& cell = grid[board][sensor];
+      cell.count++;
+      cell.last = temperature;
+      cell.min = std::min(cell.min, temperature);
+      cell.max = std::max(cell.max, temperature);
+      cell.sum += temperature;
+    }
+  }
+  return grid;
+}
+
+void write_temperature_heatmap(const TemperatureGrid& grid, const std::string& path) {
+  CsvWriter csv(path);
+  csv.field("metric").field("board");
+  for (unsigned sensor = 0; sensor < NTC_SENSOR_COUNT; sensor++) {
+    csv.field("t" + std::to_string(sensor));
+  }
+  csv.end_row();
+  const std::array<const char*, 3> metrics = {"max", "mean", "last"};
+  for (std::size_t metric = 0; metric < metrics.size(); metric++) {
+    for (unsigned board = 0; board < NUM_BOARDS; board++) {
+      csv.field(metrics[metric]).field(static_cast<uint64_t>(board));
+      for (const auto& cell : grid[board]) {
+        if (cell.count == 0) {
+          csv.empty();
+          continue;
+        }
+        switch (metric) {
+          case 0:
+            csv.field(static_cast<double>(cell.max));
+            break;
+          case 1:
+            csv.field(cell.mean());
+            break;
+          default:
+            csv.field(static_cast<double>(cell.last));
+            break;
+        }
+      }
+      csv.end_row();
+    }
+  }
+}
+
+void print_temperature_heatmap(const TemperatureGrid& grid, std::FILE* out) {
+  constexpr const char* SHADES = " .:-=+*#%@";
+  int lowest = std::numeric_limits<int>::max();
+  int highest = std::numeric_limits<int>::min();
+  for (const auto& board : grid) {
+    for (const auto& cell : board) {
+      if (cell.count > 0) {
+        lowest = std::min(lowest, cell.max);
+        highest = std::max(highest, cell.max);
+      }
+    }
+  }
+  if (lowest > highest) {
+    std::fprintf(out, "No ALL_TEMPS frames in log\n");
+    return;
+  }
+  std::fprintf(out, "Max cell temperature per thermistor (%d..%d C)\n", lowest, highest);
+  for (unsigned board = 0; board < NUM_BOARDS; board++) {
+    std::fprintf(out, "board %u |", board);
+    for (const auto& cell : grid[board]) {
+      if (cell.count == 0) {
+        std::fprintf(out, "  ?");
+        continue;
+      }
+      const int span = std::max(1, highest - lowest);
+      const int shade = (cell.max - lowest) * 9 / span;
+      std::fprintf(out, " %c%c", SHADES[shade], SHADES[shade]);
+    }
+    int board_max = std::numeric_limits<int>::min();
+    for (const auto& cell : grid[board]) {
+      if (cell.count > 0) board_max = std::max(board_max, cell.max);
+    }
+    if (board_max == std::numeric_limits<int>::min()) {
+      std::fprintf(out, " |\n");
+    } else {
+      std::fprintf(out, " | max %d C\n", board_max);
+    }
+  }
+}
+
+std::vector<BitInterval> bamocar_error_timeline(const std::vector<CanFrame>& frames,
+                                                uint64_t t0_us) {
+  // Response layout as parsed by the dash: errors in bytes 1-2, warnings in bytes 3-4
+  std::vector<BitInterval> timeline;
+  std::array<int, 32> open{};  // index into timeline + 1, 0 when the bit is clear
+  for (const auto& frame : frames) {
+    if (frame.id != BAMO_RESPONSE_ID || frame.extended || frame.len < 3 ||
+        frame.data[0] != LOGICMAP_ERRORS) {
+      continue;
+    }
+    uint32_t bitmap = frame.data[1] | frame.data[2] << 8;
+    if (frame.len >= 5) {
+      bitmap |= static_cast<uint32_t>(frame.data[3]) << 16 | static_cast<uint32_t>(frame.data[4])
+                                                                 << 24;
+    }
+    const double time_s = seconds_since(frame.timestamp_us, t0_us);
+    for (int bit = 0; bit < 32; bit++) {
+      const bool set = (bitmap >> bit) & 1U;
+      if (set && open[bit] == 0) {
+        timeline.push_back(BitInterval{bit >= 16, bit % 16, time_s, time_s});
+        open[bit] = static_cast<int>(timeline.size());
+      } else if (set) {
+        timeline[open[bit] - 1].end_s = time_s;
+      } else if (open[bit] != 0) {
+        timeline[open[bit] - 1].end_s = time_s;
+        open[bit] = 0;
+      }
+    }
+  }
+  return timeline;
+}
+
+void write_bamocar_error_timeline(const std::vector<BitInterval>& timeline,
+                                  const std::string& path) {
+  CsvWriter csv(path);
+  csv.field("kind").field("bit").field("start_s").field("end_s").field("duration_s");
+  csv.end_row();
+  for (const auto& interval : timeline) {
+    csv.field(interval.warning ? "warning" : "error")
+        .field(static_cast<uint64_t>(interval.bit))
+        .field(interval.start_s)
+        .field(interval.end_s)
+        .field(interval.end_s - interval.start_s);
+    csv.end_row();
+  }
+}
@@ -0,0 +1,302 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../../../../sdLogFormat.hpp"
+#include "dbc.hpp"
+#include "debug_log.hpp"
+#include "log_source.hpp"
+#include "reports.hpp"
+#include "unity.h"
+
+namespace {
+
+const char* TEST_DBC = R"(
+BO_ 768 master_msgs: 8 Master
+ SG_ multiplexor M : 0|8@1+ (1,0) [0|255] ""  Dash,ASCU
+ SG_ rr_rpm m17 : 8|32@1+ (1,0) [0|4294967295] "rpm"  Dash,ASCU
+ SG_ master_state m49 : 8|8@1+ (1,0) [0|5] ""  Dash,ASCU
+
+BO_ 2147494237 STEERING_CUBEM_STATE: 8 SteeringController
+ SG_ cubem_steering_angle : 7|16@0- (0.1,0) [-32768|32767] "degrees"  ASCU
+ SG_ cubem_motor_temperature : 48|8@1- (1,0) [-128|127] "C"  ASCU
+)";
+
+std::string write_temp_file(const std::string& name, const void* data, std::size_t size) {
+  const std::string path = "/tmp/" + name;
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  std::fwrite(data, 1, size, file);
+  std::fclose(file);
+  return path;
+}
+
+}  // namespace
+
+void test_dbc_parses_messages_and_multiplexing() {
+  const Dbc dbc = Dbc::parse(TEST_DBC);
+  TEST_ASSERT_EQUAL(2, dbc.messages().size());
+  const DbcMessage* master = dbc.find(0x300, false);
+  TEST_ASSERT_NOT_NULL(master);
+  TEST_ASSERT_EQUAL(0, master->multiplexor);
+  TEST_ASSERT_EQUAL_UINT32(49, *master->signals[2].mux_value);
+
+  const uint8_t state_frame[8] = {0x31, 3};
+  TEST_ASSERT_FALSE(master->is_present(1, state_frame, 2));
+  TEST_ASSERT_TRUE(master->is_present(2, state_frame, 2));
+  TEST_ASSERT_EQUAL_DOUBLE(3.0, master->signals[2].decode(state_frame, 2));
+}
+
+void test_dbc_decodes_motorola_signed_and_extended() {
+  const Dbc dbc = Dbc::parse(TEST_DBC);
+  const DbcMessage* steering = dbc.find(0x295D, true);
+  TEST_ASSERT_NOT_NULL(steering);
+  TEST_ASSERT_TRUE(steering->extended);
+  // -12.3 degrees = -123 raw = 0xFF85, big endian in bytes 0-1
+  const uint8_t frame[8] = {0xFF, 0x85, 0, 0, 0, 0, 0xF6, 0};
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, -12.3, steering->signals[0].decode(frame, 8));
+  TEST_ASSERT_EQUAL_DOUBLE(-10.0, steering->signals[1].decode(frame, 8));
+}
+
+void test_candump_reader_parses_lines_in_parallel_chunks() {
+  std::string text;
+  for (int i = 0; i < 1000; i++) {
+    char line[64];
+    std::snprintf(line, sizeof(line), "(1700000000.%06d) can0 181#8F%02X000000\n", i * 100,
+                  i % 256);
+    text += line;
+  }
+  text += "garbage line\n(1700000001.000000) can0 0000295D#0102\n";
+  const auto path = write_temp_file("test_decoder_dump.log", text.data(), text.size());
+  const MappedFile file(path);
+  const LogContents log = read_candump(file, 4);
+  TEST_ASSERT_EQUAL(1001, log.frames.size());
+  for (int i = 0; i < 1000; i++) {
+    TEST_ASSERT_EQUAL_UINT64(1700000000000000ULL + i * 100, log.frames[i].timestamp_us);
+    TEST_ASSERT_EQUAL_UINT8(i % 256, log.frames[i].data[1]);
+  }
+  TEST_ASSERT_TRUE(log.frames.back().extended);
+  TEST_ASSERT_EQUAL_UINT32(0x295D, log.frames.back().id);
+  TEST_ASSERT_EQUAL_UINT8(2, log.frames.back().len);
+}
+
+void test_sd_reader_decodes_columnar_blocks() {
+  using namespace sdlog;
+  std::vector<uint8_t> image(3 * BLOCK_SIZE, 0);
+
+  // Schema: SAMPLES(timestamp_us U32, state U8) and CAN_RX(timestamp_us, id, len, flags, data)
+  const ColumnDescriptor columns[] = {
+      {"timestamp_us", static_cast<uint8_t>(ColumnType::U32), 0, 0},
+      {"state", static_cast<uint8_t>(ColumnType::U8), 0, 0},
+      {"timestamp_us", static_cast<uint8_t>(ColumnType::U32), 1, 0},
+      {"id", static_cast<uint8_t>(ColumnType::U32), 1, 0},
+      {"len", static_cast<uint8_t>(ColumnType::U8), 1, 0},
+      {"flags", static_cast<uint8_t>(ColumnType::U8), 1, 0},
+      {"data", static_cast<uint8_t>(ColumnType::U64), 1, 0},
+  };
+  const BlockHeader schema{BLOCK_MAGIC, 0, 0, 7, 7, 0, 0};
+  const FileInfo info{FILE_MAGIC, FORMAT_VERSION, 7, 1, 0, 0};
+  std::memcpy(image.data(), &schema, sizeof(schema));
+  std::memcpy(image.data() + sizeof(schema), &info, sizeof(info));
+  std::memcpy(image.data() + sizeof(schema) + sizeof(info), columns, sizeof(columns));
+
+  // SAMPLES block with 2 rows, capacity 99 (5 bytes per row)
+  uint8_t* block = image.data() + BLOCK_SIZE;
+  const BlockHeader samples{BLOCK_MAGIC, 1, 0, 2, 99, 1, 3};
+  std::memcpy(block, &samples, sizeof(samples));
+  const uint32_t times[2] = {1000, 2000};
+  std::memcpy(block + 16, times, sizeof(times));
+  block[16 + 99 * 4 + 0] = 1;
+  block[16 + 99 * 4 + 1] = 2;
+
+  // CAN_RX block with 1 row, capacity 27 (18 bytes per row)
+  block = image.data() + 2 * BLOCK_SIZE;
+  const BlockHeader can{BLOCK_MAGIC, 1, 1, 1, 27, 2, 0};
+  std::memcpy(block, &can, sizeof(can));
+  const uint32_t ts = 1500;
+  const uint32_t id = BAMO_RESPONSE_ID;
+  const uint64_t payload = 0x000000048FULL;  // 0x8F, errors = 0x0004
+  std::memcpy(block + 16, &ts, 4);
+  std::memcpy(block + 16 + 27 * 4, &id, 4);
+  block[16 + 27 * 8] = 6;
+  block[16 + 27 * 9] = 0;
+  std::memcpy(block + 16 + 27 * 10, &payload, 8);
+
+  const auto path = write_temp_file("test_decoder.bin", image.data(), image.size());
+  const MappedFile file(path);
+  const LogContents log = read_log(file, 2);
+
+  TEST_ASSERT_EQUAL(1, log.tables.size());
+  TEST_ASSERT_EQUAL_DOUBLE(2000.0, log.tables[0].columns[0][1]);
+  TEST_ASSERT_EQUAL_DOUBLE(2.0, log.tables[0].columns[1][1]);
+  TEST_ASSERT_EQUAL_UINT64(3, log.dropped_rows);
+  TEST_ASSERT_EQUAL_UINT64(0, log.trailing_blocks);
+  TEST_ASSERT_EQUAL(1, log.frames.size());
+  TEST_ASSERT_EQUAL_UINT32(BAMO_RESPONSE_ID, log.frames[0].id);
+  TEST_ASSERT_EQUAL_UINT8(0x04, log.frames[0].data[1]);
+
+  const auto timeline = state_timeline_from_samples(log.tables[0], 1000);
+  TEST_ASSERT_EQUAL(2, timeline.size());
+  TEST_ASSERT_EQUAL(2, timeline[1].state);
+  TEST_ASSERT_EQUAL_DOUBLE(0.001, timeline[1].start_s);
+}
+
+void test_sd_reader_stops_where_the_sequence_breaks() {
+  using namespace sdlog;
+  std::vector<uint8_t> image(5 * BLOCK_SIZE, 0);
+  const ColumnDescriptor columns[] = {
+      {"timestamp_us", static_cast<uint8_t>(ColumnType::U32), 0, 0},
+  };
+  constexpr uint32_t BASE = 0xFFFF'FFFE;  // per file, wraps within this one
+  const BlockHeader schema{BLOCK_MAGIC, 0, 0, 1, 1, BASE, 0};
+  const FileInfo info{FILE_MAGIC, FORMAT_VERSION, 1, 1, 0, 0};
+  std::memcpy(image.data(), &schema, sizeof(schema));
+  std::memcpy(image.data() + sizeof(schema), &info, sizeof(info));
+  std::memcpy(image.data() + sizeof(schema) + sizeof(info), columns, sizeof(columns));
+
+  // Two blocks of this file, then one left by an older log and the unused tail
+  const uint32_t sequences[] = {BASE + 1, BASE + 2, 3};
+  for (uint32_t b = 0; b < 3; b++) {
+    uint8_t* block = image.data() + (b + 1) * BLOCK_SIZE;
+    const BlockHeader samples{BLOCK_MAGIC, 1, 0, 1, 124, sequences[b], 0};
+    std::memcpy(block, &samples, sizeof(samples));
+    const uint32_t time = 1000 * (b + 1);
+    std::memcpy(block + 16, &time, sizeof(time));
+  }
+
+  const auto path = write_temp_file("test_decoder_tail.bin", image.data(), image.size());
+  const MappedFile file(path);
+  const LogContents log = read_log(file, 2);
+
+  TEST_ASSERT_EQUAL(2, log.tables[0].columns[0].size());
+  TEST_ASSERT_EQUAL_DOUBLE(2000.0, log.tables[0].columns[0][1]);
+  TEST_ASSERT_EQUAL_UINT64(2, log.trailing_blocks);
+  TEST_ASSERT_EQUAL_UINT64(0, log.corrupt_blocks);
+}
+
+void test_bamocar_error_timeline_tracks_bits() {
+  std::vector<CanFrame> frames;
+  for (uint8_t i = 0; i < 10; i++) {
+    CanFrame frame;
+    frame.id = BAMO_RESPONSE_ID;
+    frame.len = 6;
+    frame.timestamp_us = i * 1000000ULL;
+    frame.data = {LOGICMAP_ERRORS, static_cast<uint8_t>(i >= 3 && i < 6 ? 0x01 : 0), 0,
+                  static_cast<uint8_t>(i >= 8 ? 0x02 : 0), 0};
+    frames.push_back(frame);
+  }
+  const auto timeline = bamocar_error_timeline(frames, 0);
+  TEST_ASSERT_EQUAL(2, timeline.size());
+  TEST_ASSERT_FALSE(timeline[0].warning);
+  TEST_ASSERT_EQUAL(0, timeline[0].bit);
+  TEST_ASSERT_EQUAL_DOUBLE(3.0, timeline[0].start_s);
+  TEST_ASSERT_EQUAL_DOUBLE(6.0, timeline[0].end_s);
+  TEST_ASSERT_TRUE(timeline[1].warning);
+  TEST_ASSERT_EQUAL(1, timeline[1].bit);
+}
+
+void test_temperature_grid_uses_chunk_index() {
+  CanFrame frame;
+  frame.id = ALL_TEMPS_ID + 4;
+  frame.len = 8;
+  frame.data = {4, 2, 30, 31, 32, 33, 34, static_cast<uint8_t>(-5)};
+  const TemperatureGrid grid = build_temperature_grid({frame});
+  TEST_ASSERT_EQUAL(30, grid[4][12].max);
+  TEST_ASSERT_EQUAL(-5, grid[4][17].last);
+  TEST_ASSERT_EQUAL(0, grid[4][11].count);
+  TEST_ASSERT_EQUAL(0, grid[3][12].count);
+}
+
+dlog::Record make_record(const char* format, uint32_t timestamp_us) {
+  dlog::Record record{};
+  record.id = dlog::fnv1a(format);
+  record.timestamp_us = timestamp_us;
+  return record;
+}
+
+void add_arg(dlog::Record& record, dlog::ArgType type, uint32_t bits) {
+  record.arg_types |= static_cast<uint8_t>(static_cast<uint8_t>(type) << (2 * record.arg_count));
+  record.args[record.arg_count++] = bits;
+}
+
+void test_debug_log_table_is_built_from_sources() {
+  TEST_ASSERT_EQUAL_HEX32(0xE40C292C, dlog::fnv1a("a"));  // FNV-1a 32 reference value
+  FormatTable table;
+  const std::size_t found = table.add_source(R"(
+#define LOG_INFO(module, fmt, ...) LOG_AT(LOG_LEVEL_INFO, module, fmt, ##__VA_ARGS__)
+  LOG_INFO(LOG_STATE, "AS state %u -> %u", to_underlying(from), to_underlying(to));
+  LOG_DEBUG(LOG_CAN,
+            "Quoted \"%d\"\t", value);
+  DEBUG_PRINTLN("not a record");
+  CAN_LOG_WARN(LOG_CAN, "not ours either");
+)");
+  TEST_ASSERT_EQUAL(2, found);
+  TEST_ASSERT_EQUAL(3, table.size());  // with the dropped records format
+  TEST_ASSERT_NOT_NULL(table.find(dlog::fnv1a("AS state %u -> %u")));
+  const std::string* quoted = table.find(dlog::fnv1a("Quoted \"%d\"\t"));
+  TEST_ASSERT_NOT_NULL(quoted);
+  TEST_ASSERT_EQUAL_STRING("Quoted \"%d\"\t", quoted->c_str());
+  TEST_ASSERT_NULL(table.find(dlog::fnv1a("not a record")));
+  TEST_ASSERT_NULL(table.find(dlog::fnv1a("not ours either")));
+}
+
+void test_debug_log_formats_recorded_types() {
+  dlog::Record record = make_record("", 0);
+  add_arg(record, dlog::ArgType::I32, static_cast<uint32_t>(-5));
+  add_arg(record, dlog::ArgType::U32, 4000000000U);
+  add_arg(record, dlog::ArgType::U32, 0xA);
+  float pressure = 2.5f;
+  uint32_t bits = 0;
+  std::memcpy(&bits, &pressure, sizeof(bits));
+  add_arg(record, dlog::ArgType::F32, bits);
+  TEST_ASSERT_EQUAL_STRING("-5 4000000000 0x0A 2.5 100% %s",
+                           format_record("%d %lu 0x%02X %.1f 100%% %s", record).c_str());
+}
+
+void test_debug_log_decodes_frames_between_text() {
+  dlog::Record record = make_record("BMS: %u V, SOC %u%%", 1500000);
+  add_arg(record, dlog::ArgType::U32, 120);
+  add_arg(record, dlog::ArgType::U32, 87);
+  std::vector<uint8_t> capture = {'b', 'o', 'o', 't'};
+  uint8_t frame[dlog::MAX_FRAME_SIZE];
+  const std::size_t length = dlog::encode_frame(record, frame);
+  TEST_ASSERT_EQUAL(dlog::FRAME_HEADER_SIZE + 8 + 1, length);
+  capture.insert(capture.end(), frame, frame + length);
+  capture.push_back(dlog::FRAME_MAGIC[0]);  // not a frame, passed through as text
+  capture.push_back('\n');
+  record.id = 0x12345678;
+  capture.insert(capture.end(), frame, frame + dlog::encode_frame(record, frame));
+  capture.insert(capture.end(), frame, frame + 3);  // capture stopped inside a frame
+
+  FormatTable table;
+  table.add("BMS: %u V, SOC %u%%");
+  std::string text;
+  const DebugLogSummary summary = decode_debug_log(table, capture.data(), capture.size(), text);
+  TEST_ASSERT_EQUAL(2, summary.records);
+  TEST_ASSERT_EQUAL(1, summary.unknown_records);
+  TEST_ASSERT_EQUAL(4 + 2 + 3, summary.text_bytes);
+  const std::string expected = std::string("boot\n[   1.500000] BMS: 120 V, SOC 87%\n\xA5\n") +
+                               "[   1.500000] <unknown format 0x12345678> 0x00000078 0x00000057\n" +
+                               "\xA5\x1D\x02";
+  TEST_ASSERT_EQUAL(expected.size(), text.size());
+  TEST_ASSERT_TRUE(expected == text);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_dbc_parses_messages_and_multiplexing);
+  RUN_TEST(test_dbc_decodes_motorola_signed_and_extended);
+  RUN_TEST(test_candump_reader_parses_lines_in_parallel_chunks);
+  RUN_TEST(test_sd_reader_decodes_columnar_blocks);
+  RUN_TEST(test_sd_reader_stops_where_the_sequence_breaks);
+  RUN_TEST(test_bamocar_error_timeline_tracks_bits);
+  RUN_TEST(test_temperature_grid_uses_chunk_index);
+  RUN_TEST(test_debug_log_table_is_built_from_sources);
+  RUN_TEST(test_debug_log_formats_recorded_types);
+  RUN_TEST(test_debug_log_decodes_frames_between_text);
+  return UNITY_END();
+}
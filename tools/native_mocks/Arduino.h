@@ -0,0 +1,198 @@
+#pragma once
+// Native stand-in for the Teensyduino core, see native_mock.hpp for the simulation model
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "native_mock.hpp"
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define INPUT_PULLDOWN 3
+#define OUTPUT_OPENDRAIN 4
+#define INPUT_DISABLE 5
+#define FALLING 2
+#define RISING 3
+#define CHANGE 4
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+inline uint32_t micros() { return static_cast<uint32_t>(mock::now_us()); }
+inline uint32_t millis() { return static_cast<uint32_t>(mock::now_us() / 1000); }
+inline void delay(uint32_t ms) { mock::advance_us(static_cast<uint64_t>(ms) * 1000); }
+inline void delayMicroseconds(uint32_t us) { mock::advance_us(us); }
+inline void yield() {}
+
+inline void noInterrupts() { mock::runtime().interrupts_enabled = false; }
+inline void interrupts() {
+  mock::runtime().interrupts_enabled = true;
+  mock::dispatch_irqs();
+}
+inline void __disable_irq() { noInterrupts(); }
+inline void __enable_irq() { interrupts(); }
+
+inline void pinMode(uint8_t pin, uint8_t mode) {
+  mock::runtime().pin_mode[pin] = mode;
+  if (mode == INPUT_PULLUP) {
+    mock::runtime().pin_level[pin] = HIGH;
+  }
+}
+inline void digitalWrite(uint8_t pin, uint8_t value) {
+  mock::runtime().pin_level[pin] = value ? HIGH : LOW;
+  mock::runtime().pin_writes[pin]++;
+  if (mock::runtime().on_digital_write) {
+    mock::runtime().on_digital_write(pin, value ? HIGH : LOW);
+  }
+}
+inline uint8_t digitalRead(uint8_t pin) { return mock::runtime().pin_level[pin] ? HIGH : LOW; }
+inline int analogRead(uint8_t pin) { return mock::runtime().analog_value[pin]; }
+inline void analogWrite(uint8_t pin, int value) { mock::runtime().pin_level[pin] = value; }
+inline void tone(uint8_t pin, uint16_t /*frequency*/) { mock::runtime().pin_level[pin] = HIGH; }
+inline void noTone(uint8_t pin) { mock::runtime().pin_level[pin] = LOW; }
+
+// Fast GPIO pad status registers, as in imxrt.h
+#define GPIO6_PSR mock::gpio_psr(6)
+#define GPIO7_PSR mock::gpio_psr(7)
+#define GPIO8_PSR mock::gpio_psr(8)
+#define GPIO9_PSR mock::gpio_psr(9)
+
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+inline void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+  mock::runtime().pin_interrupt[pin] = {isr, mode};
+}
+inline void detachInterrupt(uint8_t pin) { mock::runtime().pin_interrupt[pin] = {}; }
+
+// NVIC, as in imxrt.h
+enum IRQ_NUMBER_t { IRQ_SOFTWARE = 70 };
+inline void attachInterruptVector(IRQ_NUMBER_t irq, void (*function)()) {
+  mock::runtime().irq[irq].vector = function;
+}
+#define NVIC_ENABLE_IRQ(n) (mock::runtime().irq[(n)].enabled = true)
+#define NVIC_DISABLE_IRQ(n) (mock::runtime().irq[(n)].enabled = false)
+#define NVIC_SET_PRIORITY(n, p) (mock::runtime().irq[(n)].priority = (p))
+#define NVIC_SET_PENDING(n) mock::set_irq_pending(n)
+#define NVIC_CLEAR_PENDING(n) (mock::runtime().irq[(n)].pending = false)
+
+template <class T, class L, class H>
+constexpr std::common_type_t<T, L, H> constrain(T amt, L low, H high) {
+  return amt < low ? low : (amt > high ? high : amt);
+}
+template <class A, class B>
+constexpr std::common_type_t<A, B> min(A a, B b) {
+  return a < b ? a : b;
+}
+template <class A, class B>
+constexpr std::common_type_t<A, B> max(A a, B b) {
+  return a > b ? a : b;
+}
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+/**
+ * @brief Arduino String on top of std::string, enough for the DEBUG_PRINT concatenations
+ */
+class String {
+public:
+  String() = default;
+  String(const char *text) : value_(text == nullptr ? "" : text) {}
+  String(const std::string &text) : value_(text) {}
+  String(char c) : value_(1, c) {}
+  template <class T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+  String(T number, unsigned char base = DEC) {
+    char buffer[72];
+    if (base == DEC) {
+      std::snprintf(buffer, sizeof(buffer), std::is_signed_v<T> ? "%lld" : "%llu",
+                    static_cast<long long>(number));
+    } else {
+      auto value = static_cast<unsigned long long>(number);
+      int i = sizeof(buffer) - 1;
+      buffer[i] = '\0';
+      do {
+        buffer[--i] = "0123456789ABCDEF"[value % base];
+        value /= base;
+      } while (value != 0 && i > 0);
+      value_ = &buffer[i];
+      return;
+    }
+    value_ = buffer;
+  }
+  template <class T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+  String(T number, unsigned char decimals = 2) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", decimals, static_cast<double>(number));
+    value_ = buffer;
+  }
+
+  [[nodiscard]] const char *c_str() const { return value_.c_str(); }
+  [[nodiscard]] unsigned length() const { return static_cast<unsigned>(value_.size()); }
+  String &operator+=(const String &other) {
+    value_ += other.value_;
+    return *this;
+  }
+  friend String operator+(String lhs, const String &rhs) { return lhs += rhs; }
+  friend String operator+(const char *lhs, const String &rhs) { return String(lhs) += rhs; }
+  bool operator==(const String &other) const { return value_ == other.value_; }
+
+private:
+  std::string value_;
+};
+
+/**
+ * @brief Serial port that swallows output unless mock::runtime().serial_echo is set
+ */
+class MockSerial {
+public:
+  void begin(uint32_t /*baud*/) {}
+  explicit operator bool() const { return true; }
+  int availableForWrite() { return 64; }
+  size_t write(const uint8_t *data, size_t size) {
+    if (mock::runtime().serial_echo) std::fwrite(data, 1, size, stdout);
+    return size;
+  }
+  void print(const String &text) { out("%s", text.c_str()); }
+  void print(const char *text) { out("%s", text); }
+  void print(char c) { out("%c", c); }
+  template <class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+  void print(T value, int format = -1) {
+    print(format < 0 ? String(value) : String(value, static_cast<unsigned char>(format)));
+  }
+  template <class T>
+  void println(const T &value) {
+    print(value);
+    println();
+  }
+  template <class T>
+  void println(T value, int format) {
+    print(value, format);
+    println();
+  }
+  void println() { out("\n"); }
+  void printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+    if (!mock::runtime().serial_echo) return;
+    va_list args;
+    va_start(args, format);
+    std::vprintf(format, args);
+    va_end(args);
+  }
+
+private:
+  template <class... Args>
+  void out(const char *format, Args... args) {
+    if (mock::runtime().serial_echo) std::printf(format, args...);
+  }
+};
+
+inline MockSerial Serial;
+
+#include "elapsedMillis.h"
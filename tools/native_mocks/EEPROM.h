@@ -0,0 +1,39 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+// Teensy 4.1 emulated EEPROM, erased to 0xFF; tests reach the bytes through mock::eeprom()
+#define E2END 0x10BB
+
+namespace mock {
+inline std::array<uint8_t, E2END + 1> &eeprom() {
+  static std::array<uint8_t, E2END + 1> bytes = [] {
+    std::array<uint8_t, E2END + 1> erased{};
+    erased.fill(0xFF);
+    return erased;
+  }();
+  return bytes;
+}
+}  // namespace mock
+
+class EEPROMClass {
+public:
+  uint8_t read(const int idx) { return mock::eeprom()[idx]; }
+  void write(const int idx, const uint8_t val) { mock::eeprom()[idx] = val; }
+  void update(const int idx, const uint8_t val) { mock::eeprom()[idx] = val; }
+  uint16_t length() { return E2END + 1; }
+
+  template <typename T>
+  T &get(const int idx, T &t) {
+    std::memcpy(&t, mock::eeprom().data() + idx, sizeof(T));
+    return t;
+  }
+  template <typename T>
+  const T &put(const int idx, const T &t) {
+    std::memcpy(mock::eeprom().data() + idx, &t, sizeof(T));
+    return t;
+  }
+};
+
+inline EEPROMClass EEPROM;
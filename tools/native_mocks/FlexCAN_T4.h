@@ -0,0 +1,189 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "native_mock.hpp"
+
+typedef struct CAN_message_t {
+  uint32_t id = 0;
+  uint16_t timestamp = 0;
+  uint8_t idhit = 0;
+  struct {
+    bool extended = 0;
+    bool remote = 0;
+    bool overrun = 0;
+    bool reserved = 0;
+  } flags;
+  uint8_t len = 8;
+  uint8_t buf[8] = {0};
+  int8_t mb = 0;
+  uint8_t bus = 0;
+  bool seq = 0;
+} CAN_message_t;
+
+typedef void (*_MB_ptr)(const CAN_message_t &msg);
+
+typedef enum CAN_DEV_TABLE { CAN1 = 1, CAN2 = 2, CAN3 = 3 } CAN_DEV_TABLE;
+
+typedef enum FLEXCAN_RXQUEUE_TABLE {
+  RX_SIZE_2 = 2,
+  RX_SIZE_4 = 4,
+  RX_SIZE_8 = 8,
+  RX_SIZE_16 = 16,
+  RX_SIZE_32 = 32,
+  RX_SIZE_64 = 64,
+  RX_SIZE_128 = 128,
+  RX_SIZE_256 = 256,
+  RX_SIZE_512 = 512,
+  RX_SIZE_1024 = 1024
+} FLEXCAN_RXQUEUE_TABLE;
+
+typedef enum FLEXCAN_TXQUEUE_TABLE {
+  TX_SIZE_2 = 2,
+  TX_SIZE_4 = 4,
+  TX_SIZE_8 = 8,
+  TX_SIZE_16 = 16,
+  TX_SIZE_32 = 32,
+  TX_SIZE_64 = 64,
+  TX_SIZE_128 = 128,
+  TX_SIZE_256 = 256,
+  TX_SIZE_512 = 512,
+  TX_SIZE_1024 = 1024
+} FLEXCAN_TXQUEUE_TABLE;
+
+typedef enum FLEXCAN_MAILBOX { MB0, MB1, MB2, MB3, MB4, MB5, MB6, MB7, FIFO = 99 } FLEXCAN_MAILBOX;
+typedef enum FLEXCAN_RFFN_TABLE {
+  RFFN_8 = 0,
+  RFFN_16,
+  RFFN_24,
+  RFFN_32,
+  RFFN_40,
+  RFFN_48,
+  RFFN_56,
+  RFFN_64,
+  RFFN_72,
+  RFFN_80,
+  RFFN_88,
+  RFFN_96,
+  RFFN_104,
+  RFFN_112,
+  RFFN_120,
+  RFFN_128
+} FLEXCAN_RFFN_TABLE;
+typedef enum FLEXCAN_FLTEN { ACCEPT_ALL = 0, REJECT_ALL = 1 } FLEXCAN_FLTEN;
+typedef enum FLEXCAN_IDE { NONE = 0, EXT = 1, RTR = 2, STD = 3, INACTIVE } FLEXCAN_IDE;
+
+namespace mock {
+
+/**
+ * @brief What the firmware did with one controller, and the way to feed it frames
+ */
+struct CanBus {
+  struct Filter {
+    uint32_t id = 0;
+    bool extended = false;
+    bool used = false;
+  };
+  struct TxFrame {
+    uint64_t time_us = 0;
+    CAN_message_t msg;
+  };
+
+  bool fifo_enabled = false;
+  bool reject_all = false;
+  std::array<Filter, 128> filters{};
+  _MB_ptr fifo_handler = nullptr;
+  _MB_ptr main_handler = nullptr;
+  std::vector<TxFrame> tx;
+  std::function<void(const CAN_message_t &)> on_transmit;  // e.g. to wire two buses together
+  uint64_t rx_accepted = 0;
+  uint64_t rx_filtered = 0;
+
+  [[nodiscard]] bool accepts(const CAN_message_t &msg) const {
+    if (!fifo_enabled || !reject_all) {
+      return true;
+    }
+    for (const auto &filter : filters) {
+      if (filter.used && filter.id == msg.id && filter.extended == msg.flags.extended) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Delivers a frame as the receive interrupt would, if the acceptance filters let it in
+   */
+  bool inject(const CAN_message_t &msg) {
+    if (!accepts(msg)) {
+      rx_filtered++;
+      return false;
+    }
+    rx_accepted++;
+    CAN_message_t received = msg;
+    received.timestamp = static_cast<uint16_t>(mock::now_us());
+    if (fifo_enabled && fifo_handler != nullptr) {
+      received.mb = FIFO;
+      fifo_handler(received);
+    }
+    if (main_handler != nullptr) {
+      main_handler(received);
+    }
+    return true;
+  }
+};
+
+inline CanBus &can_bus(int bus) {
+  static std::array<CanBus, 4> buses;
+  return buses[bus];
+}
+
+inline void reset_can() {
+  for (int bus = 0; bus < 4; bus++) {
+    can_bus(bus) = CanBus{};
+  }
+}
+
+}  // namespace mock
+
+template <CAN_DEV_TABLE _bus, FLEXCAN_RXQUEUE_TABLE _rxSize = RX_SIZE_16,
+          FLEXCAN_TXQUEUE_TABLE _txSize = TX_SIZE_16>
+class FlexCAN_T4 {
+public:
+  void begin() {}
+  void setBaudRate(uint32_t /*baud*/) {}
+  void setRFFN(FLEXCAN_RFFN_TABLE /*rffn*/) {}
+  void enableFIFO(bool status = 1) { bus().fifo_enabled = status; }
+  void enableFIFOInterrupt(bool /*status*/ = 1) {}
+  void setFIFOFilter(const FLEXCAN_FLTEN &input) {
+    bus().reject_all = input == REJECT_ALL;
+    for (auto &filter : bus().filters) filter.used = false;
+  }
+  bool setFIFOFilter(uint8_t filter, uint32_t id, const FLEXCAN_IDE &ide,
+                     const FLEXCAN_IDE & /*remote*/ = NONE) {
+    bus().filters[filter] = {id, ide == EXT, true};
+    return true;
+  }
+  void onReceive(const FLEXCAN_MAILBOX &mb, _MB_ptr handler) {
+    if (mb == FIFO) {
+      bus().fifo_handler = handler;
+    } else {
+      bus().main_handler = handler;
+    }
+  }
+  void onReceive(_MB_ptr handler) { bus().main_handler = handler; }
+  void mailboxStatus() {}
+  uint64_t events() { return 0; }
+  int write(const CAN_message_t &msg) {
+    bus().tx.push_back({mock::now_us(), msg});
+    if (bus().on_transmit) {
+      bus().on_transmit(msg);
+    }
+    return 1;
+  }
+
+private:
+  static mock::CanBus &bus() { return mock::can_bus(_bus); }
+};
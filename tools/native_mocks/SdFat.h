@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// No card in the simulator: begin() fails and SdLogger stays disabled
+#define FIFO_SDIO 0
+#define O_RDONLY 0x00
+#define O_WRONLY 0x01
+#define O_RDWR 0x02
+#define O_CREAT 0x40
+#define O_TRUNC 0x200
+
+struct SdioConfig {
+  explicit SdioConfig(int /*options*/) {}
+};
+
+class SdCard {
+public:
+  bool isBusy() { return false; }
+};
+
+class FsFile {
+public:
+  bool open(const char * /*path*/, int /*flags*/ = O_RDONLY) { return false; }
+  bool openNext(FsFile * /*dir*/, int /*flags*/ = O_RDONLY) { return false; }
+  bool isDir() const { return false; }
+  size_t getName(char *name, size_t size) {
+    if (size > 0) {
+      name[0] = '\0';
+    }
+    return 0;
+  }
+  uint64_t fileSize() const { return 0; }
+  bool preAllocate(uint64_t /*size*/) { return false; }
+  size_t write(const void * /*data*/, size_t /*size*/) { return 0; }
+  bool flush() { return false; }
+  bool truncate() { return false; }
+  bool truncate(uint64_t /*length*/) { return false; }
+  bool close() { return true; }
+};
+
+class SdFs {
+public:
+  bool begin(SdioConfig /*config*/) { return false; }
+  bool exists(const char * /*path*/) { return false; }
+  SdCard *card() { return &card_; }
+
+private:
+  SdCard card_;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <functional>
+
+#include "native_mock.hpp"
+
+/**
+ * @brief Software timers on the virtual clock. begin() on a running timer restarts it,
+ * like the TCK/GPT channels do on the Teensy.
+ */
+namespace TeensyTimerTool {
+
+enum class errorCode { OK = 0 };
+
+class BaseTimer {
+public:
+  BaseTimer() = default;
+  // A copy is a new, unarmed timer; the scheduled callback stays with the original
+  BaseTimer(const BaseTimer & /*other*/) {}
+  BaseTimer &operator=(const BaseTimer & /*other*/) {
+    stop();
+    return *this;
+  }
+  ~BaseTimer() { stop(); }
+
+  errorCode stop() {
+    if (id_ != mock::INVALID_TIMER) {
+      mock::cancel(id_);
+      id_ = mock::INVALID_TIMER;
+    }
+    return errorCode::OK;
+  }
+
+protected:
+  int id_ = mock::INVALID_TIMER;
+  std::function<void()> callback_;
+};
+
+class PeriodicTimer : public BaseTimer {
+public:
+  template <class Callback>
+  errorCode begin(Callback callback, float period_us, bool start = true) {
+    callback_ = callback;
+    period_us_ = static_cast<uint64_t>(period_us);
+    return start ? this->start() : errorCode::OK;
+  }
+  errorCode start() {
+    stop();
+    id_ = mock::schedule_periodic(period_us_, callback_);
+    return errorCode::OK;
+  }
+
+private:
+  uint64_t period_us_ = 0;
+};
+
+class OneShotTimer : public BaseTimer {
+public:
+  template <class Callback>
+  errorCode begin(Callback callback) {
+    callback_ = callback;
+    return errorCode::OK;
+  }
+  errorCode trigger(float delay_us) {
+    stop();
+    id_ = mock::schedule_once(static_cast<uint64_t>(delay_us), [this] {
+      id_ = mock::INVALID_TIMER;
+      callback_();
+    });
+    return errorCode::OK;
+  }
+};
+
+}  // namespace TeensyTimerTool
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+#include "native_mock.hpp"
+
+class elapsedMillis {
+public:
+  elapsedMillis(uint32_t value = 0) : start_(now() - value) {}
+  operator uint32_t() const { return now() - start_; }
+  elapsedMillis &operator=(uint32_t value) {
+    start_ = now() - value;
+    return *this;
+  }
+
+private:
+  static uint32_t now() { return static_cast<uint32_t>(mock::now_us() / 1000); }
+  uint32_t start_;
+};
+
+class elapsedMicros {
+public:
+  elapsedMicros(uint32_t value = 0) : start_(now() - value) {}
+  operator uint32_t() const { return now() - start_; }
+  elapsedMicros &operator=(uint32_t value) {
+    start_ = now() - value;
+    return *this;
+  }
+
+private:
+  static uint32_t now() { return static_cast<uint32_t>(mock::now_us()); }
+  uint32_t start_;
+};
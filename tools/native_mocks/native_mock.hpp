@@ -0,0 +1,216 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Host-side replacement for the Teensy runtime used by the native test environments
+ *
+ * Time is virtual: it only moves through delay()/delayMicroseconds() in the firmware or
+ * mock::advance_us() in a test. Timer callbacks (TeensyTimerTool), pin interrupts and
+ * anything else scheduled with mock::schedule_* run at their exact virtual due time while
+ * the clock moves, the same way the hardware would interrupt a delay() in loop(). NVIC lines
+ * pended with NVIC_SET_PENDING run right away, or at the next interrupts() if masked.
+ */
+namespace mock {
+
+constexpr int NUM_PINS = 64;
+constexpr int NUM_IRQS = 160;
+constexpr int INVALID_TIMER = -1;
+
+/**
+ * @brief Periodic or one shot callback on the virtual clock
+ */
+struct ScheduledEvent {
+  int id = INVALID_TIMER;
+  uint64_t due_us = 0;
+  uint64_t period_us = 0;  // 0 for one shot
+  bool active = false;
+  std::function<void()> callback;
+};
+
+struct PinInterrupt {
+  void (*isr)() = nullptr;
+  int mode = 0;
+};
+
+/**
+ * @brief One NVIC line; pended lines run as soon as interrupts are enabled, never nested in
+ * themselves
+ */
+struct IrqLine {
+  void (*vector)() = nullptr;
+  bool enabled = false;
+  bool pending = false;
+  bool active = false;
+  uint8_t priority = 128;
+};
+
+struct Runtime {
+  uint64_t now_us = 0;
+  int next_event_id = 0;
+  std::vector<ScheduledEvent> events;
+  bool interrupts_enabled = true;
+
+  std::array<int, NUM_PINS> pin_level{};
+  std::array<int, NUM_PINS> pin_mode{};
+  std::array<int, NUM_PINS> analog_value{};
+  std::array<PinInterrupt, NUM_PINS> pin_interrupt{};
+  std::array<uint32_t, NUM_PINS> pin_writes{};  // digitalWrite() count per pin
+  std::function<void(int pin, int value)> on_digital_write;  // observer for output timing
+  std::array<IrqLine, NUM_IRQS> irq{};
+
+  bool serial_echo = false;  // mirror Serial output to stdout
+};
+
+/**
+ * @brief Fast GPIO port (6..9) and bit of each Teensy 4.1 pin, from core_pins.h
+ */
+struct GpioPad {
+  uint8_t port;
+  uint8_t bit;
+};
+constexpr std::array<GpioPad, 42> TEENSY41_PADS{{
+    {6, 3},  {6, 2},  {9, 4},  {9, 5},  {9, 6},  {9, 8},  {7, 10}, {7, 17}, {7, 16}, {7, 11},
+    {7, 0},  {7, 2},  {7, 1},  {7, 3},  {6, 18}, {6, 19}, {6, 23}, {6, 22}, {6, 17}, {6, 16},
+    {6, 26}, {6, 27}, {6, 24}, {6, 25}, {6, 12}, {6, 13}, {6, 30}, {6, 31}, {8, 18}, {9, 31},
+    {8, 23}, {8, 22}, {7, 12}, {9, 7},  {7, 29}, {7, 28}, {7, 18}, {7, 19}, {6, 28}, {6, 29},
+    {6, 20}, {6, 21},
+}};
+
+inline Runtime &runtime() {
+  static Runtime instance;
+  return instance;
+}
+
+inline uint64_t now_us() { return runtime().now_us; }
+
+/**
+ * @brief Pad status register of a fast GPIO port, assembled from the pin levels
+ */
+inline uint32_t gpio_psr(int port) {
+  uint32_t psr = 0;
+  for (std::size_t pin = 0; pin < TEENSY41_PADS.size(); pin++) {
+    if (TEENSY41_PADS[pin].port == port && runtime().pin_level[pin] != 0) {
+      psr |= 1U << TEENSY41_PADS[pin].bit;
+    }
+  }
+  return psr;
+}
+
+/**
+ * @brief Clears the clock, pins and every scheduled event; call before each test
+ */
+inline void reset() {
+  const bool echo = runtime().serial_echo;
+  runtime() = Runtime{};
+  runtime().serial_echo = echo;
+}
+
+inline int schedule(uint64_t delay_us, uint64_t period_us, std::function<void()> callback) {
+  Runtime &rt = runtime();
+  ScheduledEvent event;
+  event.id = rt.next_event_id++;
+  event.due_us = rt.now_us + delay_us;
+  event.period_us = period_us;
+  event.active = true;
+  event.callback = std::move(callback);
+  rt.events.push_back(std::move(event));
+  return rt.events.back().id;
+}
+
+inline int schedule_once(uint64_t delay_us, std::function<void()> callback) {
+  return schedule(delay_us, 0, std::move(callback));
+}
+
+inline int schedule_periodic(uint64_t period_us, std::function<void()> callback) {
+  return schedule(period_us, period_us, std::move(callback));
+}
+
+inline void cancel(int id) {
+  auto &events = runtime().events;
+  events.erase(std::remove_if(events.begin(), events.end(),
+                              [id](const ScheduledEvent &e) { return e.id == id; }),
+               events.end());
+}
+
+/**
+ * @brief Moves the virtual clock forward, running due events in time order (FIFO on ties)
+ */
+inline void advance_us(uint64_t delta_us) {
+  Runtime &rt = runtime();
+  const uint64_t target = rt.now_us + delta_us;
+  while (true) {
+    ScheduledEvent *next = nullptr;
+    for (auto &event : rt.events) {
+      if (event.active && event.due_us <= target &&
+          (next == nullptr || event.due_us < next->due_us)) {
+        next = &event;
+      }
+    }
+    if (next == nullptr) {
+      break;
+    }
+    rt.now_us = std::max(rt.now_us, next->due_us);
+    const int id = next->id;
+    auto callback = next->callback;  // the callback may (re)schedule and invalidate `next`
+    if (next->period_us != 0) {
+      next->due_us += next->period_us;
+    } else {
+      cancel(id);
+    }
+    callback();
+  }
+  rt.now_us = target;
+}
+
+/**
+ * @brief Drives an input pin from the test side, firing an attached interrupt on the edge
+ */
+inline void set_pin(int pin, int level) {
+  Runtime &rt = runtime();
+  const int previous = rt.pin_level[pin];
+  rt.pin_level[pin] = level;
+  const PinInterrupt &irq = rt.pin_interrupt[pin];
+  if (irq.isr == nullptr || previous == level) {
+    return;
+  }
+  constexpr int CHANGE = 4;
+  constexpr int FALLING = 2;
+  constexpr int RISING = 3;
+  if (irq.mode == CHANGE || (irq.mode == RISING && level != 0) ||
+      (irq.mode == FALLING && level == 0)) {
+    irq.isr();
+  }
+}
+
+/**
+ * @brief Runs every pended and enabled NVIC line, unless interrupts are masked
+ */
+inline void dispatch_irqs() {
+  Runtime &rt = runtime();
+  if (!rt.interrupts_enabled) {
+    return;
+  }
+  for (auto &line : rt.irq) {
+    if (line.pending && line.enabled && !line.active && line.vector != nullptr) {
+      line.pending = false;
+      line.active = true;
+      line.vector();
+      line.active = false;
+    }
+  }
+}
+
+inline void set_irq_pending(int irq) {
+  runtime().irq[irq].pending = true;
+  dispatch_irqs();
+}
+
+inline void set_analog(int pin, int value) { runtime().analog_value[pin] = value; }
+
+inline int pin(int pin) { return runtime().pin_level[pin]; }
+
+}  // namespace mock
@@ -0,0 +1,207 @@
+#include <Arduino.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "../../../ringBuffer.hpp"
+#include "circular_buffer.h"
+
+namespace {
+
+constexpr std::size_t SCALAR_CAPACITY = 256;
+constexpr std::size_t SLOTS = 32;
+constexpr std::size_t PACKET_MAX = 128;
+constexpr uint16_t WIDGETS = 12;
+
+volatile uint32_t sink = 0;  // keeps results alive so the work is not optimized away
+
+template <typename F>
+double ns_per_op(const std::size_t ops, F&& f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(ops);
+}
+
+void report(const char* name, const double old_ns, const double new_ns) {
+  std::printf("%-34s %10.2f %10.2f %8.2fx\n", name, old_ns, new_ns, old_ns / new_ns);
+}
+
+/**
+ * @brief Display packet as transfer16 builds it: header, length, widget ID, packet ID, data,
+ * checksum
+ */
+uint16_t make_packet(uint16_t* packet, const uint16_t widget, const uint16_t data_length,
+                     const uint32_t seed) {
+  packet[0] = 0xDA7A;
+  packet[1] = data_length + 5;
+  packet[2] = widget;
+  packet[3] = static_cast<uint16_t>(seed);
+  uint16_t checksum = 0;
+  for (uint16_t i = 0; i < data_length; i++) {
+    packet[4 + i] = static_cast<uint16_t>(seed * 31 + i);
+  }
+  for (uint16_t i = 0; i < data_length + 4; i++) {
+    checksum ^= packet[i];
+  }
+  packet[data_length + 4] = checksum;
+  return data_length + 5;
+}
+
+void bench_scalar(const std::size_t iterations) {
+  static Circular_Buffer<uint16_t, SCALAR_CAPACITY> legacy;
+  static ring::SpscRing<uint16_t, SCALAR_CAPACITY> ring;
+  const double old_ns = ns_per_op(iterations, [&] {
+    uint32_t total = 0;
+    for (std::size_t i = 0; i < iterations; i++) {
+      legacy.push_back(static_cast<uint16_t>(i));
+      if (legacy.size() > SCALAR_CAPACITY / 2) {
+        total += legacy.pop_front();
+      }
+    }
+    sink = total;
+  });
+  const double new_ns = ns_per_op(iterations, [&] {
+    uint32_t total = 0;
+    uint16_t value = 0;
+    for (std::size_t i = 0; i < iterations; i++) {
+      ring.push(static_cast<uint16_t>(i));
+      if (ring.size() > SCALAR_CAPACITY / 2 && ring.pop(value)) {
+        total += value;
+      }
+    }
+    sink = total;
+  });
+  report("push/pop u16", old_ns, new_ns);
+}
+
+/**
+ * @brief The display queue: the loop replaces or queues a widget packet, the link reads the front
+ * packet and pops it every few packets
+ */
+void bench_display_queue(const std::size_t iterations) {
+  static Circular_Buffer<uint16_t, SLOTS, PACKET_MAX> legacy;
+  static ring::PacketRing<uint16_t, SLOTS, PACKET_MAX> ring;
+  uint16_t packet[PACKET_MAX];
+  const double old_ns = ns_per_op(iterations, [&] {
+    uint16_t front[PACKET_MAX];
+    uint32_t total = 0;
+    for (std::size_t i = 0; i < iterations; i++) {
+      const uint16_t length = make_packet(packet, i % WIDGETS, 1 + i % 24, i);
+      if (!legacy.replace(packet, length, 2, -1, -1) && legacy.size() < legacy.capacity()) {
+        legacy.push_back(packet, length);
+      }
+      if (i % 3 == 0 && legacy.size()) {
+        const uint16_t front_length = legacy.length_front();
+        legacy.peek_front(front, front_length);
+        total += front[front_length - 1];
+        legacy.pop_front();
+      }
+    }
+    sink = total;
+  });
+  const double new_ns = ns_per_op(iterations, [&] {
+    uint32_t total = 0;
+    for (std::size_t i = 0; i < iterations; i++) {
+      const uint16_t widget = i % WIDGETS;
+      const std::span<const uint16_t> view(packet, make_packet(packet, widget, 1 + i % 24, i));
+      if (!ring.replace(view, [widget](const std::span<const uint16_t> queued) {
+            return queued[2] == widget;
+          })) {
+        ring.push(view);
+      }
+      if (i % 3 == 0 && !ring.empty()) {
+        total += ring.front().back();
+        ring.pop();
+      }
+    }
+    sink = total;
+  });
+  report("display queue replace/push/pop", old_ns, new_ns);
+}
+
+/**
+ * @brief Statistics of a full 256 sample ring; the legacy median sorts the ring itself, so it is
+ * refilled each time to keep the comparison fair
+ */
+void bench_statistics(const std::size_t iterations) {
+  static Circular_Buffer<uint16_t, SCALAR_CAPACITY> legacy;
+  static ring::SpscRing<uint16_t, SCALAR_CAPACITY> ring;
+  std::vector<uint16_t> samples(SCALAR_CAPACITY);
+  for (std::size_t i = 0; i < samples.size(); i++) {
+    samples[i] = static_cast<uint16_t>((i * 7919) % 1024);
+    ring.push(samples[i]);
+  }
+  const std::size_t rounds = iterations / SCALAR_CAPACITY + 1;
+  const double old_ns = ns_per_op(rounds, [&] {
+    uint32_t total = 0;
+    for (std::size_t r = 0; r < rounds; r++) {
+      legacy.clear();
+      for (const uint16_t sample : samples) {
+        legacy.push_back(sample);
+      }
+      total += legacy.average() + legacy.variance() + legacy.median();
+    }
+    sink = total;
+  });
+  std::vector<uint16_t> scratch(SCALAR_CAPACITY);
+  const double new_ns = ns_per_op(rounds, [&] {
+    double total = 0;
+    for (std::size_t r = 0; r < rounds; r++) {
+      const auto regions = ring.peek();
+      total += ring::stats::mean(regions) + ring::stats::variance(regions) +
+               ring::stats::median(regions, std::span<uint16_t>(scratch));
+    }
+    sink = static_cast<uint32_t>(total);
+  });
+  report("mean/variance/median of 256", old_ns, new_ns);
+}
+
+/**
+ * @brief The new ring between two threads; the legacy buffer is not safe to share, so it has no
+ * column
+ */
+void bench_threads(const std::size_t iterations) {
+  static ring::SpscRing<uint32_t, SCALAR_CAPACITY> ring;
+  const double ns = ns_per_op(iterations, [&] {
+    std::thread producer([&] {
+      for (uint32_t i = 0; i < iterations;) {
+        if (ring.push(i)) {
+          i++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    uint32_t expected = 0;
+    uint32_t value = 0;
+    while (expected < iterations) {
+      if (ring.pop(value)) {
+        if (value != expected) {
+          std::fprintf(stderr, "out of order: %u after %u\n", value, expected);
+          std::exit(1);
+        }
+        expected++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+  });
+  std::printf("%-34s %10s %10.2f\n", "push/pop across threads", "-", ns);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  std::printf("%-34s %10s %10s %9s\n", "ns per operation", "legacy", "ring", "speedup");
+  bench_scalar(iterations);
+  bench_display_queue(iterations);
+  bench_statistics(iterations);
+  bench_threads(iterations);
+  return 0;
+}
@@ -0,0 +1,169 @@
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../../../../ringBuffer.hpp"
+#include "unity.h"
+
+namespace {
+
+template <typename T>
+std::vector<T> flatten(const ring::Regions<T>& regions) {
+  std::vector<T> values;
+  ring::stats::for_each(regions, [&values](const T& value) { values.push_back(value); });
+  return values;
+}
+
+}  // namespace
+
+void test_spsc_ring_push_pop_full_and_empty() {
+  ring::SpscRing<uint16_t, 4> queue;
+  uint16_t value = 0;
+  TEST_ASSERT_TRUE(queue.empty());
+  TEST_ASSERT_FALSE(queue.pop(value));
+  for (uint16_t i = 0; i < 4; i++) {
+    TEST_ASSERT_TRUE(queue.push(i));
+  }
+  TEST_ASSERT_TRUE(queue.full());
+  TEST_ASSERT_FALSE(queue.push(99));
+  for (uint16_t i = 0; i < 4; i++) {
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL(i, value);
+  }
+  TEST_ASSERT_TRUE(queue.empty());
+}
+
+void test_spsc_ring_peek_splits_at_wraparound() {
+  ring::SpscRing<uint16_t, 8> queue;
+  uint16_t value = 0;
+  for (uint16_t i = 0; i < 6; i++) {
+    queue.push(i);
+  }
+  for (int i = 0; i < 5; i++) {
+    queue.pop(value);
+  }
+  for (uint16_t i = 6; i < 12; i++) {
+    queue.push(i);
+  }
+  const auto regions = queue.peek();
+  TEST_ASSERT_EQUAL(3, regions[0].size());
+  TEST_ASSERT_EQUAL(4, regions[1].size());
+  const std::vector<uint16_t> expected = {5, 6, 7, 8, 9, 10, 11};
+  TEST_ASSERT_TRUE(expected == flatten(regions));
+
+  queue.consume(4);
+  TEST_ASSERT_EQUAL(3, queue.size());
+  TEST_ASSERT_TRUE(queue.pop(value));
+  TEST_ASSERT_EQUAL(9, value);
+  queue.consume(100);
+  TEST_ASSERT_TRUE(queue.empty());
+  TEST_ASSERT_EQUAL(0, ring::stats::count(queue.peek()));
+}
+
+void test_packet_ring_replace_skips_front() {
+  ring::PacketRing<uint16_t, 4, 8> queue;
+  const std::array<uint16_t, 3> a = {1, 10, 100};
+  const std::array<uint16_t, 3> b = {2, 20, 200};
+  const std::array<uint16_t, 4> a_new = {1, 11, 111, 1111};
+  const auto match_a = [](const std::span<const uint16_t> queued) { return queued[0] == 1; };
+
+  TEST_ASSERT_TRUE(queue.push(a));
+  TEST_ASSERT_FALSE(queue.replace(a_new, match_a));  // the front one may be on the wire
+  TEST_ASSERT_TRUE(queue.push(b));
+  TEST_ASSERT_TRUE(queue.push(a));
+  TEST_ASSERT_TRUE(queue.replace(a_new, match_a));
+  TEST_ASSERT_EQUAL(3, queue.size());
+  TEST_ASSERT_EQUAL(3, queue.front().size());
+  TEST_ASSERT_EQUAL(10, queue.front()[1]);
+  TEST_ASSERT_EQUAL(4, queue.peek(2).size());
+  TEST_ASSERT_EQUAL(1111, queue.peek(2)[3]);
+  TEST_ASSERT_TRUE(queue.peek(3).empty());
+
+  queue.pop();
+  TEST_ASSERT_EQUAL(20, queue.front()[1]);
+  queue.pop();
+  queue.pop();
+  queue.pop();
+  TEST_ASSERT_TRUE(queue.empty());
+}
+
+void test_packet_ring_rejects_long_packets_and_overflow() {
+  ring::PacketRing<uint16_t, 2, 4> queue;
+  const std::array<uint16_t, 5> too_long = {1, 2, 3, 4, 5};
+  const std::array<uint16_t, 2> packet = {1, 2};
+  TEST_ASSERT_FALSE(queue.push(too_long));
+  TEST_ASSERT_TRUE(queue.push(packet));
+  TEST_ASSERT_TRUE(queue.push(packet));
+  TEST_ASSERT_FALSE(queue.push(packet));
+  TEST_ASSERT_FALSE(queue.replace(too_long, [](auto) { return true; }));
+  TEST_ASSERT_EQUAL(2, queue.size());
+}
+
+void test_stats_do_not_reorder_the_ring() {
+  ring::SpscRing<int16_t, 8> queue;
+  int16_t value = 0;
+  for (int i = 0; i < 5; i++) {
+    queue.push(0);
+    queue.pop(value);
+  }
+  for (const int16_t sample : {7, -3, 12, 5, 5, 9}) {
+    queue.push(sample);
+  }
+  const auto regions = queue.peek();
+  TEST_ASSERT_EQUAL(3, regions[0].size());
+  TEST_ASSERT_EQUAL_DOUBLE(35.0, ring::stats::sum(regions));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 35.0 / 6, ring::stats::mean(regions));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 21.472222222222225, ring::stats::variance(regions));
+  TEST_ASSERT_EQUAL(-3, ring::stats::min(regions));
+  TEST_ASSERT_EQUAL(12, ring::stats::max(regions));
+
+  std::array<int16_t, 8> scratch{};
+  TEST_ASSERT_EQUAL(7, ring::stats::median(regions, std::span<int16_t>(scratch)));
+  TEST_ASSERT_EQUAL(0, ring::stats::median(regions, std::span<int16_t>(scratch.data(), 4)));
+  const std::vector<int16_t> expected = {7, -3, 12, 5, 5, 9};
+  TEST_ASSERT_TRUE(expected == flatten(queue.peek()));
+}
+
+void test_spsc_ring_keeps_order_across_threads() {
+  constexpr uint32_t COUNT = 200000;
+  static ring::SpscRing<uint32_t, 64> queue;
+  std::thread producer([] {
+    for (uint32_t i = 0; i < COUNT;) {
+      if (queue.push(i)) {
+        i++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  uint32_t expected = 0;
+  uint32_t value = 0;
+  bool in_order = true;
+  while (expected < COUNT) {
+    if (queue.pop(value)) {
+      in_order = in_order && value == expected;
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  TEST_ASSERT_TRUE(in_order);
+  TEST_ASSERT_TRUE(queue.empty());
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_spsc_ring_push_pop_full_and_empty);
+  RUN_TEST(test_spsc_ring_peek_splits_at_wraparound);
+  RUN_TEST(test_packet_ring_replace_skips_front);
+  RUN_TEST(test_packet_ring_rejects_long_packets_and_overflow);
+  RUN_TEST(test_stats_do_not_reorder_the_ring);
+  RUN_TEST(test_spsc_ring_keeps_order_across_threads);
+  return UNITY_END();
+}